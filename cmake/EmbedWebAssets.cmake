@@ -0,0 +1,177 @@
+# 将 webclient 目录下的静态资源编译进可执行文件
+#
+# 用法（由 CMakeLists.txt 中的 add_custom_command 调用）:
+#   cmake -DASSET_DIR=<webclient目录> -DOUTPUT=<生成的.cpp> [-DWORK_DIR=<临时目录>] -P EmbedWebAssets.cmake
+#
+# 每个文件生成一个 constexpr 字节数组，文本类资源额外生成 gzip 预压缩版本（仅在压缩后更小时保留），
+# 并在构建期计算好 ETag 与 MIME 类型，运行时无需任何文件 I/O。
+cmake_minimum_required(VERSION 3.20)
+
+if(NOT ASSET_DIR OR NOT OUTPUT)
+    message(FATAL_ERROR "EmbedWebAssets: ASSET_DIR and OUTPUT are required")
+endif()
+if(NOT WORK_DIR)
+    get_filename_component(WORK_DIR "${OUTPUT}" DIRECTORY)
+    set(WORK_DIR "${WORK_DIR}/embed_tmp")
+endif()
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+include("${CMAKE_CURRENT_LIST_DIR}/WebAssetTypes.cmake")
+
+# 扩展名 -> MIME 类型；compress 标记表示值得做 gzip 预压缩
+function(asset_mime ext out_mime out_compress)
+    string(TOLOWER "${ext}" ext)
+    set(compress TRUE)
+    if(ext STREQUAL ".html" OR ext STREQUAL ".htm")
+        set(mime "text/html; charset=utf-8")
+    elseif(ext STREQUAL ".css")
+        set(mime "text/css; charset=utf-8")
+    elseif(ext STREQUAL ".js")
+        set(mime "application/javascript; charset=utf-8")
+    elseif(ext STREQUAL ".json")
+        set(mime "application/json; charset=utf-8")
+    elseif(ext STREQUAL ".md")
+        set(mime "text/markdown; charset=utf-8")
+    elseif(ext STREQUAL ".txt")
+        set(mime "text/plain; charset=utf-8")
+    elseif(ext STREQUAL ".svg")
+        set(mime "image/svg+xml")
+    elseif(ext STREQUAL ".ico")
+        set(mime "image/x-icon")
+    else()
+        set(compress FALSE)
+        if(ext STREQUAL ".png")
+            set(mime "image/png")
+        elseif(ext STREQUAL ".jpg" OR ext STREQUAL ".jpeg")
+            set(mime "image/jpeg")
+        elseif(ext STREQUAL ".gif")
+            set(mime "image/gif")
+        elseif(ext STREQUAL ".woff2")
+            set(mime "font/woff2")
+        elseif(ext STREQUAL ".woff")
+            set(mime "font/woff")
+        else()
+            set(mime "application/octet-stream")
+        endif()
+    endif()
+    set(${out_mime} "${mime}" PARENT_SCOPE)
+    set(${out_compress} ${compress} PARENT_SCOPE)
+endfunction()
+
+# 十六进制串 -> C 数组初始化列表（每行 32 字节，避免单行过长）
+function(hex_to_array hex out_var)
+    string(REGEX REPLACE "([0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f])" "\\1\n    " hex "${hex}")
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," hex "${hex}")
+    set(${out_var} "    ${hex}" PARENT_SCOPE)
+endfunction()
+
+# 整数 -> 4 字节小端十六进制串（gzip 尾部 ISIZE 字段）
+function(uint32_le_hex value out_var)
+    set(result "")
+    foreach(shift 0 8 16 24)
+        math(EXPR byte "(${value} >> ${shift}) & 255" OUTPUT_FORMAT HEXADECIMAL)
+        string(SUBSTRING "${byte}" 2 -1 byte)
+        string(LENGTH "${byte}" len)
+        if(len EQUAL 1)
+            set(byte "0${byte}")
+        endif()
+        string(APPEND result "${byte}")
+    endforeach()
+    string(TOLOWER "${result}" result)
+    set(${out_var} "${result}" PARENT_SCOPE)
+endfunction()
+
+# 任意字节串 -> 全转义的 C 字符串字面量（路径可能包含中文）
+function(escape_c_string str out_var)
+    string(HEX "${str}" hex)
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "\\\\x\\1" hex "${hex}")
+    set(${out_var} "\"${hex}\"" PARENT_SCOPE)
+endfunction()
+
+# 只嵌入白名单内的 UI 资源，目录中的接口文档/设计说明不随程序发布
+webclient_asset_globs("${ASSET_DIR}" asset_globs)
+file(GLOB_RECURSE files RELATIVE "${ASSET_DIR}" ${asset_globs})
+list(SORT files)
+
+set(arrays "")
+set(table "")
+set(count 0)
+foreach(rel IN LISTS files)
+    set(src "${ASSET_DIR}/${rel}")
+    get_filename_component(ext "${rel}" LAST_EXT)
+    asset_mime("${ext}" mime compress)
+
+    file(SIZE "${src}" size)
+    file(SHA1 "${src}" sha1)
+    string(SUBSTRING "${sha1}" 0 16 etag)
+
+    file(READ "${src}" hex HEX)
+    hex_to_array("${hex}" body)
+    string(APPEND arrays "// ${rel}\nstatic constexpr unsigned char kAsset${count}[] = {\n${body}\n    0x00\n};\n")
+
+    set(gz_ref "nullptr")
+    set(gz_size 0)
+    if(compress AND size GREATER 256)
+        # 先复制为 ASCII 文件名，libarchive 在非 UTF-8 locale 下无法处理中文路径
+        set(plain "${WORK_DIR}/asset${count}")
+        set(gz "${plain}.gz")
+        configure_file("${src}" "${plain}" COPYONLY)
+        file(ARCHIVE_CREATE OUTPUT "${gz}" PATHS "${plain}" FORMAT raw COMPRESSION GZip)
+        # libarchive 的 raw 格式会用 0 填充到块边界，按尾部 ISIZE 字段截掉填充
+        file(READ "${gz}" gz_hex HEX)
+        uint32_le_hex(${size} isize)
+        string(FIND "${gz_hex}" "${isize}" pos REVERSE)
+        math(EXPR odd "${pos} % 2")
+        set(gz_size 0)
+        if(pos GREATER 0 AND odd EQUAL 0)
+            math(EXPR gz_len "${pos} + 8")
+            string(SUBSTRING "${gz_hex}" 0 ${gz_len} gz_hex)
+            math(EXPR gz_size "${gz_len} / 2")
+        endif()
+        if(gz_size GREATER 0 AND gz_size LESS size)
+            hex_to_array("${gz_hex}" gz_body)
+            string(APPEND arrays "static constexpr unsigned char kAsset${count}Gz[] = {\n${gz_body}\n    0x00\n};\n")
+            set(gz_ref "kAsset${count}Gz")
+        else()
+            set(gz_size 0)
+        endif()
+        file(REMOVE "${gz}" "${plain}")
+    endif()
+    string(APPEND arrays "\n")
+
+    escape_c_string("/${rel}" path_literal)
+    string(APPEND table "    {${path_literal}, \"${mime}\", \"\\\"${etag}\\\"\", kAsset${count}, ${size}, ${gz_ref}, ${gz_size}},\n")
+    math(EXPR count "${count} + 1")
+endforeach()
+
+if(count EQUAL 0)
+    # MSVC 不允许零长度数组，保留一个哨兵元素
+    set(table "    {nullptr, nullptr, nullptr, nullptr, 0, nullptr, 0},\n")
+endif()
+
+set(content "// Generated by cmake/EmbedWebAssets.cmake from ${ASSET_DIR} - do not edit.
+#include \"server/EmbeddedAssets.h\"
+
+namespace sysmonitor {
+namespace {
+
+${arrays}// 按 path 字节序排列，供二分查找
+static constexpr EmbeddedAsset kAssets[] = {
+${table}};
+
+} // namespace
+
+const EmbeddedAsset* EmbeddedAssetTable() { return kAssets; }
+size_t EmbeddedAssetCount() { return ${count}; }
+
+} // namespace sysmonitor
+")
+
+# 内容未变化时不覆盖，避免无谓的重新编译
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" old)
+    if(old STREQUAL content)
+        return()
+    endif()
+endif()
+file(WRITE "${OUTPUT}" "${content}")
@@ -0,0 +1,13 @@
+# 可嵌入/可服务的前端资源扩展名白名单
+# 由 CMakeLists.txt（依赖收集）与 EmbedWebAssets.cmake（实际嵌入）共用，
+# 确保 RegisterAPI.json、api.md、界面设计.txt 等开发文档不会被编译进可执行文件
+set(WEBCLIENT_ASSET_EXTENSIONS html htm css js svg ico png jpg jpeg gif webp woff woff2)
+
+# 生成 file(GLOB_RECURSE) 所需的匹配模式列表
+function(webclient_asset_globs dir out_var)
+    set(globs "")
+    foreach(ext IN LISTS WEBCLIENT_ASSET_EXTENSIONS)
+        list(APPEND globs "${dir}/*.${ext}")
+    endforeach()
+    set(${out_var} "${globs}" PARENT_SCOPE)
+endfunction()
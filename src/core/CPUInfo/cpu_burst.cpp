@@ -0,0 +1,236 @@
+#include "cpu_burst.h"
+#include <algorithm>
+#include <chrono>
+#include "../../utils/util_time.h"
+#ifdef _WIN32
+#include <mmsystem.h>
+#endif
+
+namespace sysmonitor {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t kMinIntervalUs = 1000;
+constexpr uint32_t kMaxIntervalUs = 1000000;
+constexpr uint32_t kMaxDurationMs = 10 * 60 * 1000;
+constexpr size_t kMaxSamples = 100000;
+constexpr size_t kMaxValues = 4 * 1024 * 1024;   // 16 MB float
+
+uint64_t ElapsedUs(Clock::time_point from, Clock::time_point to) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(to - from).count());
+}
+
+#ifdef _WIN32
+// 采集期间把系统计时器精度提高到 1ms，否则等待按默认的 15.6ms 取整
+class TimerResolutionGuard {
+public:
+    TimerResolutionGuard() : active_(timeBeginPeriod(1) == TIMERR_NOERROR) {}
+    ~TimerResolutionGuard() {
+        if (active_) timeEndPeriod(1);
+    }
+
+private:
+    bool active_;
+};
+#endif
+
+} // namespace
+
+CpuBurstCapture::CpuBurstCapture() : CpuBurstCapture(CreateDefaultCpuTimesSource()) {
+}
+
+CpuBurstCapture::CpuBurstCapture(std::unique_ptr<CpuTimesSource> source) : source_(std::move(source)) {
+}
+
+CpuBurstCapture::~CpuBurstCapture() {
+    Stop();
+}
+
+bool CpuBurstCapture::Start(const CpuBurstOptions& options, std::string& error) {
+    if (options.intervalUs < kMinIntervalUs || options.intervalUs > kMaxIntervalUs) {
+        error = "interval must be between 1ms and 1s";
+        return false;
+    }
+    if (options.durationMs == 0 || options.durationMs > kMaxDurationMs) {
+        error = "duration must be between 1ms and 10min";
+        return false;
+    }
+    if (!(options.maxOverheadPercent > 0.0) || options.maxOverheadPercent > 100.0) {
+        error = "maxOverhead must be in (0, 100]";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> control(controlMutex_);
+    auto previous = std::atomic_load(&current_);
+    if (previous && previous->running.load(std::memory_order_acquire)) {
+        error = "a burst capture is already running";
+        return false;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    const uint32_t cores = source_->CoreCount();
+    const size_t stride = static_cast<size_t>(cores) + 1;
+    const size_t wanted = static_cast<size_t>(options.durationMs) * 1000 / options.intervalUs + 1;
+    const size_t capacity = std::min({wanted, kMaxSamples, std::max<size_t>(kMaxValues / stride, 1)});
+
+    auto buffer = std::make_shared<Buffer>();
+    buffer->id = nextId_++;
+    buffer->startTime = GET_LOCAL_TIME_MS();
+    buffer->options = options;
+    buffer->cores = cores;
+    buffer->capacity = capacity;
+    buffer->offsetsUs.resize(capacity);
+    buffer->values.resize(capacity * stride);
+
+    {
+        std::lock_guard<std::mutex> lk(stopMutex_);
+        stopRequested_ = false;
+    }
+    std::atomic_store(&current_, std::shared_ptr<Buffer>(buffer));
+    thread_ = std::thread(&CpuBurstCapture::Run, this, std::move(buffer));
+    return true;
+}
+
+void CpuBurstCapture::Stop() {
+    std::lock_guard<std::mutex> control(controlMutex_);
+    {
+        std::lock_guard<std::mutex> lk(stopMutex_);
+        stopRequested_ = true;
+    }
+    stopCv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+CpuBurstStatus CpuBurstCapture::GetStatus() const {
+    auto buffer = std::atomic_load(&current_);
+    return buffer ? StatusOf(*buffer) : CpuBurstStatus();
+}
+
+CpuBurstStatus CpuBurstCapture::Read(size_t from, size_t maxSamples, std::vector<CpuBurstSample>& out) const {
+    out.clear();
+    auto buffer = std::atomic_load(&current_);
+    if (!buffer) {
+        return CpuBurstStatus();
+    }
+    CpuBurstStatus status = StatusOf(*buffer);
+    if (from >= status.samples) {
+        return status;
+    }
+    const size_t count = std::min(status.samples - from, maxSamples);
+    const size_t stride = static_cast<size_t>(buffer->cores) + 1;
+    out.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const size_t index = from + i;
+        const float* row = &buffer->values[index * stride];
+        CpuBurstSample& sample = out[i];
+        sample.offsetUs = buffer->offsetsUs[index];
+        sample.totalUsage = row[0];
+        sample.coreUsages.assign(row + 1, row + stride);
+    }
+    return status;
+}
+
+CpuBurstStatus CpuBurstCapture::StatusOf(const Buffer& buffer) {
+    CpuBurstStatus status;
+    status.id = buffer.id;
+    // 先读 running：看到结束时，结束前发布的样本数一定可见
+    status.running = buffer.running.load(std::memory_order_acquire);
+    status.samples = buffer.published.load(std::memory_order_acquire);
+    status.startTime = buffer.startTime;
+    status.options = buffer.options;
+    status.cores = buffer.cores;
+    status.capacity = buffer.capacity;
+    status.throttled = buffer.throttled.load(std::memory_order_relaxed);
+    status.missed = buffer.missed.load(std::memory_order_relaxed);
+    const uint64_t elapsed = buffer.elapsedUs.load(std::memory_order_relaxed);
+    status.overheadPercent = elapsed > 0
+        ? 100.0 * static_cast<double>(buffer.workUs.load(std::memory_order_relaxed)) / static_cast<double>(elapsed)
+        : 0.0;
+    return status;
+}
+
+// 采样线程：截止时间固定在 start + k × interval 上；累计采样耗时换算出的最早时间晚于
+// 下一个截止点时，跳到其后的第一个截止点，使 workUs / elapsedUs 保持在 maxOverheadPercent 以内
+void CpuBurstCapture::Run(std::shared_ptr<Buffer> buffer) {
+    Buffer& b = *buffer;
+    const uint32_t cores = b.cores;
+    const size_t stride = static_cast<size_t>(cores) + 1;
+    const auto interval = std::chrono::microseconds(b.options.intervalUs);
+    const auto duration = std::chrono::milliseconds(b.options.durationMs);
+    const double workScale = 100.0 / b.options.maxOverheadPercent;
+
+    std::vector<CpuTimes> before(cores), after(cores);
+    std::vector<float> lastUsage(stride, 0.0f);
+    CpuTimes beforeTotal, afterTotal;
+#ifdef _WIN32
+    TimerResolutionGuard timerResolution;
+#endif
+
+    const auto start = Clock::now();
+    bool ok = source_->Read(beforeTotal, before.data());
+    uint64_t lastWorkUs = ElapsedUs(start, Clock::now());
+    uint64_t workUs = lastWorkUs;
+
+    uint64_t k = 1;
+    while (ok && b.published.load(std::memory_order_relaxed) < b.capacity) {
+        // 开销上限：按上一次的耗时预估本次采样，完成后的累计耗时也不超过上限
+        const auto earliest = start + std::chrono::microseconds(static_cast<uint64_t>((workUs + lastWorkUs) * workScale));
+        auto deadline = start + interval * k;
+        if (deadline < earliest) {
+            const uint64_t target = static_cast<uint64_t>((earliest - start + interval - Clock::duration(1)) / interval);
+            b.throttled.fetch_add(target - k, std::memory_order_relaxed);
+            k = target;
+            deadline = start + interval * k;
+        }
+        if (deadline - start > duration) {
+            break;
+        }
+        {
+            std::unique_lock<std::mutex> lk(stopMutex_);
+            if (stopCv_.wait_until(lk, deadline, [this] { return stopRequested_; })) {
+                break;
+            }
+        }
+
+        const auto sampleStart = Clock::now();
+        if (!source_->Read(afterTotal, after.data())) {
+            break;
+        }
+        const size_t index = b.published.load(std::memory_order_relaxed);
+        float* row = &b.values[index * stride];
+        row[0] = lastUsage[0] = static_cast<float>(CpuUsageBetween(beforeTotal, afterTotal, lastUsage[0]));
+        for (uint32_t i = 0; i < cores; ++i) {
+            row[i + 1] = lastUsage[i + 1] = static_cast<float>(CpuUsageBetween(before[i], after[i], lastUsage[i + 1]));
+        }
+        b.offsetsUs[index] = static_cast<uint32_t>(ElapsedUs(start, sampleStart));
+        b.published.store(index + 1, std::memory_order_release);
+        beforeTotal = afterTotal;
+        std::copy(after.begin(), after.end(), before.begin());
+
+        const auto sampleEnd = Clock::now();
+        lastWorkUs = ElapsedUs(sampleStart, sampleEnd);
+        workUs += lastWorkUs;
+        b.workUs.store(workUs, std::memory_order_relaxed);
+        b.elapsedUs.store(ElapsedUs(start, sampleEnd), std::memory_order_relaxed);
+
+        // 唤醒过晚时跳过已经错过的截止点
+        const uint64_t reached = static_cast<uint64_t>((sampleEnd - start) / interval);
+        if (reached > k) {
+            b.missed.fetch_add(reached - k, std::memory_order_relaxed);
+            k = reached;
+        }
+        ++k;
+    }
+
+    b.workUs.store(workUs, std::memory_order_relaxed);
+    b.elapsedUs.store(ElapsedUs(start, Clock::now()), std::memory_order_relaxed);
+    b.running.store(false, std::memory_order_release);
+}
+
+} // namespace sysmonitor
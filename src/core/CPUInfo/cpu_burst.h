@@ -0,0 +1,97 @@
+#pragma once
+#include "cpu_times.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sysmonitor {
+
+struct CpuBurstOptions {
+    uint32_t intervalUs = 10000;          // 采样间隔
+    uint32_t durationMs = 30000;          // 采集时长
+    double maxOverheadPercent = 5.0;      // 采样线程耗时占墙钟时间的上限（单个核心的百分比）
+};
+
+// 单个样本；使用率为百分比，offsetUs 相对采集开始时间
+struct CpuBurstSample {
+    uint32_t offsetUs = 0;
+    float totalUsage = 0.0f;
+    std::vector<float> coreUsages;
+};
+
+struct CpuBurstStatus {
+    uint64_t id = 0;                      // 每次 Start 递增，0 表示从未采集
+    bool running = false;
+    uint64_t startTime = 0;               // 毫秒
+    CpuBurstOptions options;
+    uint32_t cores = 0;
+    size_t capacity = 0;                  // 预分配的样本数
+    size_t samples = 0;                   // 已写入的样本数
+    uint64_t throttled = 0;               // 因开销上限推迟的采样次数
+    uint64_t missed = 0;                  // 唤醒过晚而跳过的采样点
+    double overheadPercent = 0.0;         // 采样线程实际耗时占比
+};
+
+/**
+ * @brief 按需高频采样整机与各核心 CPU 使用率，用于捕捉 1 秒平均值看不到的短时尖峰
+ *
+ * 每次采集使用专用线程按绝对时间采样，样本写入启动时一次分配好的缓冲区：
+ * 采样线程是唯一写者，写完一行后以 release 发布样本数，读者 acquire 读取已发布的前缀，
+ * 读写双方都不加锁。累计耗时超过 maxOverheadPercent 时推迟下一次采样，保证采样开销的上限。
+ */
+class CpuBurstCapture {
+public:
+    CpuBurstCapture();
+    explicit CpuBurstCapture(std::unique_ptr<CpuTimesSource> source);
+    ~CpuBurstCapture();
+
+    CpuBurstCapture(const CpuBurstCapture&) = delete;
+    CpuBurstCapture& operator=(const CpuBurstCapture&) = delete;
+
+    // 已有采集在进行或参数超出范围时返回 false 并给出原因
+    bool Start(const CpuBurstOptions& options, std::string& error);
+    void Stop();
+
+    CpuBurstStatus GetStatus() const;
+
+    // 读取第 from 个起最多 maxSamples 个已发布的样本，返回本次采集的状态
+    CpuBurstStatus Read(size_t from, size_t maxSamples, std::vector<CpuBurstSample>& out) const;
+
+private:
+    // 一次采集的缓冲区，发布后只追加不重分配
+    struct Buffer {
+        uint64_t id = 0;
+        uint64_t startTime = 0;
+        CpuBurstOptions options;
+        uint32_t cores = 0;
+        size_t capacity = 0;
+        std::vector<uint32_t> offsetsUs;
+        std::vector<float> values;        // 每个样本 cores + 1 个：合计在前，之后按核心
+        std::atomic<size_t> published{0};
+        std::atomic<bool> running{true};
+        std::atomic<uint64_t> throttled{0};
+        std::atomic<uint64_t> missed{0};
+        std::atomic<uint64_t> workUs{0};
+        std::atomic<uint64_t> elapsedUs{0};
+    };
+
+    void Run(std::shared_ptr<Buffer> buffer);
+    static CpuBurstStatus StatusOf(const Buffer& buffer);
+
+    std::unique_ptr<CpuTimesSource> source_;
+    std::shared_ptr<Buffer> current_;     // std::atomic_load / atomic_store
+
+    std::mutex controlMutex_;             // 串行化 Start / Stop
+    std::thread thread_;
+    std::mutex stopMutex_;
+    std::condition_variable stopCv_;
+    bool stopRequested_ = false;
+    uint64_t nextId_ = 1;
+};
+
+} // namespace sysmonitor
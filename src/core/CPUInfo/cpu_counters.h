@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+
+namespace sysmonitor {
+
+enum class CpuCounterMode {
+    None,
+    Hardware,   // cycles、instructions、缓存未命中、分支预测失败
+    Software,   // 虚拟机等没有硬件计数器时：上下文切换、迁移、缺页、主缺页
+};
+
+// 每个逻辑核心的累计计数，已按多路复用比例折算；只用于相邻两次读取求差。当前模式以外的字段为 0
+struct CpuCounterValues {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cacheMisses = 0;       // 末级缓存未命中
+    uint64_t branchMisses = 0;
+
+    uint64_t contextSwitches = 0;
+    uint64_t migrations = 0;
+    uint64_t pageFaults = 0;
+    uint64_t majorFaults = 0;
+};
+
+// 计数器组被多路复用（与其他组分时占用 PMU）时只在 running / enabled 的时间内计数，按比例折算回整段时间。
+// running 为 0 时本段没有计数，无从估计，记 0
+inline uint64_t ScaleMultiplexedCount(uint64_t value, uint64_t enabled, uint64_t running) {
+    if (running == 0) {
+        return 0;
+    }
+    if (running >= enabled) {
+        return value;
+    }
+    return static_cast<uint64_t>(static_cast<double>(value) * static_cast<double>(enabled) / static_cast<double>(running));
+}
+
+/**
+ * @brief 每核心性能计数器来源
+ *
+ * 计数器按核心成组打开，每次读取对每组做一次 read。构造后模式与核心数不变。
+ * Read 在采样路径上调用，实现应避免分配堆内存。
+ */
+class CpuCounterSource {
+public:
+    virtual ~CpuCounterSource() = default;
+
+    virtual CpuCounterMode Mode() const = 0;
+    // 与 CpuTimesSource::CoreCount 一致
+    virtual uint32_t CoreCount() const = 0;
+
+    // cores 由调用方预先分配 CoreCount() 个；无法计数的核心（如离线）写入 0
+    virtual bool Read(CpuCounterValues* cores) = 0;
+};
+
+// Linux perf_event_open：优先硬件事件，不可用时退回软件事件；都打不开（权限不足、非 Linux）时返回 nullptr
+std::unique_ptr<CpuCounterSource> CreateDefaultCpuCounterSource();
+
+} // namespace sysmonitor
@@ -0,0 +1,154 @@
+// Linux 性能计数器来源：每个 CPU 用 perf_event_open 打开一组计数器（pid = -1 统计该 CPU 上的所有任务），
+// 以 PERF_FORMAT_GROUP 一次 read 取回整组数值与启用/运行时间。
+// 系统级计数需要 CAP_PERFMON 或 perf_event_paranoid <= 0
+#ifdef __linux__
+#include "cpu_counters.h"
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#include <vector>
+
+namespace sysmonitor {
+
+namespace {
+
+constexpr size_t kGroupSize = 4;
+
+struct EventSpec {
+    uint32_t type;
+    uint64_t config;
+    uint64_t CpuCounterValues::* field;
+};
+
+// 组长在前。cpu-clock 在按 CPU 统计时等于墙钟时间，没有信息量，软件组不包含。
+// CACHE_MISSES 在多数 CPU 上对应末级缓存未命中，比 HW_CACHE 组合事件支持更广
+const EventSpec kHardwareEvents[kGroupSize] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, &CpuCounterValues::cycles},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, &CpuCounterValues::instructions},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, &CpuCounterValues::cacheMisses},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, &CpuCounterValues::branchMisses},
+};
+
+const EventSpec kSoftwareEvents[kGroupSize] = {
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, &CpuCounterValues::contextSwitches},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS, &CpuCounterValues::migrations},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS, &CpuCounterValues::pageFaults},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS_MAJ, &CpuCounterValues::majorFaults},
+};
+
+int PerfEventOpen(const EventSpec& spec, int cpu, int groupFd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // 组长先停用，整组打开后再一起启用，组内计数从同一时刻开始
+    attr.disabled = groupFd < 0 ? 1 : 0;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, -1, cpu, groupFd, PERF_FLAG_FD_CLOEXEC));
+}
+
+class PerfEventCpuCounterSource : public CpuCounterSource {
+public:
+    PerfEventCpuCounterSource() {
+        long configured = sysconf(_SC_NPROCESSORS_CONF);
+        groups_.resize(configured > 0 ? static_cast<size_t>(configured) : 1);
+        if (OpenAll(kHardwareEvents)) {
+            mode_ = CpuCounterMode::Hardware;
+        } else if (OpenAll(kSoftwareEvents)) {
+            mode_ = CpuCounterMode::Software;
+        }
+    }
+
+    ~PerfEventCpuCounterSource() override {
+        CloseAll();
+    }
+
+    CpuCounterMode Mode() const override { return mode_; }
+    uint32_t CoreCount() const override { return static_cast<uint32_t>(groups_.size()); }
+
+    bool Read(CpuCounterValues* cores) override {
+        for (size_t i = 0; i < groups_.size(); ++i) {
+            CpuCounterValues& out = cores[i];
+            out = CpuCounterValues();
+            const Group& group = groups_[i];
+            if (group.fds[0] < 0) continue;
+
+            // PERF_FORMAT_GROUP 布局：nr, time_enabled, time_running, value[nr]
+            uint64_t data[3 + kGroupSize];
+            if (read(group.fds[0], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[0] != kGroupSize) {
+                continue;
+            }
+            const uint64_t enabled = data[1];
+            const uint64_t running = data[2];
+            if (running == 0) continue;
+            for (size_t e = 0; e < kGroupSize; ++e) {
+                out.*(events_[e].field) = ScaleMultiplexedCount(data[3 + e], enabled, running);
+            }
+        }
+        return true;
+    }
+
+private:
+    struct Group {
+        int fds[kGroupSize] = {-1, -1, -1, -1};
+    };
+
+    // 至少一个 CPU 成功打开整组时返回 true；离线 CPU 打开失败，跳过
+    bool OpenAll(const EventSpec (&events)[kGroupSize]) {
+        bool any = false;
+        for (size_t cpu = 0; cpu < groups_.size(); ++cpu) {
+            Group& group = groups_[cpu];
+            bool ok = true;
+            for (size_t e = 0; e < kGroupSize && ok; ++e) {
+                group.fds[e] = PerfEventOpen(events[e], static_cast<int>(cpu), e == 0 ? -1 : group.fds[0]);
+                ok = group.fds[e] >= 0;
+            }
+            if (!ok) {
+                CloseGroup(group);
+                continue;
+            }
+            ioctl(group.fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            any = true;
+        }
+        if (any) {
+            events_ = events;
+        } else {
+            CloseAll();
+        }
+        return any;
+    }
+
+    static void CloseGroup(Group& group) {
+        for (int& fd : group.fds) {
+            if (fd >= 0) close(fd);
+            fd = -1;
+        }
+    }
+
+    void CloseAll() {
+        for (Group& group : groups_) {
+            CloseGroup(group);
+        }
+    }
+
+    std::vector<Group> groups_;
+    const EventSpec* events_ = kHardwareEvents;
+    CpuCounterMode mode_ = CpuCounterMode::None;
+};
+
+} // namespace
+
+std::unique_ptr<CpuCounterSource> CreateDefaultCpuCounterSource() {
+    auto source = std::make_unique<PerfEventCpuCounterSource>();
+    if (source->Mode() == CpuCounterMode::None) {
+        return nullptr;
+    }
+    return source;
+}
+
+} // namespace sysmonitor
+
+#endif // __linux__
@@ -0,0 +1,13 @@
+// Windows 没有可供用户态按核心读取的通用硬件计数器接口（需要 ETW PMC 或驱动），不提供该采集器
+#ifdef _WIN32
+#include "cpu_counters.h"
+
+namespace sysmonitor {
+
+std::unique_ptr<CpuCounterSource> CreateDefaultCpuCounterSource() {
+    return nullptr;
+}
+
+} // namespace sysmonitor
+
+#endif // _WIN32
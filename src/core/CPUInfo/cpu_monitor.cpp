@@ -1,30 +1,91 @@
-#define NOMINMAX
-#include <windows.h>
-#include <iostream>
-#include <pdh.h>
-#include <pdhmsg.h>
 #include <algorithm>
 #include <mutex>
-#include <vector>
 #include "cpu_monitor.h"
 #include "../../utils/util_time.h"
-
-#pragma comment(lib, "pdh.lib")
+#include "../../utils/metrics.h"
 
 namespace sysmonitor {
 
-// ??????????????λ???????????λ??
-static DWORD CountSetBits(ULONG_PTR bitMask) {
-    DWORD count = 0;
-    while (bitMask) {
-        count += bitMask & 1;
-        bitMask >>= 1;
+namespace {
+
+CpuTimeBreakdown BreakdownBetween(const CpuTimes& before, const CpuTimes& after) {
+    const uint64_t user = CounterDelta(before.user, after.user);
+    const uint64_t system = CounterDelta(before.system, after.system);
+    const uint64_t irq = CounterDelta(before.irq, after.irq);
+    const uint64_t softirq = CounterDelta(before.softirq, after.softirq);
+    const uint64_t iowait = CounterDelta(before.iowait, after.iowait);
+    const uint64_t steal = CounterDelta(before.steal, after.steal);
+    const uint64_t idle = CounterDelta(before.idle - before.iowait, after.idle - after.iowait);
+    const uint64_t total = user + system + irq + softirq + iowait + steal + idle;
+
+    CpuTimeBreakdown breakdown;
+    if (total == 0) {
+        return breakdown;
     }
-    return count;
+    const double scale = 100.0 / static_cast<double>(total);
+    breakdown.user = user * scale;
+    breakdown.system = system * scale;
+    breakdown.irq = irq * scale;
+    breakdown.softirq = softirq * scale;
+    breakdown.iowait = iowait * scale;
+    breakdown.steal = steal * scale;
+    breakdown.idle = idle * scale;
+    return breakdown;
+}
+
+inline double PerSec(uint64_t before, uint64_t after, double seconds) {
+    return static_cast<double>(CounterDelta(before, after)) / seconds;
+}
+
+// 比值的分母为 0 时记 0
+inline double Ratio(double numerator, double denominator) {
+    return denominator > 0.0 ? numerator / denominator : 0.0;
+}
+
+CpuCounterRates CounterRatesBetween(const CpuCounterValues& before, const CpuCounterValues& after, double seconds) {
+    CpuCounterRates rates;
+    rates.cyclesPerSec = PerSec(before.cycles, after.cycles, seconds);
+    rates.instructionsPerSec = PerSec(before.instructions, after.instructions, seconds);
+    rates.cacheMissesPerSec = PerSec(before.cacheMisses, after.cacheMisses, seconds);
+    rates.branchMissesPerSec = PerSec(before.branchMisses, after.branchMisses, seconds);
+    rates.contextSwitchesPerSec = PerSec(before.contextSwitches, after.contextSwitches, seconds);
+    rates.migrationsPerSec = PerSec(before.migrations, after.migrations, seconds);
+    rates.pageFaultsPerSec = PerSec(before.pageFaults, after.pageFaults, seconds);
+    rates.majorFaultsPerSec = PerSec(before.majorFaults, after.majorFaults, seconds);
+    return rates;
 }
 
-CPUMonitor::CPUMonitor() : intervalMs_(1000) {
+// 由各项速率推导比值；整机合计时在累加之后调用
+void FinishCounterRates(CpuCounterRates& rates) {
+    rates.instructionsPerCycle = Ratio(rates.instructionsPerSec, rates.cyclesPerSec);
+    rates.cacheMissesPerKiloInstructions = Ratio(1000.0 * rates.cacheMissesPerSec, rates.instructionsPerSec);
+    rates.branchMissesPerKiloInstructions = Ratio(1000.0 * rates.branchMissesPerSec, rates.instructionsPerSec);
+}
+
+void AddCounterRates(CpuCounterRates& total, const CpuCounterRates& core) {
+    total.cyclesPerSec += core.cyclesPerSec;
+    total.instructionsPerSec += core.instructionsPerSec;
+    total.cacheMissesPerSec += core.cacheMissesPerSec;
+    total.branchMissesPerSec += core.branchMissesPerSec;
+    total.contextSwitchesPerSec += core.contextSwitchesPerSec;
+    total.migrationsPerSec += core.migrationsPerSec;
+    total.pageFaultsPerSec += core.pageFaultsPerSec;
+    total.majorFaultsPerSec += core.majorFaultsPerSec;
+}
+
+} // namespace
+
+CPUMonitor::CPUMonitor() : CPUMonitor(CreateDefaultCpuTimesSource()) {
+}
+
+CPUMonitor::CPUMonitor(std::unique_ptr<CpuTimesSource> source) : intervalMs_(1000), source_(std::move(source)) {
     cpuInfo_ = SystemInfo::GetCPUInfo();
+    // 每次采样原地更新，之后不再分配
+    uint32_t cores = source_->CoreCount();
+    coreTimes_.assign(cores, CpuTimes());
+    lastCoreTimes_.assign(cores, CpuTimes());
+    currentCoreUsages_.assign(cores, 0.0);
+    currentCoreBreakdowns_.assign(cores, CpuTimeBreakdown());
 }
 
 CPUMonitor::~CPUMonitor() {
@@ -35,286 +96,139 @@ bool CPUMonitor::Initialize() {
     return UpdateUsageData();
 }
 
-void CPUMonitor::StartMonitoring(int intervalMs) {
+bool CPUMonitor::EnableCounters() {
+    return EnableCounters(CreateDefaultCpuCounterSource());
+}
+
+bool CPUMonitor::EnableCounters(std::unique_ptr<CpuCounterSource> source) {
+    if (!source || source->Mode() == CpuCounterMode::None) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lk(coreUsageMutex_);
+    const uint32_t cores = source->CoreCount();
+    counterSource_ = std::move(source);
+    hasCounterBaseline_ = false;
+    counterValues_.assign(cores, CpuCounterValues());
+    lastCounterValues_.assign(cores, CpuCounterValues());
+    currentCounterRates_ = CpuCounterRates();
+    currentCoreCounterRates_.assign(cores, CpuCounterRates());
+    return true;
+}
+
+void CPUMonitor::StartMonitoring(PeriodicScheduler& scheduler, int intervalMs) {
     if (isRunning_) return;
-    
+
     intervalMs_ = intervalMs;
     isRunning_ = true;
-    monitorThread_ = std::make_unique<std::thread>(&CPUMonitor::MonitoringLoop, this);
+    scheduler_ = &scheduler;
+    taskId_ = scheduler.Schedule("cpu", static_cast<uint32_t>(intervalMs), [this] { Sample(); });
 }
 
 void CPUMonitor::StopMonitoring() {
-    isRunning_ = false;
-    if (monitorThread_ && monitorThread_->joinable()) {
-        monitorThread_->join();
+    if (!isRunning_.exchange(false)) return;
+    scheduler_->Cancel(taskId_);
+    taskId_ = PeriodicScheduler::kInvalidTask;
+}
+
+void CPUMonitor::Sample() {
+    CPUUsage usageData;
+    usageData.totalUsage = CalculateUsage();
+    usageData.timestamp = GET_LOCAL_TIME_MS();
+    if (usageData.totalUsage >= 0.0) {
+        CopyCurrent(usageData);
+    }
+
+    if (callback_) {
+        callback_(usageData);
     }
 }
 
-void CPUMonitor::MonitoringLoop() {
-    while (isRunning_) {
-        double usage = CalculateUsage();
-        CPUUsage usageData;
-        usageData.totalUsage = usage;
-        usageData.timestamp = GET_LOCAL_TIME_MS();
-
-        if (callback_) {
-            callback_(usageData);
-        }
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs_));
+void CPUMonitor::CopyCurrent(CPUUsage& usage) {
+    std::lock_guard<std::mutex> lk(coreUsageMutex_);
+    usage.coreUsages = currentCoreUsages_;
+    usage.breakdown = currentBreakdown_;
+    usage.coreBreakdowns = currentCoreBreakdowns_;
+    if (counterSource_) {
+        usage.counterMode = counterSource_->Mode();
+        usage.counters = currentCounterRates_;
+        usage.coreCounters = currentCoreCounterRates_;
     }
 }
 
 CPUUsage CPUMonitor::GetCurrentUsage() {
+    SYSMON_TIME_COLLECTOR("CPUGetCurrentUsage");
+
     CPUUsage usage;
     usage.timestamp = GET_LOCAL_TIME_MS();
-    if (!UpdateUsageData()) {
+    // 后台采样运行时直接返回最近一次结果；按请求采样会缩短采样间隔，计时粒度下读数失真
+    if (!isRunning_ && !UpdateUsageData()) {
         usage.totalUsage = -1.0;
         return usage;
     }
 
     usage.totalUsage = currentUsage.load();
-
-    try {
-        std::lock_guard<std::mutex> lk(coreUsageMutex_);
-        usage.coreUsages = currentCoreUsages_;
-    } catch (...) {
-        usage.coreUsages.clear();
-    }
-
+    CopyCurrent(usage);
     return usage;
 }
 
 bool CPUMonitor::UpdateUsageData() {
-    FILETIME idleTime, kernelTime, userTime;
-    
-    if (!GetSystemTimes(&idleTime, &kernelTime, &userTime)) {
+    std::lock_guard<std::mutex> lk(coreUsageMutex_);
+
+    CpuTimes total;
+    if (!source_->Read(total, coreTimes_.data())) {
         return false;
     }
-    
-    ULARGE_INTEGER idle, kernel, user;
-    idle.LowPart = idleTime.dwLowDateTime;
-    idle.HighPart = idleTime.dwHighDateTime;
-    kernel.LowPart = kernelTime.dwLowDateTime;
-    kernel.HighPart = kernelTime.dwHighDateTime;
-    user.LowPart = userTime.dwLowDateTime;
-    user.HighPart = userTime.dwHighDateTime;
-    
-    uint64_t totalTime = (kernel.QuadPart + user.QuadPart);
-    uint64_t idleTimeValue = idle.QuadPart;
-    
-    if (lastTotalTime_ != 0 && lastIdleTime_ != 0) {
-        uint64_t totalDiff = totalTime - lastTotalTime_;
-        uint64_t idleDiff = idleTimeValue - lastIdleTime_;
-        
-        if (totalDiff > 0) {
-            double usage = 100.0 * (static_cast<double>(totalDiff) - static_cast<double>(idleDiff)) / static_cast<double>(totalDiff);
-            usage = usage < 0.0 ? 0.0 : (usage > 100.0 ? 100.0 : usage);
-            currentUsage.store(usage);
-            std::cout << "Debug: CPU Usage = " << usage << "%" << std::endl;
-        } else {
-            currentUsage.store(0.0);
-        }
-    } else {
-        currentUsage.store(0.0);
-    }
 
-    lastTotalTime_ = totalTime;
-    lastIdleTime_ = idleTimeValue;
-
-    try {
-        HMODULE ntdll = GetModuleHandleA("ntdll.dll");
-        if (ntdll) {
-            using NtQuerySystemInformation_t = NTSTATUS(WINAPI*)(int, PVOID, ULONG, PULONG);
-            auto NtQuerySystemInformation = reinterpret_cast<NtQuerySystemInformation_t>(GetProcAddress(ntdll, "NtQuerySystemInformation"));
-            if (NtQuerySystemInformation) {
-                uint32_t cores = cpuInfo_.logicalCores > 0 ? cpuInfo_.logicalCores : SystemInfo::GetLogicalCoreCount();
-
-                struct SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION {
-                    LARGE_INTEGER IdleTime;
-                    LARGE_INTEGER KernelTime;
-                    LARGE_INTEGER UserTime;
-                    LARGE_INTEGER DpcTime;
-                    LARGE_INTEGER InterruptTime;
-                    ULONG InterruptCount;
-                };
-
-                std::vector<SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION> info;
-                info.resize(cores);
-                ULONG returnLength = 0;
-
-                NTSTATUS status = NtQuerySystemInformation(8, info.data(), static_cast<ULONG>(sizeof(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION) * info.size()), &returnLength);
-                if (status == 0) {
-                    if (lastCoreTotalTimes_.size() != cores) {
-                        lastCoreTotalTimes_.assign(cores, 0);
-                        lastCoreIdleTimes_.assign(cores, 0);
-                        currentCoreUsages_.assign(cores, 0.0);
-                    }
-
-                    std::lock_guard<std::mutex> lk(coreUsageMutex_);
-                    for (uint32_t i = 0; i < cores; ++i) {
-                        uint64_t k = static_cast<uint64_t>(info[i].KernelTime.QuadPart);
-                        uint64_t u = static_cast<uint64_t>(info[i].UserTime.QuadPart);
-                        uint64_t idle = static_cast<uint64_t>(info[i].IdleTime.QuadPart);
-                        uint64_t total = k + u;
-
-                        if (lastCoreTotalTimes_[i] != 0 || lastCoreIdleTimes_[i] != 0) {
-                            uint64_t totalDiff = total - lastCoreTotalTimes_[i];
-                            uint64_t idleDiff = idle - lastCoreIdleTimes_[i];
-                            double usage = 0.0;
-                            if (totalDiff > 0) {
-                                usage = 100.0 * (static_cast<double>(totalDiff) - static_cast<double>(idleDiff)) / static_cast<double>(totalDiff);
-                                if (usage < 0.0) usage = 0.0;
-                                if (usage > 100.0) usage = 100.0;
-                            }
-                            currentCoreUsages_[i] = usage;
-                        } else {
-                            currentCoreUsages_[i] = 0.0;
-                        }
-
-                        lastCoreTotalTimes_[i] = total;
-                        lastCoreIdleTimes_[i] = idle;
-                    }
-                }
-            }
-        }
-    } catch (...) {
+    const bool hasBaseline = hasBaseline_;
+    currentUsage.store(hasBaseline ? CpuUsageBetween(lastTotal_, total) : 0.0);
+    currentBreakdown_ = hasBaseline ? BreakdownBetween(lastTotal_, total) : CpuTimeBreakdown();
+    lastTotal_ = total;
 
+    for (size_t i = 0; i < coreTimes_.size(); ++i) {
+        currentCoreUsages_[i] = hasBaseline ? CpuUsageBetween(lastCoreTimes_[i], coreTimes_[i]) : 0.0;
+        currentCoreBreakdowns_[i] = hasBaseline ? BreakdownBetween(lastCoreTimes_[i], coreTimes_[i]) : CpuTimeBreakdown();
+        lastCoreTimes_[i] = coreTimes_[i];
     }
+    hasBaseline_ = true;
 
-    return true;
-}
-double CPUMonitor::CalculateUsage() {
-    FILETIME idleTime, kernelTime, userTime;
-    
-    if (!GetSystemTimes(&idleTime, &kernelTime, &userTime)) {
-        return -1.0;
+    if (counterSource_) {
+        UpdateCounterRates();
     }
-    
-    ULARGE_INTEGER idle, kernel, user;
-    idle.LowPart = idleTime.dwLowDateTime;
-    idle.HighPart = idleTime.dwHighDateTime;
-    kernel.LowPart = kernelTime.dwLowDateTime;
-    kernel.HighPart = kernelTime.dwHighDateTime;
-    user.LowPart = userTime.dwLowDateTime;
-    user.HighPart = userTime.dwHighDateTime;
-    
-    uint64_t totalTime = (kernel.QuadPart + user.QuadPart);
-    uint64_t idleTimeValue = idle.QuadPart;
-    
-    if (lastTotalTime_ == 0 || lastIdleTime_ == 0) {
-        // 第一次调用，只记录时间，不计算使用率
-        lastTotalTime_ = totalTime;
-        lastIdleTime_ = idleTimeValue;
-        return 0.0;
-    }
-    
-    uint64_t totalDiff = totalTime - lastTotalTime_;
-    uint64_t idleDiff = idleTimeValue - lastIdleTime_;
-    
-    lastTotalTime_ = totalTime;
-    lastIdleTime_ = idleTimeValue;
-    
-    if (totalDiff == 0) {
-        return 0.0;
-    }
-    
-    double usage = 100.0 * (totalDiff - idleDiff) / totalDiff;
-    return std::max(0.0, std::min(100.0, usage));
+    return true;
 }
-// SystemInfo ??????
-CPUInfo SystemInfo::GetCPUInfo() {
-    CPUInfo info;
-    
-    // ????????
-    SYSTEM_INFO sysInfo;
-    GetSystemInfo(&sysInfo);
-    info.logicalCores = sysInfo.dwNumberOfProcessors;
-    
-    // ????????????
-    switch (sysInfo.wProcessorArchitecture) {
-        case PROCESSOR_ARCHITECTURE_AMD64:
-            info.architecture = "x64";
-            break;
-        case PROCESSOR_ARCHITECTURE_ARM:
-            info.architecture = "ARM";
-            break;
-        case PROCESSOR_ARCHITECTURE_IA64:
-            info.architecture = "Intel Itanium";
-            break;
-        case PROCESSOR_ARCHITECTURE_INTEL:
-            info.architecture = "x86";
-            break;
-        default:
-            info.architecture = "Unknown";
-    }
-    
-    // ??????????????????
-    DWORD returnLength = 0;
-    GetLogicalProcessorInformation(NULL, &returnLength);
-    
-    if (GetLastError() == ERROR_INSUFFICIENT_BUFFER) {
-        auto buffer = std::make_unique<BYTE[]>(returnLength);
-        auto processorInfo = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION>(buffer.get());
-        
-        if (GetLogicalProcessorInformation(processorInfo, &returnLength)) {
-            DWORD processorCoreCount = 0;
-            DWORD processorPackageCount = 0;
-            
-            DWORD byteOffset = 0;
-            while (byteOffset + sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION) <= returnLength) {
-                switch (processorInfo->Relationship) {
-                    case RelationProcessorCore:
-                        processorCoreCount++;
-                        info.physicalCores = processorCoreCount;
-                        break;
-                    case RelationProcessorPackage:
-                        processorPackageCount++;
-                        info.packages = processorPackageCount;
-                        break;
-                }
-                byteOffset += sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
-                processorInfo++;
-            }
-        }
+
+void CPUMonitor::UpdateCounterRates() {
+    SYSMON_TIME_COLLECTOR("CPUCounters");
+
+    const auto now = std::chrono::steady_clock::now();
+    if (!counterSource_->Read(counterValues_.data())) {
+        return;
     }
-    
-    // ?????????CPU????????
-    HKEY hKey;
-    if (RegOpenKeyEx(HKEY_LOCAL_MACHINE,
-        "HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0",
-        0, KEY_READ, &hKey) == ERROR_SUCCESS) {
-        
-        char processorName[256] = {0};
-        DWORD size = sizeof(processorName);
-        if (RegQueryValueEx(hKey, "ProcessorNameString", NULL, NULL, 
-                           (LPBYTE)processorName, &size) == ERROR_SUCCESS) {
-            info.name = processorName;
-        }
-        
-        DWORD mhz;
-        size = sizeof(mhz);
-        if (RegQueryValueEx(hKey, "~MHz", NULL, NULL, 
-                           (LPBYTE)&mhz, &size) == ERROR_SUCCESS) {
-            info.baseFrequency = mhz;
-        }
-        
-        RegCloseKey(hKey);
+    const double seconds = std::chrono::duration<double>(now - lastCounterTime_).count();
+    const bool hasBaseline = hasCounterBaseline_ && seconds > 0.0;
+
+    CpuCounterRates total;
+    for (size_t i = 0; i < counterValues_.size(); ++i) {
+        CpuCounterRates& rates = currentCoreCounterRates_[i];
+        rates = hasBaseline ? CounterRatesBetween(lastCounterValues_[i], counterValues_[i], seconds) : CpuCounterRates();
+        FinishCounterRates(rates);
+        AddCounterRates(total, rates);
     }
-    
-    return info;
-}
+    FinishCounterRates(total);
+    currentCounterRates_ = total;
 
-uint32_t SystemInfo::GetPhysicalCoreCount() {
-    return GetCPUInfo().physicalCores;
+    counterValues_.swap(lastCounterValues_);
+    lastCounterTime_ = now;
+    hasCounterBaseline_ = true;
 }
 
-uint32_t SystemInfo::GetLogicalCoreCount() {
-    return GetCPUInfo().logicalCores;
-}
+double CPUMonitor::CalculateUsage() {
+    SYSMON_TIME_COLLECTOR("CPUCalculateUsage");
 
-std::string SystemInfo::GetCPUName() {
-    return GetCPUInfo().name;
+    if (!UpdateUsageData()) {
+        return -1.0;
+    }
+    return currentUsage.load();
 }
 
-} // namespace sysmonitor
\ No newline at end of file
+} // namespace sysmonitor
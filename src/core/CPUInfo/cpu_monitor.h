@@ -1,7 +1,10 @@
 #pragma once
 #include "system_info.h"
+#include "cpu_times.h"
+#include "cpu_counters.h"
+#include "../../utils/scheduler.h"
 #include <atomic>
-#include <thread>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -13,6 +16,7 @@ public:
     using UsageCallback = std::function<void(const CPUUsage&)>;
 
     CPUMonitor();
+    explicit CPUMonitor(std::unique_ptr<CpuTimesSource> source);
     ~CPUMonitor();
 
     // 禁用拷贝
@@ -20,7 +24,11 @@ public:
     CPUMonitor& operator=(const CPUMonitor&) = delete;
 
     bool Initialize();
-    void StartMonitoring(int intervalMs = 1000);
+    // 可选：每次采样同时读取每核心性能计数器，速率随 CPUUsage 发布。返回是否有可用的计数器来源
+    bool EnableCounters();
+    bool EnableCounters(std::unique_ptr<CpuCounterSource> source);
+    // 在 scheduler 上注册周期采样任务；scheduler 须比本对象存活更久
+    void StartMonitoring(PeriodicScheduler& scheduler, int intervalMs = 1000);
     void StopMonitoring();
     
     CPUUsage GetCurrentUsage();
@@ -33,25 +41,43 @@ public:
     bool IsRunning() const { return isRunning_; }
 
 private:
-    void MonitoringLoop();
+    void Sample();
     bool UpdateUsageData();
+    // 由 UpdateUsageData 在持有 coreUsageMutex_ 时调用
+    void UpdateCounterRates();
     double CalculateUsage();
+    // 复制最近一次的每核心使用率与时间细分
+    void CopyCurrent(CPUUsage& usage);
 
 private:
     std::atomic<bool> isRunning_{false};
-    std::unique_ptr<std::thread> monitorThread_;
+    PeriodicScheduler* scheduler_ = nullptr;
+    PeriodicScheduler::TaskId taskId_ = PeriodicScheduler::kInvalidTask;
     UsageCallback callback_;
     int intervalMs_;
     CPUInfo cpuInfo_;
     
     // CPU使用率计算相关
+    std::unique_ptr<CpuTimesSource> source_;
     std::atomic<double> currentUsage{0.0};
-    uint64_t lastTotalTime_{0};
-    uint64_t lastIdleTime_{0};
 
-    std::vector<uint64_t> lastCoreTotalTimes_;
-    std::vector<uint64_t> lastCoreIdleTimes_;
+    // 以下由 coreUsageMutex_ 保护，数组在构造时按核心数分配
+    bool hasBaseline_ = false;
+    CpuTimes lastTotal_;
+    std::vector<CpuTimes> coreTimes_;
+    std::vector<CpuTimes> lastCoreTimes_;
     std::vector<double> currentCoreUsages_;
+    CpuTimeBreakdown currentBreakdown_;
+    std::vector<CpuTimeBreakdown> currentCoreBreakdowns_;
+
+    // 性能计数器，未启用时 counterSource_ 为空
+    std::unique_ptr<CpuCounterSource> counterSource_;
+    bool hasCounterBaseline_ = false;
+    std::chrono::steady_clock::time_point lastCounterTime_;
+    std::vector<CpuCounterValues> counterValues_;
+    std::vector<CpuCounterValues> lastCounterValues_;
+    CpuCounterRates currentCounterRates_;
+    std::vector<CpuCounterRates> currentCoreCounterRates_;
     std::mutex coreUsageMutex_;
 };
 
@@ -0,0 +1,124 @@
+#include "cpu_telemetry.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "../../utils/util_time.h"
+#include "../../utils/metrics.h"
+
+namespace sysmonitor {
+
+namespace {
+
+inline uint16_t Saturate16(uint64_t value) {
+    return static_cast<uint16_t>(std::min<uint64_t>(value, std::numeric_limits<uint16_t>::max()));
+}
+
+// 计数器被重置（如驱动重新加载）时不计为事件
+inline uint64_t Delta(uint64_t before, uint64_t after) {
+    return after > before ? after - before : 0;
+}
+
+} // namespace
+
+CpuTelemetryMonitor::CpuTelemetryMonitor() : CpuTelemetryMonitor(CreateDefaultCpuTelemetrySource()) {
+}
+
+CpuTelemetryMonitor::CpuTelemetryMonitor(std::unique_ptr<CpuTelemetrySource> source, size_t historyCapacity)
+    : source_(std::move(source)),
+      cores_(source_->CoreCount()),
+      sensors_(source_->SensorNames().size()),
+      capacity_(std::max<size_t>(historyCapacity, 1)) {
+    current_.assign(cores_, CpuCoreFrequency());
+    previous_.assign(cores_, CpuCoreFrequency());
+    temperatures_.assign(sensors_, std::nan(""));
+
+    timestamps_.assign(capacity_, 0);
+    mhz_.assign(capacity_ * cores_, 0);
+    limitMhz_.assign(capacity_ * cores_, 0);
+    coreEvents_.assign(capacity_ * cores_, 0);
+    packageEvents_.assign(capacity_ * cores_, 0);
+    temps_.assign(capacity_ * sensors_, 0.0f);
+}
+
+CpuTelemetryMonitor::~CpuTelemetryMonitor() {
+    StopMonitoring();
+}
+
+void CpuTelemetryMonitor::StartMonitoring(PeriodicScheduler& scheduler, int intervalMs) {
+    if (isRunning_) return;
+
+    isRunning_ = true;
+    scheduler_ = &scheduler;
+    // 先采一次，启动后即有最近样本可读
+    Sample();
+    taskId_ = scheduler.Schedule("cpu-telemetry", static_cast<uint32_t>(intervalMs), [this] { Sample(); });
+}
+
+void CpuTelemetryMonitor::StopMonitoring() {
+    if (!isRunning_.exchange(false)) return;
+    scheduler_->Cancel(taskId_);
+    taskId_ = PeriodicScheduler::kInvalidTask;
+}
+
+void CpuTelemetryMonitor::Sample() {
+    SYSMON_TIME_COLLECTOR("CPUTelemetry");
+
+    if (!source_->Read(current_.data(), temperatures_.data())) {
+        return;
+    }
+    const uint64_t timestamp = GET_LOCAL_TIME_MS();
+
+    auto latest = std::make_shared<CpuTelemetry>();
+    latest->timestamp = timestamp;
+    latest->throttleCounters = source_->HasThrottleCounters();
+    latest->cores = current_;
+    latest->sensorNames = source_->SensorNames();
+    latest->temperatures = temperatures_;
+    std::atomic_store(&latest_, std::shared_ptr<const CpuTelemetry>(std::move(latest)));
+
+    {
+        std::lock_guard<std::mutex> lk(historyMutex_);
+        const size_t slot = head_;
+        timestamps_[slot] = timestamp;
+        for (uint32_t i = 0; i < cores_; ++i) {
+            const CpuCoreFrequency& core = current_[i];
+            const size_t index = slot * cores_ + i;
+            mhz_[index] = Saturate16(core.currentMHz);
+            limitMhz_[index] = Saturate16(core.limitMHz);
+            coreEvents_[index] = hasPrevious_ ? Saturate16(Delta(previous_[i].coreThrottleCount, core.coreThrottleCount)) : 0;
+            packageEvents_[index] = hasPrevious_ ? Saturate16(Delta(previous_[i].packageThrottleCount, core.packageThrottleCount)) : 0;
+        }
+        for (size_t i = 0; i < sensors_; ++i) {
+            temps_[slot * sensors_ + i] = static_cast<float>(temperatures_[i]);
+        }
+        head_ = (head_ + 1) % capacity_;
+        count_ = std::min(count_ + 1, capacity_);
+    }
+
+    previous_.swap(current_);
+    hasPrevious_ = true;
+}
+
+std::vector<CpuTelemetrySample> CpuTelemetryMonitor::GetHistory(uint64_t since) const {
+    std::vector<CpuTelemetrySample> samples;
+    std::lock_guard<std::mutex> lk(historyMutex_);
+    const size_t oldest = (head_ + capacity_ - count_) % capacity_;
+    for (size_t n = 0; n < count_; ++n) {
+        const size_t slot = (oldest + n) % capacity_;
+        if (timestamps_[slot] <= since) {
+            continue;
+        }
+        CpuTelemetrySample sample;
+        sample.timestamp = timestamps_[slot];
+        const size_t base = slot * cores_;
+        sample.coreMHz.assign(mhz_.begin() + base, mhz_.begin() + base + cores_);
+        sample.coreLimitMHz.assign(limitMhz_.begin() + base, limitMhz_.begin() + base + cores_);
+        sample.coreThrottleEvents.assign(coreEvents_.begin() + base, coreEvents_.begin() + base + cores_);
+        sample.packageThrottleEvents.assign(packageEvents_.begin() + base, packageEvents_.begin() + base + cores_);
+        sample.temperatures.assign(temps_.begin() + slot * sensors_, temps_.begin() + (slot + 1) * sensors_);
+        samples.push_back(std::move(sample));
+    }
+    return samples;
+}
+
+} // namespace sysmonitor
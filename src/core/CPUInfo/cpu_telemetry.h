@@ -0,0 +1,122 @@
+#pragma once
+#include "../../utils/scheduler.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sysmonitor {
+
+// 单个逻辑核心的频率与降频计数，不可用的字段为 0
+struct CpuCoreFrequency {
+    uint32_t currentMHz = 0;
+    uint32_t limitMHz = 0;              // 当前策略允许的最高频率（Linux scaling_max_freq，Windows MhzLimit）
+    uint32_t maxMHz = 0;                // 硬件最高频率，构造时读取
+    uint64_t coreThrottleCount = 0;     // 累计降频事件，同一物理核心的线程共享
+    uint64_t packageThrottleCount = 0;  // 同一封装的核心共享
+};
+
+/**
+ * @brief 频率、降频计数与温度的来源
+ *
+ * 与 CpuTimesSource 相同，CpuTelemetryMonitor 只通过该接口访问操作系统；
+ * Read 在采样路径上调用，实现应避免分配堆内存。
+ */
+class CpuTelemetrySource {
+public:
+    virtual ~CpuTelemetrySource() = default;
+
+    virtual uint32_t CoreCount() const = 0;
+    // 温度传感器名称（如 "coretemp/Package id 0"），构造后不变
+    virtual const std::vector<std::string>& SensorNames() const = 0;
+    // 平台是否提供降频事件计数
+    virtual bool HasThrottleCounters() const = 0;
+
+    // cores 预分配 CoreCount() 个，temperatures 预分配 SensorNames().size() 个（摄氏度，读取失败为 NaN）
+    virtual bool Read(CpuCoreFrequency* cores, double* temperatures) = 0;
+};
+
+std::unique_ptr<CpuTelemetrySource> CreateDefaultCpuTelemetrySource();
+
+#ifdef __linux__
+// 以 sysRoot 代替 /sys，核心数由调用方给定；测试用假的 sysfs 目录树驱动
+std::unique_ptr<CpuTelemetrySource> CreateSysfsCpuTelemetrySource(const std::string& sysRoot, uint32_t coreCount);
+#endif
+
+// 最近一次采样
+struct CpuTelemetry {
+    uint64_t timestamp = 0;
+    bool throttleCounters = false;
+    std::vector<CpuCoreFrequency> cores;
+    std::vector<std::string> sensorNames;
+    std::vector<double> temperatures;
+};
+
+// 历史样本；降频事件为本采样周期内的新增次数
+struct CpuTelemetrySample {
+    uint64_t timestamp = 0;
+    std::vector<uint32_t> coreMHz;
+    std::vector<uint32_t> coreLimitMHz;
+    std::vector<uint32_t> coreThrottleEvents;
+    std::vector<uint32_t> packageThrottleEvents;
+    std::vector<float> temperatures;
+};
+
+/**
+ * @brief 周期采样各核心频率、降频计数与温度，保留固定长度的历史
+ *
+ * 历史存放在启动时分配的环形数组中，频率与事件数按 uint16 饱和存储。
+ * 用于把性能下降与温度墙、功耗墙降频对应起来。
+ */
+class CpuTelemetryMonitor {
+public:
+    CpuTelemetryMonitor();
+    explicit CpuTelemetryMonitor(std::unique_ptr<CpuTelemetrySource> source, size_t historyCapacity = 3600);
+    ~CpuTelemetryMonitor();
+
+    CpuTelemetryMonitor(const CpuTelemetryMonitor&) = delete;
+    CpuTelemetryMonitor& operator=(const CpuTelemetryMonitor&) = delete;
+
+    // 在 scheduler 上注册周期采样任务；scheduler 须比本对象存活更久
+    void StartMonitoring(PeriodicScheduler& scheduler, int intervalMs = 1000);
+    void StopMonitoring();
+
+    std::shared_ptr<const CpuTelemetry> GetLatest() const { return std::atomic_load(&latest_); }
+
+    // 返回时间戳大于 since 的历史样本，按时间升序
+    std::vector<CpuTelemetrySample> GetHistory(uint64_t since = 0) const;
+
+private:
+    void Sample();
+
+    std::unique_ptr<CpuTelemetrySource> source_;
+    std::atomic<bool> isRunning_{false};
+    PeriodicScheduler* scheduler_ = nullptr;
+    PeriodicScheduler::TaskId taskId_ = PeriodicScheduler::kInvalidTask;
+
+    const uint32_t cores_;
+    const size_t sensors_;
+    std::shared_ptr<const CpuTelemetry> latest_;   // std::atomic_load / atomic_store
+
+    // 以下只在采样任务中访问
+    std::vector<CpuCoreFrequency> current_;
+    std::vector<CpuCoreFrequency> previous_;
+    std::vector<double> temperatures_;
+    bool hasPrevious_ = false;
+
+    // 环形历史，每个样本占 cores_ 个槽位（温度为 sensors_ 个），由 historyMutex_ 保护
+    mutable std::mutex historyMutex_;
+    const size_t capacity_;
+    size_t head_ = 0;                   // 下一个写入位置
+    size_t count_ = 0;
+    std::vector<uint64_t> timestamps_;
+    std::vector<uint16_t> mhz_;
+    std::vector<uint16_t> limitMhz_;
+    std::vector<uint16_t> coreEvents_;
+    std::vector<uint16_t> packageEvents_;
+    std::vector<float> temps_;
+};
+
+} // namespace sysmonitor
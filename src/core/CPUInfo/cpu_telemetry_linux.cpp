@@ -0,0 +1,221 @@
+// Linux 频率与温度来源：cpufreq、thermal_throttle 与 hwmon 的 sysfs 属性，
+// 构造时打开并常驻描述符，每次采样对每个属性做一次 pread
+#ifdef __linux__
+#include "cpu_telemetry.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <utility>
+
+namespace sysmonitor {
+
+namespace {
+
+constexpr size_t kMaxSensors = 64;
+
+int OpenAttribute(const std::string& path) {
+    return open(path.c_str(), O_RDONLY | O_CLOEXEC);
+}
+
+// sysfs 属性在偏移 0 处重新读取即得到最新值
+bool ReadInt(int fd, int64_t& value) {
+    if (fd < 0) return false;
+    char buffer[32];
+    ssize_t n = pread(fd, buffer, sizeof(buffer) - 1, 0);
+    if (n <= 0) return false;
+    buffer[n] = '\0';
+
+    const char* p = buffer;
+    bool negative = *p == '-';
+    if (negative) ++p;
+    int64_t result = 0;
+    unsigned digit;
+    const char* start = p;
+    while ((digit = static_cast<unsigned char>(*p) - '0') < 10) {
+        result = result * 10 + digit;
+        ++p;
+    }
+    if (p == start) return false;
+    value = negative ? -result : result;
+    return true;
+}
+
+// 只在构造时调用
+bool ReadIntOnce(const std::string& path, int64_t& value) {
+    int fd = OpenAttribute(path);
+    bool ok = ReadInt(fd, value);
+    if (fd >= 0) close(fd);
+    return ok;
+}
+
+std::string ReadLineOnce(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+class SysfsCpuTelemetrySource : public CpuTelemetrySource {
+public:
+    SysfsCpuTelemetrySource(const std::string& root, uint32_t coreCount) {
+        cores_.resize(coreCount > 0 ? coreCount : 1);
+        OpenCpuAttributes(root);
+        OpenHwmonSensors(root);
+    }
+
+    ~SysfsCpuTelemetrySource() override {
+        for (const Core& core : cores_) {
+            for (int fd : {core.curFd, core.limitFd, core.coreThrottleFd, core.packageThrottleFd}) {
+                if (fd >= 0) close(fd);
+            }
+        }
+        for (int fd : sensorFds_) {
+            if (fd >= 0) close(fd);
+        }
+    }
+
+    uint32_t CoreCount() const override { return static_cast<uint32_t>(cores_.size()); }
+    const std::vector<std::string>& SensorNames() const override { return sensorNames_; }
+    bool HasThrottleCounters() const override { return hasThrottleCounters_; }
+
+    bool Read(CpuCoreFrequency* out, double* temperatures) override {
+        int64_t value;
+        for (size_t i = 0; i < cores_.size(); ++i) {
+            const Core& core = cores_[i];
+            CpuCoreFrequency& freq = out[i];
+            // cpufreq 以 kHz 为单位
+            freq.currentMHz = ReadInt(core.curFd, value) && value > 0 ? static_cast<uint32_t>(value / 1000) : 0;
+            freq.limitMHz = ReadInt(core.limitFd, value) && value > 0 ? static_cast<uint32_t>(value / 1000) : 0;
+            freq.maxMHz = core.maxMHz;
+            freq.coreThrottleCount = ReadInt(core.coreThrottleFd, value) && value > 0 ? static_cast<uint64_t>(value) : 0;
+            freq.packageThrottleCount = ReadInt(core.packageThrottleFd, value) && value > 0 ? static_cast<uint64_t>(value) : 0;
+        }
+        // 同一物理核心 / 封装共享计数器，只读取第一个逻辑核心的描述符
+        for (size_t i = 0; i < cores_.size(); ++i) {
+            const Core& core = cores_[i];
+            if (core.coreOwner != i) out[i].coreThrottleCount = out[core.coreOwner].coreThrottleCount;
+            if (core.packageOwner != i) out[i].packageThrottleCount = out[core.packageOwner].packageThrottleCount;
+        }
+        for (size_t i = 0; i < sensorFds_.size(); ++i) {
+            // hwmon 温度以毫摄氏度为单位
+            temperatures[i] = ReadInt(sensorFds_[i], value) ? static_cast<double>(value) / 1000.0 : std::nan("");
+        }
+        return true;
+    }
+
+private:
+    struct Core {
+        int curFd = -1;
+        int limitFd = -1;
+        int coreThrottleFd = -1;
+        int packageThrottleFd = -1;
+        uint32_t maxMHz = 0;
+        size_t coreOwner = 0;       // 共享降频计数器的第一个逻辑核心
+        size_t packageOwner = 0;
+    };
+
+    void OpenCpuAttributes(const std::string& root) {
+        std::map<std::pair<int64_t, int64_t>, size_t> coreOwners;
+        std::map<int64_t, size_t> packageOwners;
+        for (size_t i = 0; i < cores_.size(); ++i) {
+            Core& core = cores_[i];
+            const std::string cpu = root + "/devices/system/cpu/cpu" + std::to_string(i);
+
+            core.curFd = OpenAttribute(cpu + "/cpufreq/scaling_cur_freq");
+            if (core.curFd < 0) {
+                core.curFd = OpenAttribute(cpu + "/cpufreq/cpuinfo_cur_freq");
+            }
+            core.limitFd = OpenAttribute(cpu + "/cpufreq/scaling_max_freq");
+            int64_t value;
+            if (ReadIntOnce(cpu + "/cpufreq/cpuinfo_max_freq", value) && value > 0) {
+                core.maxMHz = static_cast<uint32_t>(value / 1000);
+            }
+
+            int64_t package = -1, coreId = static_cast<int64_t>(i);
+            ReadIntOnce(cpu + "/topology/physical_package_id", package);
+            ReadIntOnce(cpu + "/topology/core_id", coreId);
+            auto coreIt = coreOwners.emplace(std::make_pair(package, coreId), i).first;
+            auto packageIt = packageOwners.emplace(package, i).first;
+            core.coreOwner = coreIt->second;
+            core.packageOwner = packageIt->second;
+
+            // thermal_throttle 仅 x86（Intel）提供
+            if (core.coreOwner == i) {
+                core.coreThrottleFd = OpenAttribute(cpu + "/thermal_throttle/core_throttle_count");
+            }
+            if (core.packageOwner == i) {
+                core.packageThrottleFd = OpenAttribute(cpu + "/thermal_throttle/package_throttle_count");
+            }
+            hasThrottleCounters_ = hasThrottleCounters_ || core.coreThrottleFd >= 0 || core.packageThrottleFd >= 0;
+        }
+    }
+
+    // 每个 hwmon 设备的 temp*_input；名称取 "设备名/标签"，没有标签时用属性名
+    void OpenHwmonSensors(const std::string& root) {
+        std::vector<std::pair<std::string, std::string>> sensors;   // 名称, 路径
+        const std::string hwmonRoot = root + "/class/hwmon";
+        DIR* dir = opendir(hwmonRoot.c_str());
+        if (!dir) return;
+        std::vector<std::string> devices;
+        while (dirent* entry = readdir(dir)) {
+            if (std::string(entry->d_name).rfind("hwmon", 0) == 0) {
+                devices.push_back(hwmonRoot + "/" + entry->d_name);
+            }
+        }
+        closedir(dir);
+        std::sort(devices.begin(), devices.end());
+
+        for (const std::string& device : devices) {
+            std::string name = ReadLineOnce(device + "/name");
+            DIR* attrs = opendir(device.c_str());
+            if (!attrs) continue;
+            std::vector<std::string> inputs;
+            while (dirent* entry = readdir(attrs)) {
+                std::string attr = entry->d_name;
+                if (attr.rfind("temp", 0) == 0 && attr.size() > 6 && attr.compare(attr.size() - 6, 6, "_input") == 0) {
+                    inputs.push_back(attr);
+                }
+            }
+            closedir(attrs);
+            std::sort(inputs.begin(), inputs.end());
+            for (const std::string& input : inputs) {
+                const std::string prefix = input.substr(0, input.size() - 6);
+                std::string label = ReadLineOnce(device + "/" + prefix + "_label");
+                sensors.emplace_back((name.empty() ? "hwmon" : name) + "/" + (label.empty() ? prefix : label),
+                                     device + "/" + input);
+            }
+        }
+
+        for (const auto& sensor : sensors) {
+            if (sensorFds_.size() >= kMaxSensors) break;
+            int fd = OpenAttribute(sensor.second);
+            if (fd < 0) continue;
+            sensorNames_.push_back(sensor.first);
+            sensorFds_.push_back(fd);
+        }
+    }
+
+    std::vector<Core> cores_;
+    std::vector<std::string> sensorNames_;
+    std::vector<int> sensorFds_;
+    bool hasThrottleCounters_ = false;
+};
+
+} // namespace
+
+std::unique_ptr<CpuTelemetrySource> CreateDefaultCpuTelemetrySource() {
+    long configured = sysconf(_SC_NPROCESSORS_CONF);
+    return CreateSysfsCpuTelemetrySource("/sys", configured > 0 ? static_cast<uint32_t>(configured) : 1);
+}
+
+std::unique_ptr<CpuTelemetrySource> CreateSysfsCpuTelemetrySource(const std::string& sysRoot, uint32_t coreCount) {
+    return std::make_unique<SysfsCpuTelemetrySource>(sysRoot, coreCount);
+}
+
+} // namespace sysmonitor
+
+#endif // __linux__
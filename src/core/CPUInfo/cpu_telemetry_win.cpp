@@ -0,0 +1,68 @@
+// Windows 频率来源：CallNtPowerInformation(ProcessorInformation) 提供每个核心的当前频率与限制频率；
+// Windows 不公开降频事件计数与温度传感器，这两项为空
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <powrprof.h>
+#include "cpu_telemetry.h"
+#include <algorithm>
+#include <vector>
+
+namespace sysmonitor {
+
+namespace {
+
+// SDK 未导出该结构，定义见 CallNtPowerInformation 文档
+struct PROCESSOR_POWER_INFORMATION {
+    ULONG Number;
+    ULONG MaxMhz;
+    ULONG CurrentMhz;
+    ULONG MhzLimit;        // 低于 MaxMhz 表示正受温度或功耗限制
+    ULONG MaxIdleState;
+    ULONG CurrentIdleState;
+};
+
+class PowerInfoCpuTelemetrySource : public CpuTelemetrySource {
+public:
+    PowerInfoCpuTelemetrySource() {
+        SYSTEM_INFO sysInfo;
+        GetSystemInfo(&sysInfo);
+        info_.resize(sysInfo.dwNumberOfProcessors > 0 ? sysInfo.dwNumberOfProcessors : 1);
+    }
+
+    uint32_t CoreCount() const override { return static_cast<uint32_t>(info_.size()); }
+    const std::vector<std::string>& SensorNames() const override { return sensorNames_; }
+    bool HasThrottleCounters() const override { return false; }
+
+    bool Read(CpuCoreFrequency* cores, double* temperatures) override {
+        const ULONG size = static_cast<ULONG>(sizeof(PROCESSOR_POWER_INFORMATION) * info_.size());
+        if (CallNtPowerInformation(ProcessorInformation, nullptr, 0, info_.data(), size) != 0) {
+            return false;
+        }
+        for (size_t i = 0; i < info_.size(); ++i) {
+            CpuCoreFrequency& core = cores[i];
+            core.currentMHz = info_[i].CurrentMhz;
+            core.limitMHz = info_[i].MhzLimit;
+            core.maxMHz = info_[i].MaxMhz;
+            core.coreThrottleCount = 0;
+            core.packageThrottleCount = 0;
+        }
+        return true;
+    }
+
+private:
+    std::vector<PROCESSOR_POWER_INFORMATION> info_;
+    std::vector<std::string> sensorNames_;
+};
+
+} // namespace
+
+std::unique_ptr<CpuTelemetrySource> CreateDefaultCpuTelemetrySource() {
+    return std::make_unique<PowerInfoCpuTelemetrySource>();
+}
+
+} // namespace sysmonitor
+
+#endif // _WIN32
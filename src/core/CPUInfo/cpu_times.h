@@ -0,0 +1,64 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace sysmonitor {
+
+// 累计 CPU 时间，单位由实现决定（jiffies、100ns 等），只用于相邻两次采样求差
+struct CpuTimes {
+    uint64_t busy = 0;
+    uint64_t idle = 0;          // 含 iowait
+
+    // 按类别细分：user + system + irq + softirq + steal = busy，idle 中含 iowait
+    uint64_t user = 0;
+    uint64_t system = 0;
+    uint64_t irq = 0;
+    uint64_t softirq = 0;
+    uint64_t iowait = 0;
+    uint64_t steal = 0;
+};
+
+// 累计计数之差；计数偶尔回退（如 Linux 的 iowait），差值按 0 处理
+inline uint64_t CounterDelta(uint64_t before, uint64_t after) {
+    return after > before ? after - before : 0;
+}
+
+// 相邻两次读数的使用率（%）。idle 含 iowait，同样可能回退，按 0 处理而不是回绕；
+// 两次读数没有变化（计数精度不足）时返回 unchanged
+inline double CpuUsageBetween(const CpuTimes& before, const CpuTimes& after, double unchanged = 0.0) {
+    const uint64_t busy = CounterDelta(before.busy, after.busy);
+    const uint64_t total = busy + CounterDelta(before.idle, after.idle);
+    if (total == 0) {
+        return unchanged;
+    }
+    const double usage = 100.0 * static_cast<double>(busy) / static_cast<double>(total);
+    return std::max(0.0, std::min(100.0, usage));
+}
+
+/**
+ * @brief CPU 时间来源：读取整机与每个逻辑核心的累计忙/闲时间
+ *
+ * CPUMonitor 只通过该接口访问操作系统，差值与使用率的计算与平台无关。
+ * Read 在采样路径上调用，实现应避免分配堆内存。
+ */
+class CpuTimesSource {
+public:
+    virtual ~CpuTimesSource() = default;
+
+    // 逻辑核心数（含离线核心），构造后不变
+    virtual uint32_t CoreCount() const = 0;
+
+    // cores 由调用方预先分配 CoreCount() 个；离线核心不写入
+    virtual bool Read(CpuTimes& total, CpuTimes* cores) = 0;
+};
+
+std::unique_ptr<CpuTimesSource> CreateDefaultCpuTimesSource();
+
+#ifdef __linux__
+// 读取 procRoot/stat，核心数由调用方给定；测试用假的 procfs 目录驱动
+std::unique_ptr<CpuTimesSource> CreateProcStatCpuTimesSource(const std::string& procRoot, uint32_t coreCount);
+#endif
+
+} // namespace sysmonitor
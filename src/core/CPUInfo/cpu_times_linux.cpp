@@ -0,0 +1,108 @@
+// Linux CPU 时间来源：常驻 /proc/stat 描述符，每次采样一次 pread 读入固定缓冲区，
+// 只解析开头的 cpu / cpuN 行，不分配堆内存
+#ifdef __linux__
+#include "cpu_times.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace sysmonitor {
+
+namespace {
+
+// 单行上限："cpuNNNN" + 10 个最长 20 位的字段
+constexpr size_t kMaxCpuLineLength = 256;
+
+// 跳过空格后解析十进制数：每个字符只做一次无符号比较，不调用 strtoull / isdigit；
+// 遇到非数字即停止（含缓冲区末尾的 '\0'），没有数字时为 0
+inline uint64_t ParseUInt(const char*& p) {
+    while (*p == ' ') ++p;
+    uint64_t value = 0;
+    unsigned digit;
+    while ((digit = static_cast<unsigned char>(*p) - '0') < 10) {
+        value = value * 10 + digit;
+        ++p;
+    }
+    return value;
+}
+
+class ProcStatCpuTimesSource : public CpuTimesSource {
+public:
+    ProcStatCpuTimesSource(const std::string& procRoot, uint32_t coreCount)
+        : coreCount_(coreCount > 0 ? coreCount : 1) {
+        // cpu 行在 /proc/stat 开头，之后的 intr 等行可能很长，只读需要的前缀
+        buffer_.resize((coreCount_ + 1) * kMaxCpuLineLength + 1);
+        fd_ = open((procRoot + "/stat").c_str(), O_RDONLY | O_CLOEXEC);
+    }
+
+    ~ProcStatCpuTimesSource() override {
+        if (fd_ >= 0) close(fd_);
+    }
+
+    uint32_t CoreCount() const override { return coreCount_; }
+
+    bool Read(CpuTimes& total, CpuTimes* cores) override {
+        if (fd_ < 0) return false;
+        ssize_t n = pread(fd_, buffer_.data(), buffer_.size() - 1, 0);
+        if (n <= 0) return false;
+        buffer_[static_cast<size_t>(n)] = '\0';
+
+        const char* p = buffer_.data();
+        const char* end = p + n;
+        bool sawTotal = false;
+        // 行格式：cpu[N] user nice system idle iowait irq softirq steal guest guest_nice
+        // guest 已计入 user，不再累加
+        while (end - p > 3 && std::memcmp(p, "cpu", 3) == 0) {
+            p += 3;
+            const bool isCore = *p != ' ';
+            const uint64_t index = isCore ? ParseUInt(p) : 0;
+            uint64_t field[8];
+            for (uint64_t& value : field) {
+                value = ParseUInt(p);
+            }
+            // 只扫描行尾剩余的 guest 字段；找不到换行说明该行被截断
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!eol) break;
+
+            CpuTimes times;
+            times.user = field[0] + field[1];
+            times.system = field[2];
+            times.irq = field[5];
+            times.softirq = field[6];
+            times.steal = field[7];
+            times.iowait = field[4];
+            times.busy = times.user + times.system + times.irq + times.softirq + times.steal;
+            times.idle = field[3] + field[4];
+            if (!isCore) {
+                total = times;
+                sawTotal = true;
+            } else if (index < coreCount_) {
+                cores[index] = times;
+            }
+            p = eol + 1;
+        }
+        return sawTotal;
+    }
+
+private:
+    int fd_ = -1;
+    uint32_t coreCount_ = 1;
+    std::vector<char> buffer_;
+};
+
+} // namespace
+
+std::unique_ptr<CpuTimesSource> CreateDefaultCpuTimesSource() {
+    long configured = sysconf(_SC_NPROCESSORS_CONF);
+    return CreateProcStatCpuTimesSource("/proc", configured > 0 ? static_cast<uint32_t>(configured) : 1);
+}
+
+std::unique_ptr<CpuTimesSource> CreateProcStatCpuTimesSource(const std::string& procRoot, uint32_t coreCount) {
+    return std::make_unique<ProcStatCpuTimesSource>(procRoot, coreCount);
+}
+
+} // namespace sysmonitor
+
+#endif // __linux__
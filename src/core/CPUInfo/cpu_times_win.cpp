@@ -0,0 +1,114 @@
+// Windows CPU 时间来源：GetSystemTimes 取整机合计，NtQuerySystemInformation 取每个核心
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include "cpu_times.h"
+#include <algorithm>
+#include <vector>
+
+namespace sysmonitor {
+
+namespace {
+
+uint64_t FileTimeToUInt64(const FILETIME& ft) {
+    ULARGE_INTEGER value;
+    value.LowPart = ft.dwLowDateTime;
+    value.HighPart = ft.dwHighDateTime;
+    return value.QuadPart;
+}
+
+// SystemProcessorPerformanceInformation
+constexpr int kProcessorPerformanceInformation = 8;
+
+struct SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION {
+    LARGE_INTEGER IdleTime;
+    LARGE_INTEGER KernelTime;     // 含 IdleTime
+    LARGE_INTEGER UserTime;
+    LARGE_INTEGER DpcTime;
+    LARGE_INTEGER InterruptTime;
+    ULONG InterruptCount;
+};
+
+// KernelTime 包含空闲、DPC 与中断时间，system 只保留其余部分
+CpuTimes ToCpuTimes(const SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION& info) {
+    CpuTimes times;
+    const uint64_t kernel = static_cast<uint64_t>(info.KernelTime.QuadPart);
+    times.idle = static_cast<uint64_t>(info.IdleTime.QuadPart);
+    times.user = static_cast<uint64_t>(info.UserTime.QuadPart);
+    times.irq = static_cast<uint64_t>(info.InterruptTime.QuadPart);
+    times.softirq = static_cast<uint64_t>(info.DpcTime.QuadPart);
+    const uint64_t kernelBusy = kernel > times.idle ? kernel - times.idle : 0;
+    times.system = kernelBusy > times.irq + times.softirq ? kernelBusy - times.irq - times.softirq : 0;
+    times.busy = times.user + kernelBusy;
+    return times;
+}
+
+using NtQuerySystemInformation_t = NTSTATUS(WINAPI*)(int, PVOID, ULONG, PULONG);
+
+class WinCpuTimesSource : public CpuTimesSource {
+public:
+    WinCpuTimesSource() {
+        SYSTEM_INFO sysInfo;
+        GetSystemInfo(&sysInfo);
+        coreCount_ = sysInfo.dwNumberOfProcessors > 0 ? sysInfo.dwNumberOfProcessors : 1;
+        info_.resize(coreCount_);
+
+        HMODULE ntdll = GetModuleHandleA("ntdll.dll");
+        if (ntdll) {
+            query_ = reinterpret_cast<NtQuerySystemInformation_t>(GetProcAddress(ntdll, "NtQuerySystemInformation"));
+        }
+    }
+
+    uint32_t CoreCount() const override { return coreCount_; }
+
+    bool Read(CpuTimes& total, CpuTimes* cores) override {
+        // 每核心数据带有 DPC 与中断时间，合计取各核心之和；取不到时退回 GetSystemTimes
+        ULONG returnLength = 0;
+        if (query_ && query_(kProcessorPerformanceInformation, info_.data(),
+                             static_cast<ULONG>(sizeof(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION) * info_.size()),
+                             &returnLength) == 0) {
+            size_t count = std::min<size_t>(returnLength / sizeof(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION), info_.size());
+            if (count > 0) {
+                total = CpuTimes();
+                for (size_t i = 0; i < count; ++i) {
+                    cores[i] = ToCpuTimes(info_[i]);
+                    total.busy += cores[i].busy;
+                    total.idle += cores[i].idle;
+                    total.user += cores[i].user;
+                    total.system += cores[i].system;
+                    total.irq += cores[i].irq;
+                    total.softirq += cores[i].softirq;
+                }
+                return true;
+            }
+        }
+
+        FILETIME idleTime, kernelTime, userTime;
+        if (!GetSystemTimes(&idleTime, &kernelTime, &userTime)) {
+            return false;
+        }
+        total = CpuTimes();
+        total.idle = FileTimeToUInt64(idleTime);
+        total.user = FileTimeToUInt64(userTime);
+        total.system = FileTimeToUInt64(kernelTime) - total.idle;
+        total.busy = total.user + total.system;
+        return true;
+    }
+
+private:
+    uint32_t coreCount_ = 1;
+    NtQuerySystemInformation_t query_ = nullptr;
+    std::vector<SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION> info_;
+};
+
+} // namespace
+
+std::unique_ptr<CpuTimesSource> CreateDefaultCpuTimesSource() {
+    return std::make_unique<WinCpuTimesSource>();
+}
+
+} // namespace sysmonitor
+
+#endif // _WIN32
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sysmonitor {
+
+// 一个逻辑处理器的位置；编号与 CpuTimesSource 的核心下标一致
+struct LogicalProcessor {
+    uint32_t cpu = 0;
+    uint32_t package = 0;       // 封装序号，从 0 连续编号
+    uint32_t core = 0;          // 物理核心序号，全机从 0 连续编号
+    uint32_t thread = 0;        // 在所属物理核心内的 SMT 线程序号
+    uint32_t node = 0;          // NUMA 节点号（操作系统编号）
+};
+
+struct NumaNodeTopology {
+    uint32_t node = 0;
+    std::vector<uint32_t> cpus;
+};
+
+/**
+ * @brief CPU 与 NUMA 拓扑
+ *
+ * 启动时发现一次，之后不变；用于把每核心指标归到封装、物理核心与 NUMA 节点。
+ * 非 NUMA 系统只有一个节点 0。
+ */
+struct CpuTopology {
+    uint32_t packages = 0;
+    uint32_t physicalCores = 0;
+    std::vector<LogicalProcessor> processors;
+    std::vector<NumaNodeTopology> nodes;
+};
+
+// Windows: GetLogicalProcessorInformationEx；Linux: /sys/devices/system/{cpu,node}
+CpuTopology DiscoverCpuTopology();
+
+#ifdef __linux__
+// 以 sysRoot 代替 /sys，逻辑处理器数由调用方给定；测试用假的 sysfs 目录树驱动
+CpuTopology DiscoverCpuTopology(const std::string& sysRoot, uint32_t cpuCount);
+#endif
+
+} // namespace sysmonitor
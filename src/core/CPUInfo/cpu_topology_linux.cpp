@@ -0,0 +1,122 @@
+// Linux 拓扑来源：/sys/devices/system/cpu/cpuN/topology 给出封装与核心编号，
+// /sys/devices/system/node/nodeN/cpulist 给出节点包含的逻辑处理器
+#ifdef __linux__
+#include "cpu_topology.h"
+#include <dirent.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace sysmonitor {
+
+namespace {
+
+bool ReadIntFile(const std::string& path, long& value) {
+    std::ifstream in(path);
+    return static_cast<bool>(in >> value);
+}
+
+// cpulist 格式："0-3,8-11"
+std::vector<uint32_t> ParseCpuList(const std::string& list) {
+    std::vector<uint32_t> cpus;
+    const char* p = list.c_str();
+    while (*p) {
+        char* end;
+        unsigned long first = std::strtoul(p, &end, 10);
+        if (end == p) break;
+        unsigned long last = first;
+        p = end;
+        if (*p == '-') {
+            last = std::strtoul(p + 1, &end, 10);
+            p = end;
+        }
+        for (unsigned long cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(static_cast<uint32_t>(cpu));
+        }
+        if (*p != ',') break;
+        ++p;
+    }
+    return cpus;
+}
+
+std::vector<NumaNodeTopology> DiscoverNodes(const std::string& root) {
+    std::vector<NumaNodeTopology> nodes;
+    const std::string nodeRoot = root + "/devices/system/node";
+    DIR* dir = opendir(nodeRoot.c_str());
+    if (!dir) return nodes;
+    while (dirent* entry = readdir(dir)) {
+        const char* name = entry->d_name;
+        if (std::strncmp(name, "node", 4) != 0 || name[4] < '0' || name[4] > '9') continue;
+        NumaNodeTopology node;
+        node.node = static_cast<uint32_t>(std::strtoul(name + 4, nullptr, 10));
+        std::ifstream in(nodeRoot + "/" + name + "/cpulist");
+        std::string list;
+        std::getline(in, list);
+        node.cpus = ParseCpuList(list);
+        nodes.push_back(std::move(node));
+    }
+    closedir(dir);
+    std::sort(nodes.begin(), nodes.end(),
+              [](const NumaNodeTopology& a, const NumaNodeTopology& b) { return a.node < b.node; });
+    return nodes;
+}
+
+} // namespace
+
+CpuTopology DiscoverCpuTopology() {
+    long configured = sysconf(_SC_NPROCESSORS_CONF);
+    return DiscoverCpuTopology("/sys", configured > 0 ? static_cast<uint32_t>(configured) : 1);
+}
+
+CpuTopology DiscoverCpuTopology(const std::string& root, uint32_t cpuCount) {
+    CpuTopology topology;
+    topology.processors.resize(cpuCount > 0 ? cpuCount : 1);
+
+    // 内核的 package / core 编号不连续（如 core_id 0,1,2,8,9），此处重新连续编号
+    std::map<long, uint32_t> packages;
+    std::map<std::pair<long, long>, uint32_t> cores;
+    std::map<std::pair<long, long>, uint32_t> threads;
+    for (size_t i = 0; i < topology.processors.size(); ++i) {
+        LogicalProcessor& cpu = topology.processors[i];
+        cpu.cpu = static_cast<uint32_t>(i);
+
+        const std::string dir = root + "/devices/system/cpu/cpu" + std::to_string(i) + "/topology";
+        long package = 0, coreId = static_cast<long>(i);
+        ReadIntFile(dir + "/physical_package_id", package);
+        ReadIntFile(dir + "/core_id", coreId);
+
+        cpu.package = packages.emplace(package, static_cast<uint32_t>(packages.size())).first->second;
+        const auto key = std::make_pair(package, coreId);
+        cpu.core = cores.emplace(key, static_cast<uint32_t>(cores.size())).first->second;
+        cpu.thread = threads[key]++;
+    }
+    topology.packages = static_cast<uint32_t>(packages.size());
+    topology.physicalCores = static_cast<uint32_t>(cores.size());
+
+    topology.nodes = DiscoverNodes(root);
+    if (topology.nodes.empty()) {
+        // 内核未启用 NUMA：全部处理器归入节点 0
+        NumaNodeTopology node;
+        for (const LogicalProcessor& cpu : topology.processors) {
+            node.cpus.push_back(cpu.cpu);
+        }
+        topology.nodes.push_back(std::move(node));
+    }
+    for (const NumaNodeTopology& node : topology.nodes) {
+        for (uint32_t cpu : node.cpus) {
+            if (cpu < topology.processors.size()) {
+                topology.processors[cpu].node = node.node;
+            }
+        }
+    }
+    return topology;
+}
+
+} // namespace sysmonitor
+
+#endif // __linux__
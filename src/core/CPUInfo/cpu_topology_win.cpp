@@ -0,0 +1,117 @@
+// Windows 拓扑来源：GetLogicalProcessorInformationEx(RelationAll)。
+// 逻辑处理器编号按处理器组依次展开：组 g 的第 b 位 = 前面各组活动处理器数之和 + b
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <memory>
+#include "cpu_topology.h"
+
+namespace sysmonitor {
+
+namespace {
+
+// 对 mask 中每个置位的逻辑处理器调用 fn(编号)
+template <typename Fn>
+void ForEachProcessor(const GROUP_AFFINITY& affinity, const std::vector<uint32_t>& groupOffsets, Fn fn) {
+    if (affinity.Group >= groupOffsets.size()) return;
+    for (uint32_t bit = 0; bit < sizeof(KAFFINITY) * 8; ++bit) {
+        if (affinity.Mask & (static_cast<KAFFINITY>(1) << bit)) {
+            fn(groupOffsets[affinity.Group] + bit);
+        }
+    }
+}
+
+} // namespace
+
+CpuTopology DiscoverCpuTopology() {
+    CpuTopology topology;
+
+    const WORD groupCount = GetActiveProcessorGroupCount();
+    std::vector<uint32_t> groupOffsets(groupCount, 0);
+    uint32_t total = 0;
+    for (WORD g = 0; g < groupCount; ++g) {
+        groupOffsets[g] = total;
+        total += GetActiveProcessorCount(g);
+    }
+    topology.processors.resize(total > 0 ? total : 1);
+    for (size_t i = 0; i < topology.processors.size(); ++i) {
+        topology.processors[i].cpu = static_cast<uint32_t>(i);
+    }
+
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+    std::unique_ptr<BYTE[]> buffer;
+    if (GetLastError() == ERROR_INSUFFICIENT_BUFFER) {
+        buffer = std::make_unique<BYTE[]>(length);
+        if (!GetLogicalProcessorInformationEx(RelationAll,
+                reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.get()), &length)) {
+            length = 0;
+        }
+    } else {
+        length = 0;
+    }
+
+    auto assign = [&](uint32_t cpu, auto fn) {
+        if (cpu < topology.processors.size()) fn(topology.processors[cpu]);
+    };
+
+    for (DWORD offset = 0; offset < length;) {
+        auto info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.get() + offset);
+        switch (info->Relationship) {
+            case RelationProcessorPackage: {
+                const uint32_t package = topology.packages++;
+                for (WORD g = 0; g < info->Processor.GroupCount; ++g) {
+                    ForEachProcessor(info->Processor.GroupMask[g], groupOffsets, [&](uint32_t cpu) {
+                        assign(cpu, [&](LogicalProcessor& p) { p.package = package; });
+                    });
+                }
+                break;
+            }
+            case RelationProcessorCore: {
+                const uint32_t core = topology.physicalCores++;
+                uint32_t thread = 0;
+                // 核心只属于一个处理器组
+                ForEachProcessor(info->Processor.GroupMask[0], groupOffsets, [&](uint32_t cpu) {
+                    assign(cpu, [&](LogicalProcessor& p) { p.core = core; p.thread = thread++; });
+                });
+                break;
+            }
+            case RelationNumaNode: {
+                NumaNodeTopology node;
+                node.node = info->NumaNode.NodeNumber;
+                ForEachProcessor(info->NumaNode.GroupMask, groupOffsets, [&](uint32_t cpu) {
+                    assign(cpu, [&](LogicalProcessor& p) { p.node = node.node; });
+                    node.cpus.push_back(cpu);
+                });
+                topology.nodes.push_back(std::move(node));
+                break;
+            }
+            default:
+                break;
+        }
+        offset += info->Size;
+    }
+
+    // 查询失败时退化为单封装、每个逻辑处理器一个核心、单节点
+    if (topology.physicalCores == 0) {
+        topology.packages = 1;
+        topology.physicalCores = static_cast<uint32_t>(topology.processors.size());
+        for (LogicalProcessor& cpu : topology.processors) {
+            cpu.core = cpu.cpu;
+        }
+    }
+    if (topology.nodes.empty()) {
+        NumaNodeTopology node;
+        for (const LogicalProcessor& cpu : topology.processors) {
+            node.cpus.push_back(cpu.cpu);
+        }
+        topology.nodes.push_back(std::move(node));
+    }
+    return topology;
+}
+
+} // namespace sysmonitor
+
+#endif // _WIN32
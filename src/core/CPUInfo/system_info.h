@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include "cpu_counters.h"
 
 namespace sysmonitor {
 
@@ -16,10 +17,46 @@ struct CPUInfo {
     std::string architecture;
 };
 
+// 采样间隔内各类 CPU 时间的占比（%），之和为 100；平台没有的类别为 0
+struct CpuTimeBreakdown {
+    double user = 0.0;       // 含 nice
+    double system = 0.0;     // 不含中断
+    double irq = 0.0;        // 硬中断（Windows: InterruptTime）
+    double softirq = 0.0;    // 软中断（Windows: DpcTime）
+    double iowait = 0.0;     // 仅 Linux
+    double steal = 0.0;      // 虚拟机被宿主占用，仅 Linux
+    double idle = 0.0;       // 不含 iowait
+};
+
+// 采样间隔内的性能计数器速率；只有 counterMode 对应的一组字段有值
+struct CpuCounterRates {
+    // 硬件模式
+    double instructionsPerCycle = 0.0;
+    double cyclesPerSec = 0.0;
+    double instructionsPerSec = 0.0;
+    double cacheMissesPerSec = 0.0;
+    double branchMissesPerSec = 0.0;
+    double cacheMissesPerKiloInstructions = 0.0;
+    double branchMissesPerKiloInstructions = 0.0;
+
+    // 软件模式
+    double contextSwitchesPerSec = 0.0;
+    double migrationsPerSec = 0.0;
+    double pageFaultsPerSec = 0.0;
+    double majorFaultsPerSec = 0.0;
+};
+
 struct CPUUsage {
     double totalUsage;
     std::vector<double> coreUsages;
+    CpuTimeBreakdown breakdown;
+    std::vector<CpuTimeBreakdown> coreBreakdowns;
     uint64_t timestamp;
+
+    // 启用性能计数器后有值，见 CPUMonitor::EnableCounters
+    CpuCounterMode counterMode = CpuCounterMode::None;
+    CpuCounterRates counters;
+    std::vector<CpuCounterRates> coreCounters;
 };
 
 class SystemInfo {
@@ -28,7 +65,7 @@ public:
     static std::string GetCPUName();
     static uint32_t GetPhysicalCoreCount();
     static uint32_t GetLogicalCoreCount();
-    static double GetCPUTemperature(); // 注意：Windows默认不支持，可能需要第三方驱动
+    static double GetCPUTemperature(); // ACPI 热区温度（摄氏度），需要管理员权限，取不到时为 NaN
 };
 
 } // namespace sysmonitor
\ No newline at end of file
@@ -0,0 +1,93 @@
+// Linux 平台的 CPU 静态信息：/proc/cpuinfo 给出名称、厂商与当前频率，
+// 物理核心与封装数来自 sysfs 拓扑，最高频率来自 cpufreq
+#ifdef __linux__
+#include "system_info.h"
+#include "cpu_topology.h"
+#include <sys/utsname.h>
+#include <unistd.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace sysmonitor {
+
+namespace {
+
+// "key\t: value" 行中 key 匹配时返回 value
+bool CpuinfoValue(const std::string& line, const char* key, std::string& value) {
+    const size_t keyLen = std::strlen(key);
+    if (line.compare(0, keyLen, key) != 0) return false;
+    size_t colon = line.find(':', keyLen);
+    if (colon == std::string::npos || line.find_first_not_of(" \t", keyLen) != colon) return false;
+    size_t start = line.find_first_not_of(' ', colon + 1);
+    value = start == std::string::npos ? std::string() : line.substr(start);
+    return true;
+}
+
+// 与 Windows 的 PROCESSOR_ARCHITECTURE_* 名称保持一致
+std::string ArchitectureName() {
+    struct utsname name;
+    if (uname(&name) != 0) return "Unknown";
+    const std::string machine = name.machine;
+    if (machine == "x86_64") return "x64";
+    if (machine == "i386" || machine == "i686") return "x86";
+    if (machine == "aarch64") return "ARM64";
+    if (machine.compare(0, 3, "arm") == 0) return "ARM";
+    return machine;
+}
+
+} // namespace
+
+CPUInfo SystemInfo::GetCPUInfo() {
+    CPUInfo info{};
+    info.logicalCores = GetLogicalCoreCount();
+    info.architecture = ArchitectureName();
+
+    const CpuTopology topology = DiscoverCpuTopology();
+    info.physicalCores = topology.physicalCores;
+    info.packages = topology.packages;
+
+    // 每个逻辑处理器一段，取第一段
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line, value;
+    while (std::getline(cpuinfo, line) && !line.empty()) {
+        if (CpuinfoValue(line, "model name", value)) {
+            info.name = value;
+        } else if (CpuinfoValue(line, "vendor_id", value)) {
+            info.vendor = value;
+        } else if (CpuinfoValue(line, "cpu MHz", value)) {
+            info.baseFrequency = static_cast<uint32_t>(std::lround(std::atof(value.c_str())));
+        }
+    }
+
+    // cpufreq 以 kHz 为单位；虚拟机中通常没有
+    std::ifstream maxFreq("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq");
+    uint64_t kHz = 0;
+    if (maxFreq >> kHz) {
+        info.maxFrequency = static_cast<uint32_t>(kHz / 1000);
+    }
+    return info;
+}
+
+uint32_t SystemInfo::GetPhysicalCoreCount() {
+    return DiscoverCpuTopology().physicalCores;
+}
+
+uint32_t SystemInfo::GetLogicalCoreCount() {
+    long configured = sysconf(_SC_NPROCESSORS_CONF);
+    return configured > 0 ? static_cast<uint32_t>(configured) : 1;
+}
+
+std::string SystemInfo::GetCPUName() {
+    return GetCPUInfo().name;
+}
+
+// 温度来自 hwmon，见 CpuTelemetryMonitor
+double SystemInfo::GetCPUTemperature() {
+    return std::nan("");
+}
+
+} // namespace sysmonitor
+
+#endif // __linux__
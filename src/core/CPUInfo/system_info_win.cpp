@@ -0,0 +1,113 @@
+// Windows 平台的 CPU 静态信息：核心数、架构、处理器名称与基准频率
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <memory>
+#include "system_info.h"
+#include "wmi_helper.h"
+
+namespace sysmonitor {
+
+CPUInfo SystemInfo::GetCPUInfo() {
+    CPUInfo info;
+    
+    // 逻辑处理器数
+    SYSTEM_INFO sysInfo;
+    GetSystemInfo(&sysInfo);
+    info.logicalCores = sysInfo.dwNumberOfProcessors;
+    
+    // 处理器架构
+    switch (sysInfo.wProcessorArchitecture) {
+        case PROCESSOR_ARCHITECTURE_AMD64:
+            info.architecture = "x64";
+            break;
+        case PROCESSOR_ARCHITECTURE_ARM:
+            info.architecture = "ARM";
+            break;
+        case PROCESSOR_ARCHITECTURE_IA64:
+            info.architecture = "Intel Itanium";
+            break;
+        case PROCESSOR_ARCHITECTURE_INTEL:
+            info.architecture = "x86";
+            break;
+        default:
+            info.architecture = "Unknown";
+    }
+    
+    // 物理核心数与封装数
+    DWORD returnLength = 0;
+    GetLogicalProcessorInformation(NULL, &returnLength);
+    
+    if (GetLastError() == ERROR_INSUFFICIENT_BUFFER) {
+        auto buffer = std::make_unique<BYTE[]>(returnLength);
+        auto processorInfo = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION>(buffer.get());
+        
+        if (GetLogicalProcessorInformation(processorInfo, &returnLength)) {
+            DWORD processorCoreCount = 0;
+            DWORD processorPackageCount = 0;
+            
+            DWORD byteOffset = 0;
+            while (byteOffset + sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION) <= returnLength) {
+                switch (processorInfo->Relationship) {
+                    case RelationProcessorCore:
+                        processorCoreCount++;
+                        info.physicalCores = processorCoreCount;
+                        break;
+                    case RelationProcessorPackage:
+                        processorPackageCount++;
+                        info.packages = processorPackageCount;
+                        break;
+                }
+                byteOffset += sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
+                processorInfo++;
+            }
+        }
+    }
+    
+    // 从注册表读取处理器名称与基准频率
+    HKEY hKey;
+    if (RegOpenKeyEx(HKEY_LOCAL_MACHINE,
+        "HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0",
+        0, KEY_READ, &hKey) == ERROR_SUCCESS) {
+        
+        char processorName[256] = {0};
+        DWORD size = sizeof(processorName);
+        if (RegQueryValueEx(hKey, "ProcessorNameString", NULL, NULL, 
+                           (LPBYTE)processorName, &size) == ERROR_SUCCESS) {
+            info.name = processorName;
+        }
+        
+        DWORD mhz;
+        size = sizeof(mhz);
+        if (RegQueryValueEx(hKey, "~MHz", NULL, NULL, 
+                           (LPBYTE)&mhz, &size) == ERROR_SUCCESS) {
+            info.baseFrequency = mhz;
+        }
+        
+        RegCloseKey(hKey);
+    }
+    
+    return info;
+}
+
+uint32_t SystemInfo::GetPhysicalCoreCount() {
+    return GetCPUInfo().physicalCores;
+}
+
+uint32_t SystemInfo::GetLogicalCoreCount() {
+    return GetCPUInfo().logicalCores;
+}
+
+std::string SystemInfo::GetCPUName() {
+    return GetCPUInfo().name;
+}
+
+double SystemInfo::GetCPUTemperature() {
+    return WMIHelper::GetThermalZoneTemperature();
+}
+
+} // namespace sysmonitor
+
+#endif // _WIN32
@@ -3,6 +3,7 @@
 #include <comdef.h>
 #include <wbemidl.h>
 #include <iostream>
+#include <cmath>
 
 #pragma comment(lib, "wbemuuid.lib")
 
@@ -114,4 +115,70 @@ CPUInfo WMIHelper::GetDetailedCPUInfo() {
     return info;
 }
 
+double WMIHelper::GetThermalZoneTemperature() {
+    double celsius = std::nan("");
+
+    if (!Initialize()) {
+        return celsius;
+    }
+
+    IWbemLocator* pLoc = nullptr;
+    IWbemServices* pSvc = nullptr;
+
+    HRESULT hres = CoCreateInstance(
+        CLSID_WbemLocator, 0, CLSCTX_INPROC_SERVER,
+        IID_IWbemLocator, (LPVOID*)&pLoc
+    );
+
+    if (SUCCEEDED(hres)) {
+        hres = pLoc->ConnectServer(
+            _bstr_t(L"ROOT\\WMI"), NULL, NULL, 0, NULL, 0, 0, &pSvc
+        );
+
+        if (SUCCEEDED(hres)) {
+            hres = CoSetProxyBlanket(
+                pSvc, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE,
+                NULL, RPC_C_AUTHN_LEVEL_CALL,
+                RPC_C_IMP_LEVEL_IMPERSONATE, NULL, EOAC_NONE
+            );
+
+            if (SUCCEEDED(hres)) {
+                IEnumWbemClassObject* pEnumerator = nullptr;
+                hres = pSvc->ExecQuery(
+                    bstr_t("WQL"),
+                    bstr_t("SELECT CurrentTemperature FROM MSAcpi_ThermalZoneTemperature"),
+                    WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
+                    NULL, &pEnumerator
+                );
+
+                if (SUCCEEDED(hres)) {
+                    IWbemClassObject* pclsObj = nullptr;
+                    ULONG uReturn = 0;
+
+                    while (pEnumerator->Next(WBEM_INFINITE, 1, &pclsObj, &uReturn) == S_OK) {
+                        VARIANT vtProp;
+
+                        // 单位为 0.1 开尔文
+                        if (pclsObj->Get(L"CurrentTemperature", 0, &vtProp, 0, 0) == S_OK) {
+                            double zone = vtProp.uintVal / 10.0 - 273.15;
+                            if (std::isnan(celsius) || zone > celsius) {
+                                celsius = zone;
+                            }
+                            VariantClear(&vtProp);
+                        }
+
+                        pclsObj->Release();
+                    }
+
+                    pEnumerator->Release();
+                }
+            }
+            pSvc->Release();
+        }
+        pLoc->Release();
+    }
+
+    return celsius;
+}
+
 } // namespace sysmonitor
\ No newline at end of file
@@ -10,6 +10,8 @@ public:
     static void Uninitialize();
     static CPUInfo GetDetailedCPUInfo();
     static std::string GetWMICPUName();
+    // ACPI 热区温度（MSAcpi_ThermalZoneTemperature）的最大值，摄氏度；需要管理员权限，取不到时为 NaN
+    static double GetThermalZoneTemperature();
     
 private:
     static bool isInitialized_;
@@ -13,6 +13,7 @@
 
 #include "../../utils/encode.h"
 #include "../../utils/util_time.h"
+#include "../../utils/metrics.h"
 #pragma comment(lib, "pdh.lib")
 #pragma comment(lib, "setupapi.lib")
 #pragma comment(lib, "wbemuuid.lib")
@@ -207,6 +208,8 @@ void DiskMonitor::Cleanup() {
 }
 
 DiskSnapshot DiskMonitor::GetDiskSnapshot() {
+    SYSMON_TIME_COLLECTOR("GetDiskSnapshot");
+
     DiskSnapshot snapshot;
     snapshot.timestamp = GET_LOCAL_TIME_MS();
     
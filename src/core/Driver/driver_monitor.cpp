@@ -10,6 +10,7 @@
 #include <cctype>  // Add cctype header
 #include "../../utils/encode.h"
 #include "../../utils/util_time.h"
+#include "../../utils/metrics.h"
 #pragma comment(lib, "advapi32.lib")
 #pragma comment(lib, "setupapi.lib")
 #pragma comment(lib, "cfgmgr32.lib")
@@ -27,6 +28,8 @@ DriverMonitor::DriverMonitor() {}
 DriverMonitor::~DriverMonitor() {}
 
 DriverSnapshot DriverMonitor::GetDriverSnapshot() {
+    SYSMON_TIME_COLLECTOR("GetDriverSnapshot");
+
     DriverSnapshot snapshot;
     snapshot.timestamp = GET_LOCAL_TIME_MS();
     
@@ -754,6 +757,8 @@ std::string DriverMonitor::DetectHardwareClass(const DriverDetail& driver) {
 }
 
 DriverDetail DriverMonitor::GetDriverDetail(const std::string& driverName) {
+    SYSMON_TIME_COLLECTOR("GetDriverDetail");
+
     auto snapshot = GetDriverSnapshot();
     std::string safeName = util::EncodingUtil::SafeString(driverName);
     
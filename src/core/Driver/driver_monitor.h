@@ -5,7 +5,7 @@
 #include <string>
 #include <vector>
 #include <chrono>
-#include <windows.h>
+#include "../../utils/win32_types.h"
 #include "../../utils/encode.h"
 
 struct DriverVersion {
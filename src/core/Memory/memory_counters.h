@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sysmonitor {
+
+// 压力停顿（PSI）的累计停顿时间，微秒
+struct PressureStallTotals {
+    uint64_t someUs = 0;    // 至少一个任务停顿
+    uint64_t fullUs = 0;    // 所有非空闲任务同时停顿（cpu 在旧内核上没有）
+};
+
+// 单个 NUMA 节点的内存，字节
+struct NumaNodeMemory {
+    uint32_t node = 0;
+    uint64_t total = 0;     // 仅 Linux
+    uint64_t free = 0;      // Linux MemFree；Windows 为可用内存（含备用列表）
+};
+
+// 一次读取的内存计数。容量字段为字节；累计字段只用于相邻两次读取求差。平台没有的字段为 0
+struct MemoryCounters {
+    uint64_t totalPhysical = 0;
+    uint64_t availablePhysical = 0;
+    uint64_t commitCharge = 0;       // Linux Committed_AS，Windows CommitTotal
+    uint64_t commitLimit = 0;
+    uint64_t cached = 0;             // 页缓存：Linux Cached，Windows SystemCache
+    uint64_t swapTotal = 0;          // 仅 Linux
+    uint64_t swapFree = 0;
+
+    // 累计计数（页数 / 次数）
+    uint64_t pagesSwappedIn = 0;     // Linux pswpin，Windows Pages Input
+    uint64_t pagesSwappedOut = 0;    // Linux pswpout，Windows Pages Output
+    uint64_t pageFaults = 0;         // 全部缺页（含次缺页）
+    uint64_t majorFaults = 0;        // 需要读盘的缺页，Windows Page Reads
+
+    // 仅 Linux 4.20+ 且启用 PSI 时有效
+    bool hasPressure = false;
+    PressureStallTotals memoryPressure;
+    PressureStallTotals cpuPressure;
+    PressureStallTotals ioPressure;
+
+    // 按节点号排序；非 NUMA 系统只有节点 0，Linux 内核未启用 NUMA 时为空
+    std::vector<NumaNodeMemory> nodes;
+};
+
+/**
+ * @brief 内存计数来源
+ *
+ * MemoryMonitor 只通过该接口访问操作系统，速率与占比的计算与平台无关。
+ * Read 在采样路径上调用，实现应避免分配堆内存；nodes 的容量在多次读取间复用。
+ */
+class MemoryCountersSource {
+public:
+    virtual ~MemoryCountersSource() = default;
+
+    virtual bool Read(MemoryCounters& counters) = 0;
+};
+
+std::unique_ptr<MemoryCountersSource> CreateDefaultMemoryCountersSource();
+
+#ifdef __linux__
+// 以 procRoot、sysRoot 代替 /proc、/sys；测试用假的目录树驱动
+std::unique_ptr<MemoryCountersSource> CreateProcMemoryCountersSource(const std::string& procRoot,
+                                                                     const std::string& sysRoot);
+#endif
+
+} // namespace sysmonitor
@@ -0,0 +1,270 @@
+// Linux 内存计数来源：/proc/meminfo、/proc/vmstat、/proc/pressure/{memory,cpu,io}
+// 与 /sys/devices/system/node/nodeN/meminfo。
+// 描述符常驻，每次采样一次 pread 读入固定缓冲区；键名按哈希在预先构造的表中查找对应字段，
+// 不对每行做字符串比较
+#ifdef __linux__
+#include "memory_counters.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sysmonitor {
+
+namespace {
+
+constexpr uint64_t kFnvOffset = 1469598103934665603ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+constexpr uint64_t HashKey(const char* key) {
+    uint64_t hash = kFnvOffset;
+    while (*key) {
+        hash = (hash ^ static_cast<unsigned char>(*key++)) * kFnvPrime;
+    }
+    return hash;
+}
+
+template <typename T>
+struct FieldSpec {
+    const char* key;
+    uint64_t T::* field;
+    uint64_t scale;         // meminfo 的 kB 转换为字节
+};
+
+const FieldSpec<MemoryCounters> kMeminfoFields[] = {
+    {"MemTotal", &MemoryCounters::totalPhysical, 1024},
+    {"MemAvailable", &MemoryCounters::availablePhysical, 1024},
+    {"Cached", &MemoryCounters::cached, 1024},
+    {"SwapTotal", &MemoryCounters::swapTotal, 1024},
+    {"SwapFree", &MemoryCounters::swapFree, 1024},
+    {"CommitLimit", &MemoryCounters::commitLimit, 1024},
+    {"Committed_AS", &MemoryCounters::commitCharge, 1024},
+};
+
+const FieldSpec<MemoryCounters> kVmstatFields[] = {
+    {"pswpin", &MemoryCounters::pagesSwappedIn, 1},
+    {"pswpout", &MemoryCounters::pagesSwappedOut, 1},
+    {"pgfault", &MemoryCounters::pageFaults, 1},
+    {"pgmajfault", &MemoryCounters::majorFaults, 1},
+};
+
+// 节点 meminfo 每行带 "Node N " 前缀
+const FieldSpec<NumaNodeMemory> kNodeMeminfoFields[] = {
+    {"MemTotal", &NumaNodeMemory::total, 1024},
+    {"MemFree", &NumaNodeMemory::free, 1024},
+};
+
+// 键哈希 → 字段的开放寻址表，构造后只读
+template <typename T>
+class FieldTable {
+public:
+    template <size_t N>
+    explicit FieldTable(const FieldSpec<T> (&specs)[N]) {
+        static_assert(N * 2 <= kSlots, "field table too small");
+        for (const FieldSpec<T>& spec : specs) {
+            const uint64_t hash = HashKey(spec.key);
+            size_t slot = hash & (kSlots - 1);
+            while (slots_[slot].spec) {
+                slot = (slot + 1) & (kSlots - 1);
+            }
+            slots_[slot] = {hash, &spec};
+        }
+    }
+
+    const FieldSpec<T>* Find(uint64_t hash) const {
+        for (size_t slot = hash & (kSlots - 1);; slot = (slot + 1) & (kSlots - 1)) {
+            const Slot& entry = slots_[slot];
+            if (!entry.spec || entry.hash == hash) return entry.spec;
+        }
+    }
+
+private:
+    static constexpr size_t kSlots = 32;
+    struct Slot {
+        uint64_t hash = 0;
+        const FieldSpec<T>* spec = nullptr;
+    };
+    std::array<Slot, kSlots> slots_{};
+};
+
+const FieldTable<MemoryCounters>& MeminfoTable() {
+    static const FieldTable<MemoryCounters> table(kMeminfoFields);
+    return table;
+}
+
+const FieldTable<MemoryCounters>& VmstatTable() {
+    static const FieldTable<MemoryCounters> table(kVmstatFields);
+    return table;
+}
+
+const FieldTable<NumaNodeMemory>& NodeMeminfoTable() {
+    static const FieldTable<NumaNodeMemory> table(kNodeMeminfoFields);
+    return table;
+}
+
+inline uint64_t ParseUInt(const char*& p) {
+    while (*p == ' ') ++p;
+    uint64_t value = 0;
+    unsigned digit;
+    while ((digit = static_cast<unsigned char>(*p) - '0') < 10) {
+        value = value * 10 + digit;
+        ++p;
+    }
+    return value;
+}
+
+// 逐行计算键名哈希（到 ':' 或空格为止），命中表项时解析其后的数值，其余行直接跳到行尾。
+// skipWords 为键名前需要跳过的词数
+template <typename T>
+void ParseKeyValues(const char* p, const char* end, const FieldTable<T>& table, T& out, int skipWords = 0) {
+    while (p < end) {
+        for (int i = 0; i < skipWords; ++i) {
+            while (p < end && *p != ' ' && *p != '\n') ++p;
+            while (p < end && *p == ' ') ++p;
+        }
+        uint64_t hash = kFnvOffset;
+        while (p < end && *p != ':' && *p != ' ' && *p != '\n') {
+            hash = (hash ^ static_cast<unsigned char>(*p++)) * kFnvPrime;
+        }
+        if (p < end && *p != '\n') {
+            if (const FieldSpec<T>* spec = table.Find(hash)) {
+                ++p;
+                out.*(spec->field) = ParseUInt(p) * spec->scale;
+            }
+        }
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!eol) break;
+        p = eol + 1;
+    }
+}
+
+// PSI 文件：两行 "some avg10=.. avg60=.. avg300=.. total=N"，"full ..."
+void ParsePressure(const char* p, const char* end, PressureStallTotals& totals) {
+    while (p < end) {
+        const bool full = *p == 'f';
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        const char* lineEnd = eol ? eol : end;
+        // total= 在行尾，从后往前找 '='
+        const char* eq = lineEnd;
+        while (eq > p && *(eq - 1) != '=') --eq;
+        if (eq > p) {
+            const char* q = eq;
+            (full ? totals.fullUs : totals.someUs) = ParseUInt(q);
+        }
+        if (!eol) break;
+        p = eol + 1;
+    }
+}
+
+class ProcMemoryCountersSource : public MemoryCountersSource {
+public:
+    ProcMemoryCountersSource(const std::string& procRoot, const std::string& sysRoot) {
+        meminfoFd_ = open((procRoot + "/meminfo").c_str(), O_RDONLY | O_CLOEXEC);
+        vmstatFd_ = open((procRoot + "/vmstat").c_str(), O_RDONLY | O_CLOEXEC);
+        pressureFds_[0] = open((procRoot + "/pressure/memory").c_str(), O_RDONLY | O_CLOEXEC);
+        pressureFds_[1] = open((procRoot + "/pressure/cpu").c_str(), O_RDONLY | O_CLOEXEC);
+        pressureFds_[2] = open((procRoot + "/pressure/io").c_str(), O_RDONLY | O_CLOEXEC);
+        OpenNodes(sysRoot);
+        // /proc/vmstat 约 5KB 且随内核版本增长
+        buffer_.resize(16384);
+    }
+
+    ~ProcMemoryCountersSource() override {
+        for (int fd : {meminfoFd_, vmstatFd_, pressureFds_[0], pressureFds_[1], pressureFds_[2]}) {
+            if (fd >= 0) close(fd);
+        }
+        for (const auto& node : nodeFds_) {
+            close(node.second);
+        }
+    }
+
+    bool Read(MemoryCounters& counters) override {
+        std::vector<NumaNodeMemory> nodes = std::move(counters.nodes);
+        counters = MemoryCounters();
+        counters.nodes = std::move(nodes);
+        ssize_t n = ReadFile(meminfoFd_);
+        if (n <= 0) return false;
+        ParseKeyValues(buffer_.data(), buffer_.data() + n, MeminfoTable(), counters);
+
+        n = ReadFile(vmstatFd_);
+        if (n > 0) {
+            ParseKeyValues(buffer_.data(), buffer_.data() + n, VmstatTable(), counters);
+        }
+
+        // 内核未启用 PSI 时文件不存在或读取返回 EOPNOTSUPP
+        PressureStallTotals* totals[] = {&counters.memoryPressure, &counters.cpuPressure, &counters.ioPressure};
+        counters.hasPressure = true;
+        for (size_t i = 0; i < 3; ++i) {
+            n = ReadFile(pressureFds_[i]);
+            if (n <= 0) {
+                counters.hasPressure = false;
+                continue;
+            }
+            ParsePressure(buffer_.data(), buffer_.data() + n, *totals[i]);
+        }
+
+        counters.nodes.resize(nodeFds_.size());
+        for (size_t i = 0; i < nodeFds_.size(); ++i) {
+            NumaNodeMemory& node = counters.nodes[i];
+            node = NumaNodeMemory();
+            node.node = nodeFds_[i].first;
+            n = ReadFile(nodeFds_[i].second);
+            if (n > 0) {
+                ParseKeyValues(buffer_.data(), buffer_.data() + n, NodeMeminfoTable(), node, 2);
+            }
+        }
+        return counters.totalPhysical > 0;
+    }
+
+private:
+    // 非 NUMA 内核没有 /sys/devices/system/node，此时不输出节点
+    void OpenNodes(const std::string& sysRoot) {
+        const std::string root = sysRoot + "/devices/system/node";
+        DIR* dir = opendir(root.c_str());
+        if (!dir) return;
+        while (dirent* entry = readdir(dir)) {
+            const char* name = entry->d_name;
+            if (std::strncmp(name, "node", 4) != 0 || name[4] < '0' || name[4] > '9') continue;
+            int fd = open((root + "/" + name + "/meminfo").c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd >= 0) {
+                nodeFds_.emplace_back(static_cast<uint32_t>(std::strtoul(name + 4, nullptr, 10)), fd);
+            }
+        }
+        closedir(dir);
+        std::sort(nodeFds_.begin(), nodeFds_.end());
+    }
+
+    ssize_t ReadFile(int fd) {
+        if (fd < 0) return -1;
+        ssize_t n = pread(fd, buffer_.data(), buffer_.size() - 1, 0);
+        if (n > 0) buffer_[static_cast<size_t>(n)] = '\0';
+        return n;
+    }
+
+    int meminfoFd_ = -1;
+    int vmstatFd_ = -1;
+    int pressureFds_[3] = {-1, -1, -1};
+    std::vector<std::pair<uint32_t, int>> nodeFds_;     // 节点号, meminfo 描述符
+    std::vector<char> buffer_;
+};
+
+} // namespace
+
+std::unique_ptr<MemoryCountersSource> CreateDefaultMemoryCountersSource() {
+    return CreateProcMemoryCountersSource("/proc", "/sys");
+}
+
+std::unique_ptr<MemoryCountersSource> CreateProcMemoryCountersSource(const std::string& procRoot,
+                                                                     const std::string& sysRoot) {
+    return std::make_unique<ProcMemoryCountersSource>(procRoot, sysRoot);
+}
+
+} // namespace sysmonitor
+
+#endif // __linux__
@@ -0,0 +1,109 @@
+// Windows 内存计数来源：GlobalMemoryStatusEx 提供物理内存，GetPerformanceInfo 提供提交量与系统缓存，
+// 换页与缺页取 PDH \Memory 计数器的原始累计值（速率由 MemoryMonitor 按相邻两次读数求差得到），
+// 各 NUMA 节点的可用内存取 GetNumaAvailableMemoryNodeEx。
+// Windows 没有 PSI，hasPressure 恒为 false
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#include <pdh.h>
+#include "memory_counters.h"
+#include <utility>
+
+namespace sysmonitor {
+
+namespace {
+
+class PerformanceInfoMemoryCountersSource : public MemoryCountersSource {
+public:
+    PerformanceInfoMemoryCountersSource() {
+        ULONG highestNode = 0;
+        nodeCount_ = GetNumaHighestNodeNumber(&highestNode) ? highestNode + 1 : 0;
+
+        // 查询只打开一次；失败时只缺少累计计数
+        if (PdhOpenQueryW(nullptr, 0, &query_) != ERROR_SUCCESS) {
+            query_ = nullptr;
+            return;
+        }
+        PdhAddEnglishCounterW(query_, L"\\Memory\\Page Faults/sec", 0, &pageFaults_);
+        PdhAddEnglishCounterW(query_, L"\\Memory\\Page Reads/sec", 0, &pageReads_);
+        PdhAddEnglishCounterW(query_, L"\\Memory\\Pages Input/sec", 0, &pagesInput_);
+        PdhAddEnglishCounterW(query_, L"\\Memory\\Pages Output/sec", 0, &pagesOutput_);
+    }
+
+    ~PerformanceInfoMemoryCountersSource() override {
+        if (query_) PdhCloseQuery(query_);
+    }
+
+    bool Read(MemoryCounters& counters) override {
+        std::vector<NumaNodeMemory> nodes = std::move(counters.nodes);
+        counters = MemoryCounters();
+        counters.nodes = std::move(nodes);
+
+        MEMORYSTATUSEX stat;
+        stat.dwLength = sizeof(stat);
+        if (!GlobalMemoryStatusEx(&stat)) {
+            return false;
+        }
+        counters.totalPhysical = stat.ullTotalPhys;
+        counters.availablePhysical = stat.ullAvailPhys;
+
+        PERFORMANCE_INFORMATION perf;
+        perf.cb = sizeof(perf);
+        if (GetPerformanceInfo(&perf, sizeof(perf))) {
+            const uint64_t pageSize = perf.PageSize;
+            counters.commitCharge = static_cast<uint64_t>(perf.CommitTotal) * pageSize;
+            counters.commitLimit = static_cast<uint64_t>(perf.CommitLimit) * pageSize;
+            counters.cached = static_cast<uint64_t>(perf.SystemCache) * pageSize;
+        }
+
+        // */sec 计数器的 FirstValue 即自启动以来的累计次数
+        if (query_ && PdhCollectQueryData(query_) == ERROR_SUCCESS) {
+            counters.pageFaults = RawValue(pageFaults_);
+            counters.majorFaults = RawValue(pageReads_);
+            counters.pagesSwappedIn = RawValue(pagesInput_);
+            counters.pagesSwappedOut = RawValue(pagesOutput_);
+        }
+
+        counters.nodes.resize(nodeCount_);
+        for (ULONG i = 0; i < nodeCount_; ++i) {
+            NumaNodeMemory& node = counters.nodes[i];
+            node = NumaNodeMemory();
+            node.node = i;
+            ULONGLONG available = 0;
+            if (GetNumaAvailableMemoryNodeEx(static_cast<USHORT>(i), &available)) {
+                node.free = available;
+            }
+        }
+        return true;
+    }
+
+private:
+    static uint64_t RawValue(PDH_HCOUNTER counter) {
+        if (!counter) return 0;
+        PDH_RAW_COUNTER raw;
+        if (PdhGetRawCounterValue(counter, nullptr, &raw) != ERROR_SUCCESS || raw.FirstValue < 0) {
+            return 0;
+        }
+        return static_cast<uint64_t>(raw.FirstValue);
+    }
+
+    ULONG nodeCount_ = 0;
+    PDH_HQUERY query_ = nullptr;
+    PDH_HCOUNTER pageFaults_ = nullptr;
+    PDH_HCOUNTER pageReads_ = nullptr;
+    PDH_HCOUNTER pagesInput_ = nullptr;
+    PDH_HCOUNTER pagesOutput_ = nullptr;
+};
+
+} // namespace
+
+std::unique_ptr<MemoryCountersSource> CreateDefaultMemoryCountersSource() {
+    return std::make_unique<PerformanceInfoMemoryCountersSource>();
+}
+
+} // namespace sysmonitor
+
+#endif // _WIN32
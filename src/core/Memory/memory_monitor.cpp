@@ -1,16 +1,39 @@
 #include "memory_monitor.h"
-#define NOMINMAX
-#include <windows.h>
 #include <algorithm>
 #include "../../utils/util_time.h"
+#include "../../utils/metrics.h"
 namespace sysmonitor {
 
-MemoryMonitor::MemoryMonitor() : intervalMs_(1000) {
-    memoryUsage_.totalPhysical = 0;
-    memoryUsage_.availablePhysical = 0;
-    memoryUsage_.usedPhysical = 0;
-    memoryUsage_.usedPercent = 0.0;
-    memoryUsage_.timestamp = 0;
+namespace {
+
+// 计数器回绕或重置时按 0 处理
+inline uint64_t Delta(uint64_t before, uint64_t after) {
+    return after > before ? after - before : 0;
+}
+
+inline double RatePerSec(uint64_t before, uint64_t after, double seconds) {
+    return static_cast<double>(Delta(before, after)) / seconds;
+}
+
+// 停顿时间（微秒）占墙钟时间的比例
+inline double StallPercent(uint64_t before, uint64_t after, double elapsedUs) {
+    return std::clamp(100.0 * static_cast<double>(Delta(before, after)) / elapsedUs, 0.0, 100.0);
+}
+
+PressureStall StallBetween(const PressureStallTotals& before, const PressureStallTotals& after, double elapsedUs) {
+    PressureStall stall;
+    stall.some = StallPercent(before.someUs, after.someUs, elapsedUs);
+    stall.full = StallPercent(before.fullUs, after.fullUs, elapsedUs);
+    return stall;
+}
+
+} // namespace
+
+MemoryMonitor::MemoryMonitor() : MemoryMonitor(CreateDefaultMemoryCountersSource()) {
+}
+
+MemoryMonitor::MemoryMonitor(std::unique_ptr<MemoryCountersSource> source)
+    : source_(std::move(source)), intervalMs_(1000) {
 }
 
 MemoryMonitor::~MemoryMonitor() {
@@ -21,38 +44,33 @@ bool MemoryMonitor::Initialize() {
     return UpdateUsageData();
 }
 
-void MemoryMonitor::StartMonitoring(int intervalMs) {
+void MemoryMonitor::StartMonitoring(PeriodicScheduler& scheduler, int intervalMs) {
     if (isRunning_) return;
 
     intervalMs_ = intervalMs;
     isRunning_ = true;
-    monitorThread_ = std::make_unique<std::thread>(&MemoryMonitor::MonitoringLoop, this);
+    scheduler_ = &scheduler;
+    taskId_ = scheduler.Schedule("memory", static_cast<uint32_t>(intervalMs), [this] { Sample(); });
 }
 
 void MemoryMonitor::StopMonitoring() {
-    isRunning_ = false;
-
-    if (monitorThread_ && monitorThread_->joinable()) {
-        monitorThread_->join();
-    }
-    monitorThread_.reset();
+    if (!isRunning_.exchange(false)) return;
+    scheduler_->Cancel(taskId_);
+    taskId_ = PeriodicScheduler::kInvalidTask;
 }
 
-void MemoryMonitor::MonitoringLoop() {
-    while (isRunning_.load(std::memory_order_acquire)) {
-        if (UpdateUsageData()) {
-            MemoryUsage snapshot;
-            {
-                std::lock_guard<std::mutex> lk(usageMutex_);
-                snapshot = memoryUsage_;
-            }
-
-            if (callback_) {
-                callback_(snapshot);
-            }
+void MemoryMonitor::Sample() {
+    if (UpdateUsageData()) {
+        MemoryUsage snapshot;
+        {
+            std::lock_guard<std::mutex> lk(usageMutex_);
+            snapshot = memoryUsage_;
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs_));
+        std::lock_guard<std::mutex> lk(callbackMutex_);
+        if (callback_) {
+            callback_(snapshot);
+        }
     }
 }
 
@@ -62,34 +80,63 @@ MemoryUsage MemoryMonitor::GetCurrentUsage() {
 }
 
 bool MemoryMonitor::UpdateUsageData() {
-    MEMORYSTATUSEX stat;
-    stat.dwLength = sizeof(stat);
-    if (!GlobalMemoryStatusEx(&stat)) {
+    SYSMON_TIME_COLLECTOR("MemoryUpdateUsage");
+
+    if (!source_->Read(current_)) {
         return false;
     }
-
-    uint64_t total = stat.ullTotalPhys;
-    uint64_t avail = stat.ullAvailPhys;
-    uint64_t used = (total > avail) ? (total - avail) : 0;
-    double percent = 0.0;
-    if (total != 0) {
-        percent = 100.0 * static_cast<double>(used) / static_cast<double>(total);
+    const auto now = std::chrono::steady_clock::now();
+    const MemoryCounters& c = current_;
+
+    MemoryUsage usage;
+    usage.totalPhysical = c.totalPhysical;
+    usage.availablePhysical = c.availablePhysical;
+    usage.usedPhysical = (c.totalPhysical > c.availablePhysical) ? (c.totalPhysical - c.availablePhysical) : 0;
+    if (c.totalPhysical != 0) {
+        usage.usedPercent = 100.0 * static_cast<double>(usage.usedPhysical) / static_cast<double>(c.totalPhysical);
+    }
+    usage.usedPercent = std::clamp(usage.usedPercent, 0.0, 100.0);
+    usage.timestamp = GET_LOCAL_TIME_MS();
+
+    usage.commitCharge = c.commitCharge;
+    usage.commitLimit = c.commitLimit;
+    usage.cached = c.cached;
+    usage.swapTotal = c.swapTotal;
+    usage.swapUsed = (c.swapTotal > c.swapFree) ? (c.swapTotal - c.swapFree) : 0;
+    usage.nodes = c.nodes;
+
+    const double elapsedUs = hasPrevious_
+        ? static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(now - previousTime_).count())
+        : 0.0;
+    if (elapsedUs > 0.0) {
+        const MemoryCounters& p = previous_;
+        const double seconds = elapsedUs / 1e6;
+        usage.swapInPerSec = RatePerSec(p.pagesSwappedIn, c.pagesSwappedIn, seconds);
+        usage.swapOutPerSec = RatePerSec(p.pagesSwappedOut, c.pagesSwappedOut, seconds);
+        usage.pageFaultsPerSec = RatePerSec(p.pageFaults, c.pageFaults, seconds);
+        usage.majorFaultsPerSec = RatePerSec(p.majorFaults, c.majorFaults, seconds);
+
+        usage.hasPressure = c.hasPressure && p.hasPressure;
+        if (usage.hasPressure) {
+            usage.memoryPressure = StallBetween(p.memoryPressure, c.memoryPressure, elapsedUs);
+            usage.cpuPressure = StallBetween(p.cpuPressure, c.cpuPressure, elapsedUs);
+            usage.ioPressure = StallBetween(p.ioPressure, c.ioPressure, elapsedUs);
+        }
+    } else {
+        usage.hasPressure = c.hasPressure;
     }
-    percent = std::clamp(percent, 0.0, 100.0);
 
-    uint64_t ts = GET_LOCAL_TIME_MS();
+    std::swap(previous_, current_);
+    previousTime_ = now;
+    hasPrevious_ = true;
 
-    currentUsage_.store(percent, std::memory_order_release);
+    currentUsage_.store(usage.usedPercent, std::memory_order_release);
     {
         std::lock_guard<std::mutex> lk(usageMutex_);
-        memoryUsage_.totalPhysical = total;
-        memoryUsage_.availablePhysical = avail;
-        memoryUsage_.usedPhysical = used;
-        memoryUsage_.usedPercent = percent;
-        memoryUsage_.timestamp = ts;
+        memoryUsage_ = usage;
     }
 
     return true;
 }
 
-} // namespace sysmonitor
\ No newline at end of file
+} // namespace sysmonitor
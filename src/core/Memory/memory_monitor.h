@@ -1,19 +1,47 @@
 #pragma once
 #include <atomic>
-#include <thread>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <cstdint>
+#include <vector>
+#include "memory_counters.h"
+#include "../../utils/scheduler.h"
 
 namespace sysmonitor {
 
+// 压力停顿占比（%）：采样间隔内任务因资源不足而停顿的时间比例
+struct PressureStall {
+    double some = 0.0;
+    double full = 0.0;
+};
+
 struct MemoryUsage {
-    uint64_t totalPhysical;      // bytes
-    uint64_t availablePhysical;  // bytes
-    uint64_t usedPhysical;       // bytes
-    double usedPercent;          // 0.0 - 100.0
-    uint64_t timestamp;
+    uint64_t totalPhysical = 0;      // bytes
+    uint64_t availablePhysical = 0;  // bytes
+    uint64_t usedPhysical = 0;       // bytes
+    double usedPercent = 0.0;        // 0.0 - 100.0
+    uint64_t timestamp = 0;
+
+    uint64_t commitCharge = 0;       // bytes
+    uint64_t commitLimit = 0;        // bytes
+    uint64_t cached = 0;             // bytes，页缓存
+    uint64_t swapTotal = 0;          // bytes，仅 Linux
+    uint64_t swapUsed = 0;
+
+    // 相邻两次采样间的速率；首次采样为 0
+    double swapInPerSec = 0.0;       // 页/秒
+    double swapOutPerSec = 0.0;      // 页/秒
+    double pageFaultsPerSec = 0.0;
+    double majorFaultsPerSec = 0.0;
+
+    bool hasPressure = false;        // 仅 Linux 启用 PSI 时为 true
+    PressureStall memoryPressure;
+    PressureStall cpuPressure;
+    PressureStall ioPressure;
+
+    std::vector<NumaNodeMemory> nodes;
 };
 
 class MemoryMonitor {
@@ -21,13 +49,15 @@ public:
     using UsageCallback = std::function<void(const MemoryUsage&)>;
 
     MemoryMonitor();
+    explicit MemoryMonitor(std::unique_ptr<MemoryCountersSource> source);
     ~MemoryMonitor();
 
     MemoryMonitor(const MemoryMonitor&) = delete;
     MemoryMonitor& operator=(const MemoryMonitor&) = delete;
 
     bool Initialize();
-    void StartMonitoring(int intervalMs = 1000);
+    // 在 scheduler 上注册周期采样任务；scheduler 须比本对象存活更久
+    void StartMonitoring(PeriodicScheduler& scheduler, int intervalMs = 1000);
     void StopMonitoring();
 
     MemoryUsage GetCurrentUsage();
@@ -40,19 +70,27 @@ public:
     bool IsRunning() const { return isRunning_; }
 
 private:
-    void MonitoringLoop();
+    void Sample();
     bool UpdateUsageData();
 
 private:
+    std::unique_ptr<MemoryCountersSource> source_;
     std::atomic<bool> isRunning_{false};
-    std::unique_ptr<std::thread> monitorThread_;
+    PeriodicScheduler* scheduler_ = nullptr;
+    PeriodicScheduler::TaskId taskId_ = PeriodicScheduler::kInvalidTask;
     UsageCallback callback_;
     mutable std::mutex callbackMutex_;
     int intervalMs_;
 
+    // 求速率用的上一次读数，只在采样路径上访问（调度器串行执行同一任务）
+    MemoryCounters current_;
+    MemoryCounters previous_;
+    std::chrono::steady_clock::time_point previousTime_;
+    bool hasPrevious_ = false;
+
     MemoryUsage memoryUsage_;
     std::mutex usageMutex_;
     std::atomic<double> currentUsage_{0.0};
 };
 
-} // namespace sysmonitor
\ No newline at end of file
+} // namespace sysmonitor
@@ -0,0 +1,30 @@
+#include "account_name_cache.h"
+
+namespace sysmonitor {
+
+const std::string& AccountNameCache::Lookup(const std::string& userId, const Resolver& resolve) {
+    auto it = index_.find(userId);
+    if (it != index_.end()) {
+        ++stats_.hits;
+        items_.splice(items_.begin(), items_, it->second);
+        return it->second->second;
+    }
+
+    ++stats_.misses;
+    items_.emplace_front(userId, resolve(userId));
+    index_[userId] = items_.begin();
+
+    if (items_.size() > capacity_) {
+        index_.erase(items_.back().first);
+        items_.pop_back();
+        ++stats_.evictions;
+    }
+    return items_.front().second;
+}
+
+void AccountNameCache::Clear() {
+    items_.clear();
+    index_.clear();
+}
+
+} // namespace sysmonitor
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace sysmonitor {
+
+/**
+ * @brief 账户标识（SID / uid）到账户名的 LRU 缓存
+ *
+ * 系统中的账户数量很少，但 LookupAccountSid 可能因域查询阻塞数毫秒；
+ * 缓存后只有第一次遇到某个账户时才调用解析函数。非线程安全，由调用方加锁。
+ */
+class AccountNameCache {
+public:
+    using Resolver = std::function<std::string(const std::string& userId)>;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    explicit AccountNameCache(size_t capacity = 256) : capacity_(capacity == 0 ? 1 : capacity) {}
+
+    // 命中时返回缓存的账户名，否则调用 resolve 并缓存其结果
+    const std::string& Lookup(const std::string& userId, const Resolver& resolve);
+
+    void Clear();
+
+    size_t Size() const { return index_.size(); }
+    const Stats& GetStats() const { return stats_; }
+
+private:
+    using Item = std::pair<std::string, std::string>;   // userId -> name
+
+    size_t capacity_;
+    std::list<Item> items_;                              // 头部为最近使用
+    std::unordered_map<std::string, std::list<Item>::iterator> index_;
+    Stats stats_;
+};
+
+} // namespace sysmonitor
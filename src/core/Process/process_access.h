@@ -0,0 +1,114 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <memory>
+
+namespace sysmonitor {
+
+// 枚举阶段即可得到的进程信息（无需打开进程）
+struct ProcessEntry {
+    uint32_t pid = 0;
+    uint32_t parentPid = 0;
+    std::string name;
+    int32_t threadCount = 0;
+    int32_t priority = 0;
+};
+
+// 进程 CPU 时间，单位 100ns
+struct ProcessTimes {
+    int64_t createTime = 0;    // 进程创建时间，与 pid 一起唯一标识一个进程
+    uint64_t kernelTime = 0;
+    uint64_t userTime = 0;
+};
+
+struct ProcessMemory {
+    uint64_t workingSetSize = 0;   // bytes
+    uint64_t pagefileUsage = 0;    // bytes
+};
+
+// 进程累计计数器，ProcessMonitor 用相邻两次采样的差值计算速率
+struct ProcessCounters {
+    uint64_t readBytes = 0;
+    uint64_t writeBytes = 0;
+    uint64_t readOps = 0;
+    uint64_t writeOps = 0;
+    uint64_t minorFaults = 0;
+    uint64_t majorFaults = 0;
+    uint64_t voluntaryCtxSwitches = 0;     // 见 kCtxSwitchesScope
+    uint64_t involuntaryCtxSwitches = 0;
+};
+
+// 上下文切换计数的统计范围，随 JSON 输出。/proc/<pid>/status 只给出主线程（线程组组长）的计数，
+// 逐个读取 task/*/status 求和的开销与线程数成正比，采样路径上不做；Windows 不提供该计数
+#ifdef __linux__
+constexpr const char* kCtxSwitchesScope = "mainThread";
+#else
+constexpr const char* kCtxSwitchesScope = "unavailable";
+#endif
+
+// 单个线程的信息，CPU 时间单位 100ns
+struct ThreadEntry {
+    uint32_t tid = 0;
+    std::string name;
+    std::string state;         // 平台无法提供时为空
+    int32_t priority = 0;
+    int64_t createTime = 0;    // 与 tid 一起区分 tid 复用
+    uint64_t kernelTime = 0;
+    uint64_t userTime = 0;
+};
+
+/**
+ * @brief 进程访问路径：枚举进程、打开/关闭进程句柄、通过句柄查询属性
+ *
+ * ProcessMonitor 只通过该接口访问操作系统，缓存与计算逻辑因此与平台无关，
+ * 可以在 Linux 上用内存实现替换进行测试。Handle 对 Windows 是 HANDLE，
+ * 对 /proc 实现是 pid（查询时相对 /proc 目录描述符打开文件，不占用描述符）。
+ */
+class ProcessAccess {
+public:
+    using Handle = intptr_t;
+    static constexpr Handle kInvalidHandle = -1;
+
+    virtual ~ProcessAccess() = default;
+
+    virtual bool Enumerate(std::vector<ProcessEntry>& out) = 0;
+
+    // 打开进程，失败（已退出、权限不足）返回 kInvalidHandle
+    virtual Handle Open(uint32_t pid) = 0;
+    virtual void Close(Handle handle) = 0;
+
+    virtual bool QueryTimes(Handle handle, ProcessTimes& times) = 0;
+    virtual bool QueryMemory(Handle handle, ProcessMemory& memory) = 0;
+    // I/O、缺页、上下文切换计数；平台无法提供的字段保持 0
+    virtual bool QueryCounters(Handle handle, ProcessCounters& counters) = 0;
+    virtual uint32_t QueryHandleCount(Handle handle) = 0;
+    virtual uint32_t QueryGdiCount(Handle handle) = 0;
+    virtual uint32_t QueryUserCount(Handle handle) = 0;
+    virtual std::string QueryImagePath(Handle handle) = 0;
+    virtual std::string QueryCommandLine(Handle handle) = 0;
+
+    // 进程所属账户的标识（Windows 为 SID 的二进制内容，/proc 为 uid），用作账户名缓存的键
+    virtual bool QueryUserId(Handle handle, std::string& userId) = 0;
+    // 由账户标识解析账户名（LookupAccountSid 可能阻塞数毫秒，调用方应缓存结果）
+    virtual std::string LookupAccountName(const std::string& userId) = 0;
+
+    // 枚举进程的全部线程及其 CPU 时间；进程已退出或无权访问时返回 false
+    // 不依赖句柄缓存与枚举状态，可与采样线程并发调用
+    virtual bool EnumerateThreads(uint32_t pid, std::vector<ThreadEntry>& out) = 0;
+
+    // 系统累计 CPU 时间（内核 + 用户），单位与 ProcessTimes 一致
+    virtual uint64_t QuerySystemTime() = 0;
+
+    virtual bool Terminate(uint32_t pid, uint32_t exitCode) = 0;
+};
+
+// 当前平台的默认实现
+std::unique_ptr<ProcessAccess> CreateDefaultProcessAccess();
+
+#ifdef __linux__
+// 以 procRoot 代替 /proc 的实现，测试用假的 procfs 目录树驱动
+std::unique_ptr<ProcessAccess> CreateProcfsProcessAccess(const std::string& procRoot);
+#endif
+
+} // namespace sysmonitor
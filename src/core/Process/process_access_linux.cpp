@@ -0,0 +1,673 @@
+// Linux 进程访问路径：相对 /proc 目录描述符 openat + pread，手写解析 stat/statm/status
+// 已打开进程的 stat/statm/status/io 保持常驻描述符，稳态刷新只有 pread，不分配堆内存
+#ifdef __linux__
+#include "process_access.h"
+#include <fcntl.h>
+#include <pwd.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/vfs.h>
+#include <linux/magic.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+namespace sysmonitor {
+
+namespace {
+
+// FILETIME 纪元（1601-01-01）到 Unix 纪元的偏移，单位 100ns
+constexpr uint64_t kUnixEpochIn100ns = 116444736000000000ULL;
+// 描述符数量每隔这么多轮枚举才重新统计一次，按 pid 错开，避免同一轮集中统计
+constexpr uint64_t kFdCountIntervalScans = 4;
+
+// 每个采集线程复用的读缓冲区，首次使用时分配，稳态下读取 /proc 不再分配堆内存
+struct ReadBuffers {
+    char file[8192];
+    char dirents[32768];
+};
+
+ReadBuffers& Buffers() {
+    thread_local std::unique_ptr<ReadBuffers> buffers;
+    if (!buffers) buffers = std::make_unique<ReadBuffers>();
+    return *buffers;
+}
+
+// getdents64 返回的目录项布局
+struct LinuxDirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+
+// "<pid>/<name>"，写入调用方的栈缓冲区
+const char* FormatPath(char (&path)[64], uint32_t pid, const char* name) {
+    char digits[16];
+    int n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + pid % 10);
+        pid /= 10;
+    } while (pid);
+
+    char* p = path;
+    while (n) *p++ = digits[--n];
+    *p++ = '/';
+    size_t len = std::strlen(name);
+    std::memcpy(p, name, len + 1);
+    return path;
+}
+
+bool ParsePid(const char* s, uint32_t& pid) {
+    if (*s < '0' || *s > '9') return false;
+    uint32_t value = 0;
+    for (; *s; ++s) {
+        if (*s < '0' || *s > '9') return false;
+        value = value * 10 + static_cast<uint32_t>(*s - '0');
+    }
+    pid = value;
+    return true;
+}
+
+void SkipSpaces(const char*& p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+}
+
+void SkipField(const char*& p, const char* end) {
+    SkipSpaces(p, end);
+    while (p < end && *p != ' ' && *p != '\n') ++p;
+}
+
+uint64_t ParseU64(const char*& p, const char* end) {
+    SkipSpaces(p, end);
+    uint64_t value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    return value;
+}
+
+int64_t ParseI64(const char*& p, const char* end) {
+    SkipSpaces(p, end);
+    bool negative = p < end && *p == '-';
+    if (negative) ++p;
+    int64_t value = static_cast<int64_t>(ParseU64(p, end));
+    return negative ? -value : value;
+}
+
+// /proc/<pid>/stat 中需要的字段
+struct StatSample {
+    uint64_t generation = 0;                // 0 表示尚未读取；枚举轮次从 1 开始
+    uint32_t parentPid = 0;
+    int32_t priority = 0;
+    int32_t threadCount = 0;
+    char state = '?';
+    uint64_t minorFaults = 0;
+    uint64_t majorFaults = 0;
+    uint64_t utimeTicks = 0;
+    uint64_t stimeTicks = 0;
+    uint64_t startTicks = 0;   // 自开机以来的时钟周期
+    char comm[16] = {0};
+};
+
+// 格式："pid (comm) state ppid ... utime stime cutime cstime priority nice num_threads itrealvalue starttime ..."
+// comm 可能包含空格和括号，以最后一个 ')' 为界
+bool ParseStat(const char* data, size_t size, StatSample& out) {
+    const char* end = data + size;
+    const char* open = static_cast<const char*>(std::memchr(data, '(', size));
+    const char* close = nullptr;
+    for (const char* p = end; p > data; --p) {
+        if (p[-1] == ')') {
+            close = p - 1;
+            break;
+        }
+    }
+    if (!open || !close || close < open) {
+        return false;
+    }
+
+    size_t commLen = static_cast<size_t>(close - open - 1);
+    if (commLen >= sizeof(out.comm)) commLen = sizeof(out.comm) - 1;
+    std::memcpy(out.comm, open + 1, commLen);
+    out.comm[commLen] = '\0';
+
+    const char* p = close + 1;
+    SkipSpaces(p, end);
+    if (p < end) out.state = *p;                            // 3 state
+    SkipField(p, end);
+    out.parentPid = static_cast<uint32_t>(ParseU64(p, end)); // 4 ppid
+    for (int field = 5; field <= 9; ++field) SkipField(p, end);
+    out.minorFaults = ParseU64(p, end);                      // 10 minflt
+    SkipField(p, end);                                       // 11 cminflt
+    out.majorFaults = ParseU64(p, end);                      // 12 majflt
+    SkipField(p, end);                                       // 13 cmajflt
+    out.utimeTicks = ParseU64(p, end);                       // 14 utime
+    out.stimeTicks = ParseU64(p, end);                       // 15 stime
+    SkipField(p, end);                                       // 16 cutime
+    SkipField(p, end);                                       // 17 cstime
+    out.priority = static_cast<int32_t>(ParseI64(p, end));  // 18 priority
+    SkipField(p, end);                                       // 19 nice
+    out.threadCount = static_cast<int32_t>(ParseU64(p, end)); // 20 num_threads
+    SkipField(p, end);                                       // 21 itrealvalue
+    // 前面任一字段缺失（截断或格式不符）时已读到末尾，starttime 不存在
+    SkipSpaces(p, end);
+    if (p == end || *p < '0' || *p > '9') {
+        return false;
+    }
+    out.startTicks = ParseU64(p, end);                       // 22 starttime
+    return true;
+}
+
+// stat 中的状态字母，见 proc(5)
+const char* ThreadStateName(char state) {
+    switch (state) {
+    case 'R': return "Running";
+    case 'S': return "Sleeping";
+    case 'D': return "DiskSleep";
+    case 'T': return "Stopped";
+    case 't': return "TracingStop";
+    case 'Z': return "Zombie";
+    case 'X': return "Dead";
+    case 'I': return "Idle";
+    default: return "Unknown";
+    }
+}
+
+// 在 "Key:\tvalue" 格式的文件中查找 key，返回值的起始位置
+const char* FindKey(const char* data, size_t size, const char* key, size_t keyLen) {
+    const char* end = data + size;
+    const char* line = data;
+    while (line < end) {
+        if (static_cast<size_t>(end - line) > keyLen && std::memcmp(line, key, keyLen) == 0) {
+            return line + keyLen;
+        }
+        const char* next = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        if (!next) break;
+        line = next + 1;
+    }
+    return nullptr;
+}
+
+class LinuxProcessAccess : public ProcessAccess {
+public:
+    explicit LinuxProcessAccess(const std::string& procRoot)
+        : procFd_(open(procRoot.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)),
+          ticksPerSecond_(static_cast<uint64_t>(sysconf(_SC_CLK_TCK))),
+          pageSize_(static_cast<uint64_t>(sysconf(_SC_PAGESIZE))) {
+        if (procFd_ < 0) {
+            std::cerr << "Failed to open " << procRoot << ": " << std::strerror(errno) << std::endl;
+        }
+        if (ticksPerSecond_ == 0) ticksPerSecond_ = 100;
+        if (pageSize_ == 0) pageSize_ = 4096;
+        bootTime100ns_ = ReadBootTime() * 10000000ULL + kUnixEpochIn100ns;
+        systemStatFd_ = procFd_ >= 0 ? openat(procFd_, "stat", O_RDONLY | O_CLOEXEC) : -1;
+
+        // 本进程至少持有 procFd_；旧内核上 fd 目录的 st_size 恒为 0，退回逐项统计
+        struct stat st;
+        struct statfs fs;
+        fdCountFromSize_ = procFd_ >= 0 && fstatfs(procFd_, &fs) == 0 && fs.f_type == PROC_SUPER_MAGIC &&
+                           fstatat(procFd_, "self/fd", &st, 0) == 0 && st.st_size > 0;
+
+        // 常驻描述符最多占用软上限的一半，其余进程退回每次 openat
+        struct rlimit limit;
+        if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+            fdBudget_ = static_cast<size_t>(limit.rlim_cur / 2);
+        }
+    }
+
+    ~LinuxProcessAccess() override {
+        for (auto& [pid, tracked] : tracked_) {
+            CloseFds(tracked);
+        }
+        if (systemStatFd_ >= 0) close(systemStatFd_);
+        if (procFd_ >= 0) close(procFd_);
+    }
+
+    bool Enumerate(std::vector<ProcessEntry>& out) override {
+        out.clear();
+        if (procFd_ < 0 || lseek(procFd_, 0, SEEK_SET) < 0) {
+            return false;
+        }
+
+        ++generation_;
+        char* buf = Buffers().dirents;
+        for (;;) {
+            long n = syscall(SYS_getdents64, procFd_, buf, sizeof(Buffers().dirents));
+            if (n < 0) {
+                std::cerr << "Failed to enumerate /proc: " << std::strerror(errno) << std::endl;
+                return false;
+            }
+            if (n == 0) break;
+
+            for (long offset = 0; offset < n;) {
+                auto* dirent = reinterpret_cast<LinuxDirent64*>(buf + offset);
+                offset += dirent->d_reclen;
+
+                uint32_t pid;
+                if (!ParsePid(dirent->d_name, pid)) continue;
+
+                // 枚举时读取的 stat 在本轮内复用，QueryTimes / Open 不再重复读取；
+                // 已打开的进程直接 pread 常驻描述符，读失败（进程已退出、pid 被复用）时退回按路径读取
+                auto it = tracked_.find(pid);
+                StatSample sample;
+                if (!(it != tracked_.end() && ReadStatFd(it->second.statFd, sample)) && !ReadStat(pid, sample)) {
+                    continue;                           // 枚举与读取之间已退出
+                }
+                sample.generation = generation_;
+                if (it == tracked_.end()) {
+                    it = tracked_.emplace(pid, Tracked{}).first;
+                }
+                it->second.sample = sample;
+
+                ProcessEntry entry;
+                entry.pid = pid;
+                entry.parentPid = sample.parentPid;
+                entry.name = sample.comm;               // comm 最长 15 字节，位于 SSO 内
+                entry.threadCount = sample.threadCount;
+                entry.priority = sample.priority;
+                out.push_back(std::move(entry));
+            }
+        }
+
+        for (auto it = tracked_.begin(); it != tracked_.end();) {
+            if (it->second.sample.generation != generation_) {
+                CloseFds(it->second);
+                it = tracked_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        return true;
+    }
+
+    // Handle 即 pid。打开时为每轮都要读取的文件建立常驻描述符，之后每轮只需一次 pread
+    Handle Open(uint32_t pid) override {
+        StatSample fresh;
+        if (!CurrentSample(pid) && !ReadStat(pid, fresh)) {
+            return kInvalidHandle;
+        }
+
+        Tracked& tracked = tracked_[pid];
+        CloseFds(tracked);
+        tracked.fdCountGeneration = 0;
+        if (openFds_ + 4 <= fdBudget_) {
+            tracked.statFd = OpenPersistent(pid, "stat");
+            tracked.statmFd = OpenPersistent(pid, "statm");
+            tracked.statusFd = OpenPersistent(pid, "status");
+            tracked.ioFd = OpenPersistent(pid, "io");
+        }
+        return static_cast<Handle>(pid);
+    }
+
+    void Close(Handle handle) override {
+        auto it = tracked_.find(static_cast<uint32_t>(handle));
+        if (it != tracked_.end()) {
+            CloseFds(it->second);
+        }
+    }
+
+    bool QueryTimes(Handle handle, ProcessTimes& times) override {
+        uint32_t pid = static_cast<uint32_t>(handle);
+        StatSample fresh;
+        const StatSample* sample = CurrentSample(pid);
+        if (!sample) {
+            if (!ReadStat(pid, fresh)) return false;
+            sample = &fresh;
+        }
+        times.createTime = static_cast<int64_t>(bootTime100ns_ + TicksTo100ns(sample->startTicks));
+        times.kernelTime = TicksTo100ns(sample->stimeTicks);
+        times.userTime = TicksTo100ns(sample->utimeTicks);
+        return true;
+    }
+
+    bool QueryMemory(Handle handle, ProcessMemory& memory) override {
+        // statm: size resident shared text lib data dt（单位：页）
+        uint32_t pid = static_cast<uint32_t>(handle);
+        auto it = tracked_.find(pid);
+        ssize_t n = it != tracked_.end() ? PreadFd(it->second.statmFd) : -1;
+        if (n <= 0) n = ReadFile(pid, "statm");
+        if (n <= 0) return false;
+        const char* p = Buffers().file;
+        const char* end = p + n;
+        ParseU64(p, end);                                 // size
+        uint64_t resident = ParseU64(p, end);
+        ParseU64(p, end);                                 // shared
+        ParseU64(p, end);                                 // text
+        ParseU64(p, end);                                 // lib
+        uint64_t data = ParseU64(p, end);                 // data + stack，近似私有提交量
+        memory.workingSetSize = resident * pageSize_;
+        memory.pagefileUsage = data * pageSize_;
+        return true;
+    }
+
+    bool QueryCounters(Handle handle, ProcessCounters& counters) override {
+        uint32_t pid = static_cast<uint32_t>(handle);
+        auto it = tracked_.find(pid);
+        bool ok = false;
+
+        // 缺页数来自本轮枚举读取的 stat
+        StatSample fresh;
+        const StatSample* sample = CurrentSample(pid);
+        if (sample || ReadStat(pid, fresh)) {
+            if (!sample) sample = &fresh;
+            counters.minorFaults = sample->minorFaults;
+            counters.majorFaults = sample->majorFaults;
+            ok = true;
+        }
+
+        // io: "rchar: N\nwchar: N\nsyscr: N\nsyscw: N\nread_bytes: ..."，读取他人进程需要 ptrace 权限
+        // 取 rchar/wchar（含页缓存命中）以与 Windows 的 I/O 传输量口径一致
+        ssize_t n = it != tracked_.end() ? PreadFd(it->second.ioFd) : -1;
+        if (n <= 0) n = ReadFile(pid, "io");
+        if (n > 0) {
+            const char* data = Buffers().file;
+            const char* end = data + n;
+            struct { const char* key; size_t len; uint64_t* value; } fields[] = {
+                {"rchar:", 6, &counters.readBytes},
+                {"wchar:", 6, &counters.writeBytes},
+                {"syscr:", 6, &counters.readOps},
+                {"syscw:", 6, &counters.writeOps},
+            };
+            for (auto& field : fields) {
+                if (const char* value = FindKey(data, static_cast<size_t>(n), field.key, field.len)) {
+                    *field.value = ParseU64(value, end);
+                }
+            }
+            ok = true;
+        }
+
+        n = it != tracked_.end() ? PreadFd(it->second.statusFd) : -1;
+        if (n <= 0) n = ReadFile(pid, "status");
+        if (n > 0) {
+            const char* data = Buffers().file;
+            const char* end = data + n;
+            if (const char* value = FindKey(data, static_cast<size_t>(n), "voluntary_ctxt_switches:", 24)) {
+                counters.voluntaryCtxSwitches = ParseU64(value, end);
+            }
+            if (const char* value = FindKey(data, static_cast<size_t>(n), "nonvoluntary_ctxt_switches:", 27)) {
+                counters.involuntaryCtxSwitches = ParseU64(value, end);
+            }
+            ok = true;
+        }
+        return ok;
+    }
+
+    // 打开的文件描述符数量，对应 Windows 的句柄数；无权限读取 fd 目录时为 0。
+    // 已打开的进程按 kFdCountIntervalScans 的节奏刷新，其余轮次返回上次的结果
+    uint32_t QueryHandleCount(Handle handle) override {
+        const uint32_t pid = static_cast<uint32_t>(handle);
+        auto it = tracked_.find(pid);
+        if (it == tracked_.end()) {
+            return CountFds(pid);
+        }
+        Tracked& tracked = it->second;
+        const bool due = (generation_ + pid) % kFdCountIntervalScans == 0 && tracked.fdCountGeneration != generation_;
+        if (tracked.fdCountGeneration == 0 || due) {
+            tracked.fdCount = CountFds(pid);
+            tracked.fdCountGeneration = generation_ != 0 ? generation_ : 1;
+        }
+        return tracked.fdCount;
+    }
+
+    uint32_t QueryGdiCount(Handle) override {
+        return 0;
+    }
+
+    uint32_t QueryUserCount(Handle) override {
+        return 0;
+    }
+
+    std::string QueryImagePath(Handle handle) override {
+        char path[64];
+        char* target = Buffers().file;
+        ssize_t n = readlinkat(procFd_, FormatPath(path, static_cast<uint32_t>(handle), "exe"),
+                               target, sizeof(Buffers().file) - 1);
+        return n > 0 ? std::string(target, static_cast<size_t>(n)) : std::string();
+    }
+
+    std::string QueryCommandLine(Handle handle) override {
+        // 参数以 '\0' 分隔，超过缓冲区的部分截断
+        ssize_t n = ReadFile(static_cast<uint32_t>(handle), "cmdline");
+        if (n <= 0) return "";
+        while (n > 0 && Buffers().file[n - 1] == '\0') --n;
+        std::string commandLine(Buffers().file, static_cast<size_t>(n));
+        for (char& c : commandLine) {
+            if (c == '\0') c = ' ';
+        }
+        return commandLine;
+    }
+
+    bool QueryUserId(Handle handle, std::string& userId) override {
+        // status: "Uid:\treal\teffective\tsaved\tfs"，取 real uid
+        ssize_t n = ReadFile(static_cast<uint32_t>(handle), "status");
+        if (n <= 0) return false;
+        const char* value = FindKey(Buffers().file, static_cast<size_t>(n), "Uid:", 4);
+        if (!value) return false;
+        const char* end = Buffers().file + n;
+        SkipSpaces(value, end);
+        const char* start = value;
+        while (value < end && *value >= '0' && *value <= '9') ++value;
+        if (value == start) return false;
+        userId.assign(start, static_cast<size_t>(value - start));
+        return true;
+    }
+
+    std::string LookupAccountName(const std::string& userId) override {
+        const char* p = userId.data();
+        uid_t uid = static_cast<uid_t>(ParseU64(p, p + userId.size()));
+
+        struct passwd pwd;
+        struct passwd* result = nullptr;
+        char buffer[1024];
+        if (getpwuid_r(uid, &pwd, buffer, sizeof(buffer), &result) == 0 && result) {
+            return result->pw_name;
+        }
+        return userId;
+    }
+
+    // /proc/<pid>/task/<tid>/stat 与进程 stat 格式相同，comm 即线程名
+    bool EnumerateThreads(uint32_t pid, std::vector<ThreadEntry>& out) override {
+        out.clear();
+        if (procFd_ < 0) return false;
+        char path[64];
+        int taskFd = openat(procFd_, FormatPath(path, pid, "task"), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (taskFd < 0) return false;
+
+        char* buf = Buffers().dirents;
+        for (;;) {
+            long n = syscall(SYS_getdents64, taskFd, buf, sizeof(Buffers().dirents));
+            if (n <= 0) break;
+            for (long offset = 0; offset < n;) {
+                auto* dirent = reinterpret_cast<LinuxDirent64*>(buf + offset);
+                offset += dirent->d_reclen;
+
+                uint32_t tid;
+                if (!ParsePid(dirent->d_name, tid)) continue;
+                int fd = openat(taskFd, FormatPath(path, tid, "stat"), O_RDONLY | O_CLOEXEC);
+                if (fd < 0) continue;                   // 线程已退出
+                StatSample sample;
+                bool ok = ReadStatFd(fd, sample);
+                close(fd);
+                if (!ok) continue;
+
+                ThreadEntry entry;
+                entry.tid = tid;
+                entry.name = sample.comm;
+                entry.state = ThreadStateName(sample.state);
+                entry.priority = sample.priority;
+                entry.createTime = static_cast<int64_t>(bootTime100ns_ + TicksTo100ns(sample.startTicks));
+                entry.kernelTime = TicksTo100ns(sample.stimeTicks);
+                entry.userTime = TicksTo100ns(sample.utimeTicks);
+                out.push_back(std::move(entry));
+            }
+        }
+        close(taskFd);
+        return !out.empty();
+    }
+
+    uint64_t QuerySystemTime() override {
+        // /proc/stat 首行："cpu  user nice system idle iowait irq softirq steal guest guest_nice"
+        // 与 Windows GetSystemTimes 的内核 + 用户时间一样包含空闲时间；guest 已计入 user
+        ssize_t n = PreadFd(systemStatFd_);
+        if (n <= 0) return 0;
+        const char* p = Buffers().file;
+        const char* end = p + n;
+        if (n < 4 || std::memcmp(p, "cpu ", 4) != 0) return 0;
+        p += 4;
+        uint64_t total = 0;
+        for (int field = 0; field < 8; ++field) {
+            total += ParseU64(p, end);
+        }
+        return TicksTo100ns(total);
+    }
+
+    bool Terminate(uint32_t pid, uint32_t) override {
+        // 与 TerminateProcess 一样强制结束，退出码不可指定
+        return kill(static_cast<pid_t>(pid), SIGKILL) == 0;
+    }
+
+private:
+    uint64_t TicksTo100ns(uint64_t ticks) const {
+        return ticks / ticksPerSecond_ * 10000000ULL + ticks % ticksPerSecond_ * 10000000ULL / ticksPerSecond_;
+    }
+
+    // 已枚举进程的状态；常驻描述符在 Open 时建立，Close 或进程消失时关闭
+    struct Tracked {
+        StatSample sample;
+        int statFd = -1;
+        int statmFd = -1;
+        int statusFd = -1;
+        int ioFd = -1;
+        uint32_t fdCount = 0;
+        uint64_t fdCountGeneration = 0;     // 0 表示尚未统计
+    };
+
+    int OpenPersistent(uint32_t pid, const char* name) {
+        char path[64];
+        int fd = openat(procFd_, FormatPath(path, pid, name), O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) ++openFds_;
+        return fd;
+    }
+
+    void CloseFds(Tracked& tracked) {
+        for (int* fd : {&tracked.statFd, &tracked.statmFd, &tracked.statusFd, &tracked.ioFd}) {
+            if (*fd >= 0) {
+                close(*fd);
+                --openFds_;
+                *fd = -1;
+            }
+        }
+    }
+
+    // Linux 6.2 起 /proc/<pid>/fd 的 st_size 即描述符数量，一次 fstatat 代替逐项读取目录
+    uint32_t CountFds(uint32_t pid) {
+        char path[64];
+        FormatPath(path, pid, "fd");
+        struct stat st;
+        if (fdCountFromSize_) {
+            return fstatat(procFd_, path, &st, 0) == 0 ? static_cast<uint32_t>(st.st_size) : 0;
+        }
+
+        int fd = openat(procFd_, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) return 0;
+        uint32_t count = 0;
+        char* buf = Buffers().dirents;
+        long n;
+        while ((n = syscall(SYS_getdents64, fd, buf, sizeof(Buffers().dirents))) > 0) {
+            for (long offset = 0; offset < n;) {
+                auto* dirent = reinterpret_cast<LinuxDirent64*>(buf + offset);
+                offset += dirent->d_reclen;
+                if (dirent->d_name[0] != '.') ++count;
+            }
+        }
+        close(fd);
+        return count;
+    }
+
+    const StatSample* CurrentSample(uint32_t pid) const {
+        auto it = tracked_.find(pid);
+        // 首次枚举前 Open 插入的节点 generation 同为 0，不能当作本轮样本
+        return it != tracked_.end() && it->second.sample.generation != 0 && it->second.sample.generation == generation_
+                   ? &it->second.sample : nullptr;
+    }
+
+    bool ReadStat(uint32_t pid, StatSample& sample) {
+        ssize_t n = ReadFile(pid, "stat");
+        return n > 0 && ParseStat(Buffers().file, static_cast<size_t>(n), sample);
+    }
+
+    bool ReadStatFd(int fd, StatSample& sample) {
+        ssize_t n = PreadFd(fd);
+        return n > 0 && ParseStat(Buffers().file, static_cast<size_t>(n), sample);
+    }
+
+    // procfs 文件在偏移 0 处 pread 会重新生成内容，常驻描述符可以反复读取
+    ssize_t PreadFd(int fd) {
+        return fd >= 0 ? pread(fd, Buffers().file, sizeof(Buffers().file), 0) : -1;
+    }
+
+    // 读取 /proc/<pid>/<name> 到线程缓冲区，返回字节数
+    ssize_t ReadFile(uint32_t pid, const char* name) {
+        char path[64];
+        return ReadProcFile(FormatPath(path, pid, name));
+    }
+
+    ssize_t ReadProcFile(const char* relativePath) {
+        if (procFd_ < 0) return -1;
+        int fd = openat(procFd_, relativePath, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return -1;
+        ssize_t n = PreadFd(fd);
+        close(fd);
+        return n;
+    }
+
+    // btime 位于很长的 intr 行之后，可能超出线程缓冲区，构造时完整读取一次
+    uint64_t ReadBootTime() {
+        if (procFd_ < 0) return 0;
+        int fd = openat(procFd_, "stat", O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return 0;
+        std::string content;
+        char chunk[4096];
+        ssize_t n;
+        while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+            content.append(chunk, static_cast<size_t>(n));
+        }
+        close(fd);
+
+        const char* value = FindKey(content.data(), content.size(), "btime ", 6);
+        return value ? ParseU64(value, content.data() + content.size()) : 0;
+    }
+
+    int procFd_;
+    int systemStatFd_ = -1;
+    uint64_t ticksPerSecond_;
+    uint64_t pageSize_;
+    uint64_t bootTime100ns_ = 0;
+
+    // 新进程才插入节点，退出的进程在下次枚举时移除
+    std::unordered_map<uint32_t, Tracked> tracked_;
+    uint64_t generation_ = 0;
+    bool fdCountFromSize_ = false;
+    size_t openFds_ = 0;
+    size_t fdBudget_ = 4096;
+};
+
+} // namespace
+
+std::unique_ptr<ProcessAccess> CreateDefaultProcessAccess() {
+    return CreateProcfsProcessAccess("/proc");
+}
+
+std::unique_ptr<ProcessAccess> CreateProcfsProcessAccess(const std::string& procRoot) {
+    return std::make_unique<LinuxProcessAccess>(procRoot);
+}
+
+} // namespace sysmonitor
+
+#endif // __linux__
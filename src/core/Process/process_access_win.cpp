@@ -0,0 +1,278 @@
+// Windows 进程访问路径：ToolHelp 枚举 + OpenProcess 句柄查询
+#ifdef _WIN32
+#include "process_access.h"
+#include <windows.h>
+#include <tlhelp32.h>
+#include <psapi.h>
+#include <iostream>
+
+#pragma comment(lib, "psapi.lib")
+#pragma comment(lib, "advapi32.lib")
+#pragma comment(lib, "user32.lib")
+
+namespace sysmonitor {
+
+namespace {
+
+uint64_t FileTimeToUInt64(const FILETIME& ft) {
+    ULARGE_INTEGER value;
+    value.LowPart = ft.dwLowDateTime;
+    value.HighPart = ft.dwHighDateTime;
+    return value.QuadPart;
+}
+
+HANDLE ToNative(ProcessAccess::Handle handle) {
+    return reinterpret_cast<HANDLE>(handle);
+}
+
+// GetThreadDescription 自 Windows 10 1607 起提供，运行时查找
+using GetThreadDescriptionFn = HRESULT(WINAPI*)(HANDLE, PWSTR*);
+
+GetThreadDescriptionFn ResolveGetThreadDescription() {
+    static GetThreadDescriptionFn fn = reinterpret_cast<GetThreadDescriptionFn>(
+        GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "GetThreadDescription"));
+    return fn;
+}
+
+std::string QueryThreadName(HANDLE thread) {
+    GetThreadDescriptionFn getDescription = ResolveGetThreadDescription();
+    PWSTR description = nullptr;
+    if (!getDescription || FAILED(getDescription(thread, &description)) || !description) {
+        return std::string();
+    }
+    std::string name;
+    int size = WideCharToMultiByte(CP_ACP, 0, description, -1, nullptr, 0, nullptr, nullptr);
+    if (size > 1) {
+        name.resize(static_cast<size_t>(size - 1));
+        WideCharToMultiByte(CP_ACP, 0, description, -1, &name[0], size, nullptr, nullptr);
+    }
+    LocalFree(description);
+    return name;
+}
+
+// 系统关键进程（System Idle Process、System）通常无法查询句柄数
+bool IsCriticalSystemProcess(uint32_t pid) {
+    return pid == 0 || pid == 4;
+}
+
+class WinProcessAccess : public ProcessAccess {
+public:
+    bool Enumerate(std::vector<ProcessEntry>& out) override {
+        out.clear();
+
+        HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+        if (snapshot == INVALID_HANDLE_VALUE) {
+            std::cerr << "Failed to create process snapshot: " << GetLastError() << std::endl;
+            return false;
+        }
+
+        PROCESSENTRY32 processEntry;
+        processEntry.dwSize = sizeof(PROCESSENTRY32);
+        if (Process32First(snapshot, &processEntry)) {
+            do {
+                ProcessEntry entry;
+                entry.pid = processEntry.th32ProcessID;
+                entry.parentPid = processEntry.th32ParentProcessID;
+                entry.name = processEntry.szExeFile;
+                entry.threadCount = static_cast<int32_t>(processEntry.cntThreads);
+                entry.priority = processEntry.pcPriClassBase;
+                out.push_back(std::move(entry));
+            } while (Process32Next(snapshot, &processEntry));
+        }
+
+        CloseHandle(snapshot);
+        return true;
+    }
+
+    Handle Open(uint32_t pid) override {
+        // 一次打开满足所有查询：路径和命令行需要 VM_READ，令牌、GUI 资源需要 QUERY_INFORMATION
+        HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pid);
+        return hProcess ? reinterpret_cast<Handle>(hProcess) : kInvalidHandle;
+    }
+
+    void Close(Handle handle) override {
+        CloseHandle(ToNative(handle));
+    }
+
+    bool QueryTimes(Handle handle, ProcessTimes& times) override {
+        FILETIME createTime = {0}, exitTime = {0}, kernelTime = {0}, userTime = {0};
+        if (!GetProcessTimes(ToNative(handle), &createTime, &exitTime, &kernelTime, &userTime)) {
+            return false;
+        }
+        times.createTime = static_cast<int64_t>(FileTimeToUInt64(createTime));
+        times.kernelTime = FileTimeToUInt64(kernelTime);
+        times.userTime = FileTimeToUInt64(userTime);
+        return true;
+    }
+
+    bool QueryMemory(Handle handle, ProcessMemory& memory) override {
+        PROCESS_MEMORY_COUNTERS pmc;
+        ZeroMemory(&pmc, sizeof(pmc));
+        pmc.cb = sizeof(pmc);
+        if (!GetProcessMemoryInfo(ToNative(handle), &pmc, sizeof(pmc))) {
+            return false;
+        }
+        memory.workingSetSize = pmc.WorkingSetSize;
+        memory.pagefileUsage = pmc.PagefileUsage;
+        return true;
+    }
+
+    bool QueryCounters(Handle handle, ProcessCounters& counters) override {
+        // Transfer/OperationCount 统计所有 I/O（文件、网络、设备），与 /proc/<pid>/io 的 rchar/syscr 对应
+        IO_COUNTERS io;
+        bool ok = false;
+        if (GetProcessIoCounters(ToNative(handle), &io)) {
+            counters.readBytes = io.ReadTransferCount;
+            counters.writeBytes = io.WriteTransferCount;
+            counters.readOps = io.ReadOperationCount;
+            counters.writeOps = io.WriteOperationCount;
+            ok = true;
+        }
+
+        // Windows 只提供软、硬缺页合计，记入 minorFaults；上下文切换需逐线程查询，这里不提供
+        PROCESS_MEMORY_COUNTERS pmc;
+        ZeroMemory(&pmc, sizeof(pmc));
+        pmc.cb = sizeof(pmc);
+        if (GetProcessMemoryInfo(ToNative(handle), &pmc, sizeof(pmc))) {
+            counters.minorFaults = pmc.PageFaultCount;
+            ok = true;
+        }
+        return ok;
+    }
+
+    uint32_t QueryHandleCount(Handle handle) override {
+        if (IsCriticalSystemProcess(GetProcessId(ToNative(handle)))) {
+            return 0;
+        }
+        DWORD handleCount = 0;
+        return GetProcessHandleCount(ToNative(handle), &handleCount) ? handleCount : 0;
+    }
+
+    uint32_t QueryGdiCount(Handle handle) override {
+        return GetGuiResources(ToNative(handle), GR_GDIOBJECTS);
+    }
+
+    uint32_t QueryUserCount(Handle handle) override {
+        return GetGuiResources(ToNative(handle), GR_USEROBJECTS);
+    }
+
+    std::string QueryImagePath(Handle handle) override {
+        char path[MAX_PATH];
+        if (GetModuleFileNameExA(ToNative(handle), NULL, path, MAX_PATH)) {
+            return path;
+        }
+        return "";
+    }
+
+    std::string QueryCommandLine(Handle handle) override {
+        // Simplified implementation, return process path as command line
+        return QueryImagePath(handle);
+    }
+
+    bool QueryUserId(Handle handle, std::string& userId) override {
+        HANDLE hToken = NULL;
+        if (!OpenProcessToken(ToNative(handle), TOKEN_QUERY, &hToken)) {
+            return false;
+        }
+
+        bool ok = false;
+        DWORD tokenInfoSize = 0;
+        GetTokenInformation(hToken, TokenUser, NULL, 0, &tokenInfoSize);
+        if (tokenInfoSize > 0) {
+            auto tokenInfo = std::make_unique<BYTE[]>(tokenInfoSize);
+            if (GetTokenInformation(hToken, TokenUser, tokenInfo.get(), tokenInfoSize, &tokenInfoSize)) {
+                PSID sid = ((PTOKEN_USER)tokenInfo.get())->User.Sid;
+                if (IsValidSid(sid)) {
+                    userId.assign(reinterpret_cast<const char*>(sid), GetLengthSid(sid));
+                    ok = true;
+                }
+            }
+        }
+
+        CloseHandle(hToken);
+        return ok;
+    }
+
+    std::string LookupAccountName(const std::string& userId) override {
+        PSID sid = (PSID)userId.data();
+        if (userId.empty() || !IsValidSid(sid)) {
+            return "SYSTEM";
+        }
+
+        char name[256];
+        char domain[256];
+        DWORD nameSize = sizeof(name);
+        DWORD domainSize = sizeof(domain);
+        SID_NAME_USE sidType;
+        if (LookupAccountSidA(NULL, sid, name, &nameSize, domain, &domainSize, &sidType)) {
+            return std::string(domain) + "\\" + name;
+        }
+        return "SYSTEM";
+    }
+
+    // ToolHelp 线程快照覆盖全系统，按所属进程过滤；ToolHelp 不提供线程状态，state 留空
+    bool EnumerateThreads(uint32_t pid, std::vector<ThreadEntry>& out) override {
+        out.clear();
+        HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+        if (snapshot == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        THREADENTRY32 threadEntry;
+        threadEntry.dwSize = sizeof(THREADENTRY32);
+        if (Thread32First(snapshot, &threadEntry)) {
+            do {
+                if (threadEntry.th32OwnerProcessID != pid) continue;
+                ThreadEntry entry;
+                entry.tid = threadEntry.th32ThreadID;
+                entry.priority = threadEntry.tpBasePri + threadEntry.tpDeltaPri;
+
+                HANDLE thread = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, threadEntry.th32ThreadID);
+                if (thread) {
+                    FILETIME createTime = {0}, exitTime = {0}, kernelTime = {0}, userTime = {0};
+                    if (GetThreadTimes(thread, &createTime, &exitTime, &kernelTime, &userTime)) {
+                        entry.createTime = static_cast<int64_t>(FileTimeToUInt64(createTime));
+                        entry.kernelTime = FileTimeToUInt64(kernelTime);
+                        entry.userTime = FileTimeToUInt64(userTime);
+                    }
+                    entry.name = QueryThreadName(thread);
+                    CloseHandle(thread);
+                }
+                out.push_back(std::move(entry));
+            } while (Thread32Next(snapshot, &threadEntry));
+        }
+
+        CloseHandle(snapshot);
+        return !out.empty();
+    }
+
+    uint64_t QuerySystemTime() override {
+        FILETIME sysIdleTime, sysKernelTime, sysUserTime;
+        if (!GetSystemTimes(&sysIdleTime, &sysKernelTime, &sysUserTime)) {
+            return 0;
+        }
+        return FileTimeToUInt64(sysKernelTime) + FileTimeToUInt64(sysUserTime);
+    }
+
+    bool Terminate(uint32_t pid, uint32_t exitCode) override {
+        HANDLE hProcess = OpenProcess(PROCESS_TERMINATE, FALSE, pid);
+        if (!hProcess) {
+            return false;
+        }
+
+        BOOL result = ::TerminateProcess(hProcess, exitCode);
+        CloseHandle(hProcess);
+
+        return result != FALSE;
+    }
+};
+
+} // namespace
+
+std::unique_ptr<ProcessAccess> CreateDefaultProcessAccess() {
+    return std::make_unique<WinProcessAccess>();
+}
+
+} // namespace sysmonitor
+
+#endif // _WIN32
@@ -0,0 +1,265 @@
+// Linux netlink 进程连接器（proc connector）：内核逐个推送 fork/exec/exit 事件
+// 需要 CAP_NET_ADMIN；订阅失败时由调用方退回到快照比较
+#include "process_lifecycle.h"
+
+#ifdef __linux__
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace sysmonitor {
+
+namespace {
+
+// FILETIME 纪元（1601-01-01）到 Unix 纪元的偏移，单位 100ns
+constexpr uint64_t kUnixEpochIn100ns = 116444736000000000ULL;
+
+// 从 /proc/stat 读取 btime（秒），用于把内核单调时间戳换算为 createTime
+uint64_t ReadBootTime() {
+    int fd = open("/proc/stat", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+    std::string content;
+    char chunk[4096];
+    ssize_t n;
+    while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+        content.append(chunk, static_cast<size_t>(n));
+    }
+    close(fd);
+
+    size_t pos = content.find("\nbtime ");
+    return pos == std::string::npos ? 0 : std::strtoull(content.c_str() + pos + 7, nullptr, 10);
+}
+
+// /proc/<pid>/stat 的第 22 个字段 starttime（开机以来的时钟周期）；进程已被回收时返回 false
+bool ReadStartTicks(uint32_t pid, uint64_t& ticks) {
+    char path[32];
+    std::snprintf(path, sizeof(path), "/proc/%u/stat", pid);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    char buffer[1024];
+    ssize_t n = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (n <= 0) return false;
+    buffer[n] = '\0';
+
+    // comm 可能包含空格和括号，以最后一个 ')' 为界；其后第一个字段是第 3 个字段 state
+    const char* p = std::strrchr(buffer, ')');
+    if (!p) return false;
+    ++p;
+    for (int field = 3; field < 22; ++field) {
+        while (*p == ' ') ++p;
+        while (*p && *p != ' ') ++p;
+    }
+    while (*p == ' ') ++p;
+    if (*p < '0' || *p > '9') return false;
+    ticks = std::strtoull(p, nullptr, 10);
+    return true;
+}
+
+// 当前 CLOCK_BOOTTIME 与 CLOCK_MONOTONIC 之差（挂起时长），纳秒
+uint64_t SuspendedNs() {
+    timespec boot{}, monotonic{};
+    clock_gettime(CLOCK_BOOTTIME, &boot);
+    clock_gettime(CLOCK_MONOTONIC, &monotonic);
+    const int64_t diff = (static_cast<int64_t>(boot.tv_sec) - monotonic.tv_sec) * 1000000000LL +
+                         (boot.tv_nsec - monotonic.tv_nsec);
+    return diff > 0 ? static_cast<uint64_t>(diff) : 0;
+}
+
+// 内核上报的是 wait 状态：正常退出取退出码，被信号终止时按 shell 惯例为 128 + 信号值
+int32_t ExitCode(uint32_t status) {
+    const int raw = static_cast<int>(status);
+    if (WIFSIGNALED(raw)) return 128 + WTERMSIG(raw);
+    return WEXITSTATUS(raw);
+}
+
+std::string ReadComm(uint32_t pid) {
+    char path[32];
+    std::snprintf(path, sizeof(path), "/proc/%u/comm", pid);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return std::string();
+    char buffer[64];
+    ssize_t n = read(fd, buffer, sizeof(buffer));
+    close(fd);
+    if (n <= 0) return std::string();
+    size_t length = static_cast<size_t>(n);
+    if (buffer[length - 1] == '\n') --length;
+    return std::string(buffer, length);
+}
+
+class NetlinkProcessEventSource : public KernelProcessEventSource {
+public:
+    ~NetlinkProcessEventSource() override { Stop(); }
+
+    bool Start(Callback callback, OverrunCallback onOverrun) override {
+        fd_ = socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+        if (fd_ < 0) return false;
+
+        sockaddr_nl address{};
+        address.nl_family = AF_NETLINK;
+        address.nl_groups = CN_IDX_PROC;
+        address.nl_pid = 0;   // 由内核分配
+        if (bind(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+            !SendControl(PROC_CN_MCAST_LISTEN)) {
+            close(fd_);
+            fd_ = -1;
+            return false;
+        }
+
+        bootTime100ns_ = kUnixEpochIn100ns + ReadBootTime() * 10000000ULL;
+        const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+        ticksPerSecond_ = ticksPerSecond > 0 ? static_cast<uint64_t>(ticksPerSecond) : 100;
+        callback_ = std::move(callback);
+        onOverrun_ = std::move(onOverrun);
+        running_ = true;
+        thread_ = std::thread([this] { ReceiveLoop(); });
+        return true;
+    }
+
+    void Stop() override {
+        if (!running_.exchange(false)) return;
+        if (thread_.joinable()) thread_.join();
+        SendControl(PROC_CN_MCAST_IGNORE);
+        close(fd_);
+        fd_ = -1;
+    }
+
+private:
+    bool SendControl(proc_cn_mcast_op op) {
+        alignas(nlmsghdr) char buffer[NLMSG_SPACE(sizeof(cn_msg) + sizeof(proc_cn_mcast_op))] = {};
+        auto* header = reinterpret_cast<nlmsghdr*>(buffer);
+        header->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(op));
+        header->nlmsg_type = NLMSG_DONE;
+        header->nlmsg_pid = 0;
+
+        auto* message = static_cast<cn_msg*>(NLMSG_DATA(header));
+        message->id.idx = CN_IDX_PROC;
+        message->id.val = CN_VAL_PROC;
+        message->len = sizeof(op);
+        std::memcpy(message->data, &op, sizeof(op));
+
+        return send(fd_, buffer, header->nlmsg_len, 0) == static_cast<ssize_t>(header->nlmsg_len);
+    }
+
+    // 与 procfs 采集相同的 createTime：btime + starttime（时钟周期），使 (pid, createTime) 能与
+    // /api/processes 对应。进程已被回收时由事件时间戳推算：CLOCK_MONOTONIC 加上挂起时长即开机以来的
+    // 时间，按时钟周期向下取整
+    int64_t CreateTime(uint32_t pid, uint64_t timestampNs) const {
+        uint64_t ticks = 0;
+        if (!ReadStartTicks(pid, ticks)) {
+            ticks = (timestampNs + SuspendedNs()) / (1000000000ULL / ticksPerSecond_);
+        }
+        return static_cast<int64_t>(bootTime100ns_ + ticks / ticksPerSecond_ * 10000000ULL +
+                                    ticks % ticksPerSecond_ * 10000000ULL / ticksPerSecond_);
+    }
+
+    void ReceiveLoop() {
+        alignas(nlmsghdr) char buffer[16384];
+        while (running_) {
+            pollfd pfd{fd_, POLLIN, 0};
+            int ready = poll(&pfd, 1, 200);   // 定期检查 running_
+            if (ready <= 0) continue;
+
+            ssize_t n = recv(fd_, buffer, sizeof(buffer), 0);
+            if (n < 0) {
+                // 接收缓冲区溢出：内核已丢弃部分事件
+                if (errno == ENOBUFS) onOverrun_();
+                continue;
+            }
+
+            for (auto* header = reinterpret_cast<nlmsghdr*>(buffer); NLMSG_OK(header, static_cast<unsigned>(n));
+                 header = NLMSG_NEXT(header, n)) {
+                if (header->nlmsg_type == NLMSG_ERROR || header->nlmsg_type == NLMSG_NOOP) continue;
+                auto* message = static_cast<cn_msg*>(NLMSG_DATA(header));
+                if (message->id.idx != CN_IDX_PROC || message->id.val != CN_VAL_PROC) continue;
+                Handle(*reinterpret_cast<const proc_event*>(message->data));
+            }
+        }
+    }
+
+    // 只关心线程组（进程）级别的事件，忽略普通线程的创建与退出
+    void Handle(const proc_event& raw) {
+        ProcessEvent event;
+        switch (raw.what) {
+        case proc_event::PROC_EVENT_FORK: {
+            const auto& fork = raw.event_data.fork;
+            if (fork.child_pid != fork.child_tgid) return;
+            event.type = ProcessEventType::Start;
+            event.pid = static_cast<uint32_t>(fork.child_tgid);
+            event.parentPid = static_cast<uint32_t>(fork.parent_tgid);
+            event.createTime = CreateTime(event.pid, raw.timestamp_ns);
+            auto parent = names_.find(event.parentPid);
+            event.name = parent != names_.end() ? parent->second : ReadComm(event.pid);
+            names_[event.pid] = event.name;
+            break;
+        }
+        case proc_event::PROC_EVENT_EXEC: {
+            event.type = ProcessEventType::Exec;
+            event.pid = static_cast<uint32_t>(raw.event_data.exec.process_tgid);
+            event.name = ReadComm(event.pid);
+            names_[event.pid] = event.name;
+            break;
+        }
+        case proc_event::PROC_EVENT_EXIT: {
+            const auto& exit = raw.event_data.exit;
+            if (exit.process_pid != exit.process_tgid) return;
+            event.type = ProcessEventType::Exit;
+            event.pid = static_cast<uint32_t>(exit.process_tgid);
+            event.exitCode = ExitCode(exit.exit_code);
+            auto it = names_.find(event.pid);
+            if (it != names_.end()) {
+                event.name = std::move(it->second);
+                names_.erase(it);
+            }
+            break;
+        }
+        default:
+            return;
+        }
+        callback_(event);
+    }
+
+    int fd_ = -1;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    Callback callback_;
+    OverrunCallback onOverrun_;
+    uint64_t bootTime100ns_ = 0;
+    uint64_t ticksPerSecond_ = 100;
+    // 事件源启动后见过的进程名，只在接收线程中访问
+    std::unordered_map<uint32_t, std::string> names_;
+};
+
+} // namespace
+
+std::unique_ptr<KernelProcessEventSource> CreateKernelProcessEventSource() {
+    return std::make_unique<NetlinkProcessEventSource>();
+}
+
+} // namespace sysmonitor
+
+#else
+
+namespace sysmonitor {
+
+std::unique_ptr<KernelProcessEventSource> CreateKernelProcessEventSource() {
+    return nullptr;
+}
+
+} // namespace sysmonitor
+
+#endif // __linux__
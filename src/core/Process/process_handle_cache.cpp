@@ -0,0 +1,91 @@
+#include "process_handle_cache.h"
+
+namespace sysmonitor {
+
+ProcessHandleCache::Entry* ProcessHandleCache::Acquire(uint32_t pid) {
+    auto it = entries_.find(pid);
+    if (it == entries_.end()) {
+        it = entries_.emplace(pid, Entry{}).first;
+        return OpenInto(pid, it->second);
+    }
+
+    Entry& entry = it->second;
+    entry.lastSeenScan = scan_;
+    if (entry.handle != ProcessAccess::kInvalidHandle) {
+        ++stats_.hits;
+        return &entry;
+    }
+
+    // 之前打开失败：隔 kRetryScans 轮再试
+    if (scan_ - entry.openedScan < kRetryScans) {
+        return nullptr;
+    }
+    return OpenInto(pid, entry);
+}
+
+ProcessHandleCache::Entry* ProcessHandleCache::Reopen(uint32_t pid) {
+    auto it = entries_.find(pid);
+    if (it == entries_.end()) {
+        return Acquire(pid);
+    }
+
+    Entry& entry = it->second;
+    if (entry.handle != ProcessAccess::kInvalidHandle) {
+        access_.Close(entry.handle);
+        entry.handle = ProcessAccess::kInvalidHandle;
+    }
+    ++stats_.reopened;
+    return OpenInto(pid, entry);
+}
+
+ProcessHandleCache::Entry* ProcessHandleCache::OpenInto(uint32_t pid, Entry& entry) {
+    int64_t previousCreateTime = entry.createTime;
+    entry.lastSeenScan = scan_;
+    entry.openedScan = scan_;
+    entry.createTime = 0;
+    entry.handle = access_.Open(pid);
+    if (entry.handle == ProcessAccess::kInvalidHandle) {
+        ++stats_.openFailures;
+        entry.attributes = StaticAttributes();
+        return nullptr;
+    }
+
+    ++stats_.opens;
+    ProcessTimes times;
+    if (access_.QueryTimes(entry.handle, times)) {
+        entry.createTime = times.createTime;
+    }
+    // 同一进程的句柄重开时保留已缓存的属性，pid 被复用时丢弃
+    if (entry.createTime == 0 || entry.createTime != previousCreateTime) {
+        entry.attributes = StaticAttributes();
+    }
+    return &entry;
+}
+
+size_t ProcessHandleCache::EndScan() {
+    size_t closed = 0;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.lastSeenScan == scan_) {
+            ++it;
+            continue;
+        }
+        if (it->second.handle != ProcessAccess::kInvalidHandle) {
+            access_.Close(it->second.handle);
+            ++stats_.evicted;
+        }
+        it = entries_.erase(it);
+        ++closed;
+    }
+    return closed;
+}
+
+void ProcessHandleCache::Clear() {
+    for (auto& [pid, entry] : entries_) {
+        if (entry.handle != ProcessAccess::kInvalidHandle) {
+            access_.Close(entry.handle);
+        }
+    }
+    entries_.clear();
+}
+
+} // namespace sysmonitor
@@ -0,0 +1,75 @@
+#pragma once
+#include "process_access.h"
+#include <unordered_map>
+
+namespace sysmonitor {
+
+/**
+ * @brief 跨刷新周期复用的进程句柄表，按 (pid, createTime) 标识进程
+ *
+ * 每轮采集：BeginScan() → 对枚举到的每个 pid 调用 Acquire() → EndScan()。
+ * 进程只在第一次出现时打开一次；本轮未出现的 pid（已退出）在 EndScan 中关闭。
+ * 打开失败的 pid 会被记住，kRetryScans 轮后再尝试，避免每轮都对无权限进程发起内核调用。
+ * 缓存项同时保存路径、命令行、用户名等不变属性，createTime 变化（pid 被复用）时一并丢弃。
+ * 非线程安全，由调用方加锁。
+ */
+class ProcessHandleCache {
+public:
+    static constexpr uint32_t kRetryScans = 8;
+
+    // 进程生命周期内不变的属性，只在首次出现时查询
+    struct StaticAttributes {
+        bool loaded = false;
+        std::string fullPath;
+        std::string commandLine;
+        std::string username;
+    };
+
+    struct Entry {
+        ProcessAccess::Handle handle = ProcessAccess::kInvalidHandle;
+        int64_t createTime = 0;     // 打开时读取，0 表示未知
+        uint64_t lastSeenScan = 0;
+        uint64_t openedScan = 0;
+        StaticAttributes attributes;
+    };
+
+    struct Stats {
+        uint64_t opens = 0;         // 成功打开
+        uint64_t openFailures = 0;
+        uint64_t hits = 0;          // 复用已打开的句柄
+        uint64_t reopened = 0;      // pid 被复用（createTime 变化）或句柄失效后重新打开
+        uint64_t evicted = 0;       // 进程退出后关闭
+    };
+
+    explicit ProcessHandleCache(ProcessAccess& access) : access_(access) {}
+    ~ProcessHandleCache() { Clear(); }
+
+    ProcessHandleCache(const ProcessHandleCache&) = delete;
+    ProcessHandleCache& operator=(const ProcessHandleCache&) = delete;
+
+    void BeginScan() { ++scan_; }
+
+    // 返回 pid 的缓存项；无法打开时返回 nullptr
+    Entry* Acquire(uint32_t pid);
+
+    // 调用方发现句柄已失效或 createTime 与缓存不一致时调用，关闭后重新打开
+    Entry* Reopen(uint32_t pid);
+
+    // 关闭本轮未出现的进程句柄，返回关闭数量
+    size_t EndScan();
+
+    void Clear();
+
+    size_t Size() const { return entries_.size(); }
+    const Stats& GetStats() const { return stats_; }
+
+private:
+    Entry* OpenInto(uint32_t pid, Entry& entry);
+
+    ProcessAccess& access_;
+    std::unordered_map<uint32_t, Entry> entries_;
+    uint64_t scan_ = 0;
+    Stats stats_;
+};
+
+} // namespace sysmonitor
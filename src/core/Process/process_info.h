@@ -0,0 +1,75 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "process_access.h"
+
+namespace sysmonitor {
+
+struct ProcessInfo {
+    uint32_t pid;
+    uint32_t parentPid;
+    std::string name;
+    std::string fullPath;
+    std::string state;
+    std::string username;
+    double cpuUsage;           // CPU usage percentage
+    uint64_t memoryUsage;      // Memory usage (bytes)
+    uint64_t workingSetSize;   // Working set size (bytes)
+    uint64_t pagefileUsage;    // Pagefile usage (bytes)
+    int64_t createTime;        // Creation timestamp
+    int32_t priority;          // Process priority
+    int32_t threadCount;       // Thread count
+    std::string commandLine;   // Command line parameters
+    uint32_t handleCount;      // 句柄数
+    uint32_t gdiCount;         // GDI对象数
+    uint32_t userCount;        // USER对象数
+
+    // I/O、缺页、上下文切换：累计值与最近两次采样之间的每秒速率
+    ProcessCounters counters;
+    double readBytesPerSec = 0.0;
+    double writeBytesPerSec = 0.0;
+    double readOpsPerSec = 0.0;
+    double writeOpsPerSec = 0.0;
+    double minorFaultsPerSec = 0.0;
+    double majorFaultsPerSec = 0.0;
+    double voluntaryCtxSwitchesPerSec = 0.0;
+    double involuntaryCtxSwitchesPerSec = 0.0;
+    
+    ProcessInfo() 
+        : pid(0), parentPid(0), cpuUsage(0.0),
+          memoryUsage(0), workingSetSize(0), pagefileUsage(0),
+          createTime(0), priority(0), threadCount(0),
+          handleCount(0), gdiCount(0), userCount(0) {}
+};
+
+struct ProcessSnapshot {
+    std::vector<ProcessInfo> processes;
+    uint64_t timestamp;
+    uint32_t totalProcesses;
+    uint32_t totalThreads;
+    uint32_t totalHandles;     // 总句柄数
+    uint32_t totalGdiObjects;  // 总GDI对象数
+    uint32_t totalUserObjects; // 总USER对象数
+};
+
+struct ThreadInfo {
+    uint32_t tid = 0;
+    std::string name;
+    std::string state;
+    int32_t priority = 0;
+    uint64_t kernelTime = 0;        // 累计，100ns
+    uint64_t userTime = 0;
+    uint64_t kernelTimeDelta = 0;   // 与上次采样之差
+    uint64_t userTimeDelta = 0;
+    double cpuUsage = 0.0;          // 占单个逻辑核心的百分比，100 表示占满一个核心
+};
+
+struct ThreadSnapshot {
+    uint32_t pid = 0;
+    uint64_t timestamp = 0;
+    uint64_t intervalMs = 0;        // 计算差值所用的采样间隔
+    std::vector<ThreadInfo> threads;   // 按 cpuUsage 从高到低
+};
+
+} // namespace sysmonitor
@@ -0,0 +1,167 @@
+#include "process_leaks.h"
+#include <algorithm>
+#include <cmath>
+
+namespace sysmonitor {
+
+namespace {
+
+struct LeakMetricInfo {
+    LeakMetric metric;
+    const char* name;
+};
+
+// 与 LeakMetric 的声明顺序一致
+constexpr LeakMetricInfo kLeakMetrics[kLeakMetricCount] = {
+    {LeakMetric::Handles, "handles"},
+    {LeakMetric::GdiObjects, "gdi"},
+    {LeakMetric::UserObjects, "user"},
+    {LeakMetric::WorkingSet, "memory"},
+};
+
+// 残差为 0（严格线性增长）时的 t 统计量
+constexpr double kMaxTStat = 1e6;
+
+} // namespace
+
+bool ParseLeakMetric(const std::string& text, LeakMetric& metric) {
+    for (const auto& info : kLeakMetrics) {
+        if (text == info.name) {
+            metric = info.metric;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* LeakMetricName(LeakMetric metric) {
+    return kLeakMetrics[static_cast<size_t>(metric)].name;
+}
+
+// 旧样本的权重先乘以 decay，再加入权重为 1 的新样本
+void LeakDetector::Regression::Add(double x, double y, double decay) {
+    weight = decay * weight + 1.0;
+    weightSquared = decay * decay * weightSquared + 1.0;
+    const double dx = x - meanX;
+    const double dy = y - meanY;
+    meanX += dx / weight;
+    meanY += dy / weight;
+    cxx = decay * cxx + dx * (x - meanX);
+    cxy = decay * cxy + dx * (y - meanY);
+    cyy = decay * cyy + dy * (y - meanY);
+}
+
+LeakDetector::LeakDetector(const LeakDetectorOptions& options) : options_(options) {
+}
+
+void LeakDetector::SetOptions(const LeakDetectorOptions& options) {
+    options_ = options;
+    states_.clear();
+}
+
+void LeakDetector::Observe(const ProcessTable& table) {
+    ++generation_;
+    const uint64_t now = table.timestamp;
+    const double window = std::max(options_.windowSeconds, 1.0);
+
+    for (size_t row = 0; row < table.Size(); ++row) {
+        ProcessState& state = states_[table.pid[row]];
+        if (state.generation == 0 || state.createTime != table.createTime[row]) {
+            state = ProcessState();
+            state.createTime = table.createTime[row];
+            state.firstTimestamp = now;
+            state.lastTimestamp = now;
+            state.name = table.Name(row);
+        }
+        if (now < state.lastTimestamp) {
+            continue;   // 时钟回拨，跳过本次样本
+        }
+
+        const double dt = static_cast<double>(now - state.lastTimestamp) / 1000.0;
+        const double decay = std::exp(-dt / window);
+        const double x = static_cast<double>(now - state.firstTimestamp) / 1000.0;
+        state.last[0] = static_cast<double>(table.handleCount[row]);
+        state.last[1] = static_cast<double>(table.gdiCount[row]);
+        state.last[2] = static_cast<double>(table.userCount[row]);
+        state.last[3] = static_cast<double>(table.workingSetSize[row]);
+        for (size_t m = 0; m < kLeakMetricCount; ++m) {
+            state.regressions[m].Add(x, state.last[m], decay);
+        }
+        state.lastTimestamp = now;
+        state.generation = generation_;
+    }
+
+    for (auto it = states_.begin(); it != states_.end();) {
+        if (it->second.generation != generation_) {
+            it = states_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool LeakDetector::Evaluate(const ProcessState& state, size_t metric, LeakSuspect& out) const {
+    const Regression& r = state.regressions[metric];
+    const double trackedSeconds = static_cast<double>(state.lastTimestamp - state.firstTimestamp) / 1000.0;
+    const double samples = r.EffectiveSamples();
+    if (trackedSeconds < options_.windowSeconds / 2 || samples < 3.0 || r.cxx <= 0.0) {
+        return false;
+    }
+
+    const double slope = r.Slope();
+    const double minGrowth = kLeakMetrics[metric].metric == LeakMetric::WorkingSet ? options_.minGrowthBytes
+                                                                                   : options_.minGrowthCount;
+    if (slope <= 0.0 || slope * options_.windowSeconds < minGrowth) {
+        return false;
+    }
+
+    // 斜率标准误：se² = SSE / (Sxx · (n - 2))，加权时 n 取有效样本数
+    const double sse = std::max(r.cyy - slope * r.cxy, 0.0);
+    const double tStat = sse > 0.0 ? std::min(slope / std::sqrt(sse / (r.cxx * (samples - 2.0))), kMaxTStat)
+                                   : kMaxTStat;
+    if (tStat < options_.minTStat) {
+        return false;
+    }
+
+    out.metric = kLeakMetrics[metric].metric;
+    out.current = state.last[metric];
+    out.slopePerHour = slope * 3600.0;
+    out.tStat = tStat;
+    out.rSquared = r.cyy > 0.0 ? r.cxy * r.cxy / (r.cxx * r.cyy) : 1.0;
+    out.effectiveSamples = samples;
+    out.trackedSeconds = trackedSeconds;
+    return true;
+}
+
+std::vector<LeakSuspect> LeakDetector::Suspects(const std::vector<LeakMetric>& metrics, size_t n) const {
+    bool wanted[kLeakMetricCount] = {};
+    for (size_t m = 0; m < kLeakMetricCount; ++m) {
+        wanted[m] = metrics.empty() ||
+                    std::find(metrics.begin(), metrics.end(), kLeakMetrics[m].metric) != metrics.end();
+    }
+
+    std::vector<LeakSuspect> suspects;
+    for (const auto& [pid, state] : states_) {
+        for (size_t m = 0; m < kLeakMetricCount; ++m) {
+            LeakSuspect suspect;
+            if (wanted[m] && Evaluate(state, m, suspect)) {
+                suspect.pid = pid;
+                suspect.name = state.name;
+                suspects.push_back(std::move(suspect));
+            }
+        }
+    }
+
+    auto byTStat = [](const LeakSuspect& a, const LeakSuspect& b) {
+        return a.tStat != b.tStat ? a.tStat > b.tStat : a.pid < b.pid;
+    };
+    if (suspects.size() > n) {
+        std::partial_sort(suspects.begin(), suspects.begin() + n, suspects.end(), byTStat);
+        suspects.resize(n);
+    } else {
+        std::sort(suspects.begin(), suspects.end(), byTStat);
+    }
+    return suspects;
+}
+
+} // namespace sysmonitor
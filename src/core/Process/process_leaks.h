@@ -0,0 +1,97 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "process_table.h"
+
+namespace sysmonitor {
+
+// 泄漏检测的计数
+enum class LeakMetric {
+    Handles,       // handleCount（Linux 为打开的文件描述符数）
+    GdiObjects,    // gdiCount
+    UserObjects,   // userCount
+    WorkingSet,    // workingSetSize（bytes）
+};
+
+constexpr size_t kLeakMetricCount = 4;
+
+bool ParseLeakMetric(const std::string& text, LeakMetric& metric);
+const char* LeakMetricName(LeakMetric metric);
+
+struct LeakDetectorOptions {
+    double windowSeconds = 600.0;   // 回归的时间常数，更早的样本按 e^(-Δt/window) 衰减
+    double minTStat = 3.0;          // 斜率的 t 统计量下限
+    // 一个窗口内的最小增长量，低于该值的缓慢增长不报告
+    double minGrowthCount = 20.0;             // 句柄 / GDI / USER
+    double minGrowthBytes = 16.0 * 1024 * 1024;   // 工作集
+};
+
+struct LeakSuspect {
+    uint32_t pid = 0;
+    std::string name;
+    LeakMetric metric = LeakMetric::Handles;
+    double current = 0.0;          // 最近一次采样值
+    double slopePerHour = 0.0;
+    double tStat = 0.0;
+    double rSquared = 0.0;
+    double effectiveSamples = 0.0;
+    double trackedSeconds = 0.0;
+};
+
+/**
+ * @brief 在线泄漏检测：每个进程、每种计数维护一份指数遗忘的线性回归状态
+ *
+ * 每次采样 O(1) 更新加权均值与协方差（West 增量算法），不保存历史样本。
+ * 跟踪时长达到半个窗口、斜率为正且 t 统计量与窗口内增长量都超过阈值时，判定为疑似泄漏。
+ * pid 复用（createTime 变化）时重新开始。
+ */
+class LeakDetector {
+public:
+    explicit LeakDetector(const LeakDetectorOptions& options = LeakDetectorOptions());
+
+    void SetOptions(const LeakDetectorOptions& options);
+    LeakDetectorOptions GetOptions() const { return options_; }
+
+    // 每份进程表调用一次，同时清除已退出进程的状态
+    void Observe(const ProcessTable& table);
+
+    // 按 t 统计量从高到低；metrics 为空表示全部
+    std::vector<LeakSuspect> Suspects(const std::vector<LeakMetric>& metrics, size_t n) const;
+
+    size_t TrackedProcesses() const { return states_.size(); }
+
+private:
+    struct Regression {
+        double weight = 0.0;           // Σw
+        double weightSquared = 0.0;    // Σw²，用于有效样本数
+        double meanX = 0.0;
+        double meanY = 0.0;
+        double cxx = 0.0;
+        double cxy = 0.0;
+        double cyy = 0.0;
+
+        void Add(double x, double y, double decay);
+        double Slope() const { return cxx > 0.0 ? cxy / cxx : 0.0; }
+        double EffectiveSamples() const { return weightSquared > 0.0 ? weight * weight / weightSquared : 0.0; }
+    };
+
+    struct ProcessState {
+        int64_t createTime = 0;
+        uint64_t firstTimestamp = 0;   // 毫秒
+        uint64_t lastTimestamp = 0;
+        uint64_t generation = 0;
+        double last[kLeakMetricCount] = {};
+        Regression regressions[kLeakMetricCount];
+        std::string name;
+    };
+
+    bool Evaluate(const ProcessState& state, size_t metric, LeakSuspect& out) const;
+
+    LeakDetectorOptions options_;
+    std::unordered_map<uint32_t, ProcessState> states_;
+    uint64_t generation_ = 0;
+};
+
+} // namespace sysmonitor
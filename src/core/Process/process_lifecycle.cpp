@@ -0,0 +1,195 @@
+#include "process_lifecycle.h"
+#include <algorithm>
+#include <iostream>
+#include "../../utils/util_time.h"
+
+namespace sysmonitor {
+
+const char* ProcessEventTypeName(ProcessEventType type) {
+    switch (type) {
+    case ProcessEventType::Start: return "start";
+    case ProcessEventType::Exit: return "exit";
+    case ProcessEventType::Exec: return "exec";
+    }
+    return "unknown";
+}
+
+const char* ProcessEventSourceName(ProcessEventSource source) {
+    return source == ProcessEventSource::Kernel ? "kernel" : "scan";
+}
+
+ProcessEventJournal::ProcessEventJournal(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {
+    auto& registry = metrics::Registry::Instance();
+    const char* droppedHelp = "Process lifecycle events lost, by reason";
+    publishedCounter_ = &registry.GetCounter("sysmon_process_events_total", "Process lifecycle events journaled", {});
+    evictedCounter_ = &registry.GetCounter("sysmon_process_events_dropped_total", droppedHelp, {{"reason", "evicted"}});
+    readerDroppedCounter_ = &registry.GetCounter("sysmon_process_events_dropped_total", droppedHelp, {{"reason", "reader"}});
+    sourceDroppedCounter_ = &registry.GetCounter("sysmon_process_events_dropped_total", droppedHelp, {{"reason", "source"}});
+}
+
+void ProcessEventJournal::Append(ProcessEvent event) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    event.seq = nextSeq_++;
+    if (events_.size() == capacity_) {
+        events_.pop_front();
+        ++stats_.evicted;
+        evictedCounter_->Add();
+    }
+    events_.push_back(std::move(event));
+    ++stats_.published;
+    publishedCounter_->Add();
+}
+
+void ProcessEventJournal::RecordSourceDropped(uint64_t count) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    stats_.sourceDropped += count;
+    sourceDroppedCounter_->Add(count);
+}
+
+uint64_t ProcessEventJournal::ReadSince(uint64_t afterSeq, size_t maxEvents, std::vector<ProcessEvent>& out) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (events_.empty()) {
+        return 0;
+    }
+    const uint64_t firstSeq = events_.front().seq;
+    const uint64_t lastSeq = events_.back().seq;
+
+    // 0 或大于最新序号（服务重启前的序号）都视为新读者，从最旧的事件开始，不计丢失
+    uint64_t missed = 0;
+    if (afterSeq == 0 || afterSeq > lastSeq) {
+        afterSeq = firstSeq - 1;
+    } else if (afterSeq + 1 < firstSeq) {
+        missed = firstSeq - afterSeq - 1;
+        stats_.readerDropped += missed;
+        readerDroppedCounter_->Add(missed);
+        afterSeq = firstSeq - 1;
+    }
+
+    size_t index = static_cast<size_t>(afterSeq + 1 - firstSeq);
+    size_t count = std::min(maxEvents, events_.size() - index);
+    out.insert(out.end(), events_.begin() + index, events_.begin() + index + count);
+    return missed;
+}
+
+ProcessEventJournal::Stats ProcessEventJournal::GetStats() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    Stats stats = stats_;
+    stats.firstSeq = events_.empty() ? 0 : events_.front().seq;
+    stats.lastSeq = nextSeq_ - 1;
+    return stats;
+}
+
+ProcessLifecycleTracker::ProcessLifecycleTracker(size_t journalCapacity) : journal_(journalCapacity) {
+}
+
+ProcessLifecycleTracker::~ProcessLifecycleTracker() {
+    DisableKernelEvents();
+}
+
+void ProcessLifecycleTracker::Observe(std::shared_ptr<const ProcessTable> table) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    std::shared_ptr<const ProcessTable> previous = std::move(previous_);
+    previous_ = table;
+    if (!previous) {
+        return;
+    }
+    // 内核事件源正常时不比较；溢出后比较一次，补上被丢弃的启动/退出事件
+    if (kernelSource_ && !resyncPending_.exchange(false)) {
+        return;
+    }
+
+    const ProcessTable& before = *previous;
+    const ProcessTable& after = *table;
+    auto sameProcess = [](const ProcessTable& t, size_t row, const ProcessTable& other, size_t& otherRow) {
+        return other.FindRow(t.pid[row], otherRow) && other.createTime[otherRow] == t.createTime[row];
+    };
+
+    size_t other = 0;
+    for (size_t row = 0; row < before.Size(); ++row) {
+        if (sameProcess(before, row, after, other)) continue;
+        ProcessEvent event;
+        event.timestamp = after.timestamp;
+        event.type = ProcessEventType::Exit;
+        event.pid = before.pid[row];
+        event.parentPid = before.parentPid[row];
+        event.createTime = before.createTime[row];
+        event.name = before.Name(row);
+        journal_.Append(std::move(event));
+    }
+    for (size_t row = 0; row < after.Size(); ++row) {
+        if (sameProcess(after, row, before, other)) continue;
+        ProcessEvent event;
+        event.timestamp = after.timestamp;
+        event.type = ProcessEventType::Start;
+        event.pid = after.pid[row];
+        event.parentPid = after.parentPid[row];
+        event.createTime = after.createTime[row];
+        event.name = after.Name(row);
+        journal_.Append(std::move(event));
+    }
+}
+
+bool ProcessLifecycleTracker::EnableKernelEvents() {
+    if (KernelEventsActive()) {
+        return true;
+    }
+    return EnableKernelEvents(CreateKernelProcessEventSource());
+}
+
+bool ProcessLifecycleTracker::EnableKernelEvents(std::unique_ptr<KernelProcessEventSource> source) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (kernelSource_) {
+        return true;
+    }
+    if (!source) {
+        return false;
+    }
+    resyncPending_ = false;
+    bool started = source->Start([this](const ProcessEvent& event) { OnKernelEvent(event); },
+                                 [this] {
+                                     journal_.RecordSourceDropped(1);
+                                     resyncPending_ = true;
+                                 });
+    if (!started) {
+        std::cerr << "Kernel process events unavailable, falling back to snapshot diff" << std::endl;
+        return false;
+    }
+    kernelSource_ = std::move(source);
+    return true;
+}
+
+void ProcessLifecycleTracker::DisableKernelEvents() {
+    std::unique_ptr<KernelProcessEventSource> source;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        source = std::move(kernelSource_);
+    }
+    // 回调会获取 mutex_，在锁外停止事件源线程
+    if (source) {
+        source->Stop();
+    }
+}
+
+bool ProcessLifecycleTracker::KernelEventsActive() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return kernelSource_ != nullptr;
+}
+
+void ProcessLifecycleTracker::OnKernelEvent(const ProcessEvent& event) {
+    ProcessEvent copy = event;
+    copy.source = ProcessEventSource::Kernel;
+    if (copy.timestamp == 0) {
+        copy.timestamp = GET_LOCAL_TIME_MS();
+    }
+    // 事件源启动前已存在的进程没有名称，从最近一份进程表补全
+    if (copy.name.empty()) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        size_t row = 0;
+        if (previous_ && previous_->FindRow(copy.pid, row)) {
+            copy.name = previous_->Name(row);
+        }
+    }
+    journal_.Append(std::move(copy));
+}
+
+} // namespace sysmonitor
@@ -0,0 +1,137 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include "process_table.h"
+#include "../../utils/metrics.h"
+
+namespace sysmonitor {
+
+enum class ProcessEventType {
+    Start,
+    Exit,
+    Exec,      // 仅内核事件源
+};
+
+enum class ProcessEventSource {
+    Scan,      // 相邻两次采集按 (pid, createTime) 比较得出
+    Kernel,    // Linux netlink 进程连接器
+};
+
+struct ProcessEvent {
+    uint64_t seq = 0;              // 日志分配的递增序号，从 1 开始
+    uint64_t timestamp = 0;        // 毫秒
+    ProcessEventType type = ProcessEventType::Start;
+    ProcessEventSource source = ProcessEventSource::Scan;
+    uint32_t pid = 0;
+    uint32_t parentPid = 0;
+    int64_t createTime = 0;        // 100ns，FILETIME 纪元；未知时为 0
+    int32_t exitCode = 0;          // 仅内核 Exit 事件
+    std::string name;
+};
+
+const char* ProcessEventTypeName(ProcessEventType type);
+const char* ProcessEventSourceName(ProcessEventSource source);
+
+/**
+ * @brief 有界事件日志：环形保存最近 capacity 条事件，读者按序号增量读取
+ *
+ * 写满后覆盖最旧的事件；读者给出的序号已被覆盖时，缺失的条数计入 readerDropped。
+ * 各计数同时累加到 sysmon_process_events_total / sysmon_process_events_dropped_total。
+ */
+class ProcessEventJournal {
+public:
+    struct Stats {
+        uint64_t published = 0;       // 写入的事件总数
+        uint64_t evicted = 0;         // 因容量被覆盖的事件
+        uint64_t readerDropped = 0;   // 读者来不及读取而错过的事件
+        uint64_t sourceDropped = 0;   // 事件源自身丢弃（如内核套接字缓冲区溢出）
+        uint64_t firstSeq = 0;        // 当前保留的最旧序号，为空时为 0
+        uint64_t lastSeq = 0;         // 最近写入的序号
+    };
+
+    explicit ProcessEventJournal(size_t capacity = 4096);
+
+    void Append(ProcessEvent event);
+    void RecordSourceDropped(uint64_t count);
+
+    // 读取序号大于 afterSeq 的事件，最多 maxEvents 条；返回因覆盖而错过的条数
+    uint64_t ReadSince(uint64_t afterSeq, size_t maxEvents, std::vector<ProcessEvent>& out);
+
+    Stats GetStats() const;
+
+private:
+    mutable std::mutex mutex_;
+    size_t capacity_;
+    std::deque<ProcessEvent> events_;
+    uint64_t nextSeq_ = 1;
+    Stats stats_;
+
+    metrics::Counter* publishedCounter_;
+    metrics::Counter* evictedCounter_;
+    metrics::Counter* readerDroppedCounter_;
+    metrics::Counter* sourceDroppedCounter_;
+};
+
+// 内核进程事件源，回调在事件源自己的线程中调用
+class KernelProcessEventSource {
+public:
+    using Callback = std::function<void(const ProcessEvent&)>;
+    // 接收缓冲区溢出等原因丢失了事件（条数未知，按一次计）
+    using OverrunCallback = std::function<void()>;
+
+    virtual ~KernelProcessEventSource() = default;
+
+    // 订阅失败（权限不足、内核不支持）时返回 false
+    virtual bool Start(Callback callback, OverrunCallback onOverrun) = 0;
+    virtual void Stop() = 0;
+};
+
+// 当前平台不支持时返回 nullptr
+std::unique_ptr<KernelProcessEventSource> CreateKernelProcessEventSource();
+
+/**
+ * @brief 进程生命周期跟踪：比较相邻两份进程表得到启动/退出事件，写入有界日志
+ *
+ * 启用内核事件源后改用其 fork/exec/exit 事件，不再比较进程表（短命进程也不会漏掉）。
+ * 事件源报告溢出（内核丢弃了事件）后，下一次 Observe 比较一次相邻进程表补齐，
+ * 补出的事件标记为 Scan 来源，可能与溢出前后收到的内核事件重复，按 (pid, createTime) 去重。
+ */
+class ProcessLifecycleTracker {
+public:
+    explicit ProcessLifecycleTracker(size_t journalCapacity = 4096);
+    ~ProcessLifecycleTracker();
+
+    ProcessLifecycleTracker(const ProcessLifecycleTracker&) = delete;
+    ProcessLifecycleTracker& operator=(const ProcessLifecycleTracker&) = delete;
+
+    // 每发布一份进程表调用一次；第一份只作为基准
+    void Observe(std::shared_ptr<const ProcessTable> table);
+
+    bool EnableKernelEvents();
+    // 使用给定的事件源（测试注入）；source 为空或启动失败时返回 false
+    bool EnableKernelEvents(std::unique_ptr<KernelProcessEventSource> source);
+    void DisableKernelEvents();
+    bool KernelEventsActive() const;
+
+    uint64_t ReadSince(uint64_t afterSeq, size_t maxEvents, std::vector<ProcessEvent>& out) {
+        return journal_.ReadSince(afterSeq, maxEvents, out);
+    }
+    ProcessEventJournal::Stats GetStats() const { return journal_.GetStats(); }
+
+private:
+    void OnKernelEvent(const ProcessEvent& event);
+
+    ProcessEventJournal journal_;
+    mutable std::mutex mutex_;
+    std::shared_ptr<const ProcessTable> previous_;
+    std::unique_ptr<KernelProcessEventSource> kernelSource_;
+    std::atomic<bool> resyncPending_{false};   // 事件源溢出后待比较一次进程表
+};
+
+} // namespace sysmonitor
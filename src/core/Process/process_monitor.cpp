@@ -1,28 +1,37 @@
 #include "process_monitor.h"
-#include <windows.h>
-#include <tlhelp32.h>
-#include <psapi.h>
-#include <wtsapi32.h>
-#include <sddl.h>
+#include "process_tree.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
-#include <iomanip>
-#include <sstream>
-#include <comdef.h>
-#include <wbemidl.h>
-
-#pragma comment(lib, "psapi.lib")
-#pragma comment(lib, "wtsapi32.lib")
-#pragma comment(lib, "wbemuuid.lib")
-#pragma comment(lib, "advapi32.lib")
-#pragma comment(lib, "user32.lib")
+#include <thread>
+#include "../../utils/metrics.h"
 
 namespace sysmonitor {
 
-ProcessMonitor::ProcessMonitor() : lastSystemTime_(0) {
+namespace {
+
+// 首次查询某进程的线程时，两次采样之间的间隔
+constexpr int kThreadWarmupMs = 100;
+// 基准超过该时长视为过期，重新预热
+constexpr uint64_t kThreadBaselineMaxAge100ns = 60ULL * 10000000ULL;
+
+uint64_t SteadyTime100ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count()) * 10;
+}
+
+} // namespace
+
+ProcessMonitor::ProcessMonitor() : ProcessMonitor(CreateDefaultProcessAccess()) {
+}
+
+ProcessMonitor::ProcessMonitor(std::unique_ptr<ProcessAccess> access)
+    : access_(std::move(access)), handleCache_(*access_) {
     Initialize();
 }
 
 ProcessMonitor::~ProcessMonitor() {
+    StopSampling();
     Cleanup();
 }
 
@@ -31,413 +40,451 @@ bool ProcessMonitor::Initialize() {
 }
 
 void ProcessMonitor::Cleanup() {
-    processCpuData_.clear();
+    std::lock_guard<std::mutex> lk(mutex_);
+    handleCache_.Clear();
+    accountNames_.Clear();
+    processSamples_.clear();
+}
+
+void ProcessMonitor::StartSampling(PeriodicScheduler& scheduler, int intervalMs) {
+    if (isSampling_) return;
+
+    Refresh();
+    isSampling_ = true;
+    scheduler_ = &scheduler;
+    samplingTask_ = scheduler.Schedule("process", static_cast<uint32_t>(intervalMs), [this] {
+        try {
+            Refresh();
+        } catch (const std::exception& e) {
+            std::cerr << "Process sampling failed: " << e.what() << std::endl;
+        }
+    });
+}
+
+void ProcessMonitor::StopSampling() {
+    if (!isSampling_.exchange(false)) return;
+    scheduler_->Cancel(samplingTask_);
+    samplingTask_ = PeriodicScheduler::kInvalidTask;
+}
+
+std::shared_ptr<const ProcessTable> ProcessMonitor::GetLatestTable() {
+    if (isSampling_) {
+        if (auto table = std::atomic_load(&latest_)) {
+            return table;
+        }
+    }
+    return Refresh();
 }
 
 ProcessSnapshot ProcessMonitor::GetProcessSnapshot() {
-    ProcessSnapshot snapshot;
-    snapshot.timestamp = GET_LOCAL_TIME_MS();
-    
-    // Use ToolHelp API to get process list (most reliable method)
-    auto processes = GetProcessesViaToolHelp();
-    snapshot.processes = std::move(processes);
-    snapshot.totalProcesses = static_cast<uint32_t>(snapshot.processes.size());
-    
-    // Calculate total thread count and handle statistics
-    snapshot.totalThreads = 0;
-    snapshot.totalHandles = 0;
-    snapshot.totalGdiObjects = 0;
-    snapshot.totalUserObjects = 0;
-    
-    for (const auto& process : snapshot.processes) {
-        snapshot.totalThreads += process.threadCount;
-        snapshot.totalHandles += process.handleCount;
-        snapshot.totalGdiObjects += process.gdiCount;
-        snapshot.totalUserObjects += process.userCount;
+    return GetLatestTable()->ToSnapshot();
+}
+
+std::shared_ptr<const ProcessTable> ProcessMonitor::Refresh() {
+    SYSMON_TIME_COLLECTOR("GetProcessSnapshot");
+
+    // 采集、发布与生命周期/泄漏观察必须按同一顺序完成：
+    // 否则并发的两次刷新可能让较旧的表覆盖 latest_，或让 lifecycle_ 看到时间倒退的表
+    std::lock_guard<std::mutex> refreshLock(refreshMutex_);
+
+    auto published = std::make_shared<ProcessTable>();
+    published->timestamp = GET_LOCAL_TIME_MS();
+
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        CollectProcesses(*published);
+    }
+    // 索引只依赖本表数据，在 mutex_ 外建立，不阻塞句柄/线程查询
+    published->BuildIndexes();
+    published->tree = std::make_shared<const ProcessTree>(ProcessTree::Build(*published));
+
+    std::shared_ptr<const ProcessTable> result = std::move(published);
+    std::atomic_store(&latest_, result);
+    lifecycle_.Observe(result);
+    {
+        std::lock_guard<std::mutex> lk(leaksMutex_);
+        leaks_.Observe(*result);
+    }
+    return result;
+}
+
+ProcessHandleCache::Entry* ProcessMonitor::AcquireHandle(uint32_t pid, ProcessTimes* times) {
+    ProcessTimes local;
+    ProcessTimes& t = times ? *times : local;
+
+    ProcessHandleCache::Entry* entry = handleCache_.Acquire(pid);
+    if (!entry) {
+        return nullptr;
     }
-    
-    return snapshot;
-}
-
-std::vector<ProcessInfo> ProcessMonitor::GetProcessesViaToolHelp() {
-    std::vector<ProcessInfo> processes;
-    
-    // Create process snapshot
-    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS | TH32CS_SNAPMODULE, 0);
-    if (snapshot == INVALID_HANDLE_VALUE) {
-        std::cerr << "Failed to create process snapshot: " << GetLastError() << std::endl;
-        return processes;
+    if (access_->QueryTimes(entry->handle, t) && (entry->createTime == 0 || t.createTime == entry->createTime)) {
+        return entry;
     }
-    
-    PROCESSENTRY32 processEntry;
-    processEntry.dwSize = sizeof(PROCESSENTRY32);
-    
-    // Iterate through all processes
-    if (Process32First(snapshot, &processEntry)) {
-        do {
-            ProcessInfo info;
-            info.pid = processEntry.th32ProcessID;
-            info.parentPid = processEntry.th32ParentProcessID;
-            info.name = processEntry.szExeFile;
-            info.threadCount = processEntry.cntThreads;
-            info.priority = processEntry.pcPriClassBase;
-            
-            // Get more detailed information
-            HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, 
-                                         FALSE, processEntry.th32ProcessID);
-            
-            if (hProcess) {
-                // Get process path
-                char path[MAX_PATH];
-                if (GetModuleFileNameExA(hProcess, NULL, path, MAX_PATH)) {
-                    info.fullPath = path;
-                }
-                
-                // Get memory information
-                // 修复：安全地获取内存信息
-                PROCESS_MEMORY_COUNTERS pmc;
-                ZeroMemory(&pmc, sizeof(pmc));
-                pmc.cb = sizeof(pmc);
-                
-                if (GetProcessMemoryInfo(hProcess, &pmc, sizeof(pmc))) {
-                    info.memoryUsage = pmc.WorkingSetSize;
-                    info.workingSetSize = pmc.WorkingSetSize;
-                    info.pagefileUsage = pmc.PagefileUsage;
-                } else {
-                    // 获取失败时记录日志
-                    DWORD error = GetLastError();
-                    std::cerr << "GetProcessMemoryInfo failed for PID " << info.pid 
-                              << ", error: " << error << std::endl;
-                    // 保持默认值0
-                }
-                
-                // Get username
-                info.username = GetProcessUsername(processEntry.th32ProcessID);
-                
-                // Get command line
-                info.commandLine = GetProcessCommandLine(processEntry.th32ProcessID);
-                
-                FILETIME createTime = {0}, exitTime = {0}, kernelTime = {0}, userTime = {0};
-                if (GetProcessTimes(hProcess, &createTime, &exitTime, &kernelTime, &userTime)) {
-                    ULARGE_INTEGER createTimeValue;
-                    createTimeValue.LowPart = createTime.dwLowDateTime;
-                    createTimeValue.HighPart = createTime.dwHighDateTime;
-                    info.createTime = createTimeValue.QuadPart;
-                } else {
-                    // 无法打开进程时，设置合理的默认值
-                    DWORD error = GetLastError();
-                    std::cerr << "OpenProcess failed for PID " << info.pid 
-                            << ", error: " << error << std::endl;
-                    
-                    info.handleCount = 0;
-                    info.gdiCount = 0;
-                    info.userCount = 0;
-                    info.cpuUsage = 0.0;
-                    info.username = "Access Denied";
-                    info.state = "Running";
-                }
-                
-                // Get handle count and GDI/USER objects
-                info.handleCount = GetProcessHandleCount1(processEntry.th32ProcessID);
-                info.gdiCount = GetProcessGdiCount(processEntry.th32ProcessID);
-                info.userCount = GetProcessUserCount(processEntry.th32ProcessID);
-                
-                // Calculate CPU usage
-                info.cpuUsage = GetProcessCpuUsage(processEntry.th32ProcessID);
-                
-                CloseHandle(hProcess);
-            } else {
-                // If cannot open process, set default values
-                info.handleCount = 0;
-                info.gdiCount = 0;
-                info.userCount = 0;
-                info.cpuUsage = 0.0;
-            }
-            
-            // Set process state
-            info.state = "Running";
-            
-            processes.push_back(info);
-            
-        } while (Process32Next(snapshot, &processEntry));
+
+    // 句柄已失效，或 pid 已被新进程复用
+    entry = handleCache_.Reopen(pid);
+    if (entry && !access_->QueryTimes(entry->handle, t)) {
+        t = ProcessTimes{};
     }
-    
-    CloseHandle(snapshot);
-    return processes;
+    return entry;
 }
 
-// 辅助函数：判断是否为系统关键进程
-bool IsCriticalSystemProcess(uint32_t pid) {
-    // 系统关键进程通常有固定的PID或名称特征
-    if (pid == 0 || pid == 4) { // System Idle Process and System process
-        return true;
+void ProcessMonitor::LoadStaticAttributes(ProcessHandleCache::Entry& entry) {
+    auto& attributes = entry.attributes;
+    attributes.fullPath = access_->QueryImagePath(entry.handle);
+    attributes.commandLine = access_->QueryCommandLine(entry.handle);
+
+    std::string userId;
+    if (access_->QueryUserId(entry.handle, userId)) {
+        attributes.username = accountNames_.Lookup(userId, [this](const std::string& id) {
+            return access_->LookupAccountName(id);
+        });
+    } else {
+        attributes.username = "SYSTEM";
     }
-    
-    // 可以根据需要添加更多系统进程判断
-        // 可以根据需要添加更多系统进程判断
-    static const std::vector<std::string> systemProcesses = {
-        "System", "Registry", "smss.exe", "csrss.exe", 
-        "wininit.exe", "services.exe", "lsass.exe", "winlogon.exe"
-    };
-    
-    return false;
+    attributes.loaded = true;
 }
 
-uint32_t ProcessMonitor::GetProcessHandleCount1(uint32_t pid) {
-    // 跳过系统关键进程（通常无法访问）
-    if (IsCriticalSystemProcess(pid)) {
-        return 0;
+// 按行号直接填写各列：数值不经过 ProcessInfo，字符串从句柄缓存项驻留到本表的字符串池，不产生临时副本
+void ProcessMonitor::CollectProcesses(ProcessTable& table) {
+    if (!access_->Enumerate(entries_)) {
+        return;
     }
-    
-    HANDLE hProcess = NULL;
-    DWORD handleCount = 0;
-    
-    // 按权限级别从低到高尝试
-    DWORD accessLevels[] = {
-        PROCESS_QUERY_LIMITED_INFORMATION,  // 最低权限（推荐）
-        PROCESS_QUERY_INFORMATION,          // 标准权限
-        PROCESS_QUERY_INFORMATION | PROCESS_VM_READ  // 较高权限
-    };
-    
-    for (DWORD access : accessLevels) {
-        hProcess = OpenProcess(access, FALSE, pid);
-        if (hProcess) {
-            if (GetProcessHandleCount(hProcess, &handleCount)) {
-                CloseHandle(hProcess);
-                return handleCount;
-            }
-            
-            // 如果获取失败，记录错误但继续尝试更高权限
-            DWORD error = GetLastError();
-            CloseHandle(hProcess);
-            
-            // 如果是权限错误，继续尝试；如果是其他错误，直接返回
-            if (error != ERROR_ACCESS_DENIED) {
-                break;
-            }
+    table.Resize(entries_.size());
+    const StringPool::Id running = table.strings.Intern("Running");
+
+    handleCache_.BeginScan();
+    BeginEpoch();
+    for (size_t row = 0; row < entries_.size(); ++row) {
+        const ProcessEntry& entry = entries_[row];
+        table.pid[row] = entry.pid;
+        table.parentPid[row] = entry.parentPid;
+        table.nameId[row] = table.strings.Intern(entry.name);
+        table.threadCount[row] = entry.threadCount;
+        table.priority[row] = entry.priority;
+        table.stateId[row] = running;
+
+        // 每个进程只打开一次，之后所有查询（以及后续刷新）复用同一句柄
+        ProcessTimes times;
+        ProcessHandleCache::Entry* cached = AcquireHandle(entry.pid, &times);
+        if (!cached) {
+            continue;
         }
+        ProcessAccess::Handle handle = cached->handle;
+
+        // 路径、命令行、用户名在进程生命周期内不变，只有新出现的进程才查询
+        if (!cached->attributes.loaded) {
+            LoadStaticAttributes(*cached);
+        }
+        table.fullPathId[row] = table.strings.Intern(cached->attributes.fullPath);
+        table.usernameId[row] = table.strings.Intern(cached->attributes.username);
+        table.commandLineId[row] = table.strings.Intern(cached->attributes.commandLine);
+
+        ProcessMemory memory;
+        if (access_->QueryMemory(handle, memory)) {
+            table.memoryUsage[row] = memory.workingSetSize;
+            table.workingSetSize[row] = memory.workingSetSize;
+            table.pagefileUsage[row] = memory.pagefileUsage;
+        }
+
+        table.createTime[row] = times.createTime;
+
+        table.handleCount[row] = access_->QueryHandleCount(handle);
+        table.gdiCount[row] = access_->QueryGdiCount(handle);
+        table.userCount[row] = access_->QueryUserCount(handle);
+
+        access_->QueryCounters(handle, table.counters[row]);
+
+        UpdateRates(entry.pid, times, table, row);
     }
-    
-    // 备用方法：使用性能计数器（如果需要更精确的数据）
-    return 0;
+    handleCache_.EndScan();
+    EndEpoch();
 }
 
-
+uint32_t ProcessMonitor::GetProcessHandleCount1(uint32_t pid) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    const auto* entry = AcquireHandle(pid, nullptr);
+    return entry ? access_->QueryHandleCount(entry->handle) : 0;
+}
 
 uint32_t ProcessMonitor::GetProcessGdiCount(uint32_t pid) {
-    // 使用 GetGuiResources 获取GDI对象数
-    HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION, FALSE, pid);
-    if (hProcess) {
-        DWORD gdiCount = GetGuiResources(hProcess, GR_GDIOBJECTS);
-        CloseHandle(hProcess);
-        return gdiCount;
-    }
-    return 0;
+    std::lock_guard<std::mutex> lk(mutex_);
+    const auto* entry = AcquireHandle(pid, nullptr);
+    return entry ? access_->QueryGdiCount(entry->handle) : 0;
 }
 
 uint32_t ProcessMonitor::GetProcessUserCount(uint32_t pid) {
-    // 使用 GetGuiResources 获取USER对象数
-    HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION, FALSE, pid);
-    if (hProcess) {
-        DWORD userCount = GetGuiResources(hProcess, GR_USEROBJECTS);
-        CloseHandle(hProcess);
-        return userCount;
-    }
-    return 0;
+    std::lock_guard<std::mutex> lk(mutex_);
+    const auto* entry = AcquireHandle(pid, nullptr);
+    return entry ? access_->QueryUserCount(entry->handle) : 0;
 }
 
 HandleStatistics ProcessMonitor::GetHandleStatistics() {
     HandleStatistics stats;
-    stats.totalHandles = 0;
-    stats.totalGdiObjects = 0;
-    stats.totalUserObjects = 0;
-    
-    auto snapshot = GetProcessSnapshot();
-    
-    for (const auto& process : snapshot.processes) {
-        stats.processHandles[process.pid] = process.handleCount;
-        stats.processGdiObjects[process.pid] = process.gdiCount;
-        stats.processUserObjects[process.pid] = process.userCount;
-        
-        stats.totalHandles += process.handleCount;
-        stats.totalGdiObjects += process.gdiCount;
-        stats.totalUserObjects += process.userCount;
+    auto table = GetLatestTable();
+
+    const size_t rows = table->Size();
+    stats.processHandles.reserve(rows);
+    stats.processGdiObjects.reserve(rows);
+    stats.processUserObjects.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        stats.processHandles[table->pid[i]] = table->handleCount[i];
+        stats.processGdiObjects[table->pid[i]] = table->gdiCount[i];
+        stats.processUserObjects[table->pid[i]] = table->userCount[i];
     }
-    
+
+    stats.totalHandles = table->TotalHandles();
+    stats.totalGdiObjects = table->TotalGdiObjects();
+    stats.totalUserObjects = table->TotalUserObjects();
     return stats;
 }
 
-std::string ProcessMonitor::GetProcessUsername(uint32_t pid) {
-    std::string username;
-    
-    HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION, FALSE, pid);
-    if (!hProcess) {
-        return "Unknown";
-    }
-    
-    HANDLE hToken = NULL;
-    if (OpenProcessToken(hProcess, TOKEN_QUERY, &hToken)) {
-        DWORD tokenInfoSize = 0;
-        GetTokenInformation(hToken, TokenUser, NULL, 0, &tokenInfoSize);
-        
-        if (tokenInfoSize > 0) {
-            auto tokenInfo = std::make_unique<BYTE[]>(tokenInfoSize);
-            if (GetTokenInformation(hToken, TokenUser, tokenInfo.get(), tokenInfoSize, &tokenInfoSize)) {
-                PTOKEN_USER pTokenUser = (PTOKEN_USER)tokenInfo.get();
-                
-                // Convert SID to username
-                char name[256];
-                char domain[256];
-                DWORD nameSize = sizeof(name);
-                DWORD domainSize = sizeof(domain);
-                SID_NAME_USE sidType;
-                
-                if (LookupAccountSidA(NULL, pTokenUser->User.Sid, name, &nameSize, 
-                                    domain, &domainSize, &sidType)) {
-                    username = std::string(domain) + "\\" + name;
-                }
-            }
-        }
-        
-        CloseHandle(hToken);
-    }
-    
-    CloseHandle(hProcess);
-    
-    if (username.empty()) {
-        username = "SYSTEM";
-    }
-    
-    return username;
+ProcessHandleCache::Stats ProcessMonitor::GetHandleCacheStats() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return handleCache_.GetStats();
 }
 
-std::string ProcessMonitor::GetProcessCommandLine(uint32_t pid) {
-    std::string commandLine;
-    
-    // Higher privileges required to get command line
-    HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pid);
-    if (!hProcess) {
-        return "";
-    }
-    
-    // Use WMI to get command line (more reliable method)
-    // Simplified implementation here, actual implementation can use WMI queries
-    HMODULE hNtDll = GetModuleHandleA("ntdll.dll");
-    if (hNtDll) {
-        typedef NTSTATUS(NTAPI* _NtQueryInformationProcess)(
-            HANDLE, int, PVOID, ULONG, PULONG);
-        
-        auto NtQueryInformationProcess = (_NtQueryInformationProcess)
-            GetProcAddress(hNtDll, "NtQueryInformationProcess");
-        
-        if (NtQueryInformationProcess) {
-            // Simplified implementation, return process path as command line
-            char path[MAX_PATH];
-            if (GetModuleFileNameExA(hProcess, NULL, path, MAX_PATH)) {
-                commandLine = path;
-            }
-        }
-    }
-    
-    CloseHandle(hProcess);
-    return commandLine;
+AccountNameCache::Stats ProcessMonitor::GetAccountNameCacheStats() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return accountNames_.GetStats();
 }
 
 double ProcessMonitor::GetProcessCpuUsage(uint32_t pid) {
-    HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION, FALSE, pid);
-    if (!hProcess) {
-        return 0.0;
-    }
-    
-    FILETIME createTime, exitTime, kernelTime, userTime;
-    FILETIME sysIdleTime, sysKernelTime, sysUserTime;
-    
-    if (!GetProcessTimes(hProcess, &createTime, &exitTime, &kernelTime, &userTime) ||
-        !GetSystemTimes(&sysIdleTime, &sysKernelTime, &sysUserTime)) {
-        CloseHandle(hProcess);
-        return 0.0;
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto it = processSamples_.find(pid);
+    return it != processSamples_.end() ? it->second.cpuUsage : 0.0;
+}
+
+void ProcessMonitor::BeginEpoch() {
+    uint64_t wallTime = SteadyTime100ns();
+    uint64_t systemTime = access_->QuerySystemTime();
+
+    // 系统时间是所有逻辑核心的累计值，差值即本轮的总 CPU 容量；
+    // 读取失败时用墙钟间隔 × 逻辑核心数代替，两者都使结果落在 0~100%
+    uint64_t wallDelta = epoch_.wallTime > 0 && wallTime > epoch_.wallTime ? wallTime - epoch_.wallTime : 0;
+    uint64_t systemDelta = 0;
+    if (systemTime > 0 && epoch_.systemTime > 0 && systemTime > epoch_.systemTime) {
+        systemDelta = systemTime - epoch_.systemTime;
+    } else if (systemTime == 0 && wallDelta > 0) {
+        uint64_t cores = std::thread::hardware_concurrency();
+        systemDelta = wallDelta * (cores > 0 ? cores : 1);
     }
-    
-    ULARGE_INTEGER currentKernelTime, currentUserTime;
-    currentKernelTime.LowPart = kernelTime.dwLowDateTime;
-    currentKernelTime.HighPart = kernelTime.dwHighDateTime;
-    currentUserTime.LowPart = userTime.dwLowDateTime;
-    currentUserTime.HighPart = userTime.dwHighDateTime;
-    
-    uint64_t currentProcessTime = currentKernelTime.QuadPart + currentUserTime.QuadPart;
-    uint64_t currentSystemTime = 0;
-    
-    ULARGE_INTEGER sysKernel, sysUser;
-    sysKernel.LowPart = sysKernelTime.dwLowDateTime;
-    sysKernel.HighPart = sysKernelTime.dwHighDateTime;
-    sysUser.LowPart = sysUserTime.dwLowDateTime;
-    sysUser.HighPart = sysUserTime.dwHighDateTime;
-    currentSystemTime = sysKernel.QuadPart + sysUser.QuadPart;
-    
-    double cpuUsage = 0.0;
-    
-    // Check if historical data exists
-    auto it = processCpuData_.find(pid);
-    if (it != processCpuData_.end() && lastSystemTime_ > 0) {
-        const auto& prevData = it->second;
-        
-        uint64_t processTimeDiff = currentProcessTime - prevData.kernelTime - prevData.userTime;
-        uint64_t systemTimeDiff = currentSystemTime - lastSystemTime_;
-        
-        if (systemTimeDiff > 0) {
-            cpuUsage = (100.0 * processTimeDiff) / systemTimeDiff;
-            cpuUsage = cpuUsage < 0.0 ? 0.0 : (cpuUsage > 100.0 ? 100.0 : cpuUsage);
+
+    ++epoch_.id;
+    epoch_.systemTime = systemTime;
+    epoch_.systemTimeDelta = systemDelta;
+    epoch_.wallTime = wallTime;
+    epoch_.wallTimeDelta = wallDelta;
+}
+
+void ProcessMonitor::UpdateRates(uint32_t pid, const ProcessTimes& times, ProcessTable& table, size_t row) {
+    uint64_t processTime = times.kernelTime + times.userTime;
+
+    // 只与同一进程上一轮的采样比较；pid 被复用或中间漏了一轮时重新建立基准
+    auto it = processSamples_.find(pid);
+    if (it != processSamples_.end() && it->second.createTime == times.createTime &&
+        it->second.epoch + 1 == epoch_.id) {
+        const ProcessSample& previous = it->second;
+
+        uint64_t previousTime = previous.kernelTime + previous.userTime;
+        if (epoch_.systemTimeDelta > 0 && processTime > previousTime) {
+            double cpuUsage = (100.0 * static_cast<double>(processTime - previousTime)) / epoch_.systemTimeDelta;
+            table.cpuUsage[row] = cpuUsage > 100.0 ? 100.0 : cpuUsage;
+        }
+
+        if (epoch_.wallTimeDelta > 0) {
+            double seconds = static_cast<double>(epoch_.wallTimeDelta) / 1e7;
+            // 计数器只增不减；读不到（返回 0）时不产生负速率
+            auto rate = [seconds](uint64_t current, uint64_t before) {
+                return current > before ? static_cast<double>(current - before) / seconds : 0.0;
+            };
+            const ProcessCounters& now = table.counters[row];
+            const ProcessCounters& before = previous.counters;
+            table.readBytesPerSec[row] = rate(now.readBytes, before.readBytes);
+            table.writeBytesPerSec[row] = rate(now.writeBytes, before.writeBytes);
+            table.readOpsPerSec[row] = rate(now.readOps, before.readOps);
+            table.writeOpsPerSec[row] = rate(now.writeOps, before.writeOps);
+            table.minorFaultsPerSec[row] = rate(now.minorFaults, before.minorFaults);
+            table.majorFaultsPerSec[row] = rate(now.majorFaults, before.majorFaults);
+            table.voluntaryCtxSwitchesPerSec[row] = rate(now.voluntaryCtxSwitches, before.voluntaryCtxSwitches);
+            table.involuntaryCtxSwitchesPerSec[row] = rate(now.involuntaryCtxSwitches, before.involuntaryCtxSwitches);
         }
     }
-    
-    // Update data
-    processCpuData_[pid] = {
-        currentKernelTime.QuadPart,
-        currentUserTime.QuadPart,
-        GET_LOCAL_TIME_MS()
+
+    processSamples_[pid] = {
+        times.createTime,
+        times.kernelTime,
+        times.userTime,
+        table.counters[row],
+        epoch_.id,
+        table.cpuUsage[row]
     };
-    
-    lastSystemTime_ = currentSystemTime;
-    
-    CloseHandle(hProcess);
-    return cpuUsage;
 }
 
-ProcessInfo ProcessMonitor::GetProcessInfo(uint32_t pid) {
-    auto snapshot = GetProcessSnapshot();
-    for (const auto& process : snapshot.processes) {
-        if (process.pid == pid) {
-            return process;
+void ProcessMonitor::EndEpoch() {
+    for (auto it = processSamples_.begin(); it != processSamples_.end();) {
+        if (it->second.epoch != epoch_.id) {
+            it = processSamples_.erase(it);
+        } else {
+            ++it;
         }
     }
-    
+}
+
+ProcessInfo ProcessMonitor::GetProcessInfo(uint32_t pid) {
+    auto table = GetLatestTable();
+    size_t row = 0;
+    if (table->FindRow(pid, row)) {
+        return table->Row(row);
+    }
+
     // Return empty ProcessInfo indicating not found
     return ProcessInfo();
 }
 
 std::vector<ProcessInfo> ProcessMonitor::FindProcessesByName(const std::string& name) {
-    auto snapshot = GetProcessSnapshot();
+    auto table = GetLatestTable();
     std::vector<ProcessInfo> result;
-    
-    for (const auto& process : snapshot.processes) {
-        if (_stricmp(process.name.c_str(), name.c_str()) == 0) {
-            result.push_back(process);
+
+    if (const auto* rows = table->FindRowsByName(name)) {
+        result.reserve(rows->size());
+        for (uint32_t row : *rows) {
+            result.push_back(table->Row(row));
         }
     }
-    
+
     return result;
 }
 
-bool ProcessMonitor::TerminateProcess(uint32_t pid, uint32_t exitCode) {
-    HANDLE hProcess = OpenProcess(PROCESS_TERMINATE, FALSE, pid);
-    if (!hProcess) {
+bool ProcessMonitor::GetProcessThreads(uint32_t pid, ThreadSnapshot& out) {
+    // createTime 取自最近的快照，用于识别 pid 复用
+    auto table = GetLatestTable();
+    size_t row = 0;
+    if (!table->FindRow(pid, row)) {
+        return false;
+    }
+    const int64_t processCreateTime = table->createTime[row];
+
+    // 枚举与等待都不持有 threadsMutex_，并发查询其他进程不会互相阻塞
+    std::vector<ThreadEntry> entries;
+    if (!access_->EnumerateThreads(pid, entries)) {
+        return false;
+    }
+    uint64_t now = SteadyTime100ns();
+
+    {
+        std::lock_guard<std::mutex> lk(threadsMutex_);
+        auto it = threadSamples_.find(pid);
+        if (it != threadSamples_.end() && it->second.processCreateTime == processCreateTime &&
+            now - it->second.wallTime <= kThreadBaselineMaxAge100ns) {
+            ComputeThreadUsage(pid, entries, now, it->second, out);
+            return true;
+        }
+    }
+
+    // 没有可用的基准：以本次枚举为基准，等待一个短间隔后再枚举一次
+    ThreadSampleCache cache;
+    cache.processCreateTime = processCreateTime;
+    cache.wallTime = now;
+    for (const auto& thread : entries) {
+        cache.threads[thread.tid] = ThreadSample{thread.createTime, thread.kernelTime, thread.userTime};
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(kThreadWarmupMs));
+    if (!access_->EnumerateThreads(pid, entries)) {
         return false;
     }
-    
-    BOOL result = ::TerminateProcess(hProcess, exitCode);
-    CloseHandle(hProcess);
-    
-    return result != FALSE;
+    ComputeThreadUsage(pid, entries, SteadyTime100ns(), cache, out);
+
+    std::lock_guard<std::mutex> lk(threadsMutex_);
+    auto it = threadSamples_.find(pid);
+    if (it == threadSamples_.end() && threadSamples_.size() >= kMaxThreadSampleCaches) {
+        // 超出容量时淘汰最久未查询的进程
+        auto oldest = std::min_element(threadSamples_.begin(), threadSamples_.end(),
+            [](const auto& a, const auto& b) { return a.second.wallTime < b.second.wallTime; });
+        threadSamples_.erase(oldest);
+    }
+    threadSamples_[pid] = std::move(cache);
+    return true;
+}
+
+void ProcessMonitor::ComputeThreadUsage(uint32_t pid, const std::vector<ThreadEntry>& entries, uint64_t now,
+                                        ThreadSampleCache& cache, ThreadSnapshot& out) {
+    const uint64_t wallDelta = now - cache.wallTime;
+
+    out.pid = pid;
+    out.timestamp = GET_LOCAL_TIME_MS();
+    out.intervalMs = wallDelta / 10000;
+    out.threads.clear();
+    out.threads.reserve(entries.size());
+
+    std::unordered_map<uint32_t, ThreadSample> current;
+    current.reserve(entries.size());
+    for (const auto& thread : entries) {
+        ThreadInfo info;
+        info.tid = thread.tid;
+        info.name = thread.name;
+        info.state = thread.state;
+        info.priority = thread.priority;
+        info.kernelTime = thread.kernelTime;
+        info.userTime = thread.userTime;
+
+        // 新线程（或 tid 被复用）从 0 开始计算，差值为其全部 CPU 时间
+        uint64_t previousKernel = 0;
+        uint64_t previousUser = 0;
+        auto previous = cache.threads.find(thread.tid);
+        if (previous != cache.threads.end() && previous->second.createTime == thread.createTime) {
+            previousKernel = previous->second.kernelTime;
+            previousUser = previous->second.userTime;
+        }
+        info.kernelTimeDelta = thread.kernelTime >= previousKernel ? thread.kernelTime - previousKernel : 0;
+        info.userTimeDelta = thread.userTime >= previousUser ? thread.userTime - previousUser : 0;
+        if (wallDelta > 0) {
+            info.cpuUsage = static_cast<double>(info.kernelTimeDelta + info.userTimeDelta) * 100.0 /
+                            static_cast<double>(wallDelta);
+        }
+
+        current.emplace(thread.tid, ThreadSample{thread.createTime, thread.kernelTime, thread.userTime});
+        out.threads.push_back(std::move(info));
+    }
+    cache.threads = std::move(current);
+    cache.wallTime = now;
+
+    std::stable_sort(out.threads.begin(), out.threads.end(),
+                     [](const ThreadInfo& a, const ThreadInfo& b) { return a.cpuUsage > b.cpuUsage; });
+}
+
+void ProcessMonitor::SetLeakDetectorOptions(const LeakDetectorOptions& options) {
+    std::lock_guard<std::mutex> lk(leaksMutex_);
+    leaks_.SetOptions(options);
+}
+
+LeakDetectorOptions ProcessMonitor::GetLeakDetectorOptions() {
+    std::lock_guard<std::mutex> lk(leaksMutex_);
+    return leaks_.GetOptions();
+}
+
+std::vector<LeakSuspect> ProcessMonitor::GetLeakSuspects(const std::vector<LeakMetric>& metrics, size_t n) {
+    std::lock_guard<std::mutex> lk(leaksMutex_);
+    return leaks_.Suspects(metrics, n);
+}
+
+bool ProcessMonitor::EnableKernelProcessEvents() {
+    return lifecycle_.EnableKernelEvents();
+}
+
+bool ProcessMonitor::KernelProcessEventsActive() const {
+    return lifecycle_.KernelEventsActive();
+}
+
+uint64_t ProcessMonitor::ReadProcessEvents(uint64_t afterSeq, size_t maxEvents, std::vector<ProcessEvent>& out) {
+    return lifecycle_.ReadSince(afterSeq, maxEvents, out);
+}
+
+ProcessEventJournal::Stats ProcessMonitor::GetProcessEventStats() const {
+    return lifecycle_.GetStats();
+}
+
+bool ProcessMonitor::TerminateProcess(uint32_t pid, uint32_t exitCode) {
+    return access_->Terminate(pid, exitCode);
 }
 
-} // namespace sysmonitor
\ No newline at end of file
+} // namespace sysmonitor
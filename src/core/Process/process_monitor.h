@@ -4,46 +4,20 @@
 #include <cstdint>
 #include <memory>
 #include <unordered_map>
+#include <mutex>
+#include <atomic>
 #include "../../utils/util_time.h"
+#include "../../utils/scheduler.h"
+#include "process_access.h"
+#include "process_info.h"
+#include "process_table.h"
+#include "process_handle_cache.h"
+#include "account_name_cache.h"
+#include "process_lifecycle.h"
+#include "process_leaks.h"
 
 namespace sysmonitor {
 
-struct ProcessInfo {
-    uint32_t pid;
-    uint32_t parentPid;
-    std::string name;
-    std::string fullPath;
-    std::string state;
-    std::string username;
-    double cpuUsage;           // CPU usage percentage
-    uint64_t memoryUsage;      // Memory usage (bytes)
-    uint64_t workingSetSize;   // Working set size (bytes)
-    uint64_t pagefileUsage;    // Pagefile usage (bytes)
-    int64_t createTime;        // Creation timestamp
-    int32_t priority;          // Process priority
-    int32_t threadCount;       // Thread count
-    std::string commandLine;   // Command line parameters
-    uint32_t handleCount;      // 句柄数
-    uint32_t gdiCount;         // GDI对象数
-    uint32_t userCount;        // USER对象数
-    
-    ProcessInfo() 
-        : pid(0), parentPid(0), threadCount(0), priority(0),
-          memoryUsage(0), workingSetSize(0), pagefileUsage(0),
-          handleCount(0), gdiCount(0), userCount(0), cpuUsage(0.0),
-          createTime(0) {}
-};
-
-struct ProcessSnapshot {
-    std::vector<ProcessInfo> processes;
-    uint64_t timestamp;
-    uint32_t totalProcesses;
-    uint32_t totalThreads;
-    uint32_t totalHandles;     // 总句柄数
-    uint32_t totalGdiObjects;  // 总GDI对象数
-    uint32_t totalUserObjects; // 总USER对象数
-};
-
 struct HandleStatistics {
     uint32_t totalHandles;
     uint32_t totalGdiObjects;
@@ -56,21 +30,43 @@ struct HandleStatistics {
 class ProcessMonitor {
 public:
     ProcessMonitor();
+    // 指定访问路径（测试或非 Windows 平台）
+    explicit ProcessMonitor(std::unique_ptr<ProcessAccess> access);
     ~ProcessMonitor();
 
-    // Get current process snapshot
+    ProcessMonitor(const ProcessMonitor&) = delete;
+    ProcessMonitor& operator=(const ProcessMonitor&) = delete;
+
+    // 后台采样：在 scheduler 上每 intervalMs 采集一次并发布不可变快照，启动时同步发布第一份
+    void StartSampling(PeriodicScheduler& scheduler, int intervalMs = 1000);
+    void StopSampling();
+
+    // 最近发布的进程表，读者之间共享同一份数据、无需加锁；未启动采样时现场采集
+    std::shared_ptr<const ProcessTable> GetLatestTable();
+
+    // Get current process snapshot（由进程表展开为行式结构）
     ProcessSnapshot GetProcessSnapshot();
     
-    // Get detailed information for specific process
+    // Get detailed information for specific process（查最近一份进程表的 pid 索引）
     ProcessInfo GetProcessInfo(uint32_t pid);
     
-    // Find processes by name
+    // Find processes by name（查最近一份进程表的不区分大小写的名称索引）
     std::vector<ProcessInfo> FindProcessesByName(const std::string& name);
     
+    // 进程内各线程的 CPU 时间差值与使用率；进程不在最近的快照中时返回 false
+    // 同一进程重复查询时以上次结果为基准增量计算，首次查询先取一次基准再间隔短暂时间采样；
+    // 枚举与等待期间不持有锁，可并发调用
+    bool GetProcessThreads(uint32_t pid, ThreadSnapshot& out);
+
+    // 句柄 / GDI / USER / 工作集持续增长的疑似泄漏进程，随每次采样在线更新
+    void SetLeakDetectorOptions(const LeakDetectorOptions& options);
+    LeakDetectorOptions GetLeakDetectorOptions();
+    std::vector<LeakSuspect> GetLeakSuspects(const std::vector<LeakMetric>& metrics, size_t n);
+
     // Terminate process
     bool TerminateProcess(uint32_t pid, uint32_t exitCode = 0);
     
-    // Get process CPU usage history (requires continuous monitoring)
+    // 最近一次刷新计算出的 CPU 使用率（需要持续刷新快照）
     double GetProcessCpuUsage(uint32_t pid);
 
     // 新增：获取进程句柄数
@@ -85,28 +81,102 @@ public:
     // 新增：获取所有进程的句柄统计
     HandleStatistics GetHandleStatistics();
 
+    // 句柄缓存命中/打开/回收计数
+    ProcessHandleCache::Stats GetHandleCacheStats();
+
+    // 账户名缓存命中/解析计数
+    AccountNameCache::Stats GetAccountNameCacheStats();
+
+    // 进程启动/退出事件：默认比较相邻快照，启用内核事件源（Linux netlink）后改用其精确事件
+    bool EnableKernelProcessEvents();
+    bool KernelProcessEventsActive() const;
+    // 读取序号大于 afterSeq 的事件，返回因日志覆盖而错过的条数
+    uint64_t ReadProcessEvents(uint64_t afterSeq, size_t maxEvents, std::vector<ProcessEvent>& out);
+    ProcessEventJournal::Stats GetProcessEventStats() const;
+
 private:
     bool Initialize();
     void Cleanup();
-    
-    // Use WMI to get process information
-    std::vector<ProcessInfo> GetProcessesViaToolHelp();
-    
-    // Get process username
-    std::string GetProcessUsername(uint32_t pid);
-    
-    // Get process command line
-    std::string GetProcessCommandLine(uint32_t pid);
-    
-    // CPU usage calculation related
-    struct ProcessCpuData {
+
+    // 采集一份新进程表并发布
+    std::shared_ptr<const ProcessTable> Refresh();
+
+    // 枚举进程并通过句柄缓存查询详细信息，按行号写入 table 各列，调用方持有 mutex_
+    void CollectProcesses(ProcessTable& table);
+
+    // 取得 pid 的有效句柄：缓存的句柄读不到时间或 createTime 已变化（pid 被复用）时重新打开
+    ProcessHandleCache::Entry* AcquireHandle(uint32_t pid, ProcessTimes* times);
+
+    // 首次遇到进程时查询路径、命令行、用户名，结果随句柄缓存项保存
+    void LoadStaticAttributes(ProcessHandleCache::Entry& entry);
+
+    // 开始一轮采集：读取一次系统时间和墙钟作为本轮所有进程共同的分母
+    void BeginEpoch();
+    // 用本轮与上一轮的差值计算 CPU 使用率（占全部逻辑核心的百分比）及各计数器的每秒速率
+    void UpdateRates(uint32_t pid, const ProcessTimes& times, ProcessTable& table, size_t row);
+    // 移除本轮未出现（已退出）进程的历史采样
+    void EndEpoch();
+
+    // 上一轮的采样，用于计算差值
+    struct ProcessSample {
+        int64_t createTime;    // 区分 pid 复用
         uint64_t kernelTime;
         uint64_t userTime;
-        uint64_t lastUpdate;
+        ProcessCounters counters;
+        uint64_t epoch;        // 最近一次采样所在的轮次
+        double cpuUsage;
+    };
+
+    // 一轮采集的时间基准，同一轮内所有进程使用相同的分母
+    struct SampleEpoch {
+        uint64_t id = 0;
+        uint64_t systemTime = 0;       // 所有逻辑核心累计时间（100ns）
+        uint64_t systemTimeDelta = 0;  // 与上一轮之差，0 表示暂无基准
+        uint64_t wallTime = 0;         // steady_clock（100ns）
+        uint64_t wallTimeDelta = 0;
     };
     
-    std::unordered_map<uint32_t, ProcessCpuData> processCpuData_;
-    uint64_t lastSystemTime_;
+    std::unique_ptr<ProcessAccess> access_;
+    ProcessHandleCache handleCache_;
+    AccountNameCache accountNames_;
+    std::mutex mutex_;
+    // 串行化整个 Refresh（采集 → 发布 → 观察），先于 mutex_ / leaksMutex_ 获取
+    std::mutex refreshMutex_;
+    std::vector<ProcessEntry> entries_;   // 枚举结果，跨刷新复用容量
+
+    // 已发布的进程表，通过 std::atomic_load / atomic_store 整体替换，发布后不再修改
+    std::shared_ptr<const ProcessTable> latest_;
+
+    std::atomic<bool> isSampling_{false};
+    PeriodicScheduler* scheduler_ = nullptr;
+    PeriodicScheduler::TaskId samplingTask_ = PeriodicScheduler::kInvalidTask;
+
+    std::unordered_map<uint32_t, ProcessSample> processSamples_;
+    SampleEpoch epoch_;
+
+    ProcessLifecycleTracker lifecycle_;
+
+    std::mutex leaksMutex_;
+    LeakDetector leaks_;
+
+    // 线程采样缓存：按 pid 保存上次各线程的 CPU 时间，最多保留 kMaxThreadSampleCaches 个进程
+    struct ThreadSample {
+        int64_t createTime;
+        uint64_t kernelTime;
+        uint64_t userTime;
+    };
+    struct ThreadSampleCache {
+        int64_t processCreateTime = 0;
+        uint64_t wallTime = 0;          // steady_clock（100ns）
+        std::unordered_map<uint32_t, ThreadSample> threads;
+    };
+    static constexpr size_t kMaxThreadSampleCaches = 16;
+    std::mutex threadsMutex_;
+    std::unordered_map<uint32_t, ThreadSampleCache> threadSamples_;
+
+    // 以 cache 为基准计算各线程的 CPU 使用率写入 out，并把 cache 更新为本次采样
+    static void ComputeThreadUsage(uint32_t pid, const std::vector<ThreadEntry>& entries, uint64_t now,
+                                   ThreadSampleCache& cache, ThreadSnapshot& out);
 };
 
 } // namespace sysmonitor
\ No newline at end of file
@@ -0,0 +1,274 @@
+#include "process_table.h"
+#include <cctype>
+
+namespace sysmonitor {
+
+namespace {
+
+template <typename T>
+uint32_t SumColumn(const std::vector<T>& column) {
+    uint64_t total = 0;
+    for (T value : column) {
+        total += static_cast<uint64_t>(value);
+    }
+    return static_cast<uint32_t>(total);
+}
+
+std::string FoldCase(const std::string& text) {
+    std::string folded(text);
+    for (char& c : folded) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return folded;
+}
+
+} // namespace
+
+StringPool::StringPool() {
+    strings_.emplace_back();
+    index_.emplace(std::string_view(strings_.front()), kEmpty);
+}
+
+StringPool::StringPool(const StringPool& other) : strings_(other.strings_) {
+    Rebuild();
+}
+
+StringPool& StringPool::operator=(const StringPool& other) {
+    if (this != &other) {
+        strings_ = other.strings_;
+        Rebuild();
+    }
+    return *this;
+}
+
+// 复制后的索引必须指向本池中的字符串
+void StringPool::Rebuild() {
+    index_.clear();
+    index_.reserve(strings_.size());
+    for (size_t i = 0; i < strings_.size(); ++i) {
+        index_.emplace(std::string_view(strings_[i]), static_cast<Id>(i));
+    }
+}
+
+StringPool::Id StringPool::Intern(std::string_view text) {
+    auto it = index_.find(text);
+    if (it != index_.end()) {
+        return it->second;
+    }
+    Id id = static_cast<Id>(strings_.size());
+    strings_.emplace_back(text);
+    index_.emplace(std::string_view(strings_.back()), id);
+    return id;
+}
+
+bool StringPool::Find(std::string_view text, Id& id) const {
+    auto it = index_.find(text);
+    if (it == index_.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+void ProcessTable::Reserve(size_t rows) {
+    pid.reserve(rows);
+    parentPid.reserve(rows);
+    createTime.reserve(rows);
+    cpuUsage.reserve(rows);
+    memoryUsage.reserve(rows);
+    workingSetSize.reserve(rows);
+    pagefileUsage.reserve(rows);
+    priority.reserve(rows);
+    threadCount.reserve(rows);
+    handleCount.reserve(rows);
+    gdiCount.reserve(rows);
+    userCount.reserve(rows);
+    readBytesPerSec.reserve(rows);
+    writeBytesPerSec.reserve(rows);
+    readOpsPerSec.reserve(rows);
+    writeOpsPerSec.reserve(rows);
+    minorFaultsPerSec.reserve(rows);
+    majorFaultsPerSec.reserve(rows);
+    voluntaryCtxSwitchesPerSec.reserve(rows);
+    involuntaryCtxSwitchesPerSec.reserve(rows);
+    counters.reserve(rows);
+    nameId.reserve(rows);
+    fullPathId.reserve(rows);
+    usernameId.reserve(rows);
+    stateId.reserve(rows);
+    commandLineId.reserve(rows);
+}
+
+// 数值列补 0，字符串列补空串 id
+void ProcessTable::Resize(size_t rows) {
+    pid.resize(rows);
+    parentPid.resize(rows);
+    createTime.resize(rows);
+    cpuUsage.resize(rows);
+    memoryUsage.resize(rows);
+    workingSetSize.resize(rows);
+    pagefileUsage.resize(rows);
+    priority.resize(rows);
+    threadCount.resize(rows);
+    handleCount.resize(rows);
+    gdiCount.resize(rows);
+    userCount.resize(rows);
+    readBytesPerSec.resize(rows);
+    writeBytesPerSec.resize(rows);
+    readOpsPerSec.resize(rows);
+    writeOpsPerSec.resize(rows);
+    minorFaultsPerSec.resize(rows);
+    majorFaultsPerSec.resize(rows);
+    voluntaryCtxSwitchesPerSec.resize(rows);
+    involuntaryCtxSwitchesPerSec.resize(rows);
+    counters.resize(rows);
+    nameId.resize(rows);
+    fullPathId.resize(rows);
+    usernameId.resize(rows);
+    stateId.resize(rows);
+    commandLineId.resize(rows);
+}
+
+void ProcessTable::Clear() {
+    *this = ProcessTable();
+}
+
+void ProcessTable::Append(const ProcessInfo& info) {
+    pid.push_back(info.pid);
+    parentPid.push_back(info.parentPid);
+    createTime.push_back(info.createTime);
+    cpuUsage.push_back(info.cpuUsage);
+    memoryUsage.push_back(info.memoryUsage);
+    workingSetSize.push_back(info.workingSetSize);
+    pagefileUsage.push_back(info.pagefileUsage);
+    priority.push_back(info.priority);
+    threadCount.push_back(info.threadCount);
+    handleCount.push_back(info.handleCount);
+    gdiCount.push_back(info.gdiCount);
+    userCount.push_back(info.userCount);
+    readBytesPerSec.push_back(info.readBytesPerSec);
+    writeBytesPerSec.push_back(info.writeBytesPerSec);
+    readOpsPerSec.push_back(info.readOpsPerSec);
+    writeOpsPerSec.push_back(info.writeOpsPerSec);
+    minorFaultsPerSec.push_back(info.minorFaultsPerSec);
+    majorFaultsPerSec.push_back(info.majorFaultsPerSec);
+    voluntaryCtxSwitchesPerSec.push_back(info.voluntaryCtxSwitchesPerSec);
+    involuntaryCtxSwitchesPerSec.push_back(info.involuntaryCtxSwitchesPerSec);
+    counters.push_back(info.counters);
+    nameId.push_back(strings.Intern(info.name));
+    fullPathId.push_back(strings.Intern(info.fullPath));
+    usernameId.push_back(strings.Intern(info.username));
+    stateId.push_back(strings.Intern(info.state));
+    commandLineId.push_back(strings.Intern(info.commandLine));
+}
+
+ProcessInfo ProcessTable::Row(size_t row) const {
+    ProcessInfo info;
+    info.pid = pid[row];
+    info.parentPid = parentPid[row];
+    info.createTime = createTime[row];
+    info.cpuUsage = cpuUsage[row];
+    info.memoryUsage = memoryUsage[row];
+    info.workingSetSize = workingSetSize[row];
+    info.pagefileUsage = pagefileUsage[row];
+    info.priority = priority[row];
+    info.threadCount = threadCount[row];
+    info.handleCount = handleCount[row];
+    info.gdiCount = gdiCount[row];
+    info.userCount = userCount[row];
+    info.readBytesPerSec = readBytesPerSec[row];
+    info.writeBytesPerSec = writeBytesPerSec[row];
+    info.readOpsPerSec = readOpsPerSec[row];
+    info.writeOpsPerSec = writeOpsPerSec[row];
+    info.minorFaultsPerSec = minorFaultsPerSec[row];
+    info.majorFaultsPerSec = majorFaultsPerSec[row];
+    info.voluntaryCtxSwitchesPerSec = voluntaryCtxSwitchesPerSec[row];
+    info.involuntaryCtxSwitchesPerSec = involuntaryCtxSwitchesPerSec[row];
+    info.counters = counters[row];
+    info.name = strings.Get(nameId[row]);
+    info.fullPath = strings.Get(fullPathId[row]);
+    info.username = strings.Get(usernameId[row]);
+    info.state = strings.Get(stateId[row]);
+    info.commandLine = strings.Get(commandLineId[row]);
+    return info;
+}
+
+// 进程名已驻留，每个不同的名称只转换一次大小写
+void ProcessTable::BuildIndexes() {
+    rowByPid.clear();
+    rowByPid.reserve(Size());
+    for (size_t row = 0; row < Size(); ++row) {
+        rowByPid.emplace(pid[row], static_cast<uint32_t>(row));
+    }
+
+    constexpr uint32_t kUnset = static_cast<uint32_t>(-1);
+    std::vector<uint32_t> slotById(strings.Size(), kUnset);
+    std::vector<std::vector<uint32_t>*> slots;
+    rowsByName.clear();
+    for (size_t row = 0; row < Size(); ++row) {
+        uint32_t& slot = slotById[nameId[row]];
+        if (slot == kUnset) {
+            slot = static_cast<uint32_t>(slots.size());
+            slots.push_back(&rowsByName[FoldCase(strings.Get(nameId[row]))]);
+        }
+        slots[slot]->push_back(static_cast<uint32_t>(row));
+    }
+}
+
+bool ProcessTable::FindRow(uint32_t pidValue, size_t& row) const {
+    auto it = rowByPid.find(pidValue);
+    if (it == rowByPid.end()) {
+        return false;
+    }
+    row = it->second;
+    return true;
+}
+
+const std::vector<uint32_t>* ProcessTable::FindRowsByName(const std::string& name) const {
+    auto it = rowsByName.find(FoldCase(name));
+    return it == rowsByName.end() ? nullptr : &it->second;
+}
+
+uint32_t ProcessTable::TotalThreads() const {
+    return SumColumn(threadCount);
+}
+
+uint32_t ProcessTable::TotalHandles() const {
+    return SumColumn(handleCount);
+}
+
+uint32_t ProcessTable::TotalGdiObjects() const {
+    return SumColumn(gdiCount);
+}
+
+uint32_t ProcessTable::TotalUserObjects() const {
+    return SumColumn(userCount);
+}
+
+ProcessSnapshot ProcessTable::ToSnapshot() const {
+    ProcessSnapshot snapshot;
+    snapshot.timestamp = timestamp;
+    snapshot.processes.reserve(Size());
+    for (size_t row = 0; row < Size(); ++row) {
+        snapshot.processes.push_back(Row(row));
+    }
+    snapshot.totalProcesses = static_cast<uint32_t>(Size());
+    snapshot.totalThreads = TotalThreads();
+    snapshot.totalHandles = TotalHandles();
+    snapshot.totalGdiObjects = TotalGdiObjects();
+    snapshot.totalUserObjects = TotalUserObjects();
+    return snapshot;
+}
+
+ProcessTable ProcessTable::FromSnapshot(const ProcessSnapshot& snapshot) {
+    ProcessTable table;
+    table.timestamp = snapshot.timestamp;
+    table.Reserve(snapshot.processes.size());
+    for (const auto& process : snapshot.processes) {
+        table.Append(process);
+    }
+    table.BuildIndexes();
+    return table;
+}
+
+} // namespace sysmonitor
@@ -0,0 +1,124 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include "process_info.h"
+
+namespace sysmonitor {
+
+struct ProcessTree;
+
+/**
+ * @brief 字符串驻留池：相同内容只保存一份，以 32 位 id 引用
+ *
+ * id 0 固定为空串。字符串存放在 deque 中，插入后地址不变，索引直接以 string_view 为键。
+ */
+class StringPool {
+public:
+    using Id = uint32_t;
+    static constexpr Id kEmpty = 0;
+
+    StringPool();
+    StringPool(const StringPool& other);
+    StringPool& operator=(const StringPool& other);
+    StringPool(StringPool&&) = default;
+    StringPool& operator=(StringPool&&) = default;
+
+    Id Intern(std::string_view text);
+
+    // 不插入，仅查找；不存在时返回 false
+    bool Find(std::string_view text, Id& id) const;
+
+    const std::string& Get(Id id) const { return strings_[id]; }
+    size_t Size() const { return strings_.size(); }
+
+private:
+    void Rebuild();
+
+    std::deque<std::string> strings_;
+    std::unordered_map<std::string_view, Id> index_;
+};
+
+/**
+ * @brief 列式进程表：每个字段一列，字符串字段保存驻留 id
+ *
+ * 排序、聚合、比较只需扫描相关的连续数值列，不必遍历整条 ProcessInfo。
+ * 每份表拥有自己的字符串池，发布后不再修改，可在多个线程间共享。
+ * Row() / ToSnapshot() 为仍使用 ProcessInfo 的接口提供行式视图。
+ * 采集完成后调用 BuildIndexes() 为这份表重新建立 pid 与进程名的哈希索引（每次采样全量重建一次），
+ * 发布后按 pid / 名称查找不再扫描整列。
+ */
+struct ProcessTable {
+    uint64_t timestamp = 0;
+
+    // 数值列
+    std::vector<uint32_t> pid;
+    std::vector<uint32_t> parentPid;
+    std::vector<int64_t> createTime;
+    std::vector<double> cpuUsage;
+    std::vector<uint64_t> memoryUsage;
+    std::vector<uint64_t> workingSetSize;
+    std::vector<uint64_t> pagefileUsage;
+    std::vector<int32_t> priority;
+    std::vector<int32_t> threadCount;
+    std::vector<uint32_t> handleCount;
+    std::vector<uint32_t> gdiCount;
+    std::vector<uint32_t> userCount;
+    std::vector<double> readBytesPerSec;
+    std::vector<double> writeBytesPerSec;
+    std::vector<double> readOpsPerSec;
+    std::vector<double> writeOpsPerSec;
+    std::vector<double> minorFaultsPerSec;
+    std::vector<double> majorFaultsPerSec;
+    std::vector<double> voluntaryCtxSwitchesPerSec;
+    std::vector<double> involuntaryCtxSwitchesPerSec;
+    std::vector<ProcessCounters> counters;      // 累计值，较少访问，按行存放
+
+    // 字符串列（StringPool id）
+    std::vector<StringPool::Id> nameId;
+    std::vector<StringPool::Id> fullPathId;
+    std::vector<StringPool::Id> usernameId;
+    std::vector<StringPool::Id> stateId;
+    std::vector<StringPool::Id> commandLineId;
+
+    StringPool strings;
+
+    // 索引（BuildIndexes 生成）：pid → 行号；小写进程名 → 行号列表
+    std::unordered_map<uint32_t, uint32_t> rowByPid;
+    std::unordered_map<std::string, std::vector<uint32_t>> rowsByName;
+
+    // 父子关系与子树合计，发布前由 ProcessTree::Build 生成
+    std::shared_ptr<const ProcessTree> tree;
+
+    size_t Size() const { return pid.size(); }
+    void Reserve(size_t rows);
+    // 各列补齐或截断为 rows 行，采集方按行号直接填写各列，不经过 ProcessInfo
+    void Resize(size_t rows);
+    void Clear();
+
+    void Append(const ProcessInfo& info);
+    ProcessInfo Row(size_t row) const;
+
+    void BuildIndexes();
+    bool FindRow(uint32_t pid, size_t& row) const;
+    // 名称不区分大小写；无匹配时返回 nullptr
+    const std::vector<uint32_t>* FindRowsByName(const std::string& name) const;
+
+    const std::string& Name(size_t row) const { return strings.Get(nameId[row]); }
+    const std::string& Username(size_t row) const { return strings.Get(usernameId[row]); }
+
+    uint32_t TotalThreads() const;
+    uint32_t TotalHandles() const;
+    uint32_t TotalGdiObjects() const;
+    uint32_t TotalUserObjects() const;
+
+    // 行式快照（兼容旧接口）
+    ProcessSnapshot ToSnapshot() const;
+    static ProcessTable FromSnapshot(const ProcessSnapshot& snapshot);
+};
+
+} // namespace sysmonitor
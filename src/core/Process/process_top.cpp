@@ -0,0 +1,198 @@
+#include "process_top.h"
+#include <algorithm>
+#include <iterator>
+
+namespace sysmonitor {
+
+namespace {
+
+struct MetricInfo {
+    TopMetric metric;
+    const char* name;
+};
+
+// 与 TopMetric 的声明顺序一致，分组累加时按枚举值下标访问
+constexpr MetricInfo kMetrics[] = {
+    {TopMetric::Cpu, "cpu"},
+    {TopMetric::Memory, "memory"},
+    {TopMetric::Io, "io"},
+    {TopMetric::Handles, "handles"},
+    {TopMetric::Threads, "threads"},
+};
+
+double MetricValue(const ProcessTable& table, size_t row, TopMetric metric) {
+    switch (metric) {
+    case TopMetric::Cpu: return table.cpuUsage[row];
+    case TopMetric::Memory: return static_cast<double>(table.workingSetSize[row]);
+    case TopMetric::Io: return table.readBytesPerSec[row] + table.writeBytesPerSec[row];
+    case TopMetric::Handles: return static_cast<double>(table.handleCount[row]);
+    case TopMetric::Threads: return static_cast<double>(table.threadCount[row]);
+    }
+    return 0.0;
+}
+
+// 候选项：value 与其在候选数组中的下标，值相同时下标小的优先
+struct Candidate {
+    double value;
+    size_t index;
+};
+
+// a 排在 b 之前；以它为比较器的堆，堆顶是当前前 n 名中最差的一个
+struct Better {
+    bool operator()(const Candidate& a, const Candidate& b) const {
+        return a.value != b.value ? a.value > b.value : a.index < b.index;
+    }
+};
+
+class BoundedHeap {
+public:
+    explicit BoundedHeap(size_t capacity) : capacity_(capacity) {
+        heap_.reserve(std::min<size_t>(capacity, 256));
+    }
+
+    void Offer(double value, size_t index) {
+        if (capacity_ == 0) return;
+        Candidate candidate{value, index};
+        if (heap_.size() < capacity_) {
+            heap_.push_back(candidate);
+            std::push_heap(heap_.begin(), heap_.end(), Better());
+        } else if (Better()(candidate, heap_.front())) {
+            std::pop_heap(heap_.begin(), heap_.end(), Better());
+            heap_.back() = candidate;
+            std::push_heap(heap_.begin(), heap_.end(), Better());
+        }
+    }
+
+    // 从好到差
+    std::vector<Candidate> Drain() {
+        std::sort_heap(heap_.begin(), heap_.end(), Better());
+        return std::move(heap_);
+    }
+
+private:
+    size_t capacity_;
+    std::vector<Candidate> heap_;
+};
+
+// 分组累加值，values 与 kMetrics 同序；key 为字符串池 id
+struct Group {
+    StringPool::Id key = StringPool::kEmpty;
+    uint32_t processCount = 0;
+    double values[std::size(kMetrics)] = {};
+};
+
+} // namespace
+
+bool ParseTopMetric(const std::string& text, TopMetric& metric) {
+    for (const auto& info : kMetrics) {
+        if (text == info.name) {
+            metric = info.metric;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* TopMetricName(TopMetric metric) {
+    for (const auto& info : kMetrics) {
+        if (info.metric == metric) return info.name;
+    }
+    return "unknown";
+}
+
+bool ParseTopGroupBy(const std::string& text, TopGroupBy& groupBy) {
+    if (text.empty() || text == "none" || text == "process") {
+        groupBy = TopGroupBy::None;
+    } else if (text == "name") {
+        groupBy = TopGroupBy::Name;
+    } else if (text == "user") {
+        groupBy = TopGroupBy::User;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* TopGroupByName(TopGroupBy groupBy) {
+    switch (groupBy) {
+    case TopGroupBy::Name: return "name";
+    case TopGroupBy::User: return "user";
+    default: return "none";
+    }
+}
+
+std::vector<TopRanking> ComputeTopProcesses(const ProcessTable& table,
+                                            const std::vector<TopMetric>& metrics,
+                                            size_t n,
+                                            TopGroupBy groupBy) {
+    std::vector<BoundedHeap> heaps(metrics.size(), BoundedHeap(n));
+    std::vector<TopRanking> rankings;
+    rankings.reserve(metrics.size());
+    const size_t rows = table.Size();
+
+    if (groupBy == TopGroupBy::None) {
+        // 逐行读取一次，交给每个指标的堆
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t m = 0; m < metrics.size(); ++m) {
+                heaps[m].Offer(MetricValue(table, i, metrics[m]), i);
+            }
+        }
+
+        for (size_t m = 0; m < metrics.size(); ++m) {
+            TopRanking ranking{metrics[m], {}};
+            for (const auto& candidate : heaps[m].Drain()) {
+                TopEntry entry;
+                entry.pid = table.pid[candidate.index];
+                entry.name = table.Name(candidate.index);
+                entry.username = table.Username(candidate.index);
+                entry.value = candidate.value;
+                ranking.entries.push_back(std::move(entry));
+            }
+            rankings.push_back(std::move(ranking));
+        }
+        return rankings;
+    }
+
+    // 池 id 稠密，直接以 id 为下标找到所属分组；同一次遍历中计数并只累加请求的指标
+    const auto& keys = groupBy == TopGroupBy::Name ? table.nameId : table.usernameId;
+    constexpr size_t kNoGroup = static_cast<size_t>(-1);
+    std::vector<size_t> groupIndex(table.strings.Size(), kNoGroup);
+    std::vector<Group> groups;
+    for (size_t i = 0; i < rows; ++i) {
+        size_t& index = groupIndex[keys[i]];
+        if (index == kNoGroup) {
+            index = groups.size();
+            groups.emplace_back();
+            groups.back().key = keys[i];
+        }
+        Group& group = groups[index];
+        ++group.processCount;
+        for (TopMetric metric : metrics) {
+            group.values[static_cast<size_t>(metric)] += MetricValue(table, i, metric);
+        }
+    }
+
+    for (size_t g = 0; g < groups.size(); ++g) {
+        for (size_t m = 0; m < metrics.size(); ++m) {
+            heaps[m].Offer(groups[g].values[static_cast<size_t>(metrics[m])], g);
+        }
+    }
+
+    for (size_t m = 0; m < metrics.size(); ++m) {
+        TopRanking ranking{metrics[m], {}};
+        for (const auto& candidate : heaps[m].Drain()) {
+            const Group& group = groups[candidate.index];
+            const std::string& key = table.strings.Get(group.key);
+            TopEntry entry;
+            entry.name = key;
+            entry.username = groupBy == TopGroupBy::User ? key : std::string();
+            entry.value = candidate.value;
+            entry.processCount = group.processCount;
+            ranking.entries.push_back(std::move(entry));
+        }
+        rankings.push_back(std::move(ranking));
+    }
+    return rankings;
+}
+
+} // namespace sysmonitor
@@ -0,0 +1,56 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "process_table.h"
+
+namespace sysmonitor {
+
+// 排行指标
+enum class TopMetric {
+    Cpu,        // cpuUsage（%）
+    Memory,     // workingSetSize（bytes）
+    Io,         // readBytesPerSec + writeBytesPerSec
+    Handles,    // handleCount
+    Threads,    // threadCount
+};
+
+// 排行对象：单个进程，或按进程名 / 用户聚合
+enum class TopGroupBy {
+    None,
+    Name,
+    User,
+};
+
+struct TopEntry {
+    uint32_t pid = 0;            // 聚合时为 0
+    std::string name;            // 进程名；按用户聚合时为用户名
+    std::string username;
+    double value = 0.0;
+    uint32_t processCount = 1;   // 聚合时该组包含的进程数
+};
+
+struct TopRanking {
+    TopMetric metric;
+    std::vector<TopEntry> entries;   // 按 value 从大到小
+};
+
+bool ParseTopMetric(const std::string& text, TopMetric& metric);
+const char* TopMetricName(TopMetric metric);
+bool ParseTopGroupBy(const std::string& text, TopGroupBy& groupBy);
+const char* TopGroupByName(TopGroupBy groupBy);
+
+/**
+ * @brief 在一次遍历中计算多个指标的前 n 名
+ *
+ * 逐行遍历进程表一次，每行交给各指标容量为 n 的小顶堆，只与堆顶比较，复杂度 O(P · M · log n)，
+ * 不对整个列表排序；值相同时行号小的在前。分组时在同一次遍历中计数并累加请求的指标，
+ * 再对各组取前 n 名。
+ * 指标直接读取进程表的数值列，分组键使用字符串池 id，不比较字符串。
+ */
+std::vector<TopRanking> ComputeTopProcesses(const ProcessTable& table,
+                                            const std::vector<TopMetric>& metrics,
+                                            size_t n,
+                                            TopGroupBy groupBy = TopGroupBy::None);
+
+} // namespace sysmonitor
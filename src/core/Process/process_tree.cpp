@@ -0,0 +1,115 @@
+#include "process_tree.h"
+#include <utility>
+
+namespace sysmonitor {
+
+ProcessTree ProcessTree::Build(const ProcessTable& table) {
+    const size_t rows = table.Size();
+    ProcessTree tree;
+    tree.parentRow.assign(rows, kNoParent);
+    tree.orphan.assign(rows, 0);
+
+    for (size_t row = 0; row < rows; ++row) {
+        const uint32_t parentPid = table.parentPid[row];
+        if (parentPid == table.pid[row]) {
+            continue;   // 如 System Idle Process（pid 0）
+        }
+        size_t parent = 0;
+        if (!table.FindRow(parentPid, parent)) {
+            tree.orphan[row] = parentPid != 0;
+            continue;
+        }
+        // 父进程晚于子进程创建：原父进程已退出，pid 被新进程复用
+        const int64_t parentCreate = table.createTime[parent];
+        const int64_t childCreate = table.createTime[row];
+        if (parentCreate != 0 && childCreate != 0 && parentCreate > childCreate) {
+            tree.orphan[row] = 1;
+            continue;
+        }
+        tree.parentRow[row] = static_cast<int32_t>(parent);
+    }
+
+    // 沿父链标记，同一轮内再次遇到已标记的节点说明成环，在该处断开
+    std::vector<uint32_t> walk(rows, 0);
+    for (size_t row = 0; row < rows; ++row) {
+        const uint32_t id = static_cast<uint32_t>(row) + 1;
+        size_t current = row;
+        while (walk[current] == 0) {
+            walk[current] = id;
+            if (tree.parentRow[current] == kNoParent) break;
+            current = static_cast<size_t>(tree.parentRow[current]);
+        }
+        if (walk[current] == id && tree.parentRow[current] != kNoParent) {
+            tree.parentRow[current] = kNoParent;
+            tree.orphan[current] = 1;
+        }
+    }
+
+    // 按父进程计数排布子进程，保持行号顺序
+    tree.childOffset.assign(rows + 1, 0);
+    for (size_t row = 0; row < rows; ++row) {
+        if (tree.parentRow[row] != kNoParent) {
+            ++tree.childOffset[tree.parentRow[row] + 1];
+        } else {
+            tree.roots.push_back(static_cast<uint32_t>(row));
+        }
+    }
+    for (size_t row = 0; row < rows; ++row) {
+        tree.childOffset[row + 1] += tree.childOffset[row];
+    }
+    tree.children.resize(rows - tree.roots.size());
+    std::vector<uint32_t> cursor(tree.childOffset.begin(), tree.childOffset.end() - 1);
+    for (size_t row = 0; row < rows; ++row) {
+        if (tree.parentRow[row] != kNoParent) {
+            tree.children[cursor[tree.parentRow[row]]++] = static_cast<uint32_t>(row);
+        }
+    }
+
+    // 非递归后序遍历，进程链再深也不会耗尽栈
+    tree.postOrder.reserve(rows);
+    std::vector<std::pair<uint32_t, uint32_t>> stack;   // 行号，下一个待访问的子进程位置
+    for (uint32_t root : tree.roots) {
+        stack.emplace_back(root, tree.childOffset[root]);
+        while (!stack.empty()) {
+            const uint32_t row = stack.back().first;
+            const uint32_t next = stack.back().second;
+            if (next < tree.childOffset[row + 1]) {
+                ++stack.back().second;
+                const uint32_t child = tree.children[next];
+                stack.emplace_back(child, tree.childOffset[child]);
+            } else {
+                tree.postOrder.push_back(row);
+                stack.pop_back();
+            }
+        }
+    }
+
+    tree.postOrderIndex.resize(rows);
+    for (size_t i = 0; i < tree.postOrder.size(); ++i) {
+        tree.postOrderIndex[tree.postOrder[i]] = static_cast<uint32_t>(i);
+    }
+
+    // 后序中子进程总在父进程之前，逐个累加到父进程即得子树合计
+    tree.subtreeProcesses.assign(rows, 1);
+    tree.subtreeCpuUsage.assign(table.cpuUsage.begin(), table.cpuUsage.end());
+    tree.subtreeWorkingSetSize.assign(table.workingSetSize.begin(), table.workingSetSize.end());
+    tree.subtreeThreadCount.resize(rows);
+    tree.subtreeHandleCount.resize(rows);
+    for (size_t row = 0; row < rows; ++row) {
+        tree.subtreeThreadCount[row] = static_cast<uint64_t>(table.threadCount[row] > 0 ? table.threadCount[row] : 0);
+        tree.subtreeHandleCount[row] = table.handleCount[row];
+    }
+    for (uint32_t row : tree.postOrder) {
+        const int32_t parent = tree.parentRow[row];
+        if (parent == kNoParent) continue;
+        tree.subtreeProcesses[parent] += tree.subtreeProcesses[row];
+        tree.subtreeCpuUsage[parent] += tree.subtreeCpuUsage[row];
+        tree.subtreeWorkingSetSize[parent] += tree.subtreeWorkingSetSize[row];
+        tree.subtreeThreadCount[parent] += tree.subtreeThreadCount[row];
+        tree.subtreeHandleCount[parent] += tree.subtreeHandleCount[row];
+    }
+
+    return tree;
+}
+
+} // namespace sysmonitor
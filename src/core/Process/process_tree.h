@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "process_table.h"
+
+namespace sysmonitor {
+
+/**
+ * @brief 进程父子关系索引及子树合计，随每份进程表建立一次
+ *
+ * 子进程按行号分组存放（CSR 形式），children[childOffset[r] .. childOffset[r + 1]) 为 r 的子进程。
+ * 父进程不在表中、创建时间晚于子进程（pid 已被复用）或成环时，该进程作为根节点，并标记为孤儿。
+ * 子树合计包含进程自身，在一次后序遍历中累加得到。
+ */
+struct ProcessTree {
+    static constexpr int32_t kNoParent = -1;
+
+    std::vector<int32_t> parentRow;        // 父进程行号，根节点为 kNoParent
+    std::vector<uint8_t> orphan;           // parentPid 非 0 但找不到有效父进程
+    std::vector<uint32_t> childOffset;     // 行数 + 1
+    std::vector<uint32_t> children;
+    std::vector<uint32_t> roots;
+
+    // 后序序列：任一子树在其中占据以根结尾、长度为 subtreeProcesses 的连续区间
+    std::vector<uint32_t> postOrder;
+    std::vector<uint32_t> postOrderIndex;  // 行号 → 在 postOrder 中的位置
+
+    std::vector<uint32_t> subtreeProcesses;
+    std::vector<double> subtreeCpuUsage;
+    std::vector<uint64_t> subtreeWorkingSetSize;
+    std::vector<uint64_t> subtreeThreadCount;
+    std::vector<uint64_t> subtreeHandleCount;
+
+    // 需要 table 已调用 BuildIndexes()
+    static ProcessTree Build(const ProcessTable& table);
+
+    uint32_t ChildCount(size_t row) const { return childOffset[row + 1] - childOffset[row]; }
+    const uint32_t* ChildrenBegin(size_t row) const { return children.data() + childOffset[row]; }
+    const uint32_t* ChildrenEnd(size_t row) const { return children.data() + childOffset[row + 1]; }
+};
+
+} // namespace sysmonitor
@@ -4,6 +4,7 @@
 #include <iostream>
 #include "../../utils/registry_encode.h"
 #include "../../utils/util_time.h"
+#include "../../utils/metrics.h"
 // 全局变量，保存本次运行创建的备份目录
 char g_backupDir[MAX_PATH] = { 0 };
 
@@ -29,6 +30,8 @@ RegistryMonitor::RegistryMonitor() {}
  * 所有字符串数据都会转换为 UTF-8 编码以便统一处理
  */
 RegistrySnapshot RegistryMonitor::GetRegistrySnapshot() {
+    SYSMON_TIME_COLLECTOR("GetRegistrySnapshot");
+
     RegistrySnapshot snapshot;
     snapshot.timestamp = GET_LOCAL_TIME_MS();  // 使用系统启动后的毫秒数作为时间戳
     snapshot.backupInfo = BackupInfo();
@@ -1035,6 +1038,8 @@ void RegistryMonitor::PrintBackupInfo(const std::map<std::string, BackupInfo>& b
 
 // 比较两个文件夹下的reg文件，返回比较结果
 FolderComparisonResult RegistryMonitor::compareFolders(const std::string& relativeFolder1, const std::string& relativeFolder2) {
+    SYSMON_TIME_COLLECTOR("CompareRegistryFolders");
+
     FolderComparisonResult result;
 
     // 获取exe所在目录
@@ -4,7 +4,7 @@
 #include <vector>
 #include <cstdint>
 #include <map>
-#include <windows.h>
+#include "../../utils/win32_types.h"
 #include "../../utils/encode.h"
 #include <iostream>
 #include <fstream>
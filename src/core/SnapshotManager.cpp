@@ -10,7 +10,9 @@
 #include "../utils/AsyncLogger.h"
 #include "../utils/encode.h"
 #include "../third_party/nlohmann/json.hpp"
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
 using namespace std::string_literals;
 using json = nlohmann::json;
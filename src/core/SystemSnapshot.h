@@ -14,6 +14,27 @@ namespace sysmonitor {
 
 using json = nlohmann::json;
 
+// 进程 I/O、缺页、上下文切换字段（累计值与每秒速率），进程列表、详情和系统快照共用
+inline void ProcessCountersToJson(const ProcessInfo& p, json& out) {
+    out["readBytes"] = p.counters.readBytes;
+    out["writeBytes"] = p.counters.writeBytes;
+    out["readOps"] = p.counters.readOps;
+    out["writeOps"] = p.counters.writeOps;
+    out["minorFaults"] = p.counters.minorFaults;
+    out["majorFaults"] = p.counters.majorFaults;
+    out["voluntaryCtxSwitches"] = p.counters.voluntaryCtxSwitches;
+    out["involuntaryCtxSwitches"] = p.counters.involuntaryCtxSwitches;
+    out["ctxSwitchesScope"] = kCtxSwitchesScope;
+    out["readBytesPerSec"] = p.readBytesPerSec;
+    out["writeBytesPerSec"] = p.writeBytesPerSec;
+    out["readOpsPerSec"] = p.readOpsPerSec;
+    out["writeOpsPerSec"] = p.writeOpsPerSec;
+    out["minorFaultsPerSec"] = p.minorFaultsPerSec;
+    out["majorFaultsPerSec"] = p.majorFaultsPerSec;
+    out["voluntaryCtxSwitchesPerSec"] = p.voluntaryCtxSwitchesPerSec;
+    out["involuntaryCtxSwitchesPerSec"] = p.involuntaryCtxSwitchesPerSec;
+}
+
 struct SystemSnapshot {
     CPUUsage cpu{};
     MemoryUsage memory{};
@@ -202,6 +223,7 @@ struct SystemSnapshot {
             jp["handleCount"] = p.handleCount;
             jp["gdiCount"] = p.gdiCount;
             jp["userCount"] = p.userCount;
+            ProcessCountersToJson(p, jp);
             out["processes"]["processes"].push_back(jp);
         }
 
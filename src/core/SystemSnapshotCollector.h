@@ -1,6 +1,7 @@
 #pragma once
 #include "../third_party/nlohmann/json.hpp"
 #include "../utils/util_time.h"
+#include "../utils/metrics.h"
 #include "CPUInfo/system_info.h"
 #include "CPUInfo/cpu_monitor.h"
 #include "Memory/memory_monitor.h"
@@ -23,6 +24,7 @@ public:
                                   DriverMonitor& driver,
                                   RegistryMonitor& registry,
                                   ProcessMonitor& process) {
+        SYSMON_TIME_COLLECTOR("SystemSnapshotCollect");
         SystemSnapshot s;
         s.timestamp = GET_LOCAL_TIME_MS();
         try { s.cpu = cpu.GetCurrentUsage(); } catch(...) {}
@@ -3,6 +3,8 @@
 #include <thread>
 #include <chrono>
 #include <csignal>
+#include <cstring>
+#include <string>
 #include "core/stdafx.h"
 #include "core/CPUInfo/cpu_monitor.h"
 #include "core/CPUInfo/wmi_helper.h"
@@ -46,7 +48,66 @@ void PrintCPUInfo(const CPUInfo& info) {
     std::cout << std::endl;
 }
 
-int main() {
+// 解析 --name=value 形式的数值参数，未匹配时返回 false
+static bool ParseSizeArg(const char* arg, const char* name, size_t& out) {
+    size_t len = std::strlen(name);
+    if (std::strncmp(arg, name, len) != 0 || arg[len] != '=') {
+        return false;
+    }
+    try {
+        out = static_cast<size_t>(std::stoul(arg + len + 1));
+    } catch (...) {
+        std::cerr << "Invalid value for " << name << ": " << (arg + len + 1) << std::endl;
+    }
+    return true;
+}
+
+// 解析 --name=value 形式的字符串参数，未匹配时返回 false
+static bool ParseStringArg(const char* arg, const char* name, std::string& out) {
+    size_t len = std::strlen(name);
+    if (std::strncmp(arg, name, len) != 0 || arg[len] != '=') {
+        return false;
+    }
+    out = arg + len + 1;
+    return true;
+}
+
+// 命令行选项：
+//   --cheap-threads=N          threads reserved for cheap routes
+//   --expensive-threads=N      max concurrent expensive requests
+//   --expensive-queue=N        max queued expensive requests before 503
+//   --keep-alive-threads=N     extra threads started on demand for keep-alive connections
+//   --connection-queue=N       max connections waiting for a worker thread
+//   --webclient-dir=PATH       serve the UI from disk instead of the embedded copy (UI development)
+//   --process-events=netlink   使用内核进程事件（Linux，需要 CAP_NET_ADMIN），默认比较相邻快照
+//   --cpu-counters=perf        每核心 IPC、缓存与分支未命中（Linux perf_event_open，虚拟机中退回软件事件）
+//   --leak-window=SECONDS      泄漏检测的回归窗口，默认 600
+struct ServerOptions {
+    WorkerPoolOptions workerPool;
+    std::string webclientDir;
+    std::string processEvents;
+    std::string cpuCounters;
+    size_t leakWindowSeconds = 0;
+};
+
+static ServerOptions ParseServerOptions(int argc, char* argv[]) {
+    ServerOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        ParseSizeArg(arg, "--cheap-threads", options.workerPool.cheapThreads) ||
+        ParseSizeArg(arg, "--expensive-threads", options.workerPool.expensiveThreads) ||
+        ParseSizeArg(arg, "--expensive-queue", options.workerPool.maxExpensiveQueue) ||
+        ParseSizeArg(arg, "--keep-alive-threads", options.workerPool.keepAliveThreads) ||
+        ParseSizeArg(arg, "--connection-queue", options.workerPool.maxConnectionQueue) ||
+        ParseStringArg(arg, "--webclient-dir", options.webclientDir) ||
+        ParseStringArg(arg, "--process-events", options.processEvents) ||
+        ParseStringArg(arg, "--cpu-counters", options.cpuCounters) ||
+        ParseSizeArg(arg, "--leak-window", options.leakWindowSeconds);
+    }
+    return options;
+}
+
+int main(int argc, char* argv[]) {
     // Set console output encoding
     system("chcp 936 > nul");
     SetupConsoleEncoding();
@@ -72,7 +133,14 @@ int main() {
     }
     
     // Start HTTP server
+    const ServerOptions options = ParseServerOptions(argc, argv);
     HttpServer server;
+    server.SetWorkerPoolOptions(options.workerPool);
+    server.SetWebclientDirectory(options.webclientDir);
+    server.SetKernelProcessEvents(options.processEvents == "netlink");
+    server.SetCpuCounters(options.cpuCounters == "perf");
+    server.SetLeakWindowSeconds(static_cast<double>(options.leakWindowSeconds));
+
     if (server.Start(8080)) {
         std::cout << "Server started successfully!" << std::endl;
         std::cout << "Open browser and visit: http://localhost:8080" << std::endl;
@@ -0,0 +1,33 @@
+#include "EmbeddedAssets.h"
+#include <algorithm>
+#include <cstring>
+
+namespace sysmonitor {
+
+#ifdef SYSMONITOR_NO_EMBEDDED_ASSETS
+// 未启用资源嵌入（SYSMONITOR_EMBED_WEBCLIENT=OFF），前端只能从磁盘提供
+const EmbeddedAsset* EmbeddedAssetTable() { return nullptr; }
+size_t EmbeddedAssetCount() { return 0; }
+#endif
+
+const EmbeddedAsset* FindEmbeddedAsset(const std::string& path) {
+    const EmbeddedAsset* begin = EmbeddedAssetTable();
+    const EmbeddedAsset* end = begin + EmbeddedAssetCount();
+    if (begin == end) return nullptr;
+
+    std::string key = path;
+    if (key.empty() || key.back() == '/') {
+        key += "index.html";
+    }
+
+    // 生成器按字节序排序，这里用同样的无符号比较
+    auto it = std::lower_bound(begin, end, key, [](const EmbeddedAsset& asset, const std::string& k) {
+        return std::strcmp(asset.path, k.c_str()) < 0;
+    });
+    if (it != end && key == it->path) {
+        return it;
+    }
+    return nullptr;
+}
+
+} // namespace sysmonitor
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace sysmonitor {
+
+// 编译期嵌入的静态资源（由 cmake/EmbedWebAssets.cmake 从 webclient/ 生成）
+struct EmbeddedAsset {
+    const char* path;                // URL 路径，例如 "/index.html"
+    const char* mimeType;
+    const char* etag;                // 带引号的强 ETag，内容 SHA1 前 16 位
+    const unsigned char* data;       // 原始内容
+    size_t size;
+    const unsigned char* gzipData;   // gzip 预压缩内容，不值得压缩时为 nullptr
+    size_t gzipSize;
+};
+
+// 生成代码提供的资源表（按 path 排序）
+const EmbeddedAsset* EmbeddedAssetTable();
+size_t EmbeddedAssetCount();
+
+// 按 URL 路径查找资源，未找到返回 nullptr；"/" 与目录路径映射到其下的 index.html
+const EmbeddedAsset* FindEmbeddedAsset(const std::string& path);
+
+} // namespace sysmonitor
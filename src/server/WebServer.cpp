@@ -7,14 +7,256 @@
 #include "../third_party/nlohmann/json.hpp"
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <map>
 #include "../core/SystemSnapshotCollector.h"
 
 using json = nlohmann::json;
 
 namespace sysmonitor {
 
+namespace {
+
+// /api/processes/top 单个排行的最大条数
+constexpr size_t kMaxTopProcesses = 1000;
+
+// 进程事件接口单次返回的最大条数
+constexpr size_t kMaxProcessEvents = 1000;
+
+// /api/cpu/burst 单次返回的最大样本数
+constexpr size_t kMaxBurstSamples = 5000;
+
+// 解析 "10ms"、"30s"、"500us" 形式的时长，不带单位按毫秒处理
+bool ParseDurationUs(const std::string& text, uint64_t& us) {
+    size_t pos = 0;
+    unsigned long long value;
+    try {
+        value = std::stoull(text, &pos);
+    } catch (const std::exception&) {
+        return false;
+    }
+    const std::string unit = text.substr(pos);
+    uint64_t scale;
+    if (unit == "us") {
+        scale = 1;
+    } else if (unit == "ms" || unit.empty()) {
+        scale = 1000;
+    } else if (unit == "s") {
+        scale = 1000000;
+    } else if (unit == "min") {
+        scale = 60000000;
+    } else {
+        return false;
+    }
+    if (value > UINT64_MAX / scale) {
+        return false;
+    }
+    us = value * scale;
+    return true;
+}
+
+// 使用率保留两位小数，避免 float 转 double 后输出多余的位数
+double RoundPercent(double usage) {
+    return std::round(usage * 100.0) / 100.0;
+}
+
+// CpuTimeBreakdown 的字段与 JSON 名称，历史数据按此顺序压缩存储
+constexpr size_t kCpuTimeCategories = 7;
+constexpr double CpuTimeBreakdown::* kCpuTimeFields[kCpuTimeCategories] = {
+    &CpuTimeBreakdown::user, &CpuTimeBreakdown::system, &CpuTimeBreakdown::irq, &CpuTimeBreakdown::softirq,
+    &CpuTimeBreakdown::iowait, &CpuTimeBreakdown::steal, &CpuTimeBreakdown::idle,
+};
+const char* const kCpuTimeNames[kCpuTimeCategories] = {
+    "user", "system", "irq", "softirq", "iowait", "steal", "idle",
+};
+
+json CpuTimeBreakdownToJson(const CpuTimeBreakdown& breakdown) {
+    json out;
+    for (size_t i = 0; i < kCpuTimeCategories; ++i) {
+        out[kCpuTimeNames[i]] = RoundPercent(breakdown.*kCpuTimeFields[i]);
+    }
+    return out;
+}
+
+void PackCpuTimeBreakdown(const CpuTimeBreakdown& breakdown, uint16_t* out) {
+    for (size_t i = 0; i < kCpuTimeCategories; ++i) {
+        out[i] = static_cast<uint16_t>(std::lround(std::max(0.0, std::min(100.0, breakdown.*kCpuTimeFields[i])) * 100.0));
+    }
+}
+
+json PackedCpuTimeBreakdownToJson(const uint16_t* packed) {
+    json out;
+    for (size_t i = 0; i < kCpuTimeCategories; ++i) {
+        out[kCpuTimeNames[i]] = packed[i] / 100.0;
+    }
+    return out;
+}
+
+// 换页以页/秒、缺页以次/秒计
+json MemoryRatesToJson(double swapIn, double swapOut, double pageFaults, double majorFaults) {
+    return {
+        {"swapInPerSec", RoundPercent(swapIn)},
+        {"swapOutPerSec", RoundPercent(swapOut)},
+        {"pageFaultsPerSec", RoundPercent(pageFaults)},
+        {"majorFaultsPerSec", RoundPercent(majorFaults)},
+    };
+}
+
+json PressureStallToJson(const PressureStall& stall) {
+    return {{"some", RoundPercent(stall.some)}, {"full", RoundPercent(stall.full)}};
+}
+
+json MemoryPressureToJson(const PressureStall& memory, const PressureStall& cpu, const PressureStall& io) {
+    return {
+        {"memory", PressureStallToJson(memory)},
+        {"cpu", PressureStallToJson(cpu)},
+        {"io", PressureStallToJson(io)},
+    };
+}
+
+// 按拓扑把每核心使用率归到封装或 NUMA 节点取平均；groupKey 为输出中的分组字段名
+json GroupCoreUsages(const CpuTopology& topology, const std::vector<double>& coreUsages,
+                     uint32_t LogicalProcessor::* group, const char* groupKey) {
+    std::map<uint32_t, std::pair<double, uint32_t>> sums;
+    for (const LogicalProcessor& cpu : topology.processors) {
+        if (cpu.cpu < coreUsages.size()) {
+            auto& sum = sums[cpu.*group];
+            sum.first += coreUsages[cpu.cpu];
+            ++sum.second;
+        }
+    }
+    json groups = json::array();
+    for (const auto& entry : sums) {
+        groups.push_back({{groupKey, entry.first}, {"usage", RoundPercent(entry.second.first / entry.second.second)}});
+    }
+    return groups;
+}
+
+json NumaNodeMemoryToJson(const NumaNodeMemory& node) {
+    return {{"node", node.node}, {"total", node.total}, {"free", node.free}};
+}
+
+const char* CpuCounterModeName(CpuCounterMode mode) {
+    switch (mode) {
+        case CpuCounterMode::Hardware: return "hardware";
+        case CpuCounterMode::Software: return "software";
+        default: return "none";
+    }
+}
+
+// 只输出当前模式下有值的字段；次数类速率取整
+json CpuCounterRatesToJson(CpuCounterMode mode, const CpuCounterRates& rates) {
+    if (mode == CpuCounterMode::Hardware) {
+        return {
+            {"ipc", RoundPercent(rates.instructionsPerCycle)},
+            {"cyclesPerSec", std::round(rates.cyclesPerSec)},
+            {"instructionsPerSec", std::round(rates.instructionsPerSec)},
+            {"cacheMissesPerSec", std::round(rates.cacheMissesPerSec)},
+            {"branchMissesPerSec", std::round(rates.branchMissesPerSec)},
+            {"cacheMpki", RoundPercent(rates.cacheMissesPerKiloInstructions)},
+            {"branchMpki", RoundPercent(rates.branchMissesPerKiloInstructions)},
+        };
+    }
+    return {
+        {"contextSwitchesPerSec", std::round(rates.contextSwitchesPerSec)},
+        {"migrationsPerSec", std::round(rates.migrationsPerSec)},
+        {"pageFaultsPerSec", std::round(rates.pageFaultsPerSec)},
+        {"majorFaultsPerSec", std::round(rates.majorFaultsPerSec)},
+    };
+}
+
+json CpuBurstStatusToJson(const CpuBurstStatus& status) {
+    return {
+        {"id", status.id},
+        {"running", status.running},
+        {"startTime", status.startTime},
+        {"intervalUs", status.options.intervalUs},
+        {"durationMs", status.options.durationMs},
+        {"maxOverheadPercent", status.options.maxOverheadPercent},
+        {"cores", status.cores},
+        {"capacity", status.capacity},
+        {"samples", status.samples},
+        {"throttled", status.throttled},
+        {"missed", status.missed},
+        {"overheadPercent", status.overheadPercent},
+    };
+}
+
+json ProcessEventToJson(const ProcessEvent& event) {
+    json out;
+    out["seq"] = event.seq;
+    out["timestamp"] = event.timestamp;
+    out["type"] = ProcessEventTypeName(event.type);
+    out["source"] = ProcessEventSourceName(event.source);
+    out["pid"] = event.pid;
+    out["parentPid"] = event.parentPid;
+    out["createTime"] = event.createTime;
+    out["name"] = util::EncodingUtil::ToUTF8(event.name);
+    if (event.type == ProcessEventType::Exit && event.source == ProcessEventSource::Kernel) {
+        out["exitCode"] = event.exitCode;
+    }
+    return out;
+}
+
+json ProcessEventStatsToJson(const ProcessEventJournal::Stats& stats) {
+    return {
+        {"published", stats.published},
+        {"evicted", stats.evicted},
+        {"readerDropped", stats.readerDropped},
+        {"sourceDropped", stats.sourceDropped},
+        {"firstSeq", stats.firstSeq},
+        {"lastSeq", stats.lastSeq},
+    };
+}
+
+// 将后序区间 [begin, end) 构造成嵌套的进程树 JSON，返回区间内的根节点
+// 后序中每个节点的子节点恰好是栈顶的 ChildCount 个已完成节点
+json BuildProcessTreeJson(const ProcessTable& table, const ProcessTree& tree, size_t begin, size_t end) {
+    std::vector<json> stack;
+    for (size_t i = begin; i < end; ++i) {
+        const uint32_t row = tree.postOrder[i];
+        json node;
+        node["pid"] = table.pid[row];
+        node["parentPid"] = table.parentPid[row];
+        node["name"] = util::EncodingUtil::ToUTF8(table.Name(row));
+        node["cpuUsage"] = table.cpuUsage[row];
+        node["workingSetSize"] = table.workingSetSize[row];
+        node["threadCount"] = table.threadCount[row];
+        node["handleCount"] = table.handleCount[row];
+        if (tree.orphan[row]) {
+            node["orphan"] = true;
+        }
+        node["subtree"] = {
+            {"processCount", tree.subtreeProcesses[row]},
+            {"cpuUsage", tree.subtreeCpuUsage[row]},
+            {"workingSetSize", tree.subtreeWorkingSetSize[row]},
+            {"threadCount", tree.subtreeThreadCount[row]},
+            {"handleCount", tree.subtreeHandleCount[row]},
+        };
+
+        json children = json::array();
+        const size_t childCount = tree.ChildCount(row);
+        for (size_t c = stack.size() - childCount; c < stack.size(); ++c) {
+            children.push_back(std::move(stack[c]));
+        }
+        stack.resize(stack.size() - childCount);
+        node["children"] = std::move(children);
+        stack.push_back(std::move(node));
+    }
+
+    json roots = json::array();
+    for (auto& node : stack) {
+        roots.push_back(std::move(node));
+    }
+    return roots;
+}
+
+} // namespace
+
 HttpServer::HttpServer() : port_(8080) {
     cpuInfo_ = SystemInfo::GetCPUInfo();
+    cpuTopology_ = DiscoverCpuTopology();
 }
 
 HttpServer::~HttpServer() {
@@ -26,9 +268,25 @@ bool HttpServer::Start(int port) {
     
     port_ = port;
     server_ = std::make_unique<httplib::Server>();
+
+    // Bounded worker pool: cheap routes run directly on connection threads,
+    // expensive routes additionally go through expensiveLane_
+    connectionStats_ = std::make_shared<ConnectionQueueStats>();
+    expensiveLane_ = std::make_unique<RequestLane>("expensive", poolOptions_.expensiveThreads,
+                                                   poolOptions_.maxExpensiveQueue);
+    server_->new_task_queue = [this] {
+        return new WorkerPool(poolOptions_.ConnectionThreads(), poolOptions_.MaxConnectionThreads(),
+                              poolOptions_.maxConnectionQueue, connectionStats_);
+    };
+    // Headers and body are written separately; without TCP_NODELAY the body waits
+    // for the client's delayed ACK (~40ms per keep-alive request)
+    server_->set_tcp_nodelay(true);
     
     // Set up routes
     SetupRoutes();
+    server_->set_logger([this](const httplib::Request& req, const httplib::Response& res) {
+        RecordRequestMetrics(req, res);
+    });
     
     // Initialize CPU monitoring
     if (!cpuMonitor_.Initialize()) {
@@ -47,6 +305,16 @@ bool HttpServer::Start(int port) {
         std::cout << "  GET /api/cpu/usage    - Get current CPU usage" << std::endl;
         std::cout << "  GET /api/system/info  - Get system information" << std::endl;
         std::cout << "  GET /api/cpu/stream   - Real-time streaming CPU usage" << std::endl;
+        std::cout << "  POST /api/cpu/burst   - High-rate CPU usage capture" << std::endl;
+        std::cout << "  GET /api/cpu/telemetry - Per-core frequency, throttling and temperatures" << std::endl;
+        std::cout << "  GET /api/cpu/topology - Package, core, SMT and NUMA node layout" << std::endl;
+        std::cout << "  GET /api/server/stats - HTTP worker pool statistics" << std::endl;
+        std::cout << "  GET /metrics          - Prometheus metrics" << std::endl;
+        std::cout << "Worker threads: " << poolOptions_.ConnectionThreads()
+                  << " (cheap " << poolOptions_.cheapThreads
+                  << ", expensive " << poolOptions_.expensiveThreads
+                  << ", expensive queue " << poolOptions_.maxExpensiveQueue
+                  << "), up to " << poolOptions_.MaxConnectionThreads() << " for keep-alive connections" << std::endl;
         
         isRunning_ = true;
         server_->listen("0.0.0.0", port_);
@@ -63,7 +331,11 @@ void HttpServer::Stop() {
         server_->stop();
     }
     
+    cpuBurst_.Stop();
     cpuMonitor_.StopMonitoring();
+    cpuTelemetry_.StopMonitoring();
+    memoryMonitor_.StopMonitoring();
+    processMonitor_.StopSampling();
     
     if (serverThread_ && serverThread_->joinable()) {
         serverThread_->join();
@@ -75,7 +347,12 @@ void HttpServer::Stop() {
 void HttpServer::SetupRoutes() {
     // Static file service (for frontend pages)
     // server_->set_mount_point("/", "www");//Test page
-    server_->set_mount_point("/", "webclient");
+    // Embedded assets are served by the catch-all route at the end of this function;
+    // --webclient-dir (or a build without embedded assets) serves from disk instead
+    bool serveFromDisk = !webclientDir_.empty() || EmbeddedAssetCount() == 0;
+    if (serveFromDisk) {
+        server_->set_mount_point("/", webclientDir_.empty() ? "webclient" : webclientDir_);
+    }
 
     // API routes - CPU related
     server_->Get("/api/cpu/info", [this](const httplib::Request& req, httplib::Response& res) {
@@ -93,12 +370,46 @@ void HttpServer::SetupRoutes() {
     server_->Get("/api/cpu/stream", [this](const httplib::Request& req, httplib::Response& res) {
         HandleStreamCPUUsage(req, res);
     });
+
+    server_->Post("/api/cpu/burst", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleStartCPUBurst(req, res);
+    });
+
+    server_->Get("/api/cpu/burst", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleGetCPUBurst(req, res);
+    });
+
+    server_->Delete("/api/cpu/burst", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleStopCPUBurst(req, res);
+    });
+
+    server_->Get("/api/cpu/telemetry", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleGetCPUTelemetry(req, res);
+    });
+
+    server_->Get("/api/cpu/telemetry/history", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleGetCPUTelemetryHistory(req, res);
+    });
+
+    server_->Get("/api/cpu/topology", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleGetCPUTopology(req, res);
+    });
     
     // API routes - Memory related
     server_->Get("/api/memory/usage", [this](const httplib::Request& req, httplib::Response& res) {
         HandleGetMemoryUsage(req, res);
     });
 
+    // HTTP worker pool statistics
+    server_->Get("/api/server/stats", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleGetServerStats(req, res);
+    });
+
+    // Prometheus metrics
+    server_->Get("/metrics", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleGetMetrics(req, res);
+    });
+
     // Historical data routes
     server_->Get("/api/cpu/history", [this](const httplib::Request& req, httplib::Response& res) {
         HandleGetCPUHistory(req, res);
@@ -109,6 +420,7 @@ void HttpServer::SetupRoutes() {
     });
 
     // Add new API routes - Process related
+    // 进程接口只读取后台采样发布的快照，不占用昂贵接口通道
     server_->Get("/api/processes", [this](const httplib::Request& req, httplib::Response& res) {
         HandleGetProcesses(req, res);
     });
@@ -120,6 +432,35 @@ void HttpServer::SetupRoutes() {
     server_->Get("/api/process/find", [this](const httplib::Request& req, httplib::Response& res) {
         HandleFindProcesses(req, res);
     });
+
+    server_->Get("/api/processes/top", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleGetTopProcesses(req, res);
+    });
+
+    server_->Get("/api/process/tree", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleGetProcessTree(req, res);
+    });
+
+    server_->Get("/api/process/(\\d+)/subtree", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleGetProcessSubtree(req, res);
+    });
+
+    // 按需枚举线程，首次查询还要等待一个采样间隔，走昂贵接口通道
+    server_->Get("/api/process/(\\d+)/threads", ExpensiveRoute([this](const httplib::Request& req, httplib::Response& res) {
+        HandleGetProcessThreads(req, res);
+    }));
+
+    server_->Get("/api/process/leaks", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleGetProcessLeaks(req, res);
+    });
+
+    server_->Get("/api/process/events", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleGetProcessEvents(req, res);
+    });
+
+    server_->Get("/api/process/events/stream", [this](const httplib::Request& req, httplib::Response& res) {
+        HandleStreamProcessEvents(req, res);
+    });
     
     // server_->Post("/api/process/(\\d+)/terminate", [this](const httplib::Request& req, httplib::Response& res) {
     //     HandleTerminateProcess(req, res);
@@ -127,23 +468,23 @@ void HttpServer::SetupRoutes() {
 
 
     // Disk related routes
-    server_->Get("/api/disk/info", [this](const httplib::Request& req, httplib::Response& res) {
+    server_->Get("/api/disk/info", ExpensiveRoute([this](const httplib::Request& req, httplib::Response& res) {
         HandleGetDiskInfo(req, res);
-    });
+    }));
     
-    server_->Get("/api/disk/performance", [this](const httplib::Request& req, httplib::Response& res) {
+    server_->Get("/api/disk/performance", ExpensiveRoute([this](const httplib::Request& req, httplib::Response& res) {
         HandleGetDiskPerformance(req, res);
-    });
+    }));
 
     // Add OPTIONS request handling (for CORS preflight)
-    server_->Options("/api/disk/info", [](const httplib::Request& req, httplib::Response& res) {
+    server_->Options("/api/disk/info", [](const httplib::Request& /*req*/, httplib::Response& res) {
         res.set_header("Access-Control-Allow-Origin", "*");
         res.set_header("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
         res.set_header("Access-Control-Allow-Headers", "Content-Type");
         res.status = 200;
     });
     
-    server_->Options("/api/disk/performance", [](const httplib::Request& req, httplib::Response& res) {
+    server_->Options("/api/disk/performance", [](const httplib::Request& /*req*/, httplib::Response& res) {
         res.set_header("Access-Control-Allow-Origin", "*");
         res.set_header("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
         res.set_header("Access-Control-Allow-Headers", "Content-Type");
@@ -152,68 +493,75 @@ void HttpServer::SetupRoutes() {
 
 
     // Registry related APIs
-    server_->Get("/api/registry/snapshot", [this](const httplib::Request& req, httplib::Response& res) {
+    server_->Get("/api/registry/snapshot", [this](const httplib::Request& /*req*/, httplib::Response& /*res*/) {
         // HandleGetRegistrySnapshot(req, res);
     });
     
-    server_->Get("/api/registry/snapshot/save", [this](const httplib::Request& req, httplib::Response& res) {
+    server_->Get("/api/registry/snapshot/save", ExpensiveRoute([this](const httplib::Request& req, httplib::Response& res) {
         // HandleSaveRegistrySnapshot(req, res);
         HandleSaveRegistry(req, res);
-    });
+    }));
     
-    server_->Get("/api/registry/snapshot/Info", [this](const httplib::Request& req, httplib::Response& res) {
+    server_->Get("/api/registry/snapshot/Info", ExpensiveRoute([this](const httplib::Request& req, httplib::Response& res) {
         // HandleGetSavedSnapshots(req, res);
         HandleGetRegistryInfo(req, res);
-    });
+    }));
     
-    server_->Post("/api/registry/snapshot/compare", [this](const httplib::Request& req, httplib::Response& res) {
+    server_->Post("/api/registry/snapshot/compare", ExpensiveRoute([this](const httplib::Request& req, httplib::Response& res) {
         // HandleCompareSnapshots(req, res);
         HandleCompareFolders(req, res);
-    });
+    }));
     
-    server_->Delete("/api/registry/snapshots/delete/([^/]+)", [this](const httplib::Request& req, httplib::Response& res) {
+    server_->Delete("/api/registry/snapshots/delete/([^/]+)", ExpensiveRoute([this](const httplib::Request& req, httplib::Response& res) {
     HandleDeleteSnapshot(req, res);
-    });
+    }));
 
 
     // Driver information
-    server_->Get("/api/drivers/snapshot", [this](const httplib::Request& req, httplib::Response& res) {
+    server_->Get("/api/drivers/snapshot", ExpensiveRoute([this](const httplib::Request& req, httplib::Response& res) {
         HandleGetDriverSnapshot(req, res);
-    });
+    }));
     
-    server_->Get("/api/drivers/detail", [this](const httplib::Request& req, httplib::Response& res) {
+    server_->Get("/api/drivers/detail", ExpensiveRoute([this](const httplib::Request& req, httplib::Response& res) {
         HandleGetDriverDetail(req, res);
-    });
+    }));
 
     // SystemSnapshot
-    server_->Post("/api/system/snapshot/create", [this](const httplib::Request& req, httplib::Response& res) {
+    server_->Post("/api/system/snapshot/create", ExpensiveRoute([this](const httplib::Request& req, httplib::Response& res) {
         HandleCreateSystemSnapshot(req, res);
-    });
+    }));
 
     server_->Get("/api/system/snapshot/list", [this](const httplib::Request& req, httplib::Response& res) {
         HandleListSystemSnapshots(req, res);
     });
 
-    server_->Get("/api/system/snapshot/get", [this](const httplib::Request& req, httplib::Response& res) {
+    server_->Get("/api/system/snapshot/get", ExpensiveRoute([this](const httplib::Request& req, httplib::Response& res) {
         HandleGetSystemSnapshot(req, res);
-    });
+    }));
 
-    server_->Post("/api/system/snapshot/save", [this](const httplib::Request& req, httplib::Response& res) {
+    server_->Post("/api/system/snapshot/save", ExpensiveRoute([this](const httplib::Request& req, httplib::Response& res) {
         HandleSaveSystemSnapshot(req, res);
-    });
+    }));
 
-    server_->Post("/api/system/snapshot/compare", [this](const httplib::Request& req, httplib::Response& res) {
+    server_->Post("/api/system/snapshot/compare", ExpensiveRoute([this](const httplib::Request& req, httplib::Response& res) {
         HandleCompareSystemSnapshots(req, res);
-    });
+    }));
 
     server_->Delete("/api/system/snapshot/delete/([^/]+)", [this](const httplib::Request& req, httplib::Response& res) {
         HandleDeleteSystemSnapshot(req, res);
     });
 
     // 默认路由
-    server_->Get("/", [](const httplib::Request& req, httplib::Response& res) {
+    server_->Get("/", [](const httplib::Request& /*req*/, httplib::Response& res) {
         res.set_redirect("/index.html");
     });
+
+    // Embedded frontend assets, must stay the last GET route
+    if (!serveFromDisk) {
+        server_->Get("/.*", [this](const httplib::Request& req, httplib::Response& res) {
+            HandleGetEmbeddedAsset(req, res);
+        });
+    }
 }
 
 void HttpServer::StartBackgroundMonitoring() {
@@ -221,10 +569,14 @@ void HttpServer::StartBackgroundMonitoring() {
     cpuMonitor_.SetUsageCallback([this](const CPUUsage& usage) {
         currentUsage_.store(usage.totalUsage);
 
-        Sample s{GET_LOCAL_TIME_MS(), usage.totalUsage};
+        CpuSample s{GET_LOCAL_TIME_MS(), usage.totalUsage, usage.breakdown, {}};
+        s.coreBreakdowns.resize(usage.coreBreakdowns.size() * kCpuTimeCategories);
+        for (size_t i = 0; i < usage.coreBreakdowns.size(); ++i) {
+            PackCpuTimeBreakdown(usage.coreBreakdowns[i], &s.coreBreakdowns[i * kCpuTimeCategories]);
+        }
         {
             std::lock_guard<std::mutex> lk(cpuHistoryMutex_);
-            cpuHistory_.push_back(s);
+            cpuHistory_.push_back(std::move(s));
             if (cpuHistory_.size() > maxHistorySamples_) {
                 cpuHistory_.erase(cpuHistory_.begin(), cpuHistory_.begin() + (cpuHistory_.size() - maxHistorySamples_));
             }
@@ -232,7 +584,12 @@ void HttpServer::StartBackgroundMonitoring() {
     });
 
     // Start CPU monitoring
-    cpuMonitor_.StartMonitoring(1000);
+    if (cpuCounters_ && !cpuMonitor_.EnableCounters()) {
+        std::cout << "CPU performance counters unavailable (need Linux perf_event_open with CAP_PERFMON "
+                     "or perf_event_paranoid <= 0)" << std::endl;
+    }
+    cpuMonitor_.StartMonitoring(scheduler_, 1000);
+    cpuTelemetry_.StartMonitoring(scheduler_, 1000);
 
     // Set memory usage callback and record historical samples
     memoryMonitor_.SetUsageCallback([this](const MemoryUsage& usage) {
@@ -241,7 +598,11 @@ void HttpServer::StartBackgroundMonitoring() {
             memoryUsage_ = usage;
         }
 
-        Sample s{usage.timestamp ? usage.timestamp : GET_LOCAL_TIME_MS(), usage.usedPercent};
+        MemorySample s{usage.timestamp ? usage.timestamp : GET_LOCAL_TIME_MS(), usage.usedPercent,
+                       usage.commitCharge, usage.cached, usage.swapUsed,
+                       static_cast<float>(usage.swapInPerSec), static_cast<float>(usage.swapOutPerSec),
+                       static_cast<float>(usage.pageFaultsPerSec), static_cast<float>(usage.majorFaultsPerSec),
+                       usage.hasPressure, usage.memoryPressure, usage.cpuPressure, usage.ioPressure};
         {
             std::lock_guard<std::mutex> lk(memoryHistoryMutex_);
             memoryHistory_.push_back(s);
@@ -252,10 +613,205 @@ void HttpServer::StartBackgroundMonitoring() {
     });
 
     // Start memory monitoring
-    memoryMonitor_.StartMonitoring(1000);
+    memoryMonitor_.StartMonitoring(scheduler_, 1000);
+
+    // 进程列表由后台线程采样，/api/processes 等接口只读取已发布的快照
+    if (kernelProcessEvents_) {
+        processMonitor_.EnableKernelProcessEvents();
+    }
+    if (leakWindowSeconds_ > 0) {
+        LeakDetectorOptions leakOptions = processMonitor_.GetLeakDetectorOptions();
+        leakOptions.windowSeconds = leakWindowSeconds_;
+        processMonitor_.SetLeakDetectorOptions(leakOptions);
+    }
+    processMonitor_.StartSampling(scheduler_, 1000);
+}
+
+httplib::Server::Handler HttpServer::ExpensiveRoute(httplib::Server::Handler handler) {
+    return [this, handler = std::move(handler)](const httplib::Request& req, httplib::Response& res) {
+        RequestLane::Ticket ticket(*expensiveLane_);
+        if (!ticket) {
+            json error;
+            error["success"] = false;
+            error["error"] = "Server busy, please retry later";
+            res.status = 503;
+            res.set_header("Retry-After", "1");
+            res.set_content(error.dump(), "application/json");
+            return;
+        }
+        handler(req, res);
+    };
+}
+
+void HttpServer::HandleGetServerStats(const httplib::Request& /*req*/, httplib::Response& res) {
+    json response;
+
+    if (connectionStats_) {
+        const auto& c = *connectionStats_;
+        response["connections"]["threads"] = c.threads.load();
+        response["connections"]["maxThreads"] = poolOptions_.MaxConnectionThreads();
+        response["connections"]["busy"] = c.busy.load();
+        response["connections"]["queueDepth"] = c.depth.load();
+        response["connections"]["maxQueue"] = poolOptions_.maxConnectionQueue;
+        response["connections"]["accepted"] = c.accepted.load();
+        response["connections"]["rejected"] = c.rejected.load();
+        response["connections"]["waitAvgMs"] = c.wait.AverageMs();
+        response["connections"]["waitMaxMs"] = c.wait.maxUs.load() / 1000.0;
+        response["connections"]["waitLastMs"] = c.wait.lastUs.load() / 1000.0;
+    }
+
+    if (expensiveLane_) {
+        const auto& lane = *expensiveLane_;
+        json laneJson;
+        laneJson["active"] = lane.Active();
+        laneJson["maxActive"] = lane.MaxActive();
+        laneJson["queueDepth"] = lane.Queued();
+        laneJson["maxQueue"] = lane.MaxQueued();
+        laneJson["admitted"] = lane.Admitted();
+        laneJson["rejected"] = lane.Rejected();
+        laneJson["waitAvgMs"] = lane.Wait().AverageMs();
+        laneJson["waitMaxMs"] = lane.Wait().maxUs.load() / 1000.0;
+        laneJson["waitLastMs"] = lane.Wait().lastUs.load() / 1000.0;
+        response["lanes"][lane.Name()] = laneJson;
+    }
+    response["lanes"]["cheap"]["reservedThreads"] = poolOptions_.cheapThreads;
+
+    // 周期采集任务：lateness 为实际开始时间与计划时间之差
+    response["scheduler"] = json::array();
+    for (const auto& task : scheduler_.GetStats()) {
+        json taskJson;
+        taskJson["name"] = task.name;
+        taskJson["intervalMs"] = task.intervalMs;
+        taskJson["runs"] = task.runs;
+        taskJson["skipped"] = task.skipped;
+        taskJson["latenessAvgMs"] = task.runs ? static_cast<double>(task.totalLatenessUs) / task.runs / 1000.0 : 0.0;
+        taskJson["latenessMaxMs"] = task.maxLatenessUs / 1000.0;
+        taskJson["latenessLastMs"] = task.lastLatenessUs / 1000.0;
+        taskJson["durationLastMs"] = task.lastDurationUs / 1000.0;
+        response["scheduler"].push_back(taskJson);
+    }
+    response["timestamp"] = GET_LOCAL_TIME_MS();
+
+    res.set_content(response.dump(), "application/json");
+}
+
+void HttpServer::RecordRequestMetrics(const httplib::Request& req, const httplib::Response& res) {
+    // 未命中任何路由：挂载目录提供的静态文件或 404
+    std::string route = req.matched_route;
+    if (route.empty()) {
+        route = res.status < 400 ? "static" : "unmatched";
+    }
+    std::string key = req.method + " " + route;
+
+    RouteMetrics* m = nullptr;
+    {
+        std::shared_lock<std::shared_mutex> lk(routeMetricsMutex_);
+        auto it = routeMetrics_.find(key);
+        if (it != routeMetrics_.end()) m = &it->second;
+    }
+    if (!m) {
+        auto& registry = metrics::Registry::Instance();
+        metrics::Labels labels{{"method", req.method}, {"route", route}};
+        metrics::Labels client = labels, server = labels;
+        client.emplace_back("class", "4xx");
+        server.emplace_back("class", "5xx");
+
+        RouteMetrics created{
+            &registry.Histogram("sysmon_http_request_duration_seconds", "HTTP request latency by route", labels),
+            &registry.GetCounter("sysmon_http_requests_total", "HTTP requests by route", labels),
+            &registry.GetCounter("sysmon_http_request_bytes_total", "HTTP request body bytes by route", labels),
+            &registry.GetCounter("sysmon_http_response_bytes_total", "HTTP response body bytes by route", labels),
+            &registry.GetCounter("sysmon_http_request_errors_total", "HTTP error responses by route and status class", client),
+            &registry.GetCounter("sysmon_http_request_errors_total", "HTTP error responses by route and status class", server),
+        };
+        std::unique_lock<std::shared_mutex> lk(routeMetricsMutex_);
+        m = &routeMetrics_.emplace(key, created).first->second;
+    }
+
+    if (req.start_time_ != (std::chrono::steady_clock::time_point::min)()) {
+        auto elapsed = std::chrono::steady_clock::now() - req.start_time_;
+        m->latency->Record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    }
+    m->requests->Add();
+    m->requestBytes->Add(req.body.size());
+    // content provider 响应（嵌入资源）的 body 为空，按 Content-Length 统计
+    m->responseBytes->Add(res.body.empty() ? res.get_header_value_u64("Content-Length") : res.body.size());
+    if (res.status >= 500) {
+        m->serverErrors->Add();
+    } else if (res.status >= 400) {
+        m->clientErrors->Add();
+    }
+}
+
+void HttpServer::HandleGetMetrics(const httplib::Request& /*req*/, httplib::Response& res) {
+    std::ostringstream out;
+    out << metrics::Registry::Instance().RenderPrometheus();
+
+    auto metric = [&out](const char* type, const char* name, const char* help, double value,
+                         const std::string& labels = "") {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " " << type << "\n";
+        out << name << labels << " " << value << "\n";
+    };
+
+    if (connectionStats_) {
+        const auto& c = *connectionStats_;
+        metric("gauge", "sysmon_http_worker_threads", "HTTP connection worker threads", static_cast<double>(c.threads.load()));
+        metric("gauge", "sysmon_http_worker_busy", "HTTP connection workers currently serving", static_cast<double>(c.busy.load()));
+        metric("gauge", "sysmon_http_connection_queue_depth", "Connections waiting for a worker", static_cast<double>(c.depth.load()));
+        metric("counter", "sysmon_http_connections_rejected_total", "Connections dropped because the queue was full", static_cast<double>(c.rejected.load()));
+        metric("gauge", "sysmon_http_connection_wait_avg_seconds", "Average connection queue wait", c.wait.AverageMs() / 1000.0);
+        metric("gauge", "sysmon_http_connection_wait_max_seconds", "Maximum connection queue wait", c.wait.maxUs.load() / 1e6);
+    }
+    if (expensiveLane_) {
+        const auto& lane = *expensiveLane_;
+        std::string labels = metrics::FormatLabels({{"lane", lane.Name()}});
+        metric("gauge", "sysmon_http_lane_active", "Requests running in a lane", static_cast<double>(lane.Active()), labels);
+        metric("gauge", "sysmon_http_lane_queue_depth", "Requests waiting for a lane slot", static_cast<double>(lane.Queued()), labels);
+        metric("counter", "sysmon_http_lane_rejected_total", "Requests shed with 503 by a lane", static_cast<double>(lane.Rejected()), labels);
+        metric("gauge", "sysmon_http_lane_wait_avg_seconds", "Average lane wait", lane.Wait().AverageMs() / 1000.0, labels);
+        metric("gauge", "sysmon_http_lane_wait_max_seconds", "Maximum lane wait", lane.Wait().maxUs.load() / 1e6, labels);
+    }
+
+    res.set_content(out.str(), "text/plain; version=0.0.4; charset=utf-8");
+}
+
+void HttpServer::HandleGetEmbeddedAsset(const httplib::Request& req, httplib::Response& res) {
+    const EmbeddedAsset* asset = FindEmbeddedAsset(req.path);
+    if (!asset) {
+        res.status = 404;
+        return;
+    }
+
+    res.set_header("ETag", asset->etag);
+    res.set_header("Cache-Control", "no-cache");
+    if (asset->gzipData) {
+        res.set_header("Vary", "Accept-Encoding");
+    }
+
+    std::string ifNoneMatch = req.get_header_value("If-None-Match");
+    if (!ifNoneMatch.empty() && ifNoneMatch.find(asset->etag) != std::string::npos) {
+        res.status = 304;
+        return;
+    }
+
+    const unsigned char* data = asset->data;
+    size_t size = asset->size;
+    if (asset->gzipData && req.get_header_value("Accept-Encoding").find("gzip") != std::string::npos) {
+        data = asset->gzipData;
+        size = asset->gzipSize;
+        res.set_header("Content-Encoding", "gzip");
+    }
+
+    // 直接从静态数组写出，不复制到 res.body
+    res.set_content_provider(size, asset->mimeType,
+        [data](size_t offset, size_t length, httplib::DataSink& sink) {
+            return sink.write(reinterpret_cast<const char*>(data) + offset, length);
+        });
 }
 
-void HttpServer::HandleGetCPUInfo(const httplib::Request& req, httplib::Response& res) {
+void HttpServer::HandleGetCPUInfo(const httplib::Request& /*req*/, httplib::Response& res) {
     json response;
     
     response["name"] = cpuInfo_.name;
@@ -270,7 +826,7 @@ void HttpServer::HandleGetCPUInfo(const httplib::Request& req, httplib::Response
     res.set_content(response.dump(), "application/json");
 }
 
-void HttpServer::HandleGetCPUUsage(const httplib::Request& req, httplib::Response& res) {
+void HttpServer::HandleGetCPUUsage(const httplib::Request& /*req*/, httplib::Response& res) {
     json response;
     
     double usage = currentUsage_.load();
@@ -282,16 +838,52 @@ void HttpServer::HandleGetCPUUsage(const httplib::Request& req, httplib::Respons
     response["usage"] = rounded_usage;
     response["timestamp"] = GET_LOCAL_TIME_MS();
     response["unit"] = "percent";
+
+    // 后台采样运行时为最近一次采样的结果，不会重新采样
+    CPUUsage current = cpuMonitor_.GetCurrentUsage();
+    json cores = json::array();
+    for (double core : current.coreUsages) {
+        cores.push_back(RoundPercent(core));
+    }
+    response["packageUsages"] = GroupCoreUsages(cpuTopology_, current.coreUsages, &LogicalProcessor::package, "package");
+    response["nodeUsages"] = GroupCoreUsages(cpuTopology_, current.coreUsages, &LogicalProcessor::node, "node");
+    response["coreUsages"] = std::move(cores);
+    response["breakdown"] = CpuTimeBreakdownToJson(current.breakdown);
+    json coreBreakdowns = json::array();
+    for (const auto& breakdown : current.coreBreakdowns) {
+        coreBreakdowns.push_back(CpuTimeBreakdownToJson(breakdown));
+    }
+    response["coreBreakdowns"] = std::move(coreBreakdowns);
+
+    response["counterMode"] = CpuCounterModeName(current.counterMode);
+    if (current.counterMode != CpuCounterMode::None) {
+        response["counters"] = CpuCounterRatesToJson(current.counterMode, current.counters);
+        json coreCounters = json::array();
+        for (const auto& rates : current.coreCounters) {
+            coreCounters.push_back(CpuCounterRatesToJson(current.counterMode, rates));
+        }
+        response["coreCounters"] = std::move(coreCounters);
+    }
     
     res.set_content(response.dump(), "application/json");
 }
 
 void HttpServer::HandleGetCPUHistory(const httplib::Request& req, httplib::Response& res) {
     try {
+        // cores=1 时每个样本附带每核心的时间细分
+        const bool withCores = req.has_param("cores") && req.get_param_value("cores") == "1";
         json arr = json::array();
         std::lock_guard<std::mutex> lk(cpuHistoryMutex_);
         for (const auto &s : cpuHistory_) {
-            arr.push_back({{"timestamp", s.timestamp}, {"value", s.value}});
+            json item = {{"timestamp", s.timestamp}, {"value", s.value}, {"breakdown", CpuTimeBreakdownToJson(s.breakdown)}};
+            if (withCores) {
+                json cores = json::array();
+                for (size_t i = 0; i + kCpuTimeCategories <= s.coreBreakdowns.size(); i += kCpuTimeCategories) {
+                    cores.push_back(PackedCpuTimeBreakdownToJson(&s.coreBreakdowns[i]));
+                }
+                item["coreBreakdowns"] = std::move(cores);
+            }
+            arr.push_back(std::move(item));
         }
         res.set_content(arr.dump(), "application/json");
     } catch (const std::exception& e) {
@@ -302,12 +894,24 @@ void HttpServer::HandleGetCPUHistory(const httplib::Request& req, httplib::Respo
     }
 }
 
-void HttpServer::HandleGetMemoryHistory(const httplib::Request& req, httplib::Response& res) {
+void HttpServer::HandleGetMemoryHistory(const httplib::Request& /*req*/, httplib::Response& res) {
     try {
         json arr = json::array();
         std::lock_guard<std::mutex> lk(memoryHistoryMutex_);
         for (const auto &s : memoryHistory_) {
-            arr.push_back({{"timestamp", s.timestamp}, {"value", s.value}});
+            json item = {
+                {"timestamp", s.timestamp},
+                {"value", s.value},
+                {"commitCharge", s.commitCharge},
+                {"cached", s.cached},
+                {"swapUsed", s.swapUsed},
+                {"rates", MemoryRatesToJson(s.swapInPerSec, s.swapOutPerSec, s.pageFaultsPerSec, s.majorFaultsPerSec)},
+            };
+            // 平台不支持 PSI 时不输出 pressure
+            if (s.hasPressure) {
+                item["pressure"] = MemoryPressureToJson(s.memoryPressure, s.cpuPressure, s.ioPressure);
+            }
+            arr.push_back(std::move(item));
         }
         res.set_content(arr.dump(), "application/json");
     } catch (const std::exception& e) {
@@ -318,7 +922,7 @@ void HttpServer::HandleGetMemoryHistory(const httplib::Request& req, httplib::Re
     }
 }
 
-void HttpServer::HandleGetMemoryUsage(const httplib::Request& req, httplib::Response& res) {
+void HttpServer::HandleGetMemoryUsage(const httplib::Request& /*req*/, httplib::Response& res) {
     json response;
 
     MemoryUsage snapshot = memoryMonitor_.GetCurrentUsage();
@@ -334,10 +938,26 @@ void HttpServer::HandleGetMemoryUsage(const httplib::Request& req, httplib::Resp
     response["timestamp"] = snapshot.timestamp;
     response["unit"] = "bytes";
 
+    response["commitCharge"] = snapshot.commitCharge;
+    response["commitLimit"] = snapshot.commitLimit;
+    response["cached"] = snapshot.cached;
+    response["swapTotal"] = snapshot.swapTotal;
+    response["swapUsed"] = snapshot.swapUsed;
+    response["rates"] = MemoryRatesToJson(snapshot.swapInPerSec, snapshot.swapOutPerSec,
+                                          snapshot.pageFaultsPerSec, snapshot.majorFaultsPerSec);
+    if (snapshot.hasPressure) {
+        response["pressure"] = MemoryPressureToJson(snapshot.memoryPressure, snapshot.cpuPressure, snapshot.ioPressure);
+    }
+    json nodes = json::array();
+    for (const NumaNodeMemory& node : snapshot.nodes) {
+        nodes.push_back(NumaNodeMemoryToJson(node));
+    }
+    response["nodes"] = std::move(nodes);
+
     res.set_content(response.dump(), "application/json");
 }
 
-void HttpServer::HandleGetSystemInfo(const httplib::Request& req, httplib::Response& res) {
+void HttpServer::HandleGetSystemInfo(const httplib::Request& /*req*/, httplib::Response& res) {
     json response;
     
     // Basic system information
@@ -353,7 +973,7 @@ void HttpServer::HandleGetSystemInfo(const httplib::Request& req, httplib::Respo
     res.set_content(response.dump(), "application/json");
 }
 
-void HttpServer::HandleStreamCPUUsage(const httplib::Request& req, httplib::Response& res) {
+void HttpServer::HandleStreamCPUUsage(const httplib::Request& /*req*/, httplib::Response& res) {
     // Set Server-Sent Events (SSE) headers
     res.set_header("Content-Type", "text/event-stream");
     res.set_header("Cache-Control", "no-cache");
@@ -368,21 +988,237 @@ void HttpServer::HandleStreamCPUUsage(const httplib::Request& req, httplib::Resp
     // Note: This is a simplified streaming implementation, production environment requires more complex connection management
 }
 
-void HttpServer::HandleGetProcesses(const httplib::Request& req, httplib::Response& res) {
+void HttpServer::HandleStartCPUBurst(const httplib::Request& req, httplib::Response& res) {
+    auto badRequest = [&res](int status, const std::string& message) {
+        res.status = status;
+        json error;
+        error["error"] = message;
+        res.set_content(error.dump(), "application/json");
+    };
+
+    CpuBurstOptions options;
+    uint64_t us = 0;
+    if (req.has_param("interval")) {
+        if (!ParseDurationUs(req.get_param_value("interval"), us) || us > UINT32_MAX) {
+            badRequest(400, "Invalid interval: " + req.get_param_value("interval"));
+            return;
+        }
+        options.intervalUs = static_cast<uint32_t>(us);
+    }
+    if (req.has_param("duration")) {
+        if (!ParseDurationUs(req.get_param_value("duration"), us) || us / 1000 > UINT32_MAX) {
+            badRequest(400, "Invalid duration: " + req.get_param_value("duration"));
+            return;
+        }
+        options.durationMs = static_cast<uint32_t>(us / 1000);
+    }
+    if (req.has_param("maxOverhead")) {
+        try {
+            options.maxOverheadPercent = std::stod(req.get_param_value("maxOverhead"));
+        } catch (const std::exception&) {
+            badRequest(400, "Invalid maxOverhead: " + req.get_param_value("maxOverhead"));
+            return;
+        }
+    }
+
+    std::string error;
+    if (!cpuBurst_.Start(options, error)) {
+        // 已有采集在进行时返回 409，其余为参数错误
+        badRequest(cpuBurst_.GetStatus().running ? 409 : 400, error);
+        return;
+    }
+    res.status = 202;
+    res.set_content(CpuBurstStatusToJson(cpuBurst_.GetStatus()).dump(), "application/json");
+}
+
+// 增量读取：since 为已取得的样本数，按返回的 next 继续轮询，直到 running 为 false 且没有新样本
+void HttpServer::HandleGetCPUBurst(const httplib::Request& req, httplib::Response& res) {
+    try {
+        size_t since = req.has_param("since") ? static_cast<size_t>(std::stoull(req.get_param_value("since"))) : 0;
+        size_t limit = kMaxBurstSamples;
+        if (req.has_param("limit")) {
+            limit = std::min(static_cast<size_t>(std::stoull(req.get_param_value("limit"))), kMaxBurstSamples);
+        }
+
+        std::vector<CpuBurstSample> samples;
+        CpuBurstStatus status = cpuBurst_.Read(since, limit, samples);
+        if (status.id == 0) {
+            res.status = 404;
+            res.set_content(json{{"error", "No burst capture has been started"}}.dump(), "application/json");
+            return;
+        }
+
+        json response = CpuBurstStatusToJson(status);
+        json items = json::array();
+        for (const auto& sample : samples) {
+            json cores = json::array();
+            for (float usage : sample.coreUsages) {
+                cores.push_back(RoundPercent(usage));
+            }
+            items.push_back({{"t", sample.offsetUs}, {"total", RoundPercent(sample.totalUsage)}, {"cores", std::move(cores)}});
+        }
+        response["next"] = since + samples.size();
+        response["data"] = std::move(items);
+        res.set_content(response.dump(), "application/json");
+
+    } catch (const std::exception& e) {
+        json error;
+        error["error"] = e.what();
+        res.status = 400;
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
+void HttpServer::HandleStopCPUBurst(const httplib::Request& /*req*/, httplib::Response& res) {
+    cpuBurst_.Stop();
+    res.set_content(CpuBurstStatusToJson(cpuBurst_.GetStatus()).dump(), "application/json");
+}
+
+void HttpServer::HandleGetCPUTelemetry(const httplib::Request& /*req*/, httplib::Response& res) {
+    auto latest = cpuTelemetry_.GetLatest();
+    if (!latest) {
+        res.status = 503;
+        res.set_content(json{{"error", "CPU telemetry not sampled yet"}}.dump(), "application/json");
+        return;
+    }
+
+    json response;
+    response["timestamp"] = latest->timestamp;
+    response["throttleCounters"] = latest->throttleCounters;
+    response["cores"] = json::array();
+    for (const auto& core : latest->cores) {
+        response["cores"].push_back({
+            {"currentMHz", core.currentMHz},
+            {"limitMHz", core.limitMHz},
+            {"maxMHz", core.maxMHz},
+            {"coreThrottleCount", core.coreThrottleCount},
+            {"packageThrottleCount", core.packageThrottleCount},
+        });
+    }
+    // 读取失败的传感器为 NaN，输出为 null
+    response["temperatures"] = json::array();
+    for (size_t i = 0; i < latest->sensorNames.size(); ++i) {
+        response["temperatures"].push_back({{"name", latest->sensorNames[i]}, {"celsius", latest->temperatures[i]}});
+    }
+    res.set_content(response.dump(), "application/json");
+}
+
+// 每个样本给出频率与降频的汇总；cores=1 时附带每个核心的数据
+void HttpServer::HandleGetCPUTelemetryHistory(const httplib::Request& req, httplib::Response& res) {
+    try {
+        uint64_t since = req.has_param("since") ? std::stoull(req.get_param_value("since")) : 0;
+        const bool withCores = req.has_param("cores") && req.get_param_value("cores") == "1";
+
+        auto latest = cpuTelemetry_.GetLatest();
+        auto samples = cpuTelemetry_.GetHistory(since);
+
+        json response;
+        response["sensors"] = latest ? latest->sensorNames : std::vector<std::string>();
+        response["samples"] = json::array();
+        for (const auto& sample : samples) {
+            uint64_t sumMHz = 0;
+            uint32_t minMHz = 0, maxMHz = 0, reporting = 0, limited = 0, throttled = 0;
+            for (size_t i = 0; i < sample.coreMHz.size(); ++i) {
+                const uint32_t mhz = sample.coreMHz[i];
+                if (mhz > 0) {
+                    sumMHz += mhz;
+                    minMHz = reporting == 0 ? mhz : std::min(minMHz, mhz);
+                    maxMHz = std::max(maxMHz, mhz);
+                    ++reporting;
+                }
+                const uint32_t hardwareMax = latest && i < latest->cores.size() ? latest->cores[i].maxMHz : 0;
+                if (sample.coreLimitMHz[i] > 0 && hardwareMax > 0 && sample.coreLimitMHz[i] < hardwareMax) {
+                    ++limited;
+                }
+                if (sample.coreThrottleEvents[i] > 0 || sample.packageThrottleEvents[i] > 0) {
+                    ++throttled;
+                }
+            }
+
+            json item;
+            item["timestamp"] = sample.timestamp;
+            item["avgMHz"] = reporting > 0 ? static_cast<double>(sumMHz) / reporting : 0.0;
+            item["minMHz"] = minMHz;
+            item["maxMHz"] = maxMHz;
+            item["limitedCores"] = limited;
+            item["throttledCores"] = throttled;
+            item["temperatures"] = sample.temperatures;
+            if (withCores) {
+                json cores = json::array();
+                for (size_t i = 0; i < sample.coreMHz.size(); ++i) {
+                    cores.push_back({
+                        {"mhz", sample.coreMHz[i]},
+                        {"limitMHz", sample.coreLimitMHz[i]},
+                        {"coreThrottleEvents", sample.coreThrottleEvents[i]},
+                        {"packageThrottleEvents", sample.packageThrottleEvents[i]},
+                    });
+                }
+                item["cores"] = std::move(cores);
+            }
+            response["samples"].push_back(std::move(item));
+        }
+        res.set_content(response.dump(), "application/json");
+
+    } catch (const std::exception& e) {
+        json error;
+        error["error"] = e.what();
+        res.status = 400;
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
+void HttpServer::HandleGetCPUTopology(const httplib::Request& /*req*/, httplib::Response& res) {
+    json processors = json::array();
+    for (const LogicalProcessor& cpu : cpuTopology_.processors) {
+        processors.push_back({
+            {"cpu", cpu.cpu},
+            {"package", cpu.package},
+            {"core", cpu.core},
+            {"thread", cpu.thread},
+            {"node", cpu.node},
+        });
+    }
+
+    // 节点内存取内存监控最近一次采样
+    const MemoryUsage memory = memoryMonitor_.GetCurrentUsage();
+    json nodes = json::array();
+    for (const NumaNodeTopology& node : cpuTopology_.nodes) {
+        json item = {{"node", node.node}, {"cpus", node.cpus}};
+        auto it = std::find_if(memory.nodes.begin(), memory.nodes.end(),
+                               [&](const NumaNodeMemory& m) { return m.node == node.node; });
+        if (it != memory.nodes.end()) {
+            item["memory"] = NumaNodeMemoryToJson(*it);
+        }
+        nodes.push_back(std::move(item));
+    }
+
+    json response = {
+        {"packages", cpuTopology_.packages},
+        {"physicalCores", cpuTopology_.physicalCores},
+        {"logicalCores", cpuTopology_.processors.size()},
+        {"processors", std::move(processors)},
+        {"nodes", std::move(nodes)},
+    };
+    res.set_content(response.dump(), "application/json");
+}
+
+void HttpServer::HandleGetProcesses(const httplib::Request& /*req*/, httplib::Response& res) {
     try {
-        auto snapshot = processMonitor_.GetProcessSnapshot();
+        // 由后台采样线程发布，请求线程不再枚举进程
+        auto table = processMonitor_.GetLatestTable();
         json response;
         
-        // 数值字段直接赋值
-        response["timestamp"] = snapshot.timestamp;
-        response["totalProcesses"] = snapshot.totalProcesses;
-        response["totalThreads"] = snapshot.totalThreads;
-        response["totalHandles"] = snapshot.totalHandles;
-        response["totalGdiObjects"] = snapshot.totalGdiObjects;
-        response["totalUserObjects"] = snapshot.totalUserObjects;
+        // 数值字段直接赋值，合计值按列求和
+        response["timestamp"] = table->timestamp;
+        response["totalProcesses"] = table->Size();
+        response["totalThreads"] = table->TotalThreads();
+        response["totalHandles"] = table->TotalHandles();
+        response["totalGdiObjects"] = table->TotalGdiObjects();
+        response["totalUserObjects"] = table->TotalUserObjects();
         
         json processesJson = json::array();
-        for (const auto& process : snapshot.processes) {
+        for (size_t row = 0; row < table->Size(); ++row) {
+            const ProcessInfo process = table->Row(row);
             try {
                 json processJson;
                 
@@ -399,6 +1235,7 @@ void HttpServer::HandleGetProcesses(const httplib::Request& req, httplib::Respon
                 processJson["handleCount"] = process.handleCount;   // 获取指定进程当前打开的句柄总数,用于评估进程的资源使用情况，排查句柄泄漏问题
                 processJson["gdiCount"] = process.gdiCount;         // 获取进程使用的 GDI 对象数量,监控 GDI 数量有助于检测图形资源泄漏
                 processJson["userCount"] = process.userCount;       // 获取进程使用的 USER 对象数量,监控 USER 数量有助于检测窗口泄漏或 UI 资源泄漏
+                ProcessCountersToJson(process, processJson);        // I/O、缺页、上下文切换的累计值与速率
                 
                 // 字符串字段需要 UTF-8 清理
                 processJson["name"] = util::EncodingUtil::ToUTF8(process.name);
@@ -524,6 +1361,7 @@ void HttpServer::HandleGetProcessInfo(const httplib::Request& req, httplib::Resp
         response["handleCount"] = processInfo.handleCount;   // 获取指定进程当前打开的句柄总数,用于评估进程的资源使用情况，排查句柄泄漏问题
         response["gdiCount"] = processInfo.gdiCount;         // 获取进程使用的 GDI 对象数量,监控 GDI 数量有助于检测图形资源泄漏
         response["userCount"] = processInfo.userCount;  
+        ProcessCountersToJson(processInfo, response);
 
         res.set_content(response.dump(), "application/json");
         
@@ -574,6 +1412,349 @@ void HttpServer::HandleFindProcesses(const httplib::Request& req, httplib::Respo
     }
 }
 
+void HttpServer::HandleGetTopProcesses(const httplib::Request& req, httplib::Response& res) {
+    auto badRequest = [&res](const std::string& message) {
+        res.status = 400;
+        json error;
+        error["error"] = message;
+        res.set_content(error.dump(), "application/json");
+    };
+
+    try {
+        // by=cpu,memory,io：逗号分隔，可同时请求多个指标
+        std::vector<TopMetric> metrics;
+        std::string by = req.has_param("by") ? req.get_param_value("by") : "cpu";
+        std::stringstream ss(by);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (item.empty()) continue;
+            TopMetric metric;
+            if (!ParseTopMetric(item, metric)) {
+                badRequest("Unknown metric: " + item + " (expected cpu, memory, io, handles, threads)");
+                return;
+            }
+            if (std::find(metrics.begin(), metrics.end(), metric) == metrics.end()) {
+                metrics.push_back(metric);
+            }
+        }
+        if (metrics.empty()) {
+            badRequest("Parameter 'by' is empty");
+            return;
+        }
+
+        size_t n = 10;
+        if (req.has_param("n")) {
+            int value = std::stoi(req.get_param_value("n"));
+            if (value <= 0) {
+                badRequest("Parameter 'n' must be positive");
+                return;
+            }
+            n = std::min(static_cast<size_t>(value), kMaxTopProcesses);
+        }
+
+        TopGroupBy groupBy = TopGroupBy::None;
+        if (req.has_param("group") && !ParseTopGroupBy(req.get_param_value("group"), groupBy)) {
+            badRequest("Parameter 'group' must be name or user");
+            return;
+        }
+
+        auto table = processMonitor_.GetLatestTable();
+        auto rankings = ComputeTopProcesses(*table, metrics, n, groupBy);
+
+        json response;
+        response["timestamp"] = table->timestamp;
+        response["totalProcesses"] = table->Size();
+        response["n"] = n;
+        response["group"] = TopGroupByName(groupBy);
+        response["rankings"] = json::object();
+        for (const auto& ranking : rankings) {
+            json entries = json::array();
+            for (const auto& entry : ranking.entries) {
+                json item;
+                if (groupBy == TopGroupBy::None) {
+                    item["pid"] = entry.pid;
+                    item["name"] = util::EncodingUtil::ToUTF8(entry.name);
+                    item["username"] = util::EncodingUtil::ToUTF8(entry.username);
+                } else {
+                    item["group"] = util::EncodingUtil::ToUTF8(entry.name);
+                    item["processCount"] = entry.processCount;
+                }
+                item["value"] = entry.value;
+                entries.push_back(item);
+            }
+            response["rankings"][TopMetricName(ranking.metric)] = entries;
+        }
+
+        res.set_content(response.dump(), "application/json");
+
+    } catch (const std::exception& e) {
+        json error;
+        error["error"] = e.what();
+        res.status = 500;
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
+void HttpServer::HandleGetProcessTree(const httplib::Request& /*req*/, httplib::Response& res) {
+    try {
+        auto table = processMonitor_.GetLatestTable();
+        const ProcessTree& tree = *table->tree;
+
+        json response;
+        response["timestamp"] = table->timestamp;
+        response["totalProcesses"] = table->Size();
+        response["rootCount"] = tree.roots.size();
+        response["roots"] = BuildProcessTreeJson(*table, tree, 0, tree.postOrder.size());
+
+        res.set_content(response.dump(), "application/json");
+
+    } catch (const std::exception& e) {
+        json error;
+        error["error"] = e.what();
+        res.status = 500;
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
+void HttpServer::HandleGetProcessSubtree(const httplib::Request& req, httplib::Response& res) {
+    try {
+        uint32_t pid = std::stoul(req.matches[1].str());
+        auto table = processMonitor_.GetLatestTable();
+        const ProcessTree& tree = *table->tree;
+
+        size_t row = 0;
+        if (!table->FindRow(pid, row)) {
+            res.status = 404;
+            json error;
+            error["error"] = "Process not found";
+            res.set_content(error.dump(), "application/json");
+            return;
+        }
+
+        // 子树在后序序列中是以 row 结尾的连续区间
+        const size_t end = tree.postOrderIndex[row] + 1;
+        const size_t begin = end - tree.subtreeProcesses[row];
+
+        json response;
+        response["timestamp"] = table->timestamp;
+        response["process"] = BuildProcessTreeJson(*table, tree, begin, end).at(0);
+
+        res.set_content(response.dump(), "application/json");
+
+    } catch (const std::exception& e) {
+        json error;
+        error["error"] = e.what();
+        res.status = 500;
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
+void HttpServer::HandleGetProcessThreads(const httplib::Request& req, httplib::Response& res) {
+    try {
+        uint32_t pid = std::stoul(req.matches[1].str());
+        size_t top = 0;   // 0 表示返回全部线程
+        if (req.has_param("top")) {
+            int value = std::stoi(req.get_param_value("top"));
+            if (value <= 0) {
+                res.status = 400;
+                json error;
+                error["error"] = "Parameter 'top' must be positive";
+                res.set_content(error.dump(), "application/json");
+                return;
+            }
+            top = static_cast<size_t>(value);
+        }
+
+        ThreadSnapshot snapshot;
+        if (!processMonitor_.GetProcessThreads(pid, snapshot)) {
+            res.status = 404;
+            json error;
+            error["error"] = "Process not found";
+            res.set_content(error.dump(), "application/json");
+            return;
+        }
+
+        json response;
+        response["pid"] = snapshot.pid;
+        response["timestamp"] = snapshot.timestamp;
+        response["intervalMs"] = snapshot.intervalMs;
+        response["threadCount"] = snapshot.threads.size();
+
+        // 线程按 CPU 使用率降序排列，第一个即最热线程
+        if (!snapshot.threads.empty() && snapshot.threads.front().cpuUsage > 0.0) {
+            response["hotThread"] = snapshot.threads.front().tid;
+        } else {
+            response["hotThread"] = nullptr;
+        }
+
+        json threads = json::array();
+        size_t count = top ? std::min(top, snapshot.threads.size()) : snapshot.threads.size();
+        for (size_t i = 0; i < count; ++i) {
+            const ThreadInfo& thread = snapshot.threads[i];
+            json item;
+            item["tid"] = thread.tid;
+            item["name"] = util::EncodingUtil::ToUTF8(thread.name);
+            item["state"] = thread.state;
+            item["priority"] = thread.priority;
+            item["cpuUsage"] = thread.cpuUsage;
+            item["kernelTime"] = thread.kernelTime;
+            item["userTime"] = thread.userTime;
+            item["kernelTimeDelta"] = thread.kernelTimeDelta;
+            item["userTimeDelta"] = thread.userTimeDelta;
+            threads.push_back(item);
+        }
+        response["threads"] = threads;
+
+        res.set_content(response.dump(), "application/json");
+
+    } catch (const std::exception& e) {
+        json error;
+        error["error"] = e.what();
+        res.status = 500;
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
+void HttpServer::HandleGetProcessLeaks(const httplib::Request& req, httplib::Response& res) {
+    auto badRequest = [&res](const std::string& message) {
+        res.status = 400;
+        json error;
+        error["error"] = message;
+        res.set_content(error.dump(), "application/json");
+    };
+
+    try {
+        // metric=handles,memory：逗号分隔，默认全部
+        std::vector<LeakMetric> metrics;
+        if (req.has_param("metric")) {
+            std::stringstream ss(req.get_param_value("metric"));
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                if (item.empty()) continue;
+                LeakMetric metric;
+                if (!ParseLeakMetric(item, metric)) {
+                    badRequest("Unknown metric: " + item + " (expected handles, gdi, user, memory)");
+                    return;
+                }
+                metrics.push_back(metric);
+            }
+        }
+
+        size_t n = 20;
+        if (req.has_param("n")) {
+            int value = std::stoi(req.get_param_value("n"));
+            if (value <= 0) {
+                badRequest("Parameter 'n' must be positive");
+                return;
+            }
+            n = std::min(static_cast<size_t>(value), kMaxTopProcesses);
+        }
+
+        LeakDetectorOptions options = processMonitor_.GetLeakDetectorOptions();
+        auto suspects = processMonitor_.GetLeakSuspects(metrics, n);
+
+        json response;
+        response["timestamp"] = GET_LOCAL_TIME_MS();
+        response["windowSeconds"] = options.windowSeconds;
+        response["minTStat"] = options.minTStat;
+        response["suspects"] = json::array();
+        for (const auto& suspect : suspects) {
+            json item;
+            item["pid"] = suspect.pid;
+            item["name"] = util::EncodingUtil::ToUTF8(suspect.name);
+            item["metric"] = LeakMetricName(suspect.metric);
+            item["current"] = suspect.current;
+            item["slopePerHour"] = suspect.slopePerHour;
+            item["tStat"] = suspect.tStat;
+            item["rSquared"] = suspect.rSquared;
+            item["effectiveSamples"] = suspect.effectiveSamples;
+            item["trackedSeconds"] = suspect.trackedSeconds;
+            response["suspects"].push_back(item);
+        }
+
+        res.set_content(response.dump(), "application/json");
+
+    } catch (const std::exception& e) {
+        json error;
+        error["error"] = e.what();
+        res.status = 500;
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
+void HttpServer::HandleGetProcessEvents(const httplib::Request& req, httplib::Response& res) {
+    try {
+        uint64_t since = req.has_param("since") ? std::stoull(req.get_param_value("since")) : 0;
+        size_t limit = kMaxProcessEvents;
+        if (req.has_param("limit")) {
+            limit = std::min(static_cast<size_t>(std::stoul(req.get_param_value("limit"))), kMaxProcessEvents);
+        }
+
+        std::vector<ProcessEvent> events;
+        uint64_t missed = processMonitor_.ReadProcessEvents(since, limit, events);
+
+        json response;
+        response["source"] = processMonitor_.KernelProcessEventsActive() ? "kernel" : "scan";
+        response["missed"] = missed;
+        response["events"] = json::array();
+        for (const auto& event : events) {
+            response["events"].push_back(ProcessEventToJson(event));
+        }
+        // 下次请求的 since：没有新事件时保持不变
+        response["next"] = events.empty() ? since : events.back().seq;
+        response["stats"] = ProcessEventStatsToJson(processMonitor_.GetProcessEventStats());
+
+        res.set_content(response.dump(), "application/json");
+
+    } catch (const std::exception& e) {
+        json error;
+        error["error"] = e.what();
+        res.status = 400;
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
+// 与 /api/cpu/stream 相同，每次连接发送一批事件后结束，由 EventSource 重连；
+// 重连时浏览器带上 Last-Event-ID，从该序号之后继续读取
+void HttpServer::HandleStreamProcessEvents(const httplib::Request& req, httplib::Response& res) {
+    res.set_header("Cache-Control", "no-cache");
+    res.set_header("Connection", "keep-alive");
+    res.set_header("Access-Control-Allow-Origin", "*");
+
+    uint64_t lastEventId = 0;
+    bool resumed = false;
+    try {
+        if (req.has_header("Last-Event-ID")) {
+            lastEventId = std::stoull(req.get_header_value("Last-Event-ID"));
+            resumed = true;
+        }
+    } catch (const std::exception&) {
+        resumed = false;
+    }
+
+    std::ostringstream out;
+    out << "retry: 1000\n\n";
+
+    if (!resumed) {
+        // 首次连接只告知当前位置，之后的重连从这里开始接收
+        auto stats = processMonitor_.GetProcessEventStats();
+        out << "event: sync\nid: " << stats.lastSeq << "\ndata: "
+            << json{{"stats", ProcessEventStatsToJson(stats)}}.dump() << "\n\n";
+        res.set_content(out.str(), "text/event-stream");
+        return;
+    }
+
+    std::vector<ProcessEvent> events;
+    uint64_t missed = processMonitor_.ReadProcessEvents(lastEventId, kMaxProcessEvents, events);
+    if (missed > 0) {
+        out << "event: dropped\ndata: " << json{{"missed", missed}}.dump() << "\n\n";
+    }
+    for (const auto& event : events) {
+        out << "id: " << event.seq << "\nevent: process\ndata: " << ProcessEventToJson(event).dump() << "\n\n";
+    }
+    res.set_content(out.str(), "text/event-stream");
+}
+
 void HttpServer::HandleTerminateProcess(const httplib::Request& req, httplib::Response& res) {
     try {
         uint32_t pid = std::stoi(req.matches[1]);
@@ -607,7 +1788,7 @@ void HttpServer::HandleTerminateProcess(const httplib::Request& req, httplib::Re
 }
 
 // Add disk information handler functions
-void HttpServer::HandleGetDiskInfo(const httplib::Request& req, httplib::Response& res) {
+void HttpServer::HandleGetDiskInfo(const httplib::Request& /*req*/, httplib::Response& res) {
     try {
         // Set CORS headers
         res.set_header("Access-Control-Allow-Origin", "*");
@@ -684,7 +1865,7 @@ void HttpServer::HandleGetDiskInfo(const httplib::Request& req, httplib::Respons
     }
 }
 
-void HttpServer::HandleGetDiskPerformance(const httplib::Request& req, httplib::Response& res) {
+void HttpServer::HandleGetDiskPerformance(const httplib::Request& /*req*/, httplib::Response& res) {
     try {
         // Set CORS headers
         res.set_header("Access-Control-Allow-Origin", "*");
@@ -860,7 +2041,7 @@ std::string HttpServer::GetCurrentTimeString() {
 //     }
 // }
 
-void HttpServer::HandleSaveRegistry(const httplib::Request& req, httplib::Response& res) {
+void HttpServer::HandleSaveRegistry(const httplib::Request& /*req*/, httplib::Response& res) {
     try {
         res.set_header("Access-Control-Allow-Origin", "*");
         res.set_header("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
@@ -911,7 +2092,7 @@ void HttpServer::HandleSaveRegistry(const httplib::Request& req, httplib::Respon
     }
 }
 
-void HttpServer::HandleGetRegistryInfo(const httplib::Request& req, httplib::Response& res) {
+void HttpServer::HandleGetRegistryInfo(const httplib::Request& /*req*/, httplib::Response& res) {
     try {
         res.set_header("Access-Control-Allow-Origin", "*");
         res.set_header("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
@@ -1560,7 +2741,7 @@ void HttpServer::HandleDeleteSnapshot(const httplib::Request& req, httplib::Resp
     }
 }
 
-void HttpServer::HandleGetDriverSnapshot(const httplib::Request& req, httplib::Response& res) {
+void HttpServer::HandleGetDriverSnapshot(const httplib::Request& /*req*/, httplib::Response& res) {
     try {
         res.set_header("Access-Control-Allow-Origin", "*");
         res.set_header("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
@@ -1752,7 +2933,11 @@ void HttpServer::HandleCreateSystemSnapshot(const httplib::Request& req, httplib
             auto now = std::chrono::system_clock::now();
             auto tt = std::chrono::system_clock::to_time_t(now);
             std::tm tm;
+#ifdef _WIN32
             localtime_s(&tm, &tt);
+#else
+            localtime_r(&tt, &tm);
+#endif
             nameoss << "snapshot_" << std::put_time(&tm, "%Y%m%d_%H%M%S");
         }
         std::string name = nameoss.str();
@@ -1842,7 +3027,7 @@ void HttpServer::HandleGetSystemSnapshot(const httplib::Request& req, httplib::R
     }
 }
 
-void HttpServer::HandleListSystemSnapshots(const httplib::Request& req, httplib::Response& res) {
+void HttpServer::HandleListSystemSnapshots(const httplib::Request& /*req*/, httplib::Response& res) {
     try {
         LoadSnapshotsFromDisk();
 
@@ -1915,7 +3100,11 @@ void HttpServer::HandleSaveSystemSnapshot(const httplib::Request& req, httplib::
             auto now = std::chrono::system_clock::now();
             auto tt = std::chrono::system_clock::to_time_t(now);
             std::tm tm;
+#ifdef _WIN32
             localtime_s(&tm, &tt);
+#else
+            localtime_r(&tt, &tm);
+#endif
             std::ostringstream oss;
             oss << "snapshot_" << std::put_time(&tm, "%Y%m%d_%H%M%S");
             name = oss.str();
@@ -2601,6 +3790,32 @@ json HttpServer::CompareSystemSnapshotsJson(const json& snap1, const json& snap2
                         hasChange = true;
                     }
                     
+                    // I/O、缺页、上下文切换：累计值之差即两次快照间的增量，速率取各自采样时的值
+                    for (const char* key : {"readBytes", "writeBytes", "readOps", "writeOps",
+                                            "minorFaults", "majorFaults",
+                                            "voluntaryCtxSwitches", "involuntaryCtxSwitches"}) {
+                        uint64_t v1 = proc1.value(key, static_cast<uint64_t>(0));
+                        uint64_t v2 = proc2.value(key, static_cast<uint64_t>(0));
+                        if (v1 != v2) {
+                            change[std::string(key) + "1"] = v1;
+                            change[std::string(key) + "2"] = v2;
+                            change[std::string(key) + "Diff"] = static_cast<int64_t>(v2) - static_cast<int64_t>(v1);
+                            hasChange = true;
+                        }
+                    }
+                    for (const char* key : {"readBytesPerSec", "writeBytesPerSec", "readOpsPerSec", "writeOpsPerSec",
+                                            "minorFaultsPerSec", "majorFaultsPerSec",
+                                            "voluntaryCtxSwitchesPerSec", "involuntaryCtxSwitchesPerSec"}) {
+                        double r1 = proc1.value(key, 0.0);
+                        double r2 = proc2.value(key, 0.0);
+                        if (std::abs(r2 - r1) > 0.01) {
+                            change[std::string(key) + "1"] = r1;
+                            change[std::string(key) + "2"] = r2;
+                            change[std::string(key) + "Diff"] = r2 - r1;
+                            hasChange = true;
+                        }
+                    }
+                    
                     if (hasChange) {
                         changed.push_back(change);
                     }
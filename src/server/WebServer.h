@@ -4,17 +4,27 @@
 // #include "../core/SnapshotComparator.h"
 #include "../core/CPUInfo/system_info.h"
 #include "../core/CPUInfo/cpu_monitor.h"
+#include "../core/CPUInfo/cpu_burst.h"
+#include "../core/CPUInfo/cpu_telemetry.h"
+#include "../core/CPUInfo/cpu_topology.h"
 #include "../core/Memory/memory_monitor.h"
 #include "../core/Process/process_monitor.h"
+#include "../core/Process/process_top.h"
+#include "../core/Process/process_tree.h"
 #include "../core/Disk/disk_monitor.h"
 #include "../core/Register/registry_monitor.h"
 #include "../core/Driver/driver_monitor.h"
+#include "WorkerPool.h"
+#include "EmbeddedAssets.h"
+#include "../utils/metrics.h"
 #include "../third_party/httplib.h"
 #include "../third_party/nlohmann/json.hpp"
 #include <memory>
 #include <thread>
 #include <atomic>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 using json = nlohmann::json;
 
@@ -29,15 +39,41 @@ public:
     void Stop();
     bool IsRunning() const { return isRunning_; }
 
+    // 需在 Start 之前调用
+    void SetWorkerPoolOptions(const WorkerPoolOptions& options) { poolOptions_ = options; }
+    // 非空时从该目录读取前端文件（前端开发用），否则使用编译期嵌入的资源
+    void SetWebclientDirectory(const std::string& dir) { webclientDir_ = dir; }
+    // 使用内核进程事件源（Linux netlink，需要 CAP_NET_ADMIN），不可用时退回快照比较
+    void SetKernelProcessEvents(bool enabled) { kernelProcessEvents_ = enabled; }
+    // 启用每核心性能计数器（Linux perf_event_open），须在 Start 之前调用
+    void SetCpuCounters(bool enabled) { cpuCounters_ = enabled; }
+    // 泄漏检测的回归窗口（秒），0 表示使用默认值
+    void SetLeakWindowSeconds(double seconds) { leakWindowSeconds_ = seconds; }
+
 private:
     void SetupRoutes();
     void StartBackgroundMonitoring();
+
+    // 昂贵接口包装：先取得 expensive 通道槽位，排队已满时返回 503
+    httplib::Server::Handler ExpensiveRoute(httplib::Server::Handler handler);
+    void HandleGetServerStats(const httplib::Request& req, httplib::Response& res);
+    void HandleGetEmbeddedAsset(const httplib::Request& req, httplib::Response& res);
+
+    // 每个请求完成后（httplib logger 回调）记录路由耗时、字节数与错误数
+    void RecordRequestMetrics(const httplib::Request& req, const httplib::Response& res);
+    void HandleGetMetrics(const httplib::Request& req, httplib::Response& res);
     
 
     void HandleGetCPUInfo(const httplib::Request& req, httplib::Response& res);
     void HandleGetCPUUsage(const httplib::Request& req, httplib::Response& res);
     void HandleGetSystemInfo(const httplib::Request& req, httplib::Response& res);
     void HandleStreamCPUUsage(const httplib::Request& req, httplib::Response& res);
+    void HandleStartCPUBurst(const httplib::Request& req, httplib::Response& res);
+    void HandleGetCPUBurst(const httplib::Request& req, httplib::Response& res);
+    void HandleStopCPUBurst(const httplib::Request& req, httplib::Response& res);
+    void HandleGetCPUTelemetry(const httplib::Request& req, httplib::Response& res);
+    void HandleGetCPUTelemetryHistory(const httplib::Request& req, httplib::Response& res);
+    void HandleGetCPUTopology(const httplib::Request& req, httplib::Response& res);
 
     void HandleGetMemoryUsage(const httplib::Request& req, httplib::Response& res);
 
@@ -47,6 +83,13 @@ private:
     void HandleGetProcesses(const httplib::Request& req, httplib::Response& res);
     void HandleGetProcessInfo(const httplib::Request& req, httplib::Response& res);
     void HandleFindProcesses(const httplib::Request& req, httplib::Response& res);
+    void HandleGetTopProcesses(const httplib::Request& req, httplib::Response& res);
+    void HandleGetProcessTree(const httplib::Request& req, httplib::Response& res);
+    void HandleGetProcessSubtree(const httplib::Request& req, httplib::Response& res);
+    void HandleGetProcessThreads(const httplib::Request& req, httplib::Response& res);
+    void HandleGetProcessLeaks(const httplib::Request& req, httplib::Response& res);
+    void HandleGetProcessEvents(const httplib::Request& req, httplib::Response& res);
+    void HandleStreamProcessEvents(const httplib::Request& req, httplib::Response& res);
     void HandleTerminateProcess(const httplib::Request& req, httplib::Response& res);
 
 
@@ -85,20 +128,70 @@ private:
     std::unique_ptr<httplib::Server> server_;
     std::unique_ptr<std::thread> serverThread_;
     std::atomic<bool> isRunning_{false};
+
+    WorkerPoolOptions poolOptions_;
+    std::shared_ptr<ConnectionQueueStats> connectionStats_;
+    std::unique_ptr<RequestLane> expensiveLane_;
+    std::string webclientDir_;
+    bool kernelProcessEvents_ = false;
+    bool cpuCounters_ = false;
+    double leakWindowSeconds_ = 0.0;
+
+    // 按 "method route" 缓存的指标对象，避免每个请求都查询全局注册表
+    struct RouteMetrics {
+        metrics::LatencyHistogram* latency;
+        metrics::Counter* requests;
+        metrics::Counter* requestBytes;
+        metrics::Counter* responseBytes;
+        metrics::Counter* clientErrors;
+        metrics::Counter* serverErrors;
+    };
+    std::unordered_map<std::string, RouteMetrics> routeMetrics_;
+    std::shared_mutex routeMetricsMutex_;
     
+    // 周期采集任务共用的调度器，须在各监控对象之前构造、之后析构
+    PeriodicScheduler scheduler_;
+
     CPUMonitor cpuMonitor_;
     CPUInfo cpuInfo_;
+    // 启动时发现一次，用于把每核心指标归到封装与 NUMA 节点
+    CpuTopology cpuTopology_;
     std::atomic<double> currentUsage_{0.0};
-    
+    // 按需高频采样（/api/cpu/burst），使用独立的采样线程
+    CpuBurstCapture cpuBurst_;
+    // 各核心频率、降频计数与温度
+    CpuTelemetryMonitor cpuTelemetry_;
 
     MemoryMonitor memoryMonitor_;
 
     MemoryUsage memoryUsage_{}; // value-initialize to zeros
     std::mutex memoryUsageMutex_; // protect memoryUsage_
 
-    struct Sample { uint64_t timestamp; double value; };
-    std::vector<Sample> cpuHistory_;
-    std::vector<Sample> memoryHistory_;
+    // CPU 历史另存时间细分；每核心细分以 0.01% 为单位存为 uint16，每核心 7 个，顺序同 CpuTimeBreakdown
+    struct CpuSample {
+        uint64_t timestamp;
+        double value;
+        CpuTimeBreakdown breakdown;
+        std::vector<uint16_t> coreBreakdowns;
+    };
+    std::vector<CpuSample> cpuHistory_;
+    // 内存历史附带提交量、缓存、换页与缺页速率及压力停顿占比
+    struct MemorySample {
+        uint64_t timestamp;
+        double value;
+        uint64_t commitCharge;
+        uint64_t cached;
+        uint64_t swapUsed;
+        float swapInPerSec;
+        float swapOutPerSec;
+        float pageFaultsPerSec;
+        float majorFaultsPerSec;
+        bool hasPressure;
+        PressureStall memoryPressure;
+        PressureStall cpuPressure;
+        PressureStall ioPressure;
+    };
+    std::vector<MemorySample> memoryHistory_;
     std::mutex cpuHistoryMutex_;
     std::mutex memoryHistoryMutex_;
     size_t maxHistorySamples_ = 3600; 
@@ -0,0 +1,151 @@
+#include "WorkerPool.h"
+
+namespace sysmonitor {
+
+static uint64_t ElapsedUs(std::chrono::steady_clock::time_point since) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - since).count());
+}
+
+void WaitStats::Record(uint64_t us) {
+    count.fetch_add(1, std::memory_order_relaxed);
+    totalUs.fetch_add(us, std::memory_order_relaxed);
+    lastUs.store(us, std::memory_order_relaxed);
+
+    uint64_t prev = maxUs.load(std::memory_order_relaxed);
+    while (us > prev && !maxUs.compare_exchange_weak(prev, us, std::memory_order_relaxed)) {
+    }
+}
+
+double WaitStats::AverageMs() const {
+    uint64_t n = count.load(std::memory_order_relaxed);
+    if (n == 0) return 0.0;
+    return static_cast<double>(totalUs.load(std::memory_order_relaxed)) / n / 1000.0;
+}
+
+// ---------------------------------------------------------------------------
+// WorkerPool
+// ---------------------------------------------------------------------------
+
+WorkerPool::WorkerPool(size_t threads, size_t maxThreads, size_t maxQueue,
+                       std::shared_ptr<ConnectionQueueStats> stats)
+    : maxThreads_(maxThreads), maxQueue_(maxQueue), stats_(std::move(stats)) {
+    if (threads == 0) threads = 1;
+    if (maxThreads_ < threads) maxThreads_ = threads;
+    if (!stats_) stats_ = std::make_shared<ConnectionQueueStats>();
+
+    stats_->threads.store(threads);
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    shutdown();
+}
+
+bool WorkerPool::enqueue(std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (shutdown_ || (maxQueue_ > 0 && jobs_.size() >= maxQueue_)) {
+            // httplib 会记录 ResourceExhaustion 并关闭该连接
+            stats_->rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        jobs_.push_back(Job{std::move(fn), std::chrono::steady_clock::now()});
+        stats_->depth.store(jobs_.size(), std::memory_order_relaxed);
+
+        // 现有线程都被连接占用（多为空闲的保持连接）：增加一个线程，而不是让新连接等它们超时
+        if (idle_ < jobs_.size() && threads_.size() < maxThreads_) {
+            threads_.emplace_back(&WorkerPool::WorkerLoop, this);
+            stats_->threads.store(threads_.size());
+        }
+    }
+
+    stats_->accepted.fetch_add(1, std::memory_order_relaxed);
+    cond_.notify_one();
+    return true;
+}
+
+void WorkerPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (shutdown_ && threads_.empty()) return;
+        shutdown_ = true;
+    }
+    cond_.notify_all();
+
+    for (auto& t : threads_) {
+        if (t.joinable()) t.join();
+    }
+    threads_.clear();
+    stats_->threads.store(0);
+}
+
+void WorkerPool::WorkerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lk(mutex_);
+            ++idle_;
+            cond_.wait(lk, [this] { return shutdown_ || !jobs_.empty(); });
+            --idle_;
+
+            // 与 httplib::ThreadPool 一致：关闭时先把已排队的连接处理完
+            if (shutdown_ && jobs_.empty()) break;
+
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+            stats_->depth.store(jobs_.size(), std::memory_order_relaxed);
+        }
+
+        stats_->wait.Record(ElapsedUs(job.enqueued));
+        stats_->busy.fetch_add(1, std::memory_order_relaxed);
+        try {
+            job.fn();
+        } catch (...) {
+            // 单个连接的异常不能带走工作线程
+        }
+        stats_->busy.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// RequestLane
+// ---------------------------------------------------------------------------
+
+RequestLane::RequestLane(const char* name, size_t maxActive, size_t maxQueued)
+    : name_(name), maxActive_(maxActive == 0 ? 1 : maxActive), maxQueued_(maxQueued) {
+}
+
+bool RequestLane::Acquire() {
+    auto start = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lk(mutex_);
+    if (active_.load() >= maxActive_ || queued_.load() > 0) {
+        if (queued_.load() >= maxQueued_) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        queued_.fetch_add(1);
+        cond_.wait(lk, [this] { return active_.load() < maxActive_; });
+        queued_.fetch_sub(1);
+    }
+    active_.fetch_add(1);
+    lk.unlock();
+
+    admitted_.fetch_add(1, std::memory_order_relaxed);
+    wait_.Record(ElapsedUs(start));
+    return true;
+}
+
+void RequestLane::Release() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        active_.fetch_sub(1);
+    }
+    cond_.notify_one();
+}
+
+} // namespace sysmonitor
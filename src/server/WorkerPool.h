@@ -0,0 +1,139 @@
+#pragma once
+#include "../third_party/httplib.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sysmonitor {
+
+// HTTP 工作线程池配置
+// httplib 在保持连接的整个生命周期内占用一个线程（两次请求之间空闲时也不释放，直到空闲超时），
+// 因此线程数按连接而不是按请求计算：
+//   常驻线程 = cheapThreads + expensiveThreads + maxExpensiveQueue，昂贵请求占满自己的并发槽和
+//   等待槽后仍剩 cheapThreads 个；
+//   新连接到来而没有空闲线程时按需增加线程，最多 keepAliveThreads 个，保持连接的空闲客户端不会
+//   让新连接排队。连接数超过两者之和后新连接进入 maxConnectionQueue 排队，直到某个连接空闲超时
+struct WorkerPoolOptions {
+    size_t cheapThreads = 4;          // 为轻量接口（/api/cpu/usage 等）预留的线程数
+    size_t expensiveThreads = 2;      // 昂贵接口（快照、比较、驱动枚举）的最大并发数
+    size_t maxExpensiveQueue = 4;     // 昂贵接口的最大排队数，超出后返回 503
+    size_t keepAliveThreads = 64;     // 按需增加的连接线程上限
+    size_t maxConnectionQueue = 128;  // 等待工作线程的连接数上限，超出后直接关闭连接
+
+    size_t ConnectionThreads() const {
+        return cheapThreads + expensiveThreads + maxExpensiveQueue;
+    }
+    size_t MaxConnectionThreads() const {
+        return ConnectionThreads() + keepAliveThreads;
+    }
+};
+
+// 等待时间统计（单位：微秒），所有字段均可无锁读取
+struct WaitStats {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> totalUs{0};
+    std::atomic<uint64_t> maxUs{0};
+    std::atomic<uint64_t> lastUs{0};
+
+    void Record(uint64_t us);
+    double AverageMs() const;
+};
+
+// 连接队列（httplib TaskQueue）的运行指标
+struct ConnectionQueueStats {
+    std::atomic<uint64_t> depth{0};       // 当前排队的连接数
+    std::atomic<uint64_t> busy{0};        // 正在处理连接的线程数
+    std::atomic<uint64_t> threads{0};
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<uint64_t> rejected{0};
+    WaitStats wait;
+};
+
+// httplib::TaskQueue 实现：启动 threads 个线程，没有空闲线程时按需增加到 maxThreads 个（增加的线程
+// 不回收），有界队列，并记录排队深度和等待时间
+// 由 httplib 在 listen 时创建和销毁，指标写入外部持有的 ConnectionQueueStats
+class WorkerPool : public httplib::TaskQueue {
+public:
+    WorkerPool(size_t threads, size_t maxThreads, size_t maxQueue,
+               std::shared_ptr<ConnectionQueueStats> stats);
+    ~WorkerPool() override;
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    bool enqueue(std::function<void()> fn) override;
+    void shutdown() override;
+
+private:
+    void WorkerLoop();
+
+    struct Job {
+        std::function<void()> fn;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    std::vector<std::thread> threads_;
+    std::deque<Job> jobs_;
+    size_t maxThreads_;
+    size_t maxQueue_;
+    size_t idle_ = 0;                 // 正在等待任务的线程数
+    bool shutdown_ = false;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::shared_ptr<ConnectionQueueStats> stats_;
+};
+
+// 路由级优先通道：限制某一类接口的并发数与排队数
+// 轻量接口不经过通道，直接在连接线程上执行；昂贵接口必须先取得通道槽位
+class RequestLane {
+public:
+    RequestLane(const char* name, size_t maxActive, size_t maxQueued);
+
+    // 申请槽位，排队已满时立即返回 false（调用方应返回 503）
+    bool Acquire();
+    void Release();
+
+    const char* Name() const { return name_; }
+    uint64_t Active() const { return active_.load(); }
+    uint64_t Queued() const { return queued_.load(); }
+    uint64_t Admitted() const { return admitted_.load(); }
+    uint64_t Rejected() const { return rejected_.load(); }
+    size_t MaxActive() const { return maxActive_; }
+    size_t MaxQueued() const { return maxQueued_; }
+    const WaitStats& Wait() const { return wait_; }
+
+    // RAII 槽位持有者
+    class Ticket {
+    public:
+        explicit Ticket(RequestLane& lane) : lane_(&lane), held_(lane.Acquire()) {}
+        ~Ticket() { if (held_) lane_->Release(); }
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+        explicit operator bool() const { return held_; }
+
+    private:
+        RequestLane* lane_;
+        bool held_;
+    };
+
+private:
+    const char* name_;
+    size_t maxActive_;
+    size_t maxQueued_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::atomic<uint64_t> active_{0};
+    std::atomic<uint64_t> queued_{0};
+    std::atomic<uint64_t> admitted_{0};
+    std::atomic<uint64_t> rejected_{0};
+    WaitStats wait_;
+};
+
+} // namespace sysmonitor
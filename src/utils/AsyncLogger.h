@@ -174,7 +174,11 @@ private:
         
         std::tm tm;
         // Use safe localtime_s instead of localtime
+#ifdef _WIN32
         localtime_s(&tm, &time_t);
+#else
+        localtime_r(&time_t, &tm);
+#endif
         
         std::ostringstream oss;
         oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
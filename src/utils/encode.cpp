@@ -236,6 +236,7 @@ std::string EncodingUtil::SafeString(const std::string& str, const std::string&
 std::string EncodingUtil::WideToUTF8(const wchar_t* wideStr) {
         if (!wideStr || !*wideStr) return "";
         
+#ifdef _WIN32
         int utf8Len = WideCharToMultiByte(CP_UTF8, 0, wideStr, -1, nullptr, 0, nullptr, nullptr);
         if (utf8Len == 0) return "";
         
@@ -243,6 +244,29 @@ std::string EncodingUtil::WideToUTF8(const wchar_t* wideStr) {
         WideCharToMultiByte(CP_UTF8, 0, wideStr, -1, utf8Buffer.data(), utf8Len, nullptr, nullptr);
         
         return std::string(utf8Buffer.data());
+#else
+        // wchar_t 为 UTF-32
+        std::string result;
+        for (; *wideStr; ++wideStr) {
+            uint32_t cp = static_cast<uint32_t>(*wideStr);
+            if (cp < 0x80) {
+                result += static_cast<char>(cp);
+            } else if (cp < 0x800) {
+                result += static_cast<char>(0xC0 | (cp >> 6));
+                result += static_cast<char>(0x80 | (cp & 0x3F));
+            } else if (cp < 0x10000) {
+                result += static_cast<char>(0xE0 | (cp >> 12));
+                result += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (cp & 0x3F));
+            } else {
+                result += static_cast<char>(0xF0 | (cp >> 18));
+                result += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                result += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        }
+        return result;
+#endif
     }
     
     std::string EncodingUtil::WideToUTF8(const std::wstring& wideStr) {
@@ -0,0 +1,294 @@
+#include "metrics.h"
+#include <cstdio>
+#include <sstream>
+
+namespace sysmonitor {
+namespace metrics {
+
+size_t ThreadShard() {
+    static std::atomic<size_t> nextShard{0};
+    thread_local const size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % kMaxShards;
+    return shard;
+}
+
+// 最高有效位序号，v 必须非 0
+static uint32_t HighestBit(uint64_t v) {
+    uint32_t bit = 0;
+    if (v >= (1ULL << 32)) { v >>= 32; bit += 32; }
+    if (v >= (1ULL << 16)) { v >>= 16; bit += 16; }
+    if (v >= (1ULL << 8))  { v >>= 8;  bit += 8; }
+    if (v >= (1ULL << 4))  { v >>= 4;  bit += 4; }
+    if (v >= (1ULL << 2))  { v >>= 2;  bit += 2; }
+    if (v >= (1ULL << 1))  { bit += 1; }
+    return bit;
+}
+
+// ---------------------------------------------------------------------------
+// LatencyHistogram
+// ---------------------------------------------------------------------------
+
+size_t LatencyHistogram::BucketIndex(uint64_t micros) {
+    if (micros < kSubBucketCount) {
+        return static_cast<size_t>(micros);
+    }
+    const uint64_t maxValue = (1ULL << kMaxValueBits) - 1;
+    if (micros > maxValue) micros = maxValue;
+
+    // 值落在 [2^e, 2^(e+1))，右移 shift 位后落在 [16, 32)
+    uint32_t shift = HighestBit(micros) - (kSubBucketBits - 1);
+    uint64_t sub = micros >> shift;
+    return static_cast<size_t>(kSubBucketCount + (shift - 1) * kSubBucketHalf + (sub - kSubBucketHalf));
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t index) {
+    if (index < kSubBucketCount) {
+        return index;
+    }
+    uint64_t offset = index - kSubBucketCount;
+    uint32_t shift = static_cast<uint32_t>(offset / kSubBucketHalf) + 1;
+    uint64_t sub = offset % kSubBucketHalf + kSubBucketHalf;
+    return ((sub + 1) << shift) - 1;
+}
+
+LatencyHistogram::LatencyHistogram() = default;
+
+LatencyHistogram::~LatencyHistogram() {
+    for (auto& slot : shards_) {
+        delete slot.load();
+    }
+}
+
+LatencyHistogram::Shard& LatencyHistogram::LocalShard() {
+    auto& slot = shards_[ThreadShard()];
+    Shard* shard = slot.load(std::memory_order_acquire);
+    if (!shard) {
+        // 每个槽位只在第一次记录时分配一次
+        std::lock_guard<std::mutex> lk(allocMutex_);
+        shard = slot.load(std::memory_order_acquire);
+        if (!shard) {
+            shard = new Shard();
+            slot.store(shard, std::memory_order_release);
+        }
+    }
+    return *shard;
+}
+
+void LatencyHistogram::Record(uint64_t micros) {
+    Shard& shard = LocalShard();
+    shard.counts[BucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.sumUs.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t prev = shard.maxUs.load(std::memory_order_relaxed);
+    while (micros > prev && !shard.maxUs.compare_exchange_weak(prev, micros, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::Read() const {
+    Snapshot snap;
+    snap.counts.assign(kBucketCount, 0);
+    for (const auto& slot : shards_) {
+        const Shard* shard = slot.load(std::memory_order_acquire);
+        if (!shard) continue;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            snap.counts[i] += shard->counts[i].load(std::memory_order_relaxed);
+        }
+        snap.sumUs += shard->sumUs.load(std::memory_order_relaxed);
+        uint64_t m = shard->maxUs.load(std::memory_order_relaxed);
+        if (m > snap.maxUs) snap.maxUs = m;
+    }
+    // count 由桶求和得出，保证与各桶一致
+    for (uint64_t c : snap.counts) snap.count += c;
+    return snap;
+}
+
+uint64_t LatencyHistogram::Snapshot::ValueAtQuantile(double q) const {
+    if (count == 0) return 0;
+    if (q < 0.0) q = 0.0;
+    if (q > 1.0) q = 1.0;
+
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count) + 0.5);
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            uint64_t upper = BucketUpperBound(i);
+            return upper < maxUs ? upper : maxUs;
+        }
+    }
+    return maxUs;
+}
+
+uint64_t LatencyHistogram::Snapshot::CountAtOrBelow(uint64_t micros) const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        if (BucketUpperBound(i) > micros) break;
+        total += counts[i];
+    }
+    return total;
+}
+
+// ---------------------------------------------------------------------------
+// Registry
+// ---------------------------------------------------------------------------
+
+static std::string EscapeLabelValue(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '"':  out += "\\\""; break;
+            case '\n': out += "\\n"; break;
+            default:   out += c; break;
+        }
+    }
+    return out;
+}
+
+std::string FormatLabels(const Labels& labels) {
+    if (labels.empty()) return "";
+    std::string out = "{";
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (i > 0) out += ",";
+        out += labels[i].first + "=\"" + EscapeLabelValue(labels[i].second) + "\"";
+    }
+    out += "}";
+    return out;
+}
+
+// 在已渲染的标签集后追加一个标签
+static std::string AppendLabel(const std::string& labelStr, const std::string& key, const std::string& value) {
+    std::string extra = key + "=\"" + value + "\"";
+    if (labelStr.empty()) return "{" + extra + "}";
+    return labelStr.substr(0, labelStr.size() - 1) + "," + extra + "}";
+}
+
+static std::string FormatSeconds(double seconds) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.6g", seconds);
+    return buf;
+}
+
+Registry& Registry::Instance() {
+    static Registry instance;
+    return instance;
+}
+
+Registry::Family& Registry::GetFamily(const std::string& name, Type type, const std::string& help) {
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+        it = families_.emplace(name, Family{type, help, {}, {}}).first;
+    }
+    return it->second;
+}
+
+LatencyHistogram& Registry::Histogram(const std::string& family, const std::string& help, const Labels& labels) {
+    std::string key = FormatLabels(labels);
+    {
+        std::shared_lock<std::shared_mutex> lk(mutex_);
+        auto fit = families_.find(family);
+        if (fit != families_.end()) {
+            auto hit = fit->second.histograms.find(key);
+            if (hit != fit->second.histograms.end()) return *hit->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lk(mutex_);
+    auto& f = GetFamily(family, Type::HISTOGRAM, help);
+    auto& slot = f.histograms[key];
+    if (!slot) slot = std::make_unique<LatencyHistogram>();
+    return *slot;
+}
+
+Counter& Registry::GetCounter(const std::string& family, const std::string& help, const Labels& labels) {
+    std::string key = FormatLabels(labels);
+    {
+        std::shared_lock<std::shared_mutex> lk(mutex_);
+        auto fit = families_.find(family);
+        if (fit != families_.end()) {
+            auto cit = fit->second.counters.find(key);
+            if (cit != fit->second.counters.end()) return *cit->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lk(mutex_);
+    auto& f = GetFamily(family, Type::COUNTER, help);
+    auto& slot = f.counters[key];
+    if (!slot) slot = std::make_unique<Counter>();
+    return *slot;
+}
+
+std::string Registry::RenderPrometheus() const {
+    // Prometheus 直方图桶边界（秒）
+    static const double kBoundsSeconds[] = {
+        0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025,
+        0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0
+    };
+    static const double kQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+    std::ostringstream out;
+    std::shared_lock<std::shared_mutex> lk(mutex_);
+
+    for (const auto& [name, family] : families_) {
+        if (family.type == Type::COUNTER) {
+            out << "# HELP " << name << " " << family.help << "\n";
+            out << "# TYPE " << name << " counter\n";
+            for (const auto& [labels, counter] : family.counters) {
+                out << name << labels << " " << counter->Value() << "\n";
+            }
+            continue;
+        }
+
+        std::vector<std::pair<std::string, LatencyHistogram::Snapshot>> snaps;
+        snaps.reserve(family.histograms.size());
+        for (const auto& [labels, hist] : family.histograms) {
+            snaps.emplace_back(labels, hist->Read());
+        }
+
+        out << "# HELP " << name << " " << family.help << "\n";
+        out << "# TYPE " << name << " histogram\n";
+        for (const auto& [labels, snap] : snaps) {
+            for (double bound : kBoundsSeconds) {
+                uint64_t us = static_cast<uint64_t>(bound * 1e6);
+                out << name << "_bucket" << AppendLabel(labels, "le", FormatSeconds(bound))
+                    << " " << snap.CountAtOrBelow(us) << "\n";
+            }
+            out << name << "_bucket" << AppendLabel(labels, "le", "+Inf") << " " << snap.count << "\n";
+            out << name << "_sum" << labels << " " << FormatSeconds(snap.sumUs / 1e6) << "\n";
+            out << name << "_count" << labels << " " << snap.count << "\n";
+        }
+
+        // 直方图本身不携带分位数，另以 summary 形式导出 HDR 精度的分位值
+        std::string quantileName = name + "_quantiles";
+        out << "# HELP " << quantileName << " " << family.help << " (HDR quantiles)\n";
+        out << "# TYPE " << quantileName << " summary\n";
+        for (const auto& [labels, snap] : snaps) {
+            for (double q : kQuantiles) {
+                out << quantileName << AppendLabel(labels, "quantile", FormatSeconds(q))
+                    << " " << FormatSeconds(snap.ValueAtQuantile(q) / 1e6) << "\n";
+            }
+            out << quantileName << "_sum" << labels << " " << FormatSeconds(snap.sumUs / 1e6) << "\n";
+            out << quantileName << "_count" << labels << " " << snap.count << "\n";
+        }
+    }
+
+    return out.str();
+}
+
+LatencyHistogram& CollectorHistogram(const char* collector) {
+    return Registry::Instance().Histogram("sysmon_collector_duration_seconds",
+                                          "Duration of collector calls",
+                                          {{"collector", collector}});
+}
+
+Counter& CollectorErrors(const char* collector) {
+    return Registry::Instance().GetCounter("sysmon_collector_errors_total",
+                                           "Collector calls that exited with an exception",
+                                           {{"collector", collector}});
+}
+
+} // namespace metrics
+} // namespace sysmonitor
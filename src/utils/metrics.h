@@ -0,0 +1,182 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sysmonitor {
+namespace metrics {
+
+// 记录线程按槽位分片，每个线程只写自己的分片，读取时合并
+constexpr size_t kMaxShards = 32;
+
+// 当前线程的分片槽位
+size_t ThreadShard();
+
+/**
+ * @brief HDR 风格的对数-线性延迟直方图（单位：微秒）
+ *
+ * 小于 32us 的值精确记录；更大的值按 2 的幂分段，每段 16 个子桶，相对误差约 3%。
+ * 超过 2^36us（约 19 小时）的值记入最后一个桶。
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t kSubBucketBits = 5;
+    static constexpr uint64_t kSubBucketCount = 1ULL << kSubBucketBits;   // 32
+    static constexpr uint64_t kSubBucketHalf = kSubBucketCount / 2;       // 16
+    static constexpr uint32_t kMaxValueBits = 36;
+    static constexpr size_t kBucketCount =
+        kSubBucketCount + (kMaxValueBits - kSubBucketBits) * kSubBucketHalf;
+
+    static size_t BucketIndex(uint64_t micros);
+    static uint64_t BucketUpperBound(size_t index);
+
+    struct Snapshot {
+        std::vector<uint64_t> counts;
+        uint64_t count = 0;
+        uint64_t sumUs = 0;
+        uint64_t maxUs = 0;
+
+        // 返回 q 分位所在桶的上界（不超过实际最大值）
+        uint64_t ValueAtQuantile(double q) const;
+        // 小于等于 micros 的样本数（按桶上界近似）
+        uint64_t CountAtOrBelow(uint64_t micros) const;
+    };
+
+    LatencyHistogram();
+    ~LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void Record(uint64_t micros);
+    Snapshot Read() const;
+
+private:
+    struct Shard {
+        std::array<std::atomic<uint64_t>, kBucketCount> counts{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sumUs{0};
+        std::atomic<uint64_t> maxUs{0};
+    };
+
+    Shard& LocalShard();
+
+    std::array<std::atomic<Shard*>, kMaxShards> shards_{};
+    std::mutex allocMutex_;
+};
+
+// 按线程分片的单调计数器
+class Counter {
+public:
+    Counter() : cells_(new Cell[kMaxShards]) {}
+
+    void Add(uint64_t n = 1) {
+        cells_[ThreadShard()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    uint64_t Value() const {
+        uint64_t total = 0;
+        for (size_t i = 0; i < kMaxShards; ++i) {
+            total += cells_[i].value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<uint64_t> value{0};
+    };
+    std::unique_ptr<Cell[]> cells_;
+};
+
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief 全局指标注册表，按 Prometheus 文本格式导出
+ *
+ * 同一 family + labels 始终返回同一个对象，引用在进程生命周期内有效。
+ */
+class Registry {
+public:
+    static Registry& Instance();
+
+    LatencyHistogram& Histogram(const std::string& family, const std::string& help, const Labels& labels);
+    Counter& GetCounter(const std::string& family, const std::string& help, const Labels& labels);
+
+    // 导出所有指标（text/plain; version=0.0.4）
+    std::string RenderPrometheus() const;
+
+private:
+    Registry() = default;
+
+    enum class Type { COUNTER, HISTOGRAM };
+    struct Family {
+        Type type;
+        std::string help;
+        std::map<std::string, std::unique_ptr<Counter>> counters;
+        std::map<std::string, std::unique_ptr<LatencyHistogram>> histograms;
+    };
+
+    Family& GetFamily(const std::string& name, Type type, const std::string& help);
+
+    mutable std::shared_mutex mutex_;
+    std::map<std::string, Family> families_;
+};
+
+// 渲染标签集，例如 {route="/api/cpu/usage",method="GET"}
+std::string FormatLabels(const Labels& labels);
+
+// 采集函数耗时与异常计数
+LatencyHistogram& CollectorHistogram(const char* collector);
+Counter& CollectorErrors(const char* collector);
+
+// 作用域计时器：析构时记录耗时；若因异常退出作用域，额外累加错误计数
+class ScopedTimer {
+public:
+    explicit ScopedTimer(LatencyHistogram& histogram, Counter* errors = nullptr)
+        : histogram_(histogram), errors_(errors),
+          exceptions_(std::uncaught_exceptions()),
+          start_(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start_).count();
+        histogram_.Record(static_cast<uint64_t>(us));
+        if (errors_ && std::uncaught_exceptions() > exceptions_) {
+            errors_->Add();
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    LatencyHistogram& histogram_;
+    Counter* errors_;
+    int exceptions_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace metrics
+} // namespace sysmonitor
+
+#define SYSMON_METRICS_CONCAT_INNER(a, b) a##b
+#define SYSMON_METRICS_CONCAT(a, b) SYSMON_METRICS_CONCAT_INNER(a, b)
+
+// 统计当前作用域内采集函数的耗时，例如 SYSMON_TIME_COLLECTOR("GetProcessSnapshot");
+#define SYSMON_TIME_COLLECTOR(name)                                                              \
+    static auto& SYSMON_METRICS_CONCAT(collectorHist_, __LINE__) =                               \
+        ::sysmonitor::metrics::CollectorHistogram(name);                                         \
+    static auto& SYSMON_METRICS_CONCAT(collectorErr_, __LINE__) =                                \
+        ::sysmonitor::metrics::CollectorErrors(name);                                            \
+    ::sysmonitor::metrics::ScopedTimer SYSMON_METRICS_CONCAT(collectorTimer_, __LINE__)(         \
+        SYSMON_METRICS_CONCAT(collectorHist_, __LINE__), &SYSMON_METRICS_CONCAT(collectorErr_, __LINE__))
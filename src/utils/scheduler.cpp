@@ -0,0 +1,331 @@
+#include "scheduler.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace sysmonitor {
+
+namespace {
+
+constexpr uint64_t kNever = std::numeric_limits<uint64_t>::max();
+
+// 最低位 1 的位置，value 非零
+inline uint32_t LowestSetBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<uint32_t>(index);
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+}
+
+} // namespace
+
+PeriodicScheduler::PeriodicScheduler(uint32_t tickMs, size_t workerThreads, NowFn now)
+    : now_(now ? now : NowFn(&Clock::now)),
+      tick_(std::chrono::milliseconds(std::max<uint32_t>(tickMs, 1))),
+      epoch_(now_()) {
+    if (now) {
+        return;   // 手动模式
+    }
+    timerThread_ = std::thread(&PeriodicScheduler::TimerLoop, this);
+    workers_.reserve(std::max<size_t>(workerThreads, 1));
+    for (size_t i = 0; i < std::max<size_t>(workerThreads, 1); ++i) {
+        workers_.emplace_back(&PeriodicScheduler::WorkerLoop, this);
+    }
+}
+
+PeriodicScheduler::~PeriodicScheduler() {
+    Stop();
+}
+
+PeriodicScheduler::TaskId PeriodicScheduler::Schedule(const std::string& name, uint32_t intervalMs, Task task) {
+    auto& registry = metrics::Registry::Instance();
+    auto state = std::make_shared<TaskState>();
+    state->fn = std::move(task);
+    state->stats.name = name;
+    state->stats.intervalMs = intervalMs;
+    state->lateness = &registry.Histogram("sysmon_scheduler_lateness_seconds",
+                                         "Delay between a periodic task's deadline and its start", {{"task", name}});
+    state->skippedCounter = &registry.GetCounter("sysmon_scheduler_skipped_total",
+                                                 "Periodic task runs skipped because the task fell behind", {{"task", name}});
+
+    const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::milliseconds(intervalMs));
+    state->intervalTicks = std::max<uint64_t>(1, static_cast<uint64_t>((interval + tick_ / 2) / tick_));
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (stopping_) {
+        return kInvalidTask;
+    }
+    // 定时线程空闲时 currentTick_ 可能落后，先追到当前刻度
+    AdvanceTo(CurrentTick());
+
+    state->id = nextId_++;
+    state->deadline = currentTick_ + state->intervalTicks;
+    tasks_[state->id] = state;
+    Insert(state->id, state->deadline);
+    timerCv_.notify_one();
+    return state->id;
+}
+
+void PeriodicScheduler::Cancel(TaskId id) {
+    std::unique_lock<std::mutex> lk(mutex_);
+    auto it = tasks_.find(id);
+    if (it == tasks_.end()) {
+        return;
+    }
+    // 时间轮中残留的 id 在到期或迁移时找不到任务，直接丢弃
+    std::shared_ptr<TaskState> task = std::move(it->second);
+    tasks_.erase(it);
+
+    auto queued = std::remove_if(jobs_.begin(), jobs_.end(), [&task](const Job& job) { return job.task == task; });
+    if (queued != jobs_.end()) {
+        jobs_.erase(queued, jobs_.end());
+        task->running = false;
+    }
+    doneCv_.wait(lk, [&task] { return !task->running; });
+}
+
+void PeriodicScheduler::Stop() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        stopping_ = true;
+    }
+    timerCv_.notify_all();
+    workerCv_.notify_all();
+
+    if (timerThread_.joinable()) {
+        timerThread_.join();
+    }
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    for (auto& job : jobs_) {
+        job.task->running = false;
+    }
+    jobs_.clear();
+    doneCv_.notify_all();
+}
+
+std::vector<ScheduledTaskStats> PeriodicScheduler::GetStats() const {
+    std::vector<ScheduledTaskStats> stats;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        stats.reserve(tasks_.size());
+        for (const auto& entry : tasks_) {
+            stats.push_back(entry.second->stats);
+        }
+    }
+    std::sort(stats.begin(), stats.end(),
+              [](const ScheduledTaskStats& a, const ScheduledTaskStats& b) { return a.name < b.name; });
+    return stats;
+}
+
+PeriodicScheduler::Clock::time_point PeriodicScheduler::NextWakeTime() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    const uint64_t next = NextWakeTick();
+    return next == kNever ? Clock::time_point::max() : TickTime(next);
+}
+
+size_t PeriodicScheduler::RunDue() {
+    std::unique_lock<std::mutex> lk(mutex_);
+    AdvanceTo(CurrentTick());
+    size_t ran = 0;
+    while (!stopping_ && !jobs_.empty()) {
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        RunJob(std::move(job), lk);
+        ++ran;
+    }
+    return ran;
+}
+
+void PeriodicScheduler::TimerLoop() {
+    std::unique_lock<std::mutex> lk(mutex_);
+    while (!stopping_) {
+        const uint64_t next = NextWakeTick();
+        if (next == kNever) {
+            timerCv_.wait(lk);
+        } else {
+            timerCv_.wait_until(lk, TickTime(next));
+        }
+        if (stopping_) {
+            break;
+        }
+        AdvanceTo(CurrentTick());
+    }
+}
+
+void PeriodicScheduler::WorkerLoop() {
+    std::unique_lock<std::mutex> lk(mutex_);
+    for (;;) {
+        workerCv_.wait(lk, [this] { return stopping_ || !jobs_.empty(); });
+        if (stopping_) {
+            return;
+        }
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        RunJob(std::move(job), lk);
+    }
+}
+
+void PeriodicScheduler::RunJob(Job job, std::unique_lock<std::mutex>& lk) {
+    lk.unlock();
+
+    const auto start = now_();
+    const uint64_t latenessUs = start > job.scheduled
+        ? static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(start - job.scheduled).count())
+        : 0;
+    job.task->lateness->Record(latenessUs);
+    try {
+        job.task->fn();
+    } catch (const std::exception& e) {
+        std::cerr << "Scheduled task " << job.task->stats.name << " failed: " << e.what() << std::endl;
+    }
+    const uint64_t durationUs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(now_() - start).count());
+
+    lk.lock();
+    ScheduledTaskStats& stats = job.task->stats;
+    ++stats.runs;
+    stats.lastLatenessUs = latenessUs;
+    stats.maxLatenessUs = std::max(stats.maxLatenessUs, latenessUs);
+    stats.totalLatenessUs += latenessUs;
+    stats.lastDurationUs = durationUs;
+    job.task->running = false;
+    doneCv_.notify_all();
+}
+
+uint64_t PeriodicScheduler::CurrentTick() const {
+    return static_cast<uint64_t>((now_() - epoch_) / tick_);
+}
+
+// 放入与截止刻度同属一个上层区间的最低层：第 L 层的槽位在进入对应区间时整体迁移到下层
+void PeriodicScheduler::Insert(TaskId id, uint64_t deadline) {
+    for (size_t level = 0; level < kLevels; ++level) {
+        const uint32_t shift = kSlotBits * static_cast<uint32_t>(level + 1);
+        if ((deadline >> shift) == (currentTick_ >> shift)) {
+            const size_t slot = (deadline >> (kSlotBits * level)) & (kSlots - 1);
+            wheel_[level][slot].push_back(id);
+            occupied_[level] |= 1ULL << slot;
+            return;
+        }
+    }
+    overflow_.push_back(id);
+}
+
+// 只停在有事件的刻度上（到期或非空槽位迁移），中间的空刻度直接跳过
+void PeriodicScheduler::AdvanceTo(uint64_t tick) {
+    while (currentTick_ < tick) {
+        const uint64_t next = NextWakeTick();
+        if (next > tick) {
+            currentTick_ = tick;
+            return;
+        }
+        currentTick_ = next;
+
+        constexpr uint64_t kWheelSpan = 1ULL << (kSlotBits * kLevels);
+        if ((next & (kWheelSpan - 1)) == 0 && !overflow_.empty()) {
+            std::vector<TaskId> far;
+            far.swap(overflow_);
+            for (TaskId id : far) {
+                auto it = tasks_.find(id);
+                if (it != tasks_.end()) {
+                    Insert(id, it->second->deadline);
+                }
+            }
+        }
+        // 高层先迁移：上层落下来的任务可能正好落在本刻度要迁移的下层槽位
+        for (size_t level = kLevels - 1; level > 0; --level) {
+            if ((next & ((1ULL << (kSlotBits * level)) - 1)) == 0) {
+                Cascade(level, next);
+            }
+        }
+
+        const size_t slot = next & (kSlots - 1);
+        std::vector<TaskId> due;
+        due.swap(wheel_[0][slot]);
+        occupied_[0] &= ~(1ULL << slot);
+        for (TaskId id : due) {
+            Fire(id, tick);
+        }
+    }
+}
+
+void PeriodicScheduler::Cascade(size_t level, uint64_t tick) {
+    const size_t slot = (tick >> (kSlotBits * level)) & (kSlots - 1);
+    if (!(occupied_[level] & (1ULL << slot))) {
+        return;
+    }
+    std::vector<TaskId> ids;
+    ids.swap(wheel_[level][slot]);
+    occupied_[level] &= ~(1ULL << slot);
+    for (TaskId id : ids) {
+        auto it = tasks_.find(id);
+        if (it != tasks_.end()) {
+            Insert(id, it->second->deadline);
+        }
+    }
+}
+
+// 当前刻度的任务到期；latest 是本轮要追到的刻度，落后时跳过错过的周期
+void PeriodicScheduler::Fire(TaskId id, uint64_t latest) {
+    auto it = tasks_.find(id);
+    if (it == tasks_.end()) {
+        return;
+    }
+    TaskState& task = *it->second;
+    const uint64_t deadline = task.deadline;
+
+    if (task.running) {
+        ++task.stats.skipped;
+        task.skippedCounter->Add();
+    } else {
+        task.running = true;
+        jobs_.push_back(Job{it->second, TickTime(deadline)});
+        workerCv_.notify_one();
+    }
+
+    uint64_t next = deadline + task.intervalTicks;
+    if (next <= latest) {
+        const uint64_t missed = (latest - deadline) / task.intervalTicks;
+        next = deadline + (missed + 1) * task.intervalTicks;
+        task.stats.skipped += missed;
+        task.skippedCounter->Add(missed);
+    }
+    task.deadline = next;
+    Insert(id, next);
+}
+
+// 下一个需要处理的刻度：第 0 层最近的到期槽位，或更高层最近的非空槽位的起点
+uint64_t PeriodicScheduler::NextWakeTick() const {
+    for (size_t level = 0; level < kLevels; ++level) {
+        const uint32_t shift = kSlotBits * static_cast<uint32_t>(level);
+        const size_t current = (currentTick_ >> shift) & (kSlots - 1);
+        // 当前及之前的槽位已处理过，只看之后的槽位
+        const uint64_t later = occupied_[level] & ~((2ULL << current) - 1);
+        if (later) {
+            const uint64_t base = (currentTick_ >> (shift + kSlotBits)) << (shift + kSlotBits);
+            return base + (static_cast<uint64_t>(LowestSetBit(later)) << shift);
+        }
+    }
+    if (!overflow_.empty()) {
+        const uint32_t span = kSlotBits * static_cast<uint32_t>(kLevels);
+        return ((currentTick_ >> span) + 1) << span;
+    }
+    return kNever;
+}
+
+PeriodicScheduler::Clock::time_point PeriodicScheduler::TickTime(uint64_t tick) const {
+    return epoch_ + tick_ * static_cast<Clock::rep>(tick);
+}
+
+} // namespace sysmonitor
@@ -0,0 +1,130 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "metrics.h"
+
+namespace sysmonitor {
+
+// 单个周期任务的运行统计，时间单位为微秒
+struct ScheduledTaskStats {
+    std::string name;
+    uint32_t intervalMs = 0;
+    uint64_t runs = 0;
+    uint64_t skipped = 0;            // 上一次仍在运行或调度落后而跳过的周期
+    uint64_t lastLatenessUs = 0;     // 实际开始时间 - 计划时间
+    uint64_t maxLatenessUs = 0;
+    uint64_t totalLatenessUs = 0;
+    uint64_t lastDurationUs = 0;
+};
+
+/**
+ * @brief 周期任务调度器：一个定时线程 + 少量工作线程，替代每个采集器各自的 sleep 循环
+ *
+ * 截止时间按分层时间轮（4 层 × 64 槽）组织，定时线程按绝对时间 wait_until 到下一个
+ * 有任务的刻度。任务的截止时间固定为 首次截止 + k × 周期，采集耗时与唤醒延迟不会累积；
+ * 落后超过一个周期时跳过错过的周期。同一刻度到期的任务交给工作线程并行执行，
+ * 同一任务不会重叠运行。每次运行的延迟记入 sysmon_scheduler_lateness_seconds{task=...}。
+ *
+ * 传入 now 时为手动模式（测试用）：不启动定时线程与工作线程，调用方推进时钟后调用 RunDue()，
+ * 到期的任务在调用线程上依次运行。
+ */
+class PeriodicScheduler {
+public:
+    using TaskId = uint64_t;
+    using Task = std::function<void()>;
+    using Clock = std::chrono::steady_clock;
+    using NowFn = std::function<Clock::time_point()>;
+
+    static constexpr TaskId kInvalidTask = 0;
+
+    explicit PeriodicScheduler(uint32_t tickMs = 10, size_t workerThreads = 2, NowFn now = nullptr);
+    ~PeriodicScheduler();
+
+    PeriodicScheduler(const PeriodicScheduler&) = delete;
+    PeriodicScheduler& operator=(const PeriodicScheduler&) = delete;
+
+    // 首次运行在一个周期之后；周期按刻度取整，至少一个刻度
+    TaskId Schedule(const std::string& name, uint32_t intervalMs, Task task);
+
+    // 返回后任务不会再运行；正在运行时等待其结束，因此不能在任务自身中调用
+    void Cancel(TaskId id);
+
+    // 停止所有线程，之后不再运行任何任务
+    void Stop();
+
+    std::vector<ScheduledTaskStats> GetStats() const;
+
+    // 下一次需要处理时间轮的时间（到期或迁移）；没有任务时为 Clock::time_point::max()
+    Clock::time_point NextWakeTime() const;
+
+    // 手动模式：把时间轮推进到当前时间并运行到期的任务，返回运行的任务数
+    size_t RunDue();
+
+private:
+    static constexpr size_t kLevels = 4;
+    static constexpr uint32_t kSlotBits = 6;
+    static constexpr size_t kSlots = 1u << kSlotBits;   // 64
+
+    struct TaskState {
+        TaskId id = kInvalidTask;
+        Task fn;
+        uint64_t intervalTicks = 1;
+        uint64_t deadline = 0;        // 下一次运行的刻度
+        bool running = false;
+        ScheduledTaskStats stats;
+        metrics::LatencyHistogram* lateness = nullptr;
+        metrics::Counter* skippedCounter = nullptr;
+    };
+
+    struct Job {
+        std::shared_ptr<TaskState> task;
+        std::chrono::steady_clock::time_point scheduled;
+    };
+
+    void TimerLoop();
+    void WorkerLoop();
+    // 在持有 lk 时调用，运行期间释放锁
+    void RunJob(Job job, std::unique_lock<std::mutex>& lk);
+    uint64_t CurrentTick() const;
+
+    // 以下在持有 mutex_ 时调用
+    void Insert(TaskId id, uint64_t deadline);
+    void AdvanceTo(uint64_t tick);
+    void Cascade(size_t level, uint64_t tick);
+    void Fire(TaskId id, uint64_t latest);
+    uint64_t NextWakeTick() const;
+    Clock::time_point TickTime(uint64_t tick) const;
+
+    const NowFn now_;
+    const Clock::duration tick_;
+    const Clock::time_point epoch_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable timerCv_;
+    std::condition_variable workerCv_;
+    std::condition_variable doneCv_;
+    bool stopping_ = false;
+
+    uint64_t currentTick_ = 0;    // 已处理到的刻度
+    std::array<std::array<std::vector<TaskId>, kSlots>, kLevels> wheel_;
+    std::array<uint64_t, kLevels> occupied_{};   // 每层非空槽位的位图
+    std::vector<TaskId> overflow_;               // 超出最高层范围的任务
+    std::unordered_map<TaskId, std::shared_ptr<TaskState>> tasks_;
+    TaskId nextId_ = 1;
+    std::deque<Job> jobs_;
+
+    std::thread timerThread_;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace sysmonitor
@@ -1,5 +1,8 @@
 #pragma once
+#ifdef _WIN32
 #include <windows.h>
+#endif
+#include <chrono>
 #include <iostream>
 #include <iomanip>
 #include <string>
@@ -7,6 +10,8 @@
 
 #define GET_LOCAL_TIME_MS() get_windows_time_since_epoch()
 
+#ifdef _WIN32
+
 // 返回64位时间戳，需按照毫秒精度转换
 // Convert Windows FILETIME to milliseconds since 1970-01-01
 inline uint64_t get_windows_time_since_epoch() {
@@ -20,4 +25,11 @@ inline uint64_t get_windows_time_since_epoch() {
     ull.HighPart = ft.dwHighDateTime;
     
     return (ull.QuadPart - EPOCH_DIFFERENCE) / 10000; // Convert to milliseconds
-}
\ No newline at end of file
+}
+#else
+// 非 Windows 平台（压测工具）：直接使用 system_clock
+inline uint64_t get_windows_time_since_epoch() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+#endif
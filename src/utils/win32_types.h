@@ -0,0 +1,20 @@
+#pragma once
+
+// 共享头文件（驱动、注册表监控的声明）中用到的少量 Win32 类型
+// Windows 下直接使用 <windows.h>；其他平台仅提供同名占位定义，
+// 以便服务端代码能在 Linux 上配合模拟采集器编译（见 tools/loadtest）
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cstdint>
+
+typedef unsigned long DWORD;
+typedef int BOOL;
+typedef const char* LPCSTR;
+typedef struct HKEY__* HKEY;
+
+#define HKEY_CLASSES_ROOT   ((HKEY)(uintptr_t)0x80000000)
+#define HKEY_CURRENT_USER   ((HKEY)(uintptr_t)0x80000001)
+#define HKEY_LOCAL_MACHINE  ((HKEY)(uintptr_t)0x80000002)
+#define HKEY_USERS          ((HKEY)(uintptr_t)0x80000003)
+#endif
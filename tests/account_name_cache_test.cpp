@@ -0,0 +1,121 @@
+// AccountNameCache：用计数的解析函数检查命中、容量上限与 LRU 淘汰顺序
+#include "core/Process/account_name_cache.h"
+#include "test_support.h"
+#include <map>
+
+using namespace sysmonitor;
+
+namespace {
+
+// 返回 "name-<id>"，并记录每个 id 被解析的次数
+struct CountingResolver {
+    std::map<std::string, int> calls;
+
+    AccountNameCache::Resolver Fn() {
+        return [this](const std::string& id) {
+            ++calls[id];
+            return "name-" + id;
+        };
+    }
+};
+
+// 重复查询同一账户只解析一次，其余计为命中
+void TestHits() {
+    AccountNameCache cache(4);
+    CountingResolver resolver;
+    auto resolve = resolver.Fn();
+
+    CHECK_EQ(cache.Lookup("1000", resolve), std::string("name-1000"));
+    CHECK_EQ(cache.Lookup("1000", resolve), std::string("name-1000"));
+    CHECK_EQ(cache.Lookup("0", resolve), std::string("name-0"));
+    CHECK_EQ(cache.Lookup("1000", resolve), std::string("name-1000"));
+
+    CHECK_EQ(resolver.calls["1000"], 1);
+    CHECK_EQ(resolver.calls["0"], 1);
+    CHECK_EQ(cache.Size(), 2u);
+    CHECK_EQ(cache.GetStats().hits, 2u);
+    CHECK_EQ(cache.GetStats().misses, 2u);
+    CHECK_EQ(cache.GetStats().evictions, 0u);
+}
+
+// 条目数不超过容量，每插入一个新账户淘汰一个
+void TestCapacity() {
+    AccountNameCache cache(3);
+    CountingResolver resolver;
+    auto resolve = resolver.Fn();
+
+    for (int i = 0; i < 10; ++i) {
+        cache.Lookup(std::to_string(i), resolve);
+        CHECK(cache.Size() <= 3u);
+    }
+    CHECK_EQ(cache.Size(), 3u);
+    CHECK_EQ(cache.GetStats().misses, 10u);
+    CHECK_EQ(cache.GetStats().evictions, 7u);
+
+    // 最近插入的 7、8、9 仍在缓存中
+    for (const char* id : {"7", "8", "9"}) {
+        cache.Lookup(id, resolve);
+        CHECK_EQ(resolver.calls[id], 1);
+    }
+    CHECK_EQ(cache.GetStats().hits, 3u);
+
+    // 容量 0 按 1 处理
+    AccountNameCache tiny(0);
+    tiny.Lookup("a", resolve);
+    tiny.Lookup("b", resolve);
+    CHECK_EQ(tiny.Size(), 1u);
+    CHECK_EQ(tiny.GetStats().evictions, 1u);
+}
+
+// 淘汰最久未使用的条目：命中会把条目移到最近使用端
+void TestEvictionOrder() {
+    AccountNameCache cache(3);
+    CountingResolver resolver;
+    auto resolve = resolver.Fn();
+
+    cache.Lookup("a", resolve);
+    cache.Lookup("b", resolve);
+    cache.Lookup("c", resolve);
+    cache.Lookup("a", resolve);   // 使用顺序（旧 -> 新）：b c a
+    cache.Lookup("d", resolve);   // 淘汰 b
+    CHECK_EQ(cache.GetStats().evictions, 1u);
+
+    cache.Lookup("a", resolve);   // 命中，顺序：c d a
+    cache.Lookup("c", resolve);   // 命中，顺序：d a c
+    CHECK_EQ(resolver.calls["a"], 1);
+    CHECK_EQ(resolver.calls["c"], 1);
+
+    cache.Lookup("b", resolve);   // b 已被淘汰，重新解析并淘汰 d
+    CHECK_EQ(resolver.calls["b"], 2);
+    cache.Lookup("d", resolve);   // d 已被淘汰，重新解析并淘汰 a
+    CHECK_EQ(resolver.calls["d"], 2);
+    cache.Lookup("c", resolve);   // c 仍在
+    CHECK_EQ(resolver.calls["c"], 1);
+    cache.Lookup("a", resolve);
+    CHECK_EQ(resolver.calls["a"], 2);
+    CHECK_EQ(cache.Size(), 3u);
+}
+
+// Clear 清空条目，之后重新解析；统计保持累计
+void TestClear() {
+    AccountNameCache cache(4);
+    CountingResolver resolver;
+    auto resolve = resolver.Fn();
+
+    cache.Lookup("x", resolve);
+    cache.Clear();
+    CHECK_EQ(cache.Size(), 0u);
+    CHECK_EQ(cache.Lookup("x", resolve), std::string("name-x"));
+    CHECK_EQ(resolver.calls["x"], 2);
+    CHECK_EQ(cache.GetStats().misses, 2u);
+}
+
+} // namespace
+
+int main() {
+    TestHits();
+    TestCapacity();
+    TestEvictionOrder();
+    TestClear();
+    return test::Finish();
+}
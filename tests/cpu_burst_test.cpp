@@ -0,0 +1,187 @@
+// CpuBurstCapture：由脚本化的 CpuTimesSource 驱动，检查参数校验、缓冲区容量、开销上限与计数回退
+#include "core/CPUInfo/cpu_burst.h"
+#include "test_support.h"
+#include <chrono>
+#include <thread>
+
+using namespace sysmonitor;
+
+namespace {
+
+// 依次返回给定的读数（整机与每个核心相同）；读完后返回 false 结束采集，
+// loop 为 true 时改为在最后一个读数上继续累加；cost 模拟每次读取的耗时
+class ScriptedCpuTimesSource : public CpuTimesSource {
+public:
+    ScriptedCpuTimesSource(uint32_t cores, std::vector<CpuTimes> script, bool loop = false,
+                           std::chrono::microseconds cost = std::chrono::microseconds(0))
+        : cores_(cores), script_(std::move(script)), loop_(loop), cost_(cost) {}
+
+    uint32_t CoreCount() const override { return cores_; }
+
+    bool Read(CpuTimes& total, CpuTimes* cores) override {
+        if (cost_.count() > 0) std::this_thread::sleep_for(cost_);
+        if (next_ < script_.size()) {
+            total = script_[next_];
+        } else if (loop_ && !script_.empty()) {
+            total = script_.back();
+            const uint64_t extra = next_ - script_.size() + 1;
+            total.busy += extra;
+            total.idle += extra;
+        } else {
+            return false;
+        }
+        ++next_;
+        for (uint32_t i = 0; i < cores_; ++i) cores[i] = total;
+        return true;
+    }
+
+private:
+    uint32_t cores_;
+    std::vector<CpuTimes> script_;
+    bool loop_;
+    std::chrono::microseconds cost_;
+    size_t next_ = 0;
+};
+
+CpuTimes Times(uint64_t busy, uint64_t idle) {
+    CpuTimes t;
+    t.busy = busy;
+    t.idle = idle;
+    return t;
+}
+
+// 等待采集结束（读数用尽或到时），最多 5 秒
+CpuBurstStatus WaitFinished(const CpuBurstCapture& capture) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    CpuBurstStatus status = capture.GetStatus();
+    while (status.running && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        status = capture.GetStatus();
+    }
+    return status;
+}
+
+void TestRejectsInvalidOptions() {
+    CpuBurstCapture capture(std::make_unique<ScriptedCpuTimesSource>(1, std::vector<CpuTimes>{}));
+    std::string error;
+    CpuBurstOptions options;
+    options.intervalUs = 500;
+    CHECK(!capture.Start(options, error));
+    CHECK(!error.empty());
+
+    options = CpuBurstOptions();
+    options.durationMs = 0;
+    CHECK(!capture.Start(options, error));
+
+    options = CpuBurstOptions();
+    options.maxOverheadPercent = 0.0;
+    CHECK(!capture.Start(options, error));
+    CHECK_EQ(capture.GetStatus().id, 0u);
+}
+
+// 容量 = 时长 / 间隔 + 1，受样本数上限与总值数上限（核心多时）约束；启动后即可读到
+void TestCapacitySizing() {
+    struct Case {
+        uint32_t cores;
+        uint32_t intervalUs;
+        uint32_t durationMs;
+        size_t capacity;
+    };
+    const Case cases[] = {
+        {4, 1000, 20, 21},
+        {1, 1000, 10 * 60 * 1000, 100000},           // 样本数上限
+        {100000, 1000, 1000, 4 * 1024 * 1024 / 100001},  // 总值数上限：每个样本 cores + 1 个值
+    };
+    for (const Case& c : cases) {
+        CpuBurstCapture capture(std::make_unique<ScriptedCpuTimesSource>(c.cores, std::vector<CpuTimes>{Times(0, 0)}, true));
+        CpuBurstOptions options;
+        options.intervalUs = c.intervalUs;
+        options.durationMs = c.durationMs;
+        std::string error;
+        CHECK(capture.Start(options, error));
+        CpuBurstStatus status = capture.GetStatus();
+        CHECK_EQ(status.capacity, c.capacity);
+        CHECK_EQ(status.cores, c.cores);
+        CHECK(status.running || status.samples <= c.capacity);
+
+        // 采集进行中再次启动被拒绝
+        if (capture.GetStatus().running) {
+            CHECK(!capture.Start(options, error));
+        }
+        capture.Stop();
+        status = capture.GetStatus();
+        CHECK(!status.running);
+        CHECK(status.samples <= c.capacity);
+    }
+}
+
+// iowait 回退使 idle 变小：与 CPUMonitor 相同，差值按 0 处理，不能回绕成接近 0% 的值；
+// 两次读数相同时沿用上一个值
+void TestIdleGoingBackwards() {
+    std::vector<CpuTimes> script = {
+        Times(0, 100),
+        Times(10, 110),   // 50%
+        Times(15, 90),    // idle 回退 20，大于 busy 增量
+        Times(15, 90),    // 无变化
+        Times(20, 95),    // 50%
+    };
+    CpuBurstCapture capture(std::make_unique<ScriptedCpuTimesSource>(2, script));
+    CpuBurstOptions options;
+    options.intervalUs = 1000;
+    options.durationMs = 1000;
+    options.maxOverheadPercent = 100.0;
+    std::string error;
+    CHECK(capture.Start(options, error));
+    CpuBurstStatus status = WaitFinished(capture);
+    CHECK(!status.running);
+    CHECK_EQ(status.samples, 4u);
+
+    std::vector<CpuBurstSample> samples;
+    capture.Read(0, 100, samples);
+    CHECK_EQ(samples.size(), 4u);
+    if (samples.size() != 4) return;
+    const float expected[] = {50.0f, 100.0f, 100.0f, 50.0f};
+    for (size_t i = 0; i < 4; ++i) {
+        CHECK_NEAR(samples[i].totalUsage, expected[i], 1e-4);
+        CHECK_EQ(samples[i].coreUsages.size(), 2u);
+        for (float core : samples[i].coreUsages) CHECK_NEAR(core, expected[i], 1e-4);
+        if (i > 0) CHECK(samples[i].offsetUs >= samples[i - 1].offsetUs);
+    }
+
+    // 分段读取
+    capture.Read(3, 100, samples);
+    CHECK_EQ(samples.size(), 1u);
+    capture.Read(4, 100, samples);
+    CHECK(samples.empty());
+}
+
+// 每次读取耗时 2ms、开销上限 10%：两次采样之间至少约 20ms，推迟的采样点计入 throttled；
+// 不受限时开销接近 100%。按上一次耗时预估本次，读取偶尔被调度拖慢时会超出上限一个样本的耗时，
+// 这里只检查开销被压到远低于不受限的水平
+void TestOverheadThrottling() {
+    CpuBurstCapture capture(std::make_unique<ScriptedCpuTimesSource>(
+        1, std::vector<CpuTimes>{Times(0, 0)}, true, std::chrono::milliseconds(2)));
+    CpuBurstOptions options;
+    options.intervalUs = 1000;
+    options.durationMs = 300;
+    options.maxOverheadPercent = 10.0;
+    std::string error;
+    CHECK(capture.Start(options, error));
+    CpuBurstStatus status = WaitFinished(capture);
+
+    CHECK(!status.running);
+    CHECK(status.samples > 0);
+    CHECK(status.samples <= 20);          // 不受限时约 150 个
+    CHECK(status.throttled > 200);
+    CHECK(status.overheadPercent < 30.0);
+}
+
+} // namespace
+
+int main() {
+    TestRejectsInvalidOptions();
+    TestCapacitySizing();
+    TestIdleGoingBackwards();
+    TestOverheadThrottling();
+    return test::Finish();
+}
@@ -0,0 +1,294 @@
+// CPUMonitor：由注入的 CpuTimesSource 计算使用率与时间细分，由注入的 CpuCounterSource 计算计数器速率与比值
+#include "core/CPUInfo/cpu_monitor.h"
+#include "test_support.h"
+#include <deque>
+#include <utility>
+
+using namespace sysmonitor;
+
+namespace {
+
+// 依次返回预先给定的读数，每个读数含整机与各核心
+class ScriptedCpuTimesSource : public CpuTimesSource {
+public:
+    using Reading = std::pair<CpuTimes, std::vector<CpuTimes>>;
+
+    explicit ScriptedCpuTimesSource(uint32_t cores) : cores_(cores) {}
+
+    void Push(const CpuTimes& total, std::vector<CpuTimes> cores = {}) {
+        cores.resize(cores_);
+        readings_.emplace_back(total, std::move(cores));
+    }
+
+    uint32_t CoreCount() const override { return cores_; }
+
+    bool Read(CpuTimes& total, CpuTimes* cores) override {
+        if (readings_.empty()) return false;
+        total = readings_.front().first;
+        for (uint32_t i = 0; i < cores_; ++i) cores[i] = readings_.front().second[i];
+        readings_.pop_front();
+        return true;
+    }
+
+private:
+    uint32_t cores_;
+    std::deque<Reading> readings_;
+};
+
+// 一个核心的一次分组读取：四个事件的原始计数及组的启用、运行时间
+struct GroupRead {
+    uint64_t values[4];
+    uint64_t enabled;
+    uint64_t running;
+};
+
+// 与 perf_event 来源相同的折算方式，依次返回预先给定的分组读取
+class ScriptedCounterSource : public CpuCounterSource {
+public:
+    ScriptedCounterSource(CpuCounterMode mode, uint32_t cores) : mode_(mode), cores_(cores) {}
+
+    void Push(std::vector<GroupRead> cores) { readings_.push_back(std::move(cores)); }
+
+    CpuCounterMode Mode() const override { return mode_; }
+    uint32_t CoreCount() const override { return cores_; }
+
+    bool Read(CpuCounterValues* cores) override {
+        if (readings_.empty()) return false;
+        static constexpr uint64_t CpuCounterValues::* kHardware[4] = {
+            &CpuCounterValues::cycles, &CpuCounterValues::instructions,
+            &CpuCounterValues::cacheMisses, &CpuCounterValues::branchMisses};
+        static constexpr uint64_t CpuCounterValues::* kSoftware[4] = {
+            &CpuCounterValues::contextSwitches, &CpuCounterValues::migrations,
+            &CpuCounterValues::pageFaults, &CpuCounterValues::majorFaults};
+        const auto& fields = mode_ == CpuCounterMode::Hardware ? kHardware : kSoftware;
+        for (uint32_t i = 0; i < cores_; ++i) {
+            const GroupRead& read = readings_.front()[i];
+            cores[i] = CpuCounterValues();
+            for (size_t e = 0; e < 4; ++e) {
+                cores[i].*fields[e] = ScaleMultiplexedCount(read.values[e], read.enabled, read.running);
+            }
+        }
+        readings_.pop_front();
+        return true;
+    }
+
+private:
+    CpuCounterMode mode_;
+    uint32_t cores_;
+    std::deque<std::vector<GroupRead>> readings_;
+};
+
+CpuTimes Times(uint64_t user, uint64_t system, uint64_t idle, uint64_t iowait) {
+    CpuTimes t;
+    t.user = user;
+    t.system = system;
+    t.iowait = iowait;
+    t.busy = user + system;
+    t.idle = idle + iowait;
+    return t;
+}
+
+void TestUsageBetweenSamples() {
+    auto source = std::make_unique<ScriptedCpuTimesSource>(1);
+    source->Push(Times(100, 0, 900, 0));
+    source->Push(Times(130, 10, 960, 0));
+    CPUMonitor monitor(std::move(source));
+
+    CHECK(monitor.Initialize());
+    CPUUsage usage = monitor.GetCurrentUsage();
+    // 忙 40，空闲 60
+    CHECK_NEAR(usage.totalUsage, 40.0, 1e-9);
+    CHECK_NEAR(usage.breakdown.user, 30.0, 1e-9);
+    CHECK_NEAR(usage.breakdown.system, 10.0, 1e-9);
+    CHECK_NEAR(usage.breakdown.idle, 60.0, 1e-9);
+}
+
+// iowait 回退使 idle 变小：差值按 0 处理，不能回绕成极大值把使用率压成 0
+void TestIdleGoingBackwards() {
+    auto source = std::make_unique<ScriptedCpuTimesSource>(1);
+    source->Push(Times(100, 0, 900, 100));
+    source->Push(Times(150, 0, 900, 90));
+    CPUMonitor monitor(std::move(source));
+
+    CHECK(monitor.Initialize());
+    CPUUsage usage = monitor.GetCurrentUsage();
+    CHECK_NEAR(usage.totalUsage, 100.0, 1e-9);
+    CHECK_NEAR(usage.breakdown.user, 100.0, 1e-9);
+    CHECK_NEAR(usage.breakdown.iowait, 0.0, 1e-9);
+}
+
+// 每核心细分与整机细分使用同一套差值规则
+void TestPerCoreBreakdown() {
+    auto source = std::make_unique<ScriptedCpuTimesSource>(2);
+    source->Push(Times(0, 0, 0, 0), {Times(0, 0, 0, 0), Times(0, 0, 0, 0)});
+    source->Push(Times(0, 0, 0, 0), {Times(50, 25, 0, 25), Times(0, 0, 100, 0)});
+    CPUMonitor monitor(std::move(source));
+
+    CHECK(monitor.Initialize());
+    CPUUsage usage = monitor.GetCurrentUsage();
+    CHECK_EQ(usage.coreBreakdowns.size(), 2u);
+    CHECK_EQ(usage.coreUsages.size(), 2u);
+    if (usage.coreBreakdowns.size() != 2 || usage.coreUsages.size() != 2) return;
+    CHECK_NEAR(usage.coreUsages[0], 75.0, 1e-9);
+    CHECK_NEAR(usage.coreBreakdowns[0].user, 50.0, 1e-9);
+    CHECK_NEAR(usage.coreBreakdowns[0].system, 25.0, 1e-9);
+    CHECK_NEAR(usage.coreBreakdowns[0].iowait, 25.0, 1e-9);
+    CHECK_NEAR(usage.coreBreakdowns[0].idle, 0.0, 1e-9);
+    CHECK_NEAR(usage.coreUsages[1], 0.0, 1e-9);
+    CHECK_NEAR(usage.coreBreakdowns[1].idle, 100.0, 1e-9);
+}
+
+#ifdef __linux__
+// 假 /proc/stat 的两次读数经 CPUMonitor 得到每核心类别占比
+void TestProcStatBreakdown() {
+    test::FakeTree proc;
+    proc.Write("stat",
+               "cpu  0 0 0 0 0 0 0 0 0 0\n"
+               "cpu0 0 0 0 0 0 0 0 0 0 0\n"
+               "cpu1 0 0 0 0 0 0 0 0 0 0\n");
+    CPUMonitor monitor(CreateProcStatCpuTimesSource(proc.Root(), 2));
+    CHECK(monitor.Initialize());
+
+    // cpu0：user 30 + nice 10，system 20，irq 5，softirq 5，steal 10，idle 10，iowait 10
+    // cpu1：全部空闲
+    proc.Write("stat",
+               "cpu  40 0 20 110 10 5 5 10 0 0\n"
+               "cpu0 30 10 20 10 10 5 5 10 0 0\n"
+               "cpu1 0 0 0 100 0 0 0 0 0 0\n");
+    CPUUsage usage = monitor.GetCurrentUsage();
+    if (usage.coreBreakdowns.size() != 2) {
+        CHECK_EQ(usage.coreBreakdowns.size(), 2u);
+        return;
+    }
+    const CpuTimeBreakdown& core0 = usage.coreBreakdowns[0];
+    CHECK_NEAR(core0.user, 40.0, 1e-9);
+    CHECK_NEAR(core0.system, 20.0, 1e-9);
+    CHECK_NEAR(core0.irq, 5.0, 1e-9);
+    CHECK_NEAR(core0.softirq, 5.0, 1e-9);
+    CHECK_NEAR(core0.steal, 10.0, 1e-9);
+    CHECK_NEAR(core0.iowait, 10.0, 1e-9);
+    CHECK_NEAR(core0.idle, 10.0, 1e-9);
+    CHECK_NEAR(usage.coreUsages[0], 80.0, 1e-9);
+    CHECK_NEAR(usage.coreBreakdowns[1].idle, 100.0, 1e-9);
+}
+#endif
+
+// 多路复用折算：只运行了一半时间的组计数翻倍，未运行的组记 0
+void TestMultiplexScaling() {
+    CHECK_EQ(ScaleMultiplexedCount(1000, 500, 500), 1000u);
+    CHECK_EQ(ScaleMultiplexedCount(1000, 2000, 1000), 2000u);
+    CHECK_EQ(ScaleMultiplexedCount(1000, 3000, 1000), 3000u);
+    CHECK_EQ(ScaleMultiplexedCount(1000, 1000, 0), 0u);
+    CHECK_EQ(ScaleMultiplexedCount(1000000000000ULL, 4, 1), 4000000000000ULL);   // 不经过整数乘法，不会溢出
+}
+
+// 硬件模式：每核心 IPC、MPKI 由折算后的差值得到；整机比值按合计的计数计算，不是各核心比值的平均
+void TestHardwareCounters() {
+    auto times = std::make_unique<ScriptedCpuTimesSource>(2);
+    times->Push(Times(0, 0, 0, 0));
+    times->Push(Times(50, 0, 50, 0));
+    CPUMonitor monitor(std::move(times));
+
+    auto counters = std::make_unique<ScriptedCounterSource>(CpuCounterMode::Hardware, 2);
+    counters->Push({{{0, 0, 0, 0}, 1, 1}, {{0, 0, 0, 0}, 1, 1}});
+    // 核心 0 只运行了一半时间：cycles 2e6、instructions 3e6、cache 6000、branch 3000
+    // 核心 1 未复用：cycles 1e6、instructions 5e5、cache 500、branch 0
+    counters->Push({{{1000000, 1500000, 3000, 1500}, 2000, 1000}, {{1000000, 500000, 500, 0}, 1000, 1000}});
+    CHECK(monitor.EnableCounters(std::move(counters)));
+
+    CHECK(monitor.Initialize());
+    CPUUsage usage = monitor.GetCurrentUsage();
+    CHECK(usage.counterMode == CpuCounterMode::Hardware);
+    CHECK_EQ(usage.coreCounters.size(), 2u);
+    if (usage.coreCounters.size() != 2) return;
+
+    const CpuCounterRates& core0 = usage.coreCounters[0];
+    const CpuCounterRates& core1 = usage.coreCounters[1];
+    CHECK(core0.cyclesPerSec > 0.0);
+    CHECK_NEAR(core0.cyclesPerSec / core1.cyclesPerSec, 2.0, 1e-9);
+    CHECK_NEAR(core0.instructionsPerCycle, 1.5, 1e-9);
+    CHECK_NEAR(core0.cacheMissesPerKiloInstructions, 2.0, 1e-9);
+    CHECK_NEAR(core0.branchMissesPerKiloInstructions, 1.0, 1e-9);
+    CHECK_NEAR(core1.instructionsPerCycle, 0.5, 1e-9);
+    CHECK_NEAR(core1.cacheMissesPerKiloInstructions, 1.0, 1e-9);
+
+    const CpuCounterRates& total = usage.counters;
+    CHECK_NEAR(total.cyclesPerSec, core0.cyclesPerSec + core1.cyclesPerSec, 1e-6 * total.cyclesPerSec);
+    CHECK_NEAR(total.instructionsPerSec, core0.instructionsPerSec + core1.instructionsPerSec,
+               1e-6 * total.instructionsPerSec);
+    CHECK_NEAR(total.instructionsPerCycle, 3.5 / 3.0, 1e-9);
+    CHECK_NEAR(total.cacheMissesPerKiloInstructions, 1000.0 * 6500 / 3500000, 1e-9);
+    CHECK_NEAR(total.branchMissesPerKiloInstructions, 1000.0 * 3000 / 3500000, 1e-9);
+    CHECK_EQ(total.contextSwitchesPerSec, 0.0);   // 当前模式以外的字段为 0
+}
+
+// 软件模式：只有上下文切换、迁移与缺页速率，硬件比值为 0；本段未运行的组不产生负增量
+void TestSoftwareCounters() {
+    auto times = std::make_unique<ScriptedCpuTimesSource>(2);
+    times->Push(Times(0, 0, 0, 0));
+    times->Push(Times(50, 0, 50, 0));
+    CPUMonitor monitor(std::move(times));
+
+    auto counters = std::make_unique<ScriptedCounterSource>(CpuCounterMode::Software, 2);
+    counters->Push({{{100, 10, 1000, 1}, 1, 1}, {{100, 10, 1000, 1}, 1, 1}});
+    // 核心 0 折算 ×3：切换 1200、迁移 30、缺页 4800、主缺页 9；核心 1 本段未运行
+    counters->Push({{{400, 10, 1600, 3}, 300, 100}, {{0, 0, 0, 0}, 300, 0}});
+    CHECK(monitor.EnableCounters(std::move(counters)));
+
+    CHECK(monitor.Initialize());
+    CPUUsage usage = monitor.GetCurrentUsage();
+    CHECK(usage.counterMode == CpuCounterMode::Software);
+    CHECK_EQ(usage.coreCounters.size(), 2u);
+    if (usage.coreCounters.size() != 2) return;
+
+    const CpuCounterRates& core0 = usage.coreCounters[0];
+    CHECK(core0.contextSwitchesPerSec > 0.0);
+    CHECK_NEAR(core0.pageFaultsPerSec / core0.contextSwitchesPerSec, 3800.0 / 1100.0, 1e-9);
+    CHECK_NEAR(core0.migrationsPerSec / core0.contextSwitchesPerSec, 20.0 / 1100.0, 1e-9);
+    CHECK_NEAR(core0.majorFaultsPerSec / core0.contextSwitchesPerSec, 8.0 / 1100.0, 1e-9);
+    CHECK_EQ(core0.instructionsPerCycle, 0.0);
+    CHECK_EQ(core0.cacheMissesPerKiloInstructions, 0.0);
+
+    const CpuCounterRates& core1 = usage.coreCounters[1];
+    CHECK_EQ(core1.contextSwitchesPerSec, 0.0);
+    CHECK_EQ(core1.pageFaultsPerSec, 0.0);
+
+    CHECK_NEAR(usage.counters.contextSwitchesPerSec, core0.contextSwitchesPerSec, 1e-9);
+    CHECK_EQ(usage.counters.instructionsPerCycle, 0.0);
+}
+
+// 未启用计数器时不输出计数器字段
+void TestCountersDisabled() {
+    auto times = std::make_unique<ScriptedCpuTimesSource>(1);
+    times->Push(Times(0, 0, 0, 0));
+    times->Push(Times(50, 0, 50, 0));
+    CPUMonitor monitor(std::move(times));
+    CHECK(!monitor.EnableCounters(std::make_unique<ScriptedCounterSource>(CpuCounterMode::None, 1)));
+    CHECK(monitor.Initialize());
+    CPUUsage usage = monitor.GetCurrentUsage();
+    CHECK(usage.counterMode == CpuCounterMode::None);
+    CHECK(usage.coreCounters.empty());
+}
+
+void TestReadFailure() {
+    CPUMonitor monitor(std::make_unique<ScriptedCpuTimesSource>(1));
+    CHECK(!monitor.Initialize());
+    CHECK(monitor.GetCurrentUsage().totalUsage < 0.0);
+}
+
+} // namespace
+
+int main() {
+    TestUsageBetweenSamples();
+    TestIdleGoingBackwards();
+    TestPerCoreBreakdown();
+#ifdef __linux__
+    TestProcStatBreakdown();
+#endif
+    TestMultiplexScaling();
+    TestHardwareCounters();
+    TestSoftwareCounters();
+    TestCountersDisabled();
+    TestReadFailure();
+    return test::Finish();
+}
@@ -0,0 +1,135 @@
+// SysfsCpuTelemetrySource：假 sysfs 目录树上的频率、降频计数与 hwmon 温度
+#include "core/CPUInfo/cpu_telemetry.h"
+#include "test_support.h"
+#include <cmath>
+#include <vector>
+
+using namespace sysmonitor;
+
+namespace {
+
+void WriteCpu(const test::FakeTree& sys, int cpu, int package, int core) {
+    const std::string dir = "devices/system/cpu/cpu" + std::to_string(cpu);
+    sys.Write(dir + "/topology/physical_package_id", std::to_string(package) + "\n");
+    sys.Write(dir + "/topology/core_id", std::to_string(core) + "\n");
+}
+
+// cpu0/cpu1 为同一物理核心的两个线程，cpu2 在另一个封装，cpu3 没有 cpufreq
+void WriteFakeSys(const test::FakeTree& sys) {
+    WriteCpu(sys, 0, 0, 0);
+    WriteCpu(sys, 1, 0, 0);
+    WriteCpu(sys, 2, 1, 0);
+    WriteCpu(sys, 3, 1, 1);
+
+    const std::string cpu0 = "devices/system/cpu/cpu0";
+    sys.Write(cpu0 + "/cpufreq/scaling_cur_freq", "2400000\n");
+    sys.Write(cpu0 + "/cpufreq/scaling_max_freq", "3000000\n");
+    sys.Write(cpu0 + "/cpufreq/cpuinfo_max_freq", "4200000\n");
+    sys.Write(cpu0 + "/thermal_throttle/core_throttle_count", "5\n");
+    sys.Write(cpu0 + "/thermal_throttle/package_throttle_count", "9\n");
+
+    // 没有 scaling_cur_freq 时退回 cpuinfo_cur_freq；共享计数器只读取第一个线程
+    const std::string cpu1 = "devices/system/cpu/cpu1";
+    sys.Write(cpu1 + "/cpufreq/cpuinfo_cur_freq", "1800000\n");
+    sys.Write(cpu1 + "/cpufreq/cpuinfo_max_freq", "4200000\n");
+    sys.Write(cpu1 + "/thermal_throttle/core_throttle_count", "77\n");
+    sys.Write(cpu1 + "/thermal_throttle/package_throttle_count", "77\n");
+
+    const std::string cpu2 = "devices/system/cpu/cpu2";
+    sys.Write(cpu2 + "/cpufreq/scaling_cur_freq", "3100000\n");
+    sys.Write(cpu2 + "/thermal_throttle/core_throttle_count", "3\n");
+    sys.Write(cpu2 + "/thermal_throttle/package_throttle_count", "4\n");
+
+    sys.Write("class/hwmon/hwmon1/name", "coretemp\n");
+    sys.Write("class/hwmon/hwmon1/temp1_input", "45000\n");
+    sys.Write("class/hwmon/hwmon1/temp1_label", "Package id 0\n");
+    sys.Write("class/hwmon/hwmon1/temp2_input", "43500\n");
+    sys.Write("class/hwmon/hwmon1/temp2_crit", "100000\n");
+    sys.Write("class/hwmon/hwmon0/name", "acpitz\n");
+    sys.Write("class/hwmon/hwmon0/temp1_input", "-5000\n");
+}
+
+void TestFrequenciesAndThrottleCounters() {
+    test::FakeTree sys;
+    WriteFakeSys(sys);
+    auto source = CreateSysfsCpuTelemetrySource(sys.Root(), 4);
+    CHECK_EQ(source->CoreCount(), 4u);
+    CHECK(source->HasThrottleCounters());
+
+    std::vector<CpuCoreFrequency> cores(4);
+    std::vector<double> temperatures(source->SensorNames().size());
+    CHECK(source->Read(cores.data(), temperatures.data()));
+
+    CHECK_EQ(cores[0].currentMHz, 2400u);
+    CHECK_EQ(cores[0].limitMHz, 3000u);
+    CHECK_EQ(cores[0].maxMHz, 4200u);
+    CHECK_EQ(cores[0].coreThrottleCount, 5u);
+    CHECK_EQ(cores[0].packageThrottleCount, 9u);
+
+    CHECK_EQ(cores[1].currentMHz, 1800u);
+    CHECK_EQ(cores[1].limitMHz, 0u);
+    CHECK_EQ(cores[1].coreThrottleCount, 5u);
+    CHECK_EQ(cores[1].packageThrottleCount, 9u);
+
+    CHECK_EQ(cores[2].currentMHz, 3100u);
+    CHECK_EQ(cores[2].coreThrottleCount, 3u);
+    CHECK_EQ(cores[2].packageThrottleCount, 4u);
+
+    // 与 cpu2 同封装、不同核心：封装计数共享，核心计数没有
+    CHECK_EQ(cores[3].currentMHz, 0u);
+    CHECK_EQ(cores[3].maxMHz, 0u);
+    CHECK_EQ(cores[3].coreThrottleCount, 0u);
+    CHECK_EQ(cores[3].packageThrottleCount, 4u);
+}
+
+void TestHwmonSensors() {
+    test::FakeTree sys;
+    WriteFakeSys(sys);
+    auto source = CreateSysfsCpuTelemetrySource(sys.Root(), 4);
+
+    const std::vector<std::string>& names = source->SensorNames();
+    CHECK_EQ(names.size(), 3u);
+    if (names.size() != 3) return;
+    CHECK_EQ(names[0], std::string("acpitz/temp1"));
+    CHECK_EQ(names[1], std::string("coretemp/Package id 0"));
+    CHECK_EQ(names[2], std::string("coretemp/temp2"));
+
+    std::vector<CpuCoreFrequency> cores(4);
+    std::vector<double> temperatures(names.size());
+    CHECK(source->Read(cores.data(), temperatures.data()));
+    CHECK_NEAR(temperatures[0], -5.0, 1e-9);
+    CHECK_NEAR(temperatures[1], 45.0, 1e-9);
+    CHECK_NEAR(temperatures[2], 43.5, 1e-9);
+
+    // 常驻描述符每次从偏移 0 重新读取；内容无法解析时为 NaN
+    sys.Write("class/hwmon/hwmon1/temp1_input", "97000\n");
+    sys.Write("class/hwmon/hwmon1/temp2_input", "\n");
+    sys.Write("devices/system/cpu/cpu0/thermal_throttle/package_throttle_count", "10\n");
+    CHECK(source->Read(cores.data(), temperatures.data()));
+    CHECK_NEAR(temperatures[1], 97.0, 1e-9);
+    CHECK(std::isnan(temperatures[2]));
+    CHECK_EQ(cores[0].packageThrottleCount, 10u);
+    CHECK_EQ(cores[1].packageThrottleCount, 10u);
+}
+
+// 虚拟机常见情形：没有 cpufreq、thermal_throttle 与 hwmon
+void TestEmptySysfs() {
+    test::FakeTree sys;
+    auto source = CreateSysfsCpuTelemetrySource(sys.Root(), 2);
+    CHECK(!source->HasThrottleCounters());
+    CHECK(source->SensorNames().empty());
+
+    std::vector<CpuCoreFrequency> cores(2);
+    CHECK(source->Read(cores.data(), nullptr));
+    CHECK_EQ(cores[0].currentMHz, 0u);
+    CHECK_EQ(cores[1].coreThrottleCount, 0u);
+}
+
+} // namespace
+
+int main() {
+    TestFrequenciesAndThrottleCounters();
+    TestHwmonSensors();
+    TestEmptySysfs();
+    return test::Finish();
+}
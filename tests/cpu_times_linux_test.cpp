@@ -0,0 +1,130 @@
+// ProcStatCpuTimesSource：假 /proc/stat 上的 cpu 行解析
+#include "core/CPUInfo/cpu_times.h"
+#include "test_support.h"
+#include <vector>
+
+using namespace sysmonitor;
+
+namespace {
+
+// user nice system idle iowait irq softirq steal guest guest_nice
+void TestTotalLine() {
+    test::FakeTree proc;
+    proc.Write("stat",
+               "cpu  1000 20 300 5000 40 7 3 2 100 0\n"
+               "intr 12345 0 0\n");
+    auto source = CreateProcStatCpuTimesSource(proc.Root(), 1);
+    CHECK_EQ(source->CoreCount(), 1u);
+
+    CpuTimes total;
+    std::vector<CpuTimes> cores(source->CoreCount());
+    CHECK(source->Read(total, cores.data()));
+    CHECK_EQ(total.user, 1020u);            // 含 nice，guest 已计入 user 不再累加
+    CHECK_EQ(total.system, 300u);
+    CHECK_EQ(total.irq, 7u);
+    CHECK_EQ(total.softirq, 3u);
+    CHECK_EQ(total.steal, 2u);
+    CHECK_EQ(total.iowait, 40u);
+    CHECK_EQ(total.busy, 1020u + 300u + 7u + 3u + 2u);
+    CHECK_EQ(total.idle, 5040u);            // 含 iowait
+}
+
+// 每核心行按类别拆分；离线核心（cpu2）没有行，不写入；超出核心数的行忽略
+void TestPerCoreLines() {
+    test::FakeTree proc;
+    proc.Write("stat",
+               "cpu  600 60 300 4000 90 30 15 6 0 0\n"
+               "cpu0 100 10 50 1000 20 5 3 1 0 0\n"
+               "cpu1 200 20 100 1500 30 10 5 2 7 0\n"
+               "cpu3 300 30 150 1500 40 15 7 3 0 0\n"
+               "cpu7 9 9 9 9 9 9 9 9 9 9\n"
+               "intr 12345 0 0\n"
+               "ctxt 999\n");
+    auto source = CreateProcStatCpuTimesSource(proc.Root(), 4);
+
+    CpuTimes total;
+    std::vector<CpuTimes> cores(source->CoreCount());
+    cores[2].busy = 12345;                  // 哨兵：不应被改写
+    CHECK(source->Read(total, cores.data()));
+
+    CHECK_EQ(cores[0].user, 110u);
+    CHECK_EQ(cores[0].system, 50u);
+    CHECK_EQ(cores[0].irq, 5u);
+    CHECK_EQ(cores[0].softirq, 3u);
+    CHECK_EQ(cores[0].steal, 1u);
+    CHECK_EQ(cores[0].iowait, 20u);
+    CHECK_EQ(cores[0].idle, 1020u);
+    CHECK_EQ(cores[0].busy, 110u + 50u + 5u + 3u + 1u);
+
+    CHECK_EQ(cores[1].user, 220u);
+    CHECK_EQ(cores[1].busy, 220u + 100u + 10u + 5u + 2u);
+    CHECK_EQ(cores[1].idle, 1530u);
+
+    CHECK_EQ(cores[2].busy, 12345u);
+
+    CHECK_EQ(cores[3].user, 330u);
+    CHECK_EQ(cores[3].system, 150u);
+    CHECK_EQ(cores[3].irq, 15u);
+    CHECK_EQ(cores[3].softirq, 7u);
+    CHECK_EQ(cores[3].steal, 3u);
+    CHECK_EQ(cores[3].iowait, 40u);
+}
+
+// 截断的核心行之前的行仍然有效
+void TestTruncatedCoreLine() {
+    test::FakeTree proc;
+    proc.Write("stat",
+               "cpu  300 0 0 700 0 0 0 0 0 0\n"
+               "cpu0 100 0 0 400 0 0 0 0 0 0\n"
+               "cpu1 200 0 0");
+    auto source = CreateProcStatCpuTimesSource(proc.Root(), 2);
+    CpuTimes total;
+    std::vector<CpuTimes> cores(2);
+    CHECK(source->Read(total, cores.data()));
+    CHECK_EQ(cores[0].busy, 100u);
+    CHECK_EQ(cores[1].busy, 0u);
+}
+
+// 每次 Read 都从文件开头重新读取
+void TestRereadsFile() {
+    test::FakeTree proc;
+    proc.Write("stat", "cpu  10 0 0 90 0 0 0 0 0 0\n");
+    auto source = CreateProcStatCpuTimesSource(proc.Root(), 1);
+    CpuTimes total, core;
+    CHECK(source->Read(total, &core));
+    CHECK_EQ(total.busy, 10u);
+
+    proc.Write("stat", "cpu  25 0 0 175 0 0 0 0 0 0\n");
+    CHECK(source->Read(total, &core));
+    CHECK_EQ(total.busy, 25u);
+    CHECK_EQ(total.idle, 175u);
+}
+
+void TestMissingOrTruncatedTotal() {
+    CpuTimes total, core;
+
+    // 没有整机行
+    test::FakeTree noTotal;
+    noTotal.Write("stat", "intr 1 2 3\n");
+    CHECK(!CreateProcStatCpuTimesSource(noTotal.Root(), 1)->Read(total, &core));
+
+    // 整机行没有换行，视为截断
+    test::FakeTree truncated;
+    truncated.Write("stat", "cpu  1000 20 300 5000");
+    CHECK(!CreateProcStatCpuTimesSource(truncated.Root(), 1)->Read(total, &core));
+
+    // 文件不存在
+    test::FakeTree empty;
+    CHECK(!CreateProcStatCpuTimesSource(empty.Root(), 1)->Read(total, &core));
+}
+
+} // namespace
+
+int main() {
+    TestTotalLine();
+    TestPerCoreLines();
+    TestTruncatedCoreLine();
+    TestRereadsFile();
+    TestMissingOrTruncatedTotal();
+    return test::Finish();
+}
@@ -0,0 +1,115 @@
+// DiscoverCpuTopology：假 sysfs 拓扑树上的封装、核心、SMT 线程与 NUMA 节点
+#include "core/CPUInfo/cpu_topology.h"
+#include "test_support.h"
+
+using namespace sysmonitor;
+
+namespace {
+
+void WriteCpu(const test::FakeTree& sys, int cpu, int package, int core) {
+    const std::string dir = "devices/system/cpu/cpu" + std::to_string(cpu) + "/topology";
+    sys.Write(dir + "/physical_package_id", std::to_string(package) + "\n");
+    sys.Write(dir + "/core_id", std::to_string(core) + "\n");
+}
+
+// 两个封装（内核编号 0、3），每个两个物理核心（core_id 不连续），每核两个线程；
+// 编号方式同 Linux：cpu0-3 为各核心的线程 0，cpu4-7 为线程 1
+void WriteTwoSocketSmt(const test::FakeTree& sys) {
+    const int packages[] = {0, 0, 3, 3};
+    const int coreIds[] = {0, 8, 0, 9};
+    for (int cpu = 0; cpu < 8; ++cpu) {
+        WriteCpu(sys, cpu, packages[cpu % 4], coreIds[cpu % 4]);
+    }
+    sys.Write("devices/system/node/node0/cpulist", "0-1,4-5\n");
+    sys.Write("devices/system/node/node1/cpulist", "2-3,6-7\n");
+    sys.Write("devices/system/node/possible", "0-1\n");
+}
+
+void TestTwoSocketSmt() {
+    test::FakeTree sys;
+    WriteTwoSocketSmt(sys);
+    CpuTopology topology = DiscoverCpuTopology(sys.Root(), 8);
+
+    CHECK_EQ(topology.packages, 2u);
+    CHECK_EQ(topology.physicalCores, 4u);
+    CHECK_EQ(topology.processors.size(), 8u);
+    if (topology.processors.size() != 8) return;
+
+    // 封装与核心重新连续编号
+    const uint32_t packages[] = {0, 0, 1, 1, 0, 0, 1, 1};
+    const uint32_t cores[] = {0, 1, 2, 3, 0, 1, 2, 3};
+    const uint32_t threads[] = {0, 0, 0, 0, 1, 1, 1, 1};
+    const uint32_t nodes[] = {0, 0, 1, 1, 0, 0, 1, 1};
+    for (uint32_t cpu = 0; cpu < 8; ++cpu) {
+        const LogicalProcessor& p = topology.processors[cpu];
+        CHECK_EQ(p.cpu, cpu);
+        CHECK_EQ(p.package, packages[cpu]);
+        CHECK_EQ(p.core, cores[cpu]);
+        CHECK_EQ(p.thread, threads[cpu]);
+        CHECK_EQ(p.node, nodes[cpu]);
+    }
+
+    CHECK_EQ(topology.nodes.size(), 2u);
+    if (topology.nodes.size() != 2) return;
+    CHECK_EQ(topology.nodes[0].node, 0u);
+    CHECK(topology.nodes[0].cpus == std::vector<uint32_t>({0, 1, 4, 5}));
+    CHECK_EQ(topology.nodes[1].node, 1u);
+    CHECK(topology.nodes[1].cpus == std::vector<uint32_t>({2, 3, 6, 7}));
+}
+
+// 内核未启用 NUMA：没有 node 目录，全部处理器归入节点 0
+void TestWithoutNuma() {
+    test::FakeTree sys;
+    WriteCpu(sys, 0, 0, 0);
+    WriteCpu(sys, 1, 0, 1);
+    CpuTopology topology = DiscoverCpuTopology(sys.Root(), 2);
+
+    CHECK_EQ(topology.packages, 1u);
+    CHECK_EQ(topology.physicalCores, 2u);
+    CHECK_EQ(topology.nodes.size(), 1u);
+    if (topology.nodes.size() != 1) return;
+    CHECK_EQ(topology.nodes[0].node, 0u);
+    CHECK(topology.nodes[0].cpus == std::vector<uint32_t>({0, 1}));
+}
+
+// 离线处理器没有 topology 目录：视为封装 0 上独立的核心；节点号不连续时保留操作系统编号
+void TestOfflineCpuAndSparseNodes() {
+    test::FakeTree sys;
+    WriteCpu(sys, 0, 0, 0);
+    WriteCpu(sys, 1, 0, 0);
+    sys.Write("devices/system/node/node2/cpulist", "0-2\n");
+    sys.Write("devices/system/node/node10/cpulist", "\n");
+    CpuTopology topology = DiscoverCpuTopology(sys.Root(), 3);
+
+    CHECK_EQ(topology.physicalCores, 2u);
+    CHECK_EQ(topology.processors[1].core, 0u);
+    CHECK_EQ(topology.processors[1].thread, 1u);
+    CHECK_EQ(topology.processors[2].core, 1u);
+    CHECK_EQ(topology.processors[2].thread, 0u);
+
+    CHECK_EQ(topology.nodes.size(), 2u);
+    if (topology.nodes.size() != 2) return;
+    CHECK_EQ(topology.nodes[0].node, 2u);
+    CHECK_EQ(topology.nodes[1].node, 10u);
+    CHECK(topology.nodes[1].cpus.empty());
+    CHECK_EQ(topology.processors[2].node, 2u);
+}
+
+// 真实 sysfs：至少一个封装、一个节点，每个处理器都归属某个节点
+void TestRealSysfs() {
+    CpuTopology topology = DiscoverCpuTopology();
+    CHECK(topology.packages >= 1);
+    CHECK(topology.physicalCores >= 1);
+    CHECK(!topology.nodes.empty());
+    CHECK(!topology.processors.empty());
+}
+
+} // namespace
+
+int main() {
+    TestTwoSocketSmt();
+    TestWithoutNuma();
+    TestOfflineCpuAndSparseNodes();
+    TestRealSysfs();
+    return test::Finish();
+}
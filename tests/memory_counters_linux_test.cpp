@@ -0,0 +1,148 @@
+// ProcMemoryCountersSource：假 /proc、/sys 上的 meminfo、vmstat、PSI 与节点 meminfo 解析
+#include "core/Memory/memory_counters.h"
+#include "test_support.h"
+
+using namespace sysmonitor;
+
+namespace {
+
+const char* const kMeminfo =
+    "MemTotal:       16303412 kB\n"
+    "MemFree:         1234567 kB\n"
+    "MemAvailable:    9876543 kB\n"
+    "Buffers:          345678 kB\n"
+    "Cached:          5432100 kB\n"
+    "SwapCached:        11111 kB\n"
+    "SwapTotal:       8388604 kB\n"
+    "SwapFree:        8000000 kB\n"
+    "CommitLimit:    16540308 kB\n"
+    "Committed_AS:   12345678 kB\n"
+    "HugePages_Total:       0\n"
+    "Hugepagesize:       2048 kB\n";
+
+const char* const kVmstat =
+    "nr_free_pages 308641\n"
+    "pgpgin 123456\n"
+    "pswpin 42\n"
+    "pswpout 4242\n"
+    "pgfault 987654321\n"
+    "pgmajfault 1234\n"
+    "pgfault_extra 5\n";
+
+void WriteFakeProc(const test::FakeTree& proc) {
+    proc.Write("meminfo", kMeminfo);
+    proc.Write("vmstat", kVmstat);
+    proc.Write("pressure/memory",
+               "some avg10=0.00 avg60=0.00 avg300=0.00 total=1500\n"
+               "full avg10=0.00 avg60=0.00 avg300=0.00 total=700\n");
+    // 旧内核的 cpu 只有 some 行
+    proc.Write("pressure/cpu", "some avg10=1.50 avg60=0.80 avg300=0.20 total=123456789\n");
+    proc.Write("pressure/io",
+               "some avg10=0.00 avg60=0.00 avg300=0.00 total=300\n"
+               "full avg10=0.00 avg60=0.00 avg300=0.00 total=200\n");
+}
+
+void TestMeminfoAndVmstat() {
+    test::FakeTree proc, sys;
+    WriteFakeProc(proc);
+    auto source = CreateProcMemoryCountersSource(proc.Root(), sys.Root());
+
+    MemoryCounters counters;
+    CHECK(source->Read(counters));
+    CHECK_EQ(counters.totalPhysical, 16303412ULL * 1024);
+    CHECK_EQ(counters.availablePhysical, 9876543ULL * 1024);
+    CHECK_EQ(counters.cached, 5432100ULL * 1024);      // 不被 SwapCached 覆盖
+    CHECK_EQ(counters.swapTotal, 8388604ULL * 1024);
+    CHECK_EQ(counters.swapFree, 8000000ULL * 1024);
+    CHECK_EQ(counters.commitLimit, 16540308ULL * 1024);
+    CHECK_EQ(counters.commitCharge, 12345678ULL * 1024);
+
+    CHECK_EQ(counters.pagesSwappedIn, 42u);
+    CHECK_EQ(counters.pagesSwappedOut, 4242u);
+    CHECK_EQ(counters.pageFaults, 987654321u);       // 不被 pgfault_extra 覆盖
+    CHECK_EQ(counters.majorFaults, 1234u);
+    CHECK(counters.nodes.empty());
+}
+
+void TestPressure() {
+    test::FakeTree proc, sys;
+    WriteFakeProc(proc);
+    auto source = CreateProcMemoryCountersSource(proc.Root(), sys.Root());
+
+    MemoryCounters counters;
+    CHECK(source->Read(counters));
+    CHECK(counters.hasPressure);
+    CHECK_EQ(counters.memoryPressure.someUs, 1500u);
+    CHECK_EQ(counters.memoryPressure.fullUs, 700u);
+    CHECK_EQ(counters.cpuPressure.someUs, 123456789u);
+    CHECK_EQ(counters.cpuPressure.fullUs, 0u);
+    CHECK_EQ(counters.ioPressure.someUs, 300u);
+    CHECK_EQ(counters.ioPressure.fullUs, 200u);
+
+    // 计数增长后重新读取
+    proc.Write("pressure/memory",
+               "some avg10=0.00 avg60=0.00 avg300=0.00 total=2500\n"
+               "full avg10=0.00 avg60=0.00 avg300=0.00 total=900\n");
+    CHECK(source->Read(counters));
+    CHECK_EQ(counters.memoryPressure.someUs, 2500u);
+    CHECK_EQ(counters.memoryPressure.fullUs, 900u);
+}
+
+// 内核未启用 PSI：文件不存在，其余计数照常
+void TestWithoutPressure() {
+    test::FakeTree proc, sys;
+    proc.Write("meminfo", kMeminfo);
+    proc.Write("vmstat", kVmstat);
+    auto source = CreateProcMemoryCountersSource(proc.Root(), sys.Root());
+
+    MemoryCounters counters;
+    CHECK(source->Read(counters));
+    CHECK(!counters.hasPressure);
+    CHECK_EQ(counters.pageFaults, 987654321u);
+}
+
+void TestNodes() {
+    test::FakeTree proc, sys;
+    WriteFakeProc(proc);
+    sys.Write("devices/system/node/node1/meminfo",
+              "Node 1 MemTotal:        8000000 kB\n"
+              "Node 1 MemFree:         3000000 kB\n"
+              "Node 1 MemUsed:         5000000 kB\n");
+    sys.Write("devices/system/node/node0/meminfo",
+              "Node 0 MemTotal:        8303412 kB\n"
+              "Node 0 MemFree:          100000 kB\n");
+    sys.Write("devices/system/node/possible", "0-1\n");
+    auto source = CreateProcMemoryCountersSource(proc.Root(), sys.Root());
+
+    MemoryCounters counters;
+    CHECK(source->Read(counters));
+    CHECK_EQ(counters.nodes.size(), 2u);
+    if (counters.nodes.size() != 2) return;
+    CHECK_EQ(counters.nodes[0].node, 0u);
+    CHECK_EQ(counters.nodes[0].total, 8303412ULL * 1024);
+    CHECK_EQ(counters.nodes[0].free, 100000ULL * 1024);
+    CHECK_EQ(counters.nodes[1].node, 1u);
+    CHECK_EQ(counters.nodes[1].total, 8000000ULL * 1024);
+    CHECK_EQ(counters.nodes[1].free, 3000000ULL * 1024);
+}
+
+void TestMissingMeminfo() {
+    test::FakeTree proc, sys;
+    MemoryCounters counters;
+    CHECK(!CreateProcMemoryCountersSource(proc.Root(), sys.Root())->Read(counters));
+
+    // 没有 MemTotal 视为读取失败
+    proc.Write("meminfo", "MemFree: 100 kB\n");
+    CHECK(!CreateProcMemoryCountersSource(proc.Root(), sys.Root())->Read(counters));
+}
+
+} // namespace
+
+int main() {
+    TestMeminfoAndVmstat();
+    TestPressure();
+    TestWithoutPressure();
+    TestNodes();
+    TestMissingMeminfo();
+    return test::Finish();
+}
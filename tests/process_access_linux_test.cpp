@@ -0,0 +1,207 @@
+// LinuxProcessAccess：假 procfs 目录树上的字段解析，以及真实 /proc 上的冒烟测试
+#include "core/Process/process_access.h"
+#include "test_support.h"
+#include <dirent.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace sysmonitor;
+
+namespace {
+
+constexpr uint64_t kUnixEpochIn100ns = 116444736000000000ULL;
+
+uint64_t TicksTo100ns(uint64_t ticks) {
+    return ticks * 10000000ULL / static_cast<uint64_t>(sysconf(_SC_CLK_TCK));
+}
+
+void WriteFakeProc(const test::FakeTree& proc) {
+    proc.Write("stat",
+               "cpu  100 0 50 800 10 5 5 0 0 0\n"
+               "cpu0 100 0 50 800 10 5 5 0 0 0\n"
+               "intr 12345 0 0\n"
+               "btime 1700000000\n");
+
+    // comm 含空格与括号，以最后一个 ')' 为界
+    proc.Write("100/stat",
+               "100 (my (proc) x) S 1 100 100 0 -1 4194304 500 0 7 0 250 50 0 0 20 0 3 0 1234 1000000 300\n");
+    proc.Write("100/statm", "1000 300 50 10 0 200 0\n");
+    proc.Write("100/status",
+               "Name:\tx\n"
+               "Uid:\t1000\t1000\t1000\t1000\n"
+               "voluntary_ctxt_switches:\t42\n"
+               "nonvoluntary_ctxt_switches:\t7\n");
+    proc.Write("100/io", "rchar: 4096\nwchar: 2048\nsyscr: 10\nsyscw: 5\nread_bytes: 0\nwrite_bytes: 0\n");
+    proc.Write("100/cmdline", std::string("/usr/bin/x\0--flag\0", 18));
+    proc.Write("100/task/100/stat", "100 (x) S 1 100 100 0 -1 0 0 0 0 0 200 40 0 0 20 0 3 0 1234 0 0\n");
+    proc.Write("100/task/101/stat", "101 (worker) R 1 100 100 0 -1 0 0 0 0 0 50 10 0 0 21 0 3 0 1300 0 0\n");
+
+    // 截断在 itrealvalue 之后，缺少 starttime
+    proc.Write("200/stat", "200 (short) S 1 200 200 0 -1 4194304 1 0 2 0 30 10 0 0 20 0 1 0\n");
+    // 没有 comm 的右括号
+    proc.Write("300/stat", "300 (broken S 1\n");
+    // 非数字目录不是进程
+    proc.Write("self/stat", "1 (init) S 0\n");
+}
+
+void TestEnumerateSkipsMalformedStat() {
+    test::FakeTree proc;
+    WriteFakeProc(proc);
+    auto access = CreateProcfsProcessAccess(proc.Root());
+
+    std::vector<ProcessEntry> entries;
+    CHECK(access->Enumerate(entries));
+    CHECK_EQ(entries.size(), 1u);
+    if (entries.size() != 1) return;
+    CHECK_EQ(entries[0].pid, 100u);
+    CHECK_EQ(entries[0].parentPid, 1u);
+    CHECK_EQ(entries[0].name, std::string("my (proc) x"));
+    CHECK_EQ(entries[0].threadCount, 3);
+    CHECK_EQ(entries[0].priority, 20);
+
+    CHECK(access->Open(100) != ProcessAccess::kInvalidHandle);
+    CHECK(access->Open(200) == ProcessAccess::kInvalidHandle);
+    CHECK(access->Open(300) == ProcessAccess::kInvalidHandle);
+    CHECK(access->Open(400) == ProcessAccess::kInvalidHandle);
+}
+
+void TestQueries() {
+    test::FakeTree proc;
+    WriteFakeProc(proc);
+    auto access = CreateProcfsProcessAccess(proc.Root());
+    std::vector<ProcessEntry> entries;
+    access->Enumerate(entries);
+    ProcessAccess::Handle handle = access->Open(100);
+    CHECK(handle != ProcessAccess::kInvalidHandle);
+
+    ProcessTimes times;
+    CHECK(access->QueryTimes(handle, times));
+    CHECK_EQ(times.userTime, TicksTo100ns(250));
+    CHECK_EQ(times.kernelTime, TicksTo100ns(50));
+    CHECK_EQ(times.createTime, static_cast<int64_t>(1700000000ULL * 10000000ULL + kUnixEpochIn100ns + TicksTo100ns(1234)));
+
+    const uint64_t page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    ProcessMemory memory;
+    CHECK(access->QueryMemory(handle, memory));
+    CHECK_EQ(memory.workingSetSize, 300 * page);
+    CHECK_EQ(memory.pagefileUsage, 200 * page);
+
+    ProcessCounters counters;
+    CHECK(access->QueryCounters(handle, counters));
+    CHECK_EQ(counters.minorFaults, 500u);
+    CHECK_EQ(counters.majorFaults, 7u);
+    CHECK_EQ(counters.readBytes, 4096u);
+    CHECK_EQ(counters.writeBytes, 2048u);
+    CHECK_EQ(counters.readOps, 10u);
+    CHECK_EQ(counters.writeOps, 5u);
+    CHECK_EQ(counters.voluntaryCtxSwitches, 42u);
+    CHECK_EQ(counters.involuntaryCtxSwitches, 7u);
+
+    CHECK_EQ(access->QueryCommandLine(handle), std::string("/usr/bin/x --flag"));
+    std::string uid;
+    CHECK(access->QueryUserId(handle, uid));
+    CHECK_EQ(uid, std::string("1000"));
+
+    // user nice system idle iowait irq softirq steal
+    CHECK_EQ(access->QuerySystemTime(), TicksTo100ns(100 + 0 + 50 + 800 + 10 + 5 + 5 + 0));
+    access->Close(handle);
+}
+
+void TestEnumerateThreads() {
+    test::FakeTree proc;
+    WriteFakeProc(proc);
+    auto access = CreateProcfsProcessAccess(proc.Root());
+
+    std::vector<ThreadEntry> threads;
+    CHECK(access->EnumerateThreads(100, threads));
+    std::sort(threads.begin(), threads.end(), [](const ThreadEntry& a, const ThreadEntry& b) { return a.tid < b.tid; });
+    CHECK_EQ(threads.size(), 2u);
+    if (threads.size() != 2) return;
+    CHECK_EQ(threads[1].tid, 101u);
+    CHECK_EQ(threads[1].name, std::string("worker"));
+    CHECK_EQ(threads[1].state, std::string("Running"));
+    CHECK_EQ(threads[1].priority, 21);
+    CHECK_EQ(threads[1].userTime, TicksTo100ns(50));
+    CHECK_EQ(threads[1].kernelTime, TicksTo100ns(10));
+
+    CHECK(!access->EnumerateThreads(200, threads));
+}
+
+// 假目录树没有 self/fd，逐项统计 fd 目录；已打开的进程每 4 轮枚举内刷新一次，其余轮次沿用上次的结果
+void TestHandleCountCadence() {
+    test::FakeTree proc;
+    WriteFakeProc(proc);
+    for (const char* fd : {"100/fd/0", "100/fd/1", "100/fd/2"}) proc.Write(fd, "");
+    auto access = CreateProcfsProcessAccess(proc.Root());
+    std::vector<ProcessEntry> entries;
+    access->Enumerate(entries);
+    ProcessAccess::Handle handle = access->Open(100);
+    CHECK_EQ(access->QueryHandleCount(handle), 3u);
+
+    proc.Write("100/fd/3", "");
+    CHECK_EQ(access->QueryHandleCount(handle), 3u);   // 同一轮内不重新统计
+    bool refreshed = false;
+    for (int scan = 0; scan < 4 && !refreshed; ++scan) {
+        access->Enumerate(entries);
+        refreshed = access->QueryHandleCount(handle) == 4;
+    }
+    CHECK(refreshed);
+    access->Close(handle);
+}
+
+// 真实 /proc：与逐项读取 fd 目录的结果一致
+void TestRealHandleCount() {
+    auto access = CreateDefaultProcessAccess();
+    const uint32_t self = static_cast<uint32_t>(getpid());
+    ProcessAccess::Handle handle = access->Open(self);
+    CHECK(handle != ProcessAccess::kInvalidHandle);
+    const uint32_t count = access->QueryHandleCount(handle);
+
+    uint32_t listed = 0;
+    if (DIR* dir = opendir("/proc/self/fd")) {
+        while (const dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') ++listed;
+        }
+        closedir(dir);
+    }
+    CHECK(count > 0);
+    CHECK(count == listed || count + 1 == listed);   // listed 含 opendir 自身的描述符
+    access->Close(handle);
+}
+
+// 真实 /proc：至少能看到并打开本进程
+void TestRealProc() {
+    auto access = CreateDefaultProcessAccess();
+    const uint32_t self = static_cast<uint32_t>(getpid());
+
+    std::vector<ProcessEntry> entries;
+    CHECK(access->Enumerate(entries));
+    CHECK(std::any_of(entries.begin(), entries.end(), [&](const ProcessEntry& e) { return e.pid == self; }));
+
+    ProcessAccess::Handle handle = access->Open(self);
+    CHECK(handle != ProcessAccess::kInvalidHandle);
+    ProcessMemory memory;
+    CHECK(access->QueryMemory(handle, memory));
+    CHECK(memory.workingSetSize > 0);
+    CHECK(access->QueryImagePath(handle).find("process_access_linux_test") != std::string::npos);
+    access->Close(handle);
+
+    std::vector<ThreadEntry> threads;
+    CHECK(access->EnumerateThreads(self, threads));
+    CHECK(access->QuerySystemTime() > 0);
+}
+
+} // namespace
+
+int main() {
+    TestEnumerateSkipsMalformedStat();
+    TestQueries();
+    TestEnumerateThreads();
+    TestHandleCountCadence();
+    TestRealProc();
+    TestRealHandleCount();
+    return test::Finish();
+}
@@ -0,0 +1,170 @@
+// netlink 进程连接器：由真实的 fork/exec/exit 驱动事件源与 ProcessLifecycleTracker
+// 订阅需要 CAP_NET_ADMIN，没有权限或内核不支持时整个测试记为跳过
+#include "core/Process/process_access.h"
+#include "core/Process/process_lifecycle.h"
+#include "test_support.h"
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <mutex>
+#include <sys/wait.h>
+#include <thread>
+#include <vector>
+
+using namespace sysmonitor;
+
+namespace {
+
+// 与 CMakeLists.txt 中的 SKIP_RETURN_CODE 一致
+constexpr int kSkipped = 77;
+
+// 收集事件源回调，等待指定进程的退出事件
+class EventRecorder {
+public:
+    void Add(const ProcessEvent& event) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        events_.push_back(event);
+        cv_.notify_all();
+    }
+
+    // 等到 pid 的 Exit 事件后返回该进程的全部事件
+    std::vector<ProcessEvent> WaitForExit(uint32_t pid) {
+        std::unique_lock<std::mutex> lk(mutex_);
+        cv_.wait_for(lk, std::chrono::seconds(5), [&] { return HasExit(pid); });
+        std::vector<ProcessEvent> result;
+        for (const auto& event : events_) {
+            if (event.pid == pid) result.push_back(event);
+        }
+        return result;
+    }
+
+private:
+    bool HasExit(uint32_t pid) const {
+        for (const auto& event : events_) {
+            if (event.pid == pid && event.type == ProcessEventType::Exit) return true;
+        }
+        return false;
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<ProcessEvent> events_;
+};
+
+const ProcessEvent* Find(const std::vector<ProcessEvent>& events, ProcessEventType type) {
+    for (const auto& event : events) {
+        if (event.type == type) return &event;
+    }
+    return nullptr;
+}
+
+// 子进程 exec /bin/sh 执行给定脚本
+pid_t SpawnShell(const char* script) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        execl("/bin/sh", "sh", "-c", script, static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    return pid;
+}
+
+void Reap(pid_t pid) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+void TestForkExecExit(EventRecorder& recorder) {
+    pid_t child = SpawnShell("sleep 0.2; exit 3");
+    CHECK(child > 0);
+    if (child <= 0) return;
+    // 进程表中的 createTime，用于确认内核 Start 事件与扫描结果能按 (pid, createTime) 对上
+    ProcessTimes times;
+    auto access = CreateProcfsProcessAccess("/proc");
+    ProcessAccess::Handle handle = access->Open(static_cast<uint32_t>(child));
+    CHECK(handle != ProcessAccess::kInvalidHandle);
+    CHECK(access->QueryTimes(handle, times));
+    access->Close(handle);
+    Reap(child);
+
+    std::vector<ProcessEvent> events = recorder.WaitForExit(static_cast<uint32_t>(child));
+    const ProcessEvent* start = Find(events, ProcessEventType::Start);
+    const ProcessEvent* exec = Find(events, ProcessEventType::Exec);
+    const ProcessEvent* exit = Find(events, ProcessEventType::Exit);
+    CHECK(start != nullptr);
+    CHECK(exec != nullptr);
+    CHECK(exit != nullptr);
+    if (!start || !exec || !exit) return;
+
+    CHECK_EQ(start->parentPid, static_cast<uint32_t>(getpid()));
+    CHECK_EQ(start->createTime, times.createTime);
+    CHECK_EQ(exec->name, std::string("sh"));
+    // 退出事件沿用 exec 时记录的进程名；退出码已从 wait 状态中解出
+    CHECK_EQ(exit->name, std::string("sh"));
+    CHECK_EQ(exit->exitCode, 3);
+}
+
+void TestKilledBySignal(EventRecorder& recorder) {
+    pid_t child = SpawnShell("exec sleep 10");
+    CHECK(child > 0);
+    if (child <= 0) return;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    kill(child, SIGKILL);
+    Reap(child);
+
+    std::vector<ProcessEvent> events = recorder.WaitForExit(static_cast<uint32_t>(child));
+    const ProcessEvent* exit = Find(events, ProcessEventType::Exit);
+    CHECK(exit != nullptr);
+    if (exit) CHECK_EQ(exit->exitCode, 128 + SIGKILL);
+}
+
+// 服务端使用的路径：事件写入日志并标记为内核来源
+void TestTrackerJournal() {
+    ProcessLifecycleTracker tracker;
+    CHECK(tracker.EnableKernelEvents());
+    CHECK(tracker.KernelEventsActive());
+
+    pid_t child = SpawnShell("exit 5");
+    CHECK(child > 0);
+    if (child <= 0) return;
+    Reap(child);
+
+    const ProcessEvent* exit = nullptr;
+    std::vector<ProcessEvent> events;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!exit && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        events.clear();
+        tracker.ReadSince(0, 4096, events);
+        for (const auto& event : events) {
+            if (event.pid == static_cast<uint32_t>(child) && event.type == ProcessEventType::Exit) {
+                exit = &event;
+            }
+        }
+    }
+    CHECK(exit != nullptr);
+    if (exit) {
+        CHECK(exit->source == ProcessEventSource::Kernel);
+        CHECK_EQ(exit->exitCode, 5);
+        CHECK(exit->seq > 0);
+    }
+    tracker.DisableKernelEvents();
+    CHECK(!tracker.KernelEventsActive());
+}
+
+} // namespace
+
+int main() {
+    EventRecorder recorder;
+    auto source = CreateKernelProcessEventSource();
+    if (!source || !source->Start([&](const ProcessEvent& event) { recorder.Add(event); }, [] {})) {
+        std::cout << "netlink process connector unavailable (needs CAP_NET_ADMIN), skipped" << std::endl;
+        return kSkipped;
+    }
+
+    TestForkExecExit(recorder);
+    TestKilledBySignal(recorder);
+    source->Stop();
+
+    TestTrackerJournal();
+    return test::Finish();
+}
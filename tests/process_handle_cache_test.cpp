@@ -0,0 +1,231 @@
+// ProcessHandleCache：用内存中的假 ProcessAccess 检查句柄复用、打开失败重试、pid 复用与淘汰
+#include "core/Process/process_handle_cache.h"
+#include "test_support.h"
+#include <map>
+#include <set>
+
+using namespace sysmonitor;
+
+namespace {
+
+// 只实现句柄缓存用到的 Open/Close/QueryTimes，记录调用次数与仍打开的句柄
+class FakeProcessAccess : public ProcessAccess {
+public:
+    struct Process {
+        int64_t createTime = 0;
+        bool openable = true;
+    };
+
+    std::map<uint32_t, Process> processes;
+    std::map<Handle, uint32_t> openHandles;   // 句柄 -> pid
+    std::map<uint32_t, int> openCalls;        // pid -> Open 调用次数
+    std::set<Handle> closed;
+
+    bool Enumerate(std::vector<ProcessEntry>&) override { return false; }
+
+    Handle Open(uint32_t pid) override {
+        ++openCalls[pid];
+        auto it = processes.find(pid);
+        if (it == processes.end() || !it->second.openable) return kInvalidHandle;
+        Handle handle = nextHandle_++;
+        openHandles[handle] = pid;
+        return handle;
+    }
+
+    void Close(Handle handle) override {
+        CHECK(openHandles.erase(handle) == 1);   // 不重复关闭、不关闭未知句柄
+        closed.insert(handle);
+    }
+
+    bool QueryTimes(Handle handle, ProcessTimes& times) override {
+        auto it = openHandles.find(handle);
+        if (it == openHandles.end()) return false;
+        times.createTime = processes[it->second].createTime;
+        return true;
+    }
+
+    bool QueryMemory(Handle, ProcessMemory&) override { return false; }
+    bool QueryCounters(Handle, ProcessCounters&) override { return false; }
+    uint32_t QueryHandleCount(Handle) override { return 0; }
+    uint32_t QueryGdiCount(Handle) override { return 0; }
+    uint32_t QueryUserCount(Handle) override { return 0; }
+    std::string QueryImagePath(Handle) override { return std::string(); }
+    std::string QueryCommandLine(Handle) override { return std::string(); }
+    bool QueryUserId(Handle, std::string&) override { return false; }
+    std::string LookupAccountName(const std::string&) override { return std::string(); }
+    bool EnumerateThreads(uint32_t, std::vector<ThreadEntry>&) override { return false; }
+    uint64_t QuerySystemTime() override { return 0; }
+    bool Terminate(uint32_t, uint32_t) override { return false; }
+
+private:
+    Handle nextHandle_ = 100;
+};
+
+// 同一进程跨多轮只打开一次
+void TestHitAcrossScans() {
+    FakeProcessAccess access;
+    access.processes[10] = {1000, true};
+    ProcessHandleCache cache(access);
+
+    cache.BeginScan();
+    ProcessHandleCache::Entry* first = cache.Acquire(10);
+    CHECK(first != nullptr);
+    if (!first) return;
+    const ProcessAccess::Handle handle = first->handle;
+    CHECK_EQ(first->createTime, 1000);
+    cache.EndScan();
+
+    for (int scan = 0; scan < 3; ++scan) {
+        cache.BeginScan();
+        ProcessHandleCache::Entry* entry = cache.Acquire(10);
+        CHECK(entry != nullptr);
+        if (entry) CHECK_EQ(entry->handle, handle);
+        CHECK_EQ(cache.EndScan(), 0u);
+    }
+
+    CHECK_EQ(access.openCalls[10], 1);
+    CHECK_EQ(cache.GetStats().opens, 1u);
+    CHECK_EQ(cache.GetStats().hits, 3u);
+}
+
+// 打开失败的 pid 在之后 kRetryScans - 1 轮内不再调用 Open，第 kRetryScans 轮重试
+void TestFailedOpenRetry() {
+    FakeProcessAccess access;
+    access.processes[20] = {2000, false};
+    ProcessHandleCache cache(access);
+
+    cache.BeginScan();
+    CHECK(cache.Acquire(20) == nullptr);
+    cache.EndScan();
+    CHECK_EQ(access.openCalls[20], 1);
+    CHECK_EQ(cache.Size(), 1u);   // 失败也记住，EndScan 不丢弃仍在枚举中的 pid
+
+    for (uint32_t scan = 1; scan < ProcessHandleCache::kRetryScans; ++scan) {
+        cache.BeginScan();
+        CHECK(cache.Acquire(20) == nullptr);
+        cache.EndScan();
+    }
+    CHECK_EQ(access.openCalls[20], 1);
+
+    // 期间获得了权限：第 kRetryScans 轮重试成功
+    access.processes[20].openable = true;
+    cache.BeginScan();
+    ProcessHandleCache::Entry* entry = cache.Acquire(20);
+    cache.EndScan();
+    CHECK(entry != nullptr);
+    CHECK_EQ(access.openCalls[20], 2);
+    CHECK_EQ(cache.GetStats().openFailures, 1u);
+    CHECK_EQ(cache.GetStats().opens, 1u);
+
+    // 再次失败后重新计数
+    access.processes[21] = {2100, false};
+    for (uint32_t scan = 0; scan <= 2 * ProcessHandleCache::kRetryScans; ++scan) {
+        cache.BeginScan();
+        cache.Acquire(20);
+        cache.Acquire(21);
+        cache.EndScan();
+    }
+    CHECK_EQ(access.openCalls[21], 3);
+}
+
+// createTime 变化（pid 被复用）时丢弃缓存的属性；同一进程重开时保留
+void TestPidReuse() {
+    FakeProcessAccess access;
+    access.processes[30] = {3000, true};
+    ProcessHandleCache cache(access);
+
+    cache.BeginScan();
+    ProcessHandleCache::Entry* entry = cache.Acquire(30);
+    CHECK(entry != nullptr);
+    if (!entry) return;
+    entry->attributes.loaded = true;
+    entry->attributes.fullPath = "/usr/bin/first";
+    const ProcessAccess::Handle firstHandle = entry->handle;
+
+    // 句柄失效，但仍是同一个进程
+    entry = cache.Reopen(30);
+    CHECK(entry != nullptr);
+    if (!entry) return;
+    CHECK(access.closed.count(firstHandle) == 1);
+    CHECK(entry->attributes.loaded);
+    CHECK_EQ(entry->attributes.fullPath, std::string("/usr/bin/first"));
+
+    // 原进程退出，新进程拿到相同 pid
+    access.processes[30].createTime = 3500;
+    entry = cache.Reopen(30);
+    CHECK(entry != nullptr);
+    if (!entry) return;
+    CHECK_EQ(entry->createTime, 3500);
+    CHECK(!entry->attributes.loaded);
+    CHECK(entry->attributes.fullPath.empty());
+    CHECK_EQ(cache.GetStats().reopened, 2u);
+    CHECK_EQ(access.openHandles.size(), 1u);
+    cache.EndScan();
+
+    // 没有缓存项时 Reopen 等同于 Acquire
+    access.processes[31] = {3100, true};
+    entry = cache.Reopen(31);
+    CHECK(entry != nullptr);
+    CHECK_EQ(cache.GetStats().reopened, 2u);
+}
+
+// 本轮未出现的 pid 在 EndScan 中关闭并移除
+void TestEviction() {
+    FakeProcessAccess access;
+    access.processes[40] = {4000, true};
+    access.processes[41] = {4100, true};
+    access.processes[42] = {4200, false};
+    ProcessHandleCache cache(access);
+
+    cache.BeginScan();
+    ProcessHandleCache::Entry* exiting = cache.Acquire(41);
+    CHECK(exiting != nullptr);
+    if (!exiting) return;
+    const ProcessAccess::Handle exitingHandle = exiting->handle;
+    cache.Acquire(40);
+    cache.Acquire(42);
+    CHECK_EQ(cache.EndScan(), 0u);
+    CHECK_EQ(cache.Size(), 3u);
+
+    cache.BeginScan();
+    cache.Acquire(40);
+    CHECK_EQ(cache.EndScan(), 2u);
+    CHECK_EQ(cache.Size(), 1u);
+    CHECK(access.closed.count(exitingHandle) == 1);
+    CHECK_EQ(cache.GetStats().evicted, 1u);   // 打开失败的 42 没有句柄，不计入
+    CHECK_EQ(access.openHandles.size(), 1u);
+
+    // 退出的 pid 再次出现时重新打开
+    cache.BeginScan();
+    cache.Acquire(40);
+    CHECK(cache.Acquire(41) != nullptr);
+    cache.EndScan();
+    CHECK_EQ(access.openCalls[41], 2);
+}
+
+// 析构时关闭所有句柄
+void TestDestructorClosesHandles() {
+    FakeProcessAccess access;
+    access.processes[50] = {5000, true};
+    access.processes[51] = {5100, true};
+    {
+        ProcessHandleCache cache(access);
+        cache.BeginScan();
+        cache.Acquire(50);
+        cache.Acquire(51);
+        cache.EndScan();
+        CHECK_EQ(access.openHandles.size(), 2u);
+    }
+    CHECK(access.openHandles.empty());
+}
+
+} // namespace
+
+int main() {
+    TestHitAcrossScans();
+    TestFailedOpenRetry();
+    TestPidReuse();
+    TestEviction();
+    TestDestructorClosesHandles();
+    return test::Finish();
+}
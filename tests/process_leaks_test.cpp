@@ -0,0 +1,194 @@
+// LeakDetector：合成的计数序列上的线性增长、平稳 / 噪声序列，以及 minTStat、minGrowth 阈值
+#include "core/Process/process_leaks.h"
+#include "test_support.h"
+#include <functional>
+
+using namespace sysmonitor;
+
+namespace {
+
+constexpr uint64_t kStepMs = 10000;   // 每 10 秒采样一次
+
+// 确定性的噪声，范围 [-amplitude, amplitude]
+double Noise(size_t i, double amplitude) {
+    return amplitude * (static_cast<double>((i * 7919 + 13) % 41) - 20.0) / 20.0;
+}
+
+// 一个进程的一种计数：第 i 次采样（时间 t 秒）的值
+struct Series {
+    uint32_t pid;
+    std::function<double(size_t i, double t)> handles;
+    int64_t createTime = 1;
+};
+
+// 以 kStepMs 为间隔喂入 samples 次采样，workingSet 固定为 1 MiB
+void Feed(LeakDetector& detector, const std::vector<Series>& series, size_t samples, size_t first = 0) {
+    for (size_t i = first; i < first + samples; ++i) {
+        ProcessTable table;
+        table.timestamp = 1000000 + i * kStepMs;
+        const double t = static_cast<double>(i * kStepMs) / 1000.0;
+        for (const auto& s : series) {
+            ProcessInfo info;
+            info.pid = s.pid;
+            info.name = "p" + std::to_string(s.pid);
+            info.createTime = s.createTime;
+            info.handleCount = static_cast<uint32_t>(s.handles(i, t));
+            info.workingSetSize = 1024 * 1024;
+            table.Append(info);
+        }
+        detector.Observe(table);
+    }
+}
+
+const LeakSuspect* Find(const std::vector<LeakSuspect>& suspects, uint32_t pid) {
+    for (const auto& suspect : suspects) {
+        if (suspect.pid == pid) return &suspect;
+    }
+    return nullptr;
+}
+
+// 线性增长 + 轻微噪声：60 个 / 窗口
+Series Linear(uint32_t pid) {
+    return {pid, [](size_t i, double t) { return 100.0 + 0.1 * t + Noise(i, 2.0); }};
+}
+
+// 平稳但噪声大
+Series Flat(uint32_t pid) {
+    return {pid, [](size_t i, double) { return 100.0 + Noise(i, 20.0); }};
+}
+
+// 严格线性但缓慢：6 个 / 窗口
+Series Slow(uint32_t pid) {
+    return {pid, [](size_t, double t) { return 100.0 + 0.01 * t; }};
+}
+
+// 增长 30 个 / 窗口，但淹没在噪声中
+Series NoisyGrowth(uint32_t pid) {
+    return {pid, [](size_t i, double t) { return 100.0 + 0.05 * t + Noise(i, 60.0); }};
+}
+
+// 默认阈值：只报告明显的线性增长，斜率与当前值取自回归与最近一次采样
+void TestDefaults() {
+    LeakDetector detector;
+    Feed(detector, {Linear(1), Flat(2), Slow(3), NoisyGrowth(4)}, 61);
+    CHECK_EQ(detector.TrackedProcesses(), 4u);
+
+    auto suspects = detector.Suspects({}, 10);
+    CHECK_EQ(suspects.size(), 1u);
+    const LeakSuspect* linear = Find(suspects, 1);
+    CHECK(linear != nullptr);
+    if (!linear) return;
+    CHECK(linear->metric == LeakMetric::Handles);
+    CHECK_NEAR(linear->slopePerHour, 360.0, 10.0);
+    CHECK(linear->tStat > 50.0);
+    CHECK(linear->rSquared > 0.99);
+    CHECK_NEAR(linear->trackedSeconds, 600.0, 1e-9);
+    CHECK_EQ(linear->current, static_cast<double>(static_cast<uint32_t>(100.0 + 60.0 + Noise(60, 2.0))));
+
+    // 只要工作集时没有结果
+    CHECK(detector.Suspects({LeakMetric::WorkingSet}, 10).empty());
+}
+
+// 严格线性但每窗口只增长 6 个：t 统计量足够，minGrowthCount 决定是否报告
+void TestMinGrowth() {
+    LeakDetector detector;
+    Feed(detector, {Slow(3)}, 61);
+    CHECK(detector.Suspects({}, 10).empty());
+
+    LeakDetectorOptions options;
+    options.minGrowthCount = 5.0;
+    detector.SetOptions(options);   // 重设选项会清空状态
+    CHECK_EQ(detector.TrackedProcesses(), 0u);
+    Feed(detector, {Slow(3)}, 61);
+    const auto suspects = detector.Suspects({}, 10);
+    CHECK(Find(suspects, 3) != nullptr);
+    if (!suspects.empty()) CHECK(suspects[0].tStat > options.minTStat);
+}
+
+// 增长量超过 minGrowthCount 但噪声很大：minTStat 决定是否报告
+void TestMinTStat() {
+    LeakDetector detector;
+    Feed(detector, {NoisyGrowth(4)}, 61);
+    CHECK(detector.Suspects({}, 10).empty());
+
+    LeakDetectorOptions options;
+    options.minTStat = 1.5;
+    detector.SetOptions(options);
+    Feed(detector, {NoisyGrowth(4)}, 61);
+    const auto suspects = detector.Suspects({}, 10);
+    const LeakSuspect* noisy = Find(suspects, 4);
+    CHECK(noisy != nullptr);
+    if (noisy) {
+        CHECK(noisy->tStat < 3.0);
+        CHECK(noisy->slopePerHour * options.windowSeconds / 3600.0 > options.minGrowthCount);
+    }
+}
+
+// 平稳的噪声序列：任一阈值都足以排除，两个都放开时才会出现
+void TestFlatSeries() {
+    LeakDetectorOptions options;
+    options.minGrowthCount = 0.0;
+    LeakDetector detector(options);
+    Feed(detector, {Flat(2)}, 61);
+    CHECK(detector.Suspects({}, 10).empty());
+
+    options = LeakDetectorOptions();
+    options.minTStat = 0.0;
+    detector.SetOptions(options);
+    Feed(detector, {Flat(2)}, 61);
+    CHECK(detector.Suspects({}, 10).empty());
+
+    options.minGrowthCount = 0.0;
+    detector.SetOptions(options);
+    Feed(detector, {Flat(2)}, 61);
+    CHECK(Find(detector.Suspects({}, 10), 2) != nullptr);
+}
+
+// 跟踪不足半个窗口不报告；pid 复用时重新开始；退出的进程被清除
+void TestTrackingLifetime() {
+    LeakDetector detector;
+    Feed(detector, {Linear(1), Linear(5)}, 30);   // 290 秒
+    CHECK(detector.Suspects({}, 10).empty());
+    Feed(detector, {Linear(1), Linear(5)}, 31, 30);
+    CHECK_EQ(detector.Suspects({}, 10).size(), 2u);
+
+    // pid 5 被新进程复用，pid 1 退出
+    Series reused = Linear(5);
+    reused.createTime = 2;
+    Feed(detector, {reused}, 1, 61);
+    CHECK_EQ(detector.TrackedProcesses(), 1u);
+    CHECK(detector.Suspects({}, 10).empty());
+}
+
+// 按 t 统计量从高到低截取前 n 个
+void TestOrderingAndLimit() {
+    LeakDetectorOptions options;
+    options.minTStat = 1.5;
+    options.minGrowthCount = 5.0;
+    LeakDetector detector(options);
+    Feed(detector, {NoisyGrowth(4), Slow(3), Linear(1)}, 61);
+
+    auto suspects = detector.Suspects({LeakMetric::Handles}, 10);
+    CHECK_EQ(suspects.size(), 3u);
+    if (suspects.size() != 3) return;
+    CHECK_EQ(suspects[0].pid, 1u);
+    CHECK_EQ(suspects[1].pid, 3u);
+    CHECK_EQ(suspects[2].pid, 4u);
+
+    suspects = detector.Suspects({}, 1);
+    CHECK_EQ(suspects.size(), 1u);
+    if (!suspects.empty()) CHECK_EQ(suspects[0].pid, 1u);
+    CHECK(detector.Suspects({}, 0).empty());
+}
+
+} // namespace
+
+int main() {
+    TestDefaults();
+    TestMinGrowth();
+    TestMinTStat();
+    TestFlatSeries();
+    TestTrackingLifetime();
+    TestOrderingAndLimit();
+    return test::Finish();
+}
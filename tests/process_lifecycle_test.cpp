@@ -0,0 +1,163 @@
+// ProcessLifecycleTracker：相邻进程表比较、注入的内核事件源，以及事件源溢出后的补齐比较
+#include "core/Process/process_lifecycle.h"
+#include "test_support.h"
+
+using namespace sysmonitor;
+
+namespace {
+
+// 由测试直接调用回调，模拟内核事件与接收缓冲区溢出
+class FakeKernelSource : public KernelProcessEventSource {
+public:
+    bool Start(Callback callback, OverrunCallback onOverrun) override {
+        callback_ = std::move(callback);
+        onOverrun_ = std::move(onOverrun);
+        return true;
+    }
+    void Stop() override {}
+
+    void Emit(const ProcessEvent& event) { callback_(event); }
+    void Overrun() { onOverrun_(); }
+
+private:
+    Callback callback_;
+    OverrunCallback onOverrun_;
+};
+
+struct Row {
+    uint32_t pid;
+    int64_t createTime;
+    const char* name;
+};
+
+std::shared_ptr<const ProcessTable> MakeTable(uint64_t timestamp, std::initializer_list<Row> rows) {
+    auto table = std::make_shared<ProcessTable>();
+    table->timestamp = timestamp;
+    for (const Row& row : rows) {
+        ProcessInfo info;
+        info.pid = row.pid;
+        info.createTime = row.createTime;
+        info.name = row.name;
+        table->Append(info);
+    }
+    table->BuildIndexes();
+    return table;
+}
+
+std::vector<ProcessEvent> ReadAll(ProcessLifecycleTracker& tracker, uint64_t& seq) {
+    std::vector<ProcessEvent> events;
+    tracker.ReadSince(seq, 1000, events);
+    if (!events.empty()) seq = events.back().seq;
+    return events;
+}
+
+// 按 (pid, createTime) 比较：消失的记 Exit，新出现的记 Start，pid 复用算一退一启
+void TestScanDiff() {
+    ProcessLifecycleTracker tracker;
+    uint64_t seq = 0;
+    tracker.Observe(MakeTable(1000, {{1, 10, "init"}, {2, 20, "old"}, {3, 30, "reused"}}));
+    CHECK(ReadAll(tracker, seq).empty());   // 第一份只作为基准
+
+    tracker.Observe(MakeTable(2000, {{1, 10, "init"}, {3, 35, "reused"}, {4, 40, "new"}}));
+    auto events = ReadAll(tracker, seq);
+    CHECK_EQ(events.size(), 4u);
+    if (events.size() != 4) return;
+    CHECK(events[0].type == ProcessEventType::Exit);
+    CHECK_EQ(events[0].pid, 2u);
+    CHECK_EQ(events[0].name, std::string("old"));
+    CHECK(events[1].type == ProcessEventType::Exit);
+    CHECK_EQ(events[1].createTime, 30);
+    CHECK(events[2].type == ProcessEventType::Start);
+    CHECK_EQ(events[2].createTime, 35);
+    CHECK(events[3].type == ProcessEventType::Start);
+    CHECK_EQ(events[3].pid, 4u);
+    for (const auto& event : events) {
+        CHECK(event.source == ProcessEventSource::Scan);
+        CHECK_EQ(event.timestamp, 2000u);
+    }
+}
+
+// 内核事件源正常时不比较进程表；溢出后的下一份进程表比较一次补上丢失的事件，之后恢复
+void TestResyncAfterOverrun() {
+    ProcessLifecycleTracker tracker;
+    auto owned = std::make_unique<FakeKernelSource>();
+    FakeKernelSource* source = owned.get();
+    CHECK(tracker.EnableKernelEvents(std::move(owned)));
+    CHECK(tracker.KernelEventsActive());
+
+    uint64_t seq = 0;
+    tracker.Observe(MakeTable(1000, {{1, 10, "init"}, {2, 20, "worker"}}));
+    tracker.Observe(MakeTable(2000, {{1, 10, "init"}, {5, 50, "missed"}}));
+    CHECK(ReadAll(tracker, seq).empty());
+
+    // 内核事件：名称为空时从最近一份进程表补全
+    ProcessEvent exit;
+    exit.type = ProcessEventType::Exit;
+    exit.pid = 5;
+    exit.exitCode = 3;
+    source->Emit(exit);
+    auto events = ReadAll(tracker, seq);
+    CHECK_EQ(events.size(), 1u);
+    if (events.size() == 1) {
+        CHECK(events[0].source == ProcessEventSource::Kernel);
+        CHECK_EQ(events[0].name, std::string("missed"));
+        CHECK_EQ(events[0].exitCode, 3);
+    }
+
+    // 溢出期间 pid 1 退出、pid 6 启动，内核事件丢失
+    source->Overrun();
+    CHECK_EQ(tracker.GetStats().sourceDropped, 1u);
+    tracker.Observe(MakeTable(3000, {{6, 60, "late"}}));
+    events = ReadAll(tracker, seq);
+    CHECK_EQ(events.size(), 3u);   // 比较的是溢出前后两份表：1、5 退出，6 启动
+    if (events.size() == 3) {
+        CHECK(events[0].type == ProcessEventType::Exit);
+        CHECK_EQ(events[0].pid, 1u);
+        CHECK(events[2].type == ProcessEventType::Start);
+        CHECK_EQ(events[2].pid, 6u);
+        CHECK_EQ(events[2].createTime, 60);
+        for (const auto& event : events) CHECK(event.source == ProcessEventSource::Scan);
+    }
+
+    // 只补一次
+    tracker.Observe(MakeTable(4000, {{7, 70, "next"}}));
+    CHECK(ReadAll(tracker, seq).empty());
+
+    // 关闭事件源后恢复逐次比较
+    tracker.DisableKernelEvents();
+    CHECK(!tracker.KernelEventsActive());
+    tracker.Observe(MakeTable(5000, {{8, 80, "after"}}));
+    CHECK_EQ(ReadAll(tracker, seq).size(), 2u);
+}
+
+// 写满后覆盖最旧的事件；读者序号已被覆盖时返回错过的条数
+void TestJournalEviction() {
+    ProcessEventJournal journal(2);
+    for (uint32_t pid = 1; pid <= 4; ++pid) {
+        ProcessEvent event;
+        event.pid = pid;
+        journal.Append(event);
+    }
+    std::vector<ProcessEvent> events;
+    CHECK_EQ(journal.ReadSince(0, 10, events), 0u);   // 新读者从最旧的开始，不计丢失
+    CHECK_EQ(events.size(), 2u);
+    if (events.size() == 2) CHECK_EQ(events[0].seq, 3u);
+    events.clear();
+    CHECK_EQ(journal.ReadSince(1, 1, events), 1u);    // 序号 2 已被覆盖
+    CHECK_EQ(events.size(), 1u);
+    if (events.size() == 1) CHECK_EQ(events[0].pid, 3u);
+    auto stats = journal.GetStats();
+    CHECK_EQ(stats.evicted, 2u);
+    CHECK_EQ(stats.readerDropped, 1u);
+    CHECK_EQ(stats.firstSeq, 3u);
+    CHECK_EQ(stats.lastSeq, 4u);
+}
+
+} // namespace
+
+int main() {
+    TestScanDiff();
+    TestResyncAfterOverrun();
+    TestJournalEviction();
+    return test::Finish();
+}
@@ -0,0 +1,142 @@
+// ComputeTopProcesses：内存中构造的进程表上的排行、并列次序、n 为 0 与分组计数
+#include "core/Process/process_top.h"
+#include "test_support.h"
+
+using namespace sysmonitor;
+
+namespace {
+
+ProcessInfo MakeProcess(uint32_t pid, const std::string& name, const std::string& user,
+                        double cpu, uint64_t workingSet, int32_t threads) {
+    ProcessInfo info;
+    info.pid = pid;
+    info.name = name;
+    info.username = user;
+    info.cpuUsage = cpu;
+    info.workingSetSize = workingSet;
+    info.threadCount = threads;
+    return info;
+}
+
+ProcessTable MakeTable() {
+    ProcessTable table;
+    table.Append(MakeProcess(30, "chrome", "alice", 5.0, 300, 10));
+    table.Append(MakeProcess(10, "bash", "bob", 5.0, 100, 1));
+    table.Append(MakeProcess(20, "chrome", "alice", 9.0, 200, 20));
+    table.Append(MakeProcess(40, "chrome", "bob", 5.0, 400, 30));
+    table.Append(MakeProcess(50, "sshd", "root", 1.0, 50, 2));
+    return table;
+}
+
+std::vector<uint32_t> Pids(const TopRanking& ranking) {
+    std::vector<uint32_t> pids;
+    for (const auto& entry : ranking.entries) pids.push_back(entry.pid);
+    return pids;
+}
+
+// 一次调用中的多个指标各自按值从大到小
+void TestMultipleMetrics() {
+    ProcessTable table = MakeTable();
+    auto rankings = ComputeTopProcesses(table, {TopMetric::Cpu, TopMetric::Memory, TopMetric::Threads}, 2);
+    CHECK_EQ(rankings.size(), 3u);
+    if (rankings.size() != 3) return;
+
+    CHECK(rankings[0].metric == TopMetric::Cpu);
+    CHECK(Pids(rankings[0]) == std::vector<uint32_t>({20, 30}));
+    CHECK(Pids(rankings[1]) == std::vector<uint32_t>({40, 30}));
+    CHECK(Pids(rankings[2]) == std::vector<uint32_t>({40, 20}));
+    CHECK_EQ(rankings[1].entries[0].value, 400.0);
+    CHECK_EQ(rankings[1].entries[0].name, std::string("chrome"));
+    CHECK_EQ(rankings[1].entries[0].username, std::string("bob"));
+    CHECK_EQ(rankings[1].entries[0].processCount, 1u);
+}
+
+// 值相同时表中靠前的行排在前面，与 pid 大小无关；堆满后后来的并列项不挤掉已有项
+void TestTieBreak() {
+    ProcessTable table = MakeTable();
+    auto rankings = ComputeTopProcesses(table, {TopMetric::Cpu}, 3);
+    CHECK(Pids(rankings[0]) == std::vector<uint32_t>({20, 30, 10}));
+
+    rankings = ComputeTopProcesses(table, {TopMetric::Cpu}, 10);
+    CHECK(Pids(rankings[0]) == std::vector<uint32_t>({20, 30, 10, 40, 50}));
+
+    // 全部为 0 的指标按行序输出
+    rankings = ComputeTopProcesses(table, {TopMetric::Handles}, 2);
+    CHECK(Pids(rankings[0]) == std::vector<uint32_t>({30, 10}));
+}
+
+// n 为 0 或表为空：每个指标仍有一个排行，但没有条目
+void TestEmptyResults() {
+    ProcessTable table = MakeTable();
+    auto rankings = ComputeTopProcesses(table, {TopMetric::Cpu, TopMetric::Io}, 0);
+    CHECK_EQ(rankings.size(), 2u);
+    for (const auto& ranking : rankings) CHECK(ranking.entries.empty());
+
+    rankings = ComputeTopProcesses(table, {TopMetric::Memory}, 0, TopGroupBy::Name);
+    CHECK_EQ(rankings.size(), 1u);
+    if (!rankings.empty()) CHECK(rankings[0].entries.empty());
+
+    ProcessTable empty;
+    rankings = ComputeTopProcesses(empty, {TopMetric::Cpu}, 5, TopGroupBy::User);
+    CHECK_EQ(rankings.size(), 1u);
+    if (!rankings.empty()) CHECK(rankings[0].entries.empty());
+}
+
+// 按进程名聚合：组内数值求和，processCount 为组内进程数，pid 为 0
+void TestGroupByName() {
+    ProcessTable table = MakeTable();
+    auto rankings = ComputeTopProcesses(table, {TopMetric::Threads, TopMetric::Cpu}, 10, TopGroupBy::Name);
+    CHECK_EQ(rankings.size(), 2u);
+    if (rankings.size() != 2) return;
+
+    const auto& threads = rankings[0].entries;
+    CHECK_EQ(threads.size(), 3u);
+    if (threads.size() != 3) return;
+    CHECK_EQ(threads[0].name, std::string("chrome"));
+    CHECK_EQ(threads[0].value, 60.0);
+    CHECK_EQ(threads[0].processCount, 3u);
+    CHECK_EQ(threads[0].pid, 0u);
+    CHECK(threads[0].username.empty());
+    CHECK_EQ(threads[1].name, std::string("sshd"));
+    CHECK_EQ(threads[1].processCount, 1u);
+    CHECK_EQ(threads[2].name, std::string("bash"));
+
+    const auto& cpu = rankings[1].entries;
+    CHECK_EQ(cpu.size(), 3u);
+    if (cpu.size() != 3) return;
+    CHECK_EQ(cpu[0].value, 19.0);
+    CHECK_EQ(cpu[1].name, std::string("bash"));
+    CHECK_EQ(cpu[1].value, 5.0);
+}
+
+// 按用户聚合：name 与 username 都是用户名；组数超过 n 时截断，并列组按首次出现的顺序
+void TestGroupByUser() {
+    ProcessTable table = MakeTable();
+    table.Append(MakeProcess(60, "cron", "root", 4.0, 50, 1));
+    auto rankings = ComputeTopProcesses(table, {TopMetric::Cpu}, 2, TopGroupBy::User);
+    CHECK_EQ(rankings.size(), 1u);
+    if (rankings.empty()) return;
+
+    const auto& entries = rankings[0].entries;
+    CHECK_EQ(entries.size(), 2u);
+    if (entries.size() != 2) return;
+    CHECK_EQ(entries[0].name, std::string("alice"));
+    CHECK_EQ(entries[0].username, std::string("alice"));
+    CHECK_EQ(entries[0].value, 14.0);
+    CHECK_EQ(entries[0].processCount, 2u);
+    // bob 与 root 均为 10.0，bob 先出现
+    CHECK_EQ(entries[1].name, std::string("bob"));
+    CHECK_EQ(entries[1].value, 10.0);
+    CHECK_EQ(entries[1].processCount, 2u);
+}
+
+} // namespace
+
+int main() {
+    TestMultipleMetrics();
+    TestTieBreak();
+    TestEmptyResults();
+    TestGroupByName();
+    TestGroupByUser();
+    return test::Finish();
+}
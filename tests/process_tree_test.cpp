@@ -0,0 +1,137 @@
+// ProcessTree：内存中构造的进程表上的父子关系、pid 复用与成环处理、子树合计及后序区间
+#include "core/Process/process_tree.h"
+#include "test_support.h"
+#include <vector>
+
+using namespace sysmonitor;
+
+namespace {
+
+ProcessInfo MakeProcess(uint32_t pid, uint32_t parentPid, int64_t createTime, double cpu) {
+    ProcessInfo info;
+    info.pid = pid;
+    info.parentPid = parentPid;
+    info.createTime = createTime;
+    info.cpuUsage = cpu;
+    info.workingSetSize = 100;
+    info.threadCount = 2;
+    info.handleCount = 10;
+    return info;
+}
+
+// 沿 parentRow 判断 ancestor 是否为 row 自身或其祖先
+bool InSubtree(const ProcessTree& tree, uint32_t row, uint32_t ancestor) {
+    for (int32_t current = static_cast<int32_t>(row); current != ProcessTree::kNoParent;
+         current = tree.parentRow[current]) {
+        if (static_cast<uint32_t>(current) == ancestor) return true;
+    }
+    return false;
+}
+
+// 每个子树在后序中占据以根结尾、长度为 subtreeProcesses 的连续区间，且区间内恰好是该子树的进程
+void CheckPostOrderRanges(const ProcessTree& tree, size_t rows) {
+    CHECK_EQ(tree.postOrder.size(), rows);
+    for (uint32_t row = 0; row < rows; ++row) {
+        CHECK_EQ(tree.postOrder[tree.postOrderIndex[row]], row);
+        const uint32_t last = tree.postOrderIndex[row];
+        const uint32_t first = last + 1 - tree.subtreeProcesses[row];
+        for (uint32_t i = 0; i < rows; ++i) {
+            const bool inside = tree.postOrderIndex[i] >= first && tree.postOrderIndex[i] <= last;
+            if (inside != InSubtree(tree, i, row)) {
+                CHECK(inside == InSubtree(tree, i, row));
+                return;
+            }
+        }
+    }
+}
+
+// 行 0 为 init；行 3 的父 pid 已被晚创建的行 4 复用；行 5、6 互为父进程；行 7 的父进程不在表中
+ProcessTable MakeTable() {
+    ProcessTable table;
+    table.Append(MakeProcess(1, 0, 100, 1.0));
+    table.Append(MakeProcess(10, 1, 200, 2.0));
+    table.Append(MakeProcess(11, 10, 300, 3.0));
+    table.Append(MakeProcess(20, 30, 500, 4.0));
+    table.Append(MakeProcess(30, 1, 900, 5.0));
+    table.Append(MakeProcess(40, 41, 1000, 6.0));
+    table.Append(MakeProcess(41, 40, 1000, 7.0));
+    table.Append(MakeProcess(50, 999, 1100, 8.0));
+    table.BuildIndexes();
+    return table;
+}
+
+void TestRootsAndOrphans() {
+    ProcessTable table = MakeTable();
+    ProcessTree tree = ProcessTree::Build(table);
+
+    CHECK(tree.roots == std::vector<uint32_t>({0, 3, 5, 7}));
+    CHECK(tree.orphan == std::vector<uint8_t>({0, 0, 0, 1, 0, 1, 0, 1}));
+    CHECK(tree.parentRow == std::vector<int32_t>({ProcessTree::kNoParent, 0, 1, ProcessTree::kNoParent, 0,
+                                                  ProcessTree::kNoParent, 5, ProcessTree::kNoParent}));
+
+    // 子进程按行号顺序
+    CHECK_EQ(tree.ChildCount(0), 2u);
+    CHECK(std::vector<uint32_t>(tree.ChildrenBegin(0), tree.ChildrenEnd(0)) == std::vector<uint32_t>({1, 4}));
+    CHECK_EQ(tree.ChildCount(3), 0u);
+    CHECK_EQ(tree.ChildCount(5), 1u);
+    CHECK_EQ(tree.children.size(), 4u);
+}
+
+// 子树合计包含进程自身
+void TestSubtreeTotals() {
+    ProcessTable table = MakeTable();
+    ProcessTree tree = ProcessTree::Build(table);
+
+    CHECK(tree.subtreeProcesses == std::vector<uint32_t>({4, 2, 1, 1, 1, 2, 1, 1}));
+    CHECK_NEAR(tree.subtreeCpuUsage[0], 1.0 + 2.0 + 3.0 + 5.0, 1e-9);
+    CHECK_NEAR(tree.subtreeCpuUsage[1], 5.0, 1e-9);
+    CHECK_NEAR(tree.subtreeCpuUsage[3], 4.0, 1e-9);      // 不计入复用 pid 的进程
+    CHECK_NEAR(tree.subtreeCpuUsage[5], 13.0, 1e-9);
+    CHECK_EQ(tree.subtreeWorkingSetSize[0], 400u);
+    CHECK_EQ(tree.subtreeThreadCount[0], 8u);
+    CHECK_EQ(tree.subtreeHandleCount[5], 20u);
+}
+
+void TestPostOrder() {
+    ProcessTable table = MakeTable();
+    ProcessTree tree = ProcessTree::Build(table);
+
+    CHECK(tree.postOrder == std::vector<uint32_t>({2, 1, 4, 0, 3, 6, 5, 7}));
+    CheckPostOrderRanges(tree, table.Size());
+}
+
+// 10 万层的进程链：遍历不递归，整条链是一棵子树
+void TestDeepChain() {
+    const uint32_t depth = 100000;
+    ProcessTable table;
+    table.Reserve(depth);
+    for (uint32_t i = 0; i < depth; ++i) {
+        table.Append(MakeProcess(i + 1, i, 100 + i, 1.0));
+    }
+    table.BuildIndexes();
+    ProcessTree tree = ProcessTree::Build(table);
+
+    CHECK(tree.roots == std::vector<uint32_t>({0}));
+    CHECK_EQ(tree.subtreeProcesses[0], depth);
+    CHECK_NEAR(tree.subtreeCpuUsage[0], static_cast<double>(depth), 1e-6);
+    CHECK_EQ(tree.subtreeProcesses[depth - 1], 1u);
+    CHECK_EQ(tree.postOrder.front(), depth - 1);
+    CHECK_EQ(tree.postOrder.back(), 0u);
+    for (uint32_t row = 0; row < depth; ++row) {
+        if (tree.postOrderIndex[row] != depth - 1 - row || tree.subtreeProcesses[row] != depth - row) {
+            CHECK_EQ(tree.postOrderIndex[row], depth - 1 - row);
+            CHECK_EQ(tree.subtreeProcesses[row], depth - row);
+            break;
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    TestRootsAndOrphans();
+    TestSubtreeTotals();
+    TestPostOrder();
+    TestDeepChain();
+    return test::Finish();
+}
@@ -0,0 +1,207 @@
+// PeriodicScheduler：手动模式下用假时钟推进分层时间轮，检查各层迁移、跳过周期、延迟统计与取消
+#include "utils/scheduler.h"
+#include "test_support.h"
+#include <map>
+
+using namespace sysmonitor;
+
+namespace {
+
+using Clock = PeriodicScheduler::Clock;
+
+// 手动推进的时钟，刻度为 1ms
+class FakeClock {
+public:
+    PeriodicScheduler::NowFn Fn() {
+        return [this] { return now_; };
+    }
+
+    void Set(uint64_t ms) { now_ = start_ + std::chrono::milliseconds(ms); }
+    Clock::time_point At(uint64_t ms) const { return start_ + std::chrono::milliseconds(ms); }
+
+private:
+    const Clock::time_point start_ = Clock::now();
+    Clock::time_point now_ = start_;
+};
+
+ScheduledTaskStats StatsOf(const PeriodicScheduler& scheduler, const std::string& name) {
+    for (const auto& stats : scheduler.GetStats()) {
+        if (stats.name == name) return stats;
+    }
+    return ScheduledTaskStats();
+}
+
+// 周期落在不同层（0 层、1 层、2 层、3 层、超出最高层）：截止前一刻不运行，截止时恰好运行一次
+void TestDeadlineAtEachLevel() {
+    const uint32_t intervals[] = {3, 70, 4100, 300000, 17000000};
+    for (uint32_t interval : intervals) {
+        FakeClock clock;
+        PeriodicScheduler scheduler(1, 1, clock.Fn());
+        int runs = 0;
+        scheduler.Schedule("level", interval, [&runs] { ++runs; });
+
+        for (uint64_t k = 1; k <= 2; ++k) {
+            clock.Set(k * interval - 1);
+            CHECK_EQ(scheduler.RunDue(), 0u);
+            clock.Set(k * interval);
+            CHECK_EQ(scheduler.RunDue(), 1u);
+            CHECK_EQ(runs, static_cast<int>(k));
+        }
+        CHECK_EQ(StatsOf(scheduler, "level").skipped, 0u);
+        CHECK_EQ(StatsOf(scheduler, "level").lastLatenessUs, 0u);
+    }
+}
+
+// 只有高层有任务时，下一次唤醒是该槽位的起点；之后逐层迁移直到 0 层的截止刻度
+void TestNextWakeWithEmptyLevels() {
+    FakeClock clock;
+    PeriodicScheduler scheduler(1, 1, clock.Fn());
+    CHECK(scheduler.NextWakeTime() == Clock::time_point::max());
+
+    int runs = 0;
+    scheduler.Schedule("far", 300000, [&runs] { ++runs; });
+    // 300000 = 1×64³ + 9×64² + 15×64 + 32
+    const uint64_t wakes[] = {262144, 262144 + 9 * 4096, 262144 + 9 * 4096 + 15 * 64, 300000};
+    for (uint64_t wake : wakes) {
+        CHECK(scheduler.NextWakeTime() == clock.At(wake));
+        clock.Set(wake);
+        scheduler.RunDue();
+    }
+    CHECK_EQ(runs, 1);
+    CHECK(scheduler.NextWakeTime() == clock.At(262144 * 2));
+}
+
+// 超出时间轮范围的任务在整圈边界重新放入时间轮
+void TestNextWakeWithOverflow() {
+    FakeClock clock;
+    PeriodicScheduler scheduler(1, 1, clock.Fn());
+    scheduler.Schedule("overflow", 17000000, [] {});
+    CHECK(scheduler.NextWakeTime() == clock.At(1ULL << 24));
+    clock.Set(1ULL << 24);
+    CHECK_EQ(scheduler.RunDue(), 0u);
+    CHECK(scheduler.NextWakeTime() < clock.At(17000000 + 1));
+}
+
+// 多个任务共用一个时间轮：按截止时间先后运行，互不干扰
+void TestMixedLevels() {
+    FakeClock clock;
+    PeriodicScheduler scheduler(1, 1, clock.Fn());
+    std::map<std::string, int> runs;
+    const std::pair<const char*, uint32_t> tasks[] = {{"a", 50}, {"b", 70}, {"c", 4100}, {"d", 5000}};
+    for (const auto& task : tasks) {
+        const std::string name = task.first;
+        scheduler.Schedule(name, task.second, [&runs, name] { ++runs[name]; });
+    }
+
+    clock.Set(5000);
+    scheduler.RunDue();
+    // 一次追到 5000：每个任务只运行一次，错过的周期记为跳过
+    CHECK_EQ(runs["a"], 1);
+    CHECK_EQ(runs["b"], 1);
+    CHECK_EQ(runs["c"], 1);
+    CHECK_EQ(runs["d"], 1);
+    CHECK_EQ(StatsOf(scheduler, "a").skipped, 99u);
+    CHECK_EQ(StatsOf(scheduler, "b").skipped, 70u);
+
+    // 之后逐刻推进，每个任务严格按周期运行
+    runs.clear();
+    for (uint64_t ms = 5001; ms <= 9100; ++ms) {
+        clock.Set(ms);
+        scheduler.RunDue();
+    }
+    CHECK_EQ(runs["a"], 82);    // 5050 .. 9100
+    CHECK_EQ(runs["b"], 59);    // 5040 .. 9100
+    CHECK_EQ(runs["c"], 1);     // 8200
+    CHECK_EQ(runs["d"], 0);     // 10000
+}
+
+// 落后多个周期：只运行一次，跳过的周期计数，下一次截止仍按原相位；延迟按假时钟计算
+void TestSkippedPeriodsAndLateness() {
+    FakeClock clock;
+    PeriodicScheduler scheduler(1, 1, clock.Fn());
+    int runs = 0;
+    scheduler.Schedule("late", 10, [&runs] { ++runs; });
+
+    clock.Set(13);
+    CHECK_EQ(scheduler.RunDue(), 1u);
+    CHECK_EQ(StatsOf(scheduler, "late").lastLatenessUs, 3000u);
+
+    clock.Set(35);
+    CHECK_EQ(scheduler.RunDue(), 1u);
+    ScheduledTaskStats stats = StatsOf(scheduler, "late");
+    CHECK_EQ(stats.skipped, 1u);              // 20 迟到 15ms 运行，30 被跳过
+    CHECK_EQ(stats.lastLatenessUs, 15000u);
+    CHECK_EQ(stats.maxLatenessUs, 15000u);
+
+    clock.Set(39);
+    CHECK_EQ(scheduler.RunDue(), 0u);
+    clock.Set(40);
+    CHECK_EQ(scheduler.RunDue(), 1u);
+    CHECK_EQ(runs, 3);
+}
+
+// 同一刻度到期的任务中，先运行的任务取消了后一个：被取消的任务不再运行
+void TestCancelDuringFire() {
+    FakeClock clock;
+    PeriodicScheduler scheduler(1, 1, clock.Fn());
+    int runsA = 0, runsB = 0;
+    PeriodicScheduler::TaskId b = PeriodicScheduler::kInvalidTask;
+    scheduler.Schedule("a", 5, [&] {
+        ++runsA;
+        scheduler.Cancel(b);
+    });
+    b = scheduler.Schedule("b", 5, [&runsB] { ++runsB; });
+
+    clock.Set(5);
+    CHECK_EQ(scheduler.RunDue(), 1u);
+    CHECK_EQ(runsA, 1);
+    CHECK_EQ(runsB, 0);
+
+    clock.Set(10);
+    CHECK_EQ(scheduler.RunDue(), 1u);
+    CHECK_EQ(runsB, 0);
+    CHECK_EQ(scheduler.GetStats().size(), 1u);
+}
+
+// 取消高层中的任务：残留的 id 在迁移时丢弃，不再唤醒
+void TestCancelInHighLevel() {
+    FakeClock clock;
+    PeriodicScheduler scheduler(1, 1, clock.Fn());
+    int runs = 0;
+    PeriodicScheduler::TaskId id = scheduler.Schedule("far", 300000, [&runs] { ++runs; });
+    scheduler.Cancel(id);
+
+    clock.Set(262144);
+    CHECK_EQ(scheduler.RunDue(), 0u);
+    CHECK(scheduler.NextWakeTime() == Clock::time_point::max());
+    clock.Set(600000);
+    CHECK_EQ(scheduler.RunDue(), 0u);
+    CHECK_EQ(runs, 0);
+}
+
+// 停止后不再接受或运行任务
+void TestStop() {
+    FakeClock clock;
+    PeriodicScheduler scheduler(1, 1, clock.Fn());
+    int runs = 0;
+    scheduler.Schedule("stopped", 5, [&runs] { ++runs; });
+    scheduler.Stop();
+    CHECK_EQ(scheduler.Schedule("after", 5, [] {}), PeriodicScheduler::kInvalidTask);
+    clock.Set(100);
+    CHECK_EQ(scheduler.RunDue(), 0u);
+    CHECK_EQ(runs, 0);
+}
+
+} // namespace
+
+int main() {
+    TestDeadlineAtEachLevel();
+    TestNextWakeWithEmptyLevels();
+    TestNextWakeWithOverflow();
+    TestMixedLevels();
+    TestSkippedPeriodsAndLateness();
+    TestCancelDuringFire();
+    TestCancelInHighLevel();
+    TestStop();
+    return test::Finish();
+}
@@ -0,0 +1,119 @@
+#pragma once
+// 单元测试的断言与假文件系统工具。每个测试是一个独立的可执行文件，
+// main 依次调用各用例后返回 Finish()，有失败时退出码非 0，由 ctest 判定
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#endif
+
+namespace sysmonitor {
+namespace test {
+
+inline int& Failures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void Fail(const char* file, int line, const std::string& message) {
+    ++Failures();
+    std::cerr << file << ":" << line << ": " << message << std::endl;
+}
+
+inline int Finish() {
+    if (Failures() != 0) {
+        std::cerr << Failures() << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace test
+} // namespace sysmonitor
+
+#define CHECK(cond)                                                                          \
+    do {                                                                                     \
+        if (!(cond)) ::sysmonitor::test::Fail(__FILE__, __LINE__, "CHECK(" #cond ") failed"); \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                           \
+    do {                                                                                     \
+        const auto& a_ = (actual);                                                           \
+        const auto& e_ = (expected);                                                         \
+        if (!(a_ == e_)) {                                                                   \
+            std::ostringstream m_;                                                           \
+            m_ << #actual " == " #expected ": got " << a_ << ", expected " << e_;           \
+            ::sysmonitor::test::Fail(__FILE__, __LINE__, m_.str());                          \
+        }                                                                                    \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance)                                              \
+    do {                                                                                     \
+        const double a_ = (actual);                                                          \
+        const double e_ = (expected);                                                        \
+        if (!(std::fabs(a_ - e_) <= (tolerance))) {                                          \
+            std::ostringstream m_;                                                           \
+            m_ << #actual " ~= " #expected ": got " << a_ << ", expected " << e_;           \
+            ::sysmonitor::test::Fail(__FILE__, __LINE__, m_.str());                          \
+        }                                                                                    \
+    } while (0)
+
+#ifdef __linux__
+namespace sysmonitor {
+namespace test {
+
+// 临时目录，用来搭建假的 /proc、/sys 目录树；析构时整体删除
+class FakeTree {
+public:
+    FakeTree() {
+        char pattern[] = "/tmp/sysmonitor_test_XXXXXX";
+        const char* dir = mkdtemp(pattern);
+        root_ = dir ? dir : "";
+    }
+
+    ~FakeTree() {
+        if (!root_.empty()) {
+            nftw(root_.c_str(), [](const char* path, const struct stat*, int, struct FTW*) { return remove(path); },
+                 16, FTW_DEPTH | FTW_PHYS);
+        }
+    }
+
+    FakeTree(const FakeTree&) = delete;
+    FakeTree& operator=(const FakeTree&) = delete;
+
+    const std::string& Root() const { return root_; }
+
+    // 写入 root 下的相对路径，按需创建上级目录
+    void Write(const std::string& relativePath, const std::string& content) const {
+        const size_t slash = relativePath.rfind('/');
+        if (slash != std::string::npos) MakeDirs(relativePath.substr(0, slash));
+        std::ofstream(root_ + "/" + relativePath, std::ios::binary | std::ios::trunc) << content;
+    }
+
+    void MakeDirs(const std::string& relativePath) const {
+        std::string path = root_;
+        size_t start = 0;
+        while (start <= relativePath.size()) {
+            size_t slash = relativePath.find('/', start);
+            if (slash == std::string::npos) slash = relativePath.size();
+            path += "/" + relativePath.substr(start, slash - start);
+            mkdir(path.c_str(), 0755);
+            start = slash + 1;
+        }
+    }
+
+private:
+    std::string root_;
+};
+
+} // namespace test
+} // namespace sysmonitor
+#endif // __linux__
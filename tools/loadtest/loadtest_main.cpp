@@ -0,0 +1,395 @@
+// HTTP 压测工具：在本进程内启动 HttpServer（使用模拟采集器；SnapshotLoadTestLinux 的 CPU、内存与进程
+// 改用真实的 Linux 实现），
+// 按配置的客户端组合施压，最后输出每个路由的吞吐量与 p50/p99/p999 延迟
+//
+// 客户端类型：
+//   poller   模拟仪表盘轮询：每个周期请求 cpu/memory usage，每 3 个周期请求进程列表，
+//            每 10 个周期请求磁盘信息和 cpu/memory history
+//   sse      反复连接 /api/cpu/stream，记录首个事件到达耗时
+//   compare  反复比较两个预先创建的系统快照
+//
+// 延迟从计划发送时间开始计算：某个周期的请求被前一周期拖慢时，排队时间也计入延迟，
+// 避免闭环压测低估尾延迟（coordinated omission）
+//
+// --max-cheap-p99-ms 把结果变为通过/失败：ctest 的 loadtest_keep_alive 用保持连接的客户端数超过常驻连接线程数的
+// 场景检查轻量接口不会因连接线程被占满而排队
+#include "mock_collectors.h"
+#include "server/WebServer.h"
+#include "utils/metrics.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sysmonitor;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct LoadTestOptions {
+    int port = 18080;
+    size_t durationSec = 30;
+    size_t pollers = 20;
+    size_t pollIntervalMs = 1000;
+    size_t sseClients = 5;
+    size_t sseReconnectMs = 3000;   // 与浏览器 EventSource 默认重连间隔一致
+    size_t comparers = 2;
+    size_t compareIntervalMs = 2000;
+    size_t keepAlive = 1;           // 浏览器默认复用连接
+    std::string cpuCounters = "perf";   // 模拟计数器来源总是可用，默认覆盖计数器的采样与输出路径
+    std::string processEvents = "scan"; // netlink：内核进程事件（Linux，需要 CAP_NET_ADMIN）
+    size_t maxCheapP99Ms = 0;       // 非 0 时轻量接口 p99 超出或有失败请求则退出码为 2（ctest 用）
+};
+
+// 轻量接口：只读取后台采样结果，不应被其他连接或昂贵接口拖慢
+const char* const kCheapRoutes[] = {
+    "/api/cpu/usage", "/api/memory/usage", "/api/cpu/history", "/api/memory/history",
+};
+
+// 单个路由的客户端侧统计
+struct RouteStats {
+    metrics::LatencyHistogram latency;
+    std::atomic<uint64_t> ok{0};
+    std::atomic<uint64_t> errors{0};      // 连接失败或非 2xx（503 除外）
+    std::atomic<uint64_t> shed{0};        // 503：被昂贵接口通道拒绝
+    std::atomic<uint64_t> bytes{0};
+};
+
+// 所有路由在施压前创建，运行期间只读查找，无需加锁
+class Report {
+public:
+    explicit Report(const std::vector<std::string>& routes) {
+        for (const auto& route : routes) {
+            routes_[route] = std::make_unique<RouteStats>();
+        }
+    }
+
+    RouteStats& For(const std::string& route) { return *routes_.at(route); }
+
+    void Print(double elapsedSec) const {
+        std::printf("\n%-34s %9s %7s %7s %9s %9s %9s %9s %9s\n",
+                    "route", "requests", "errors", "503", "req/s", "p50 ms", "p99 ms", "p999 ms", "max ms");
+        for (const auto& [route, stats] : routes_) {
+            auto snap = stats->latency.Read();
+            uint64_t total = stats->ok + stats->errors + stats->shed;
+            if (total == 0) continue;
+            std::printf("%-34s %9llu %7llu %7llu %9.1f %9.2f %9.2f %9.2f %9.2f\n",
+                        route.c_str(),
+                        static_cast<unsigned long long>(total),
+                        static_cast<unsigned long long>(stats->errors.load()),
+                        static_cast<unsigned long long>(stats->shed.load()),
+                        total / elapsedSec,
+                        snap.ValueAtQuantile(0.5) / 1000.0,
+                        snap.ValueAtQuantile(0.99) / 1000.0,
+                        snap.ValueAtQuantile(0.999) / 1000.0,
+                        snap.maxUs / 1000.0);
+        }
+    }
+
+    // 轻量接口的 p99 都不超过 maxMs 且没有失败请求时返回 true
+    bool CheckCheapRoutes(double maxMs) const {
+        bool passed = true;
+        for (const char* route : kCheapRoutes) {
+            const RouteStats& stats = *routes_.at(route);
+            double p99Ms = stats.latency.Read().ValueAtQuantile(0.99) / 1000.0;
+            uint64_t failed = stats.errors + stats.shed;
+            if (p99Ms > maxMs || failed > 0) {
+                std::printf("FAIL %s: p99 %.2f ms (limit %.2f ms), %llu failed requests\n",
+                            route, p99Ms, maxMs, static_cast<unsigned long long>(failed));
+                passed = false;
+            }
+        }
+        return passed;
+    }
+
+private:
+    std::map<std::string, std::unique_ptr<RouteStats>> routes_;
+};
+
+void Record(RouteStats& stats, const httplib::Result& result, Clock::time_point scheduled) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - scheduled).count();
+    stats.latency.Record(static_cast<uint64_t>(us < 0 ? 0 : us));
+    if (!result) {
+        stats.errors.fetch_add(1, std::memory_order_relaxed);
+    } else if (result->status == 503) {
+        stats.shed.fetch_add(1, std::memory_order_relaxed);
+    } else if (result->status >= 400) {
+        stats.errors.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        stats.ok.fetch_add(1, std::memory_order_relaxed);
+        stats.bytes.fetch_add(result->body.size(), std::memory_order_relaxed);
+    }
+}
+
+std::unique_ptr<httplib::Client> MakeClient(const LoadTestOptions& options) {
+    auto client = std::make_unique<httplib::Client>("127.0.0.1", options.port);
+    client->set_keep_alive(options.keepAlive != 0);
+    client->set_connection_timeout(5);
+    client->set_read_timeout(30);
+    return client;
+}
+
+// 第 index 个客户端在周期内的起始偏移，使各客户端均匀错开
+Clock::duration Stagger(size_t index, size_t count, size_t intervalMs) {
+    return std::chrono::milliseconds(count == 0 ? 0 : intervalMs * index / count);
+}
+
+void RunPoller(const LoadTestOptions& options, Report& report, size_t index, Clock::time_point deadline) {
+    auto client = MakeClient(options);
+    const auto interval = std::chrono::milliseconds(options.pollIntervalMs);
+    auto next = Clock::now() + Stagger(index, options.pollers, options.pollIntervalMs);
+
+    for (uint64_t cycle = 0; next < deadline; ++cycle, next += interval) {
+        std::this_thread::sleep_until(next);
+
+        // 周期内第一个请求从计划时间起计时，之后的请求从上一个请求完成时起计时
+        auto scheduled = next;
+        auto get = [&](const char* route) {
+            auto result = client->Get(route);
+            Record(report.For(route), result, scheduled);
+            scheduled = Clock::now();
+        };
+
+        get("/api/cpu/usage");
+        get("/api/memory/usage");
+        if (cycle % 3 == 0) {
+            get("/api/processes");
+        }
+        if (cycle % 10 == 0) {
+            get("/api/disk/info");
+            get("/api/cpu/history");
+            get("/api/memory/history");
+        }
+    }
+}
+
+void RunSseClient(const LoadTestOptions& options, Report& report, size_t index, Clock::time_point deadline) {
+    auto client = MakeClient(options);
+    const auto interval = std::chrono::milliseconds(options.sseReconnectMs);
+    auto next = Clock::now() + Stagger(index, options.sseClients, options.sseReconnectMs);
+    auto& stats = report.For("/api/cpu/stream");
+
+    for (; next < deadline; next += interval) {
+        std::this_thread::sleep_until(next);
+
+        bool gotEvent = false;
+        auto result = client->Get("/api/cpu/stream", [&](const char* data, size_t length) {
+            // 以收到第一个完整事件为准
+            if (!gotEvent && std::string(data, length).find("\n\n") != std::string::npos) {
+                gotEvent = true;
+                auto us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - next).count();
+                stats.latency.Record(static_cast<uint64_t>(us));
+            }
+            stats.bytes.fetch_add(length, std::memory_order_relaxed);
+            return Clock::now() < deadline;
+        });
+
+        if (result && result->status == 200 && gotEvent) {
+            stats.ok.fetch_add(1, std::memory_order_relaxed);
+        } else if (result && result->status == 503) {
+            stats.shed.fetch_add(1, std::memory_order_relaxed);
+        } else if (!gotEvent) {
+            stats.errors.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void RunComparer(const LoadTestOptions& options, Report& report, size_t index, Clock::time_point deadline) {
+    auto client = MakeClient(options);
+    const auto interval = std::chrono::milliseconds(options.compareIntervalMs);
+    auto next = Clock::now() + Stagger(index, options.comparers, options.compareIntervalMs);
+    const std::string body = R"({"snapshot1":"loadtest_a","snapshot2":"loadtest_b"})";
+
+    for (; next < deadline; next += interval) {
+        std::this_thread::sleep_until(next);
+        auto result = client->Post("/api/system/snapshot/compare", body, "application/json");
+        Record(report.For("/api/system/snapshot/compare"), result, next);
+    }
+}
+
+bool CreateBaselineSnapshots(const LoadTestOptions& options) {
+    auto client = MakeClient(options);
+    for (const char* name : {"loadtest_a", "loadtest_b"}) {
+        std::string body = std::string(R"({"name":")") + name + R"("})";
+        auto result = client->Post("/api/system/snapshot/create", body, "application/json");
+        if (!result || result->status != 200) {
+            std::cerr << "Failed to create snapshot " << name << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// 解析 --name=value 形式的数值参数，未匹配时返回 false
+bool ParseSizeArg(const char* arg, const char* name, size_t& out) {
+    size_t len = std::strlen(name);
+    if (std::strncmp(arg, name, len) != 0 || arg[len] != '=') {
+        return false;
+    }
+    try {
+        out = static_cast<size_t>(std::stoul(arg + len + 1));
+    } catch (...) {
+        std::cerr << "Invalid value for " << name << ": " << (arg + len + 1) << std::endl;
+    }
+    return true;
+}
+
+// 解析 --name=value 形式的字符串参数，未匹配时返回 false
+bool ParseStringArg(const char* arg, const char* name, std::string& out) {
+    size_t len = std::strlen(name);
+    if (std::strncmp(arg, name, len) != 0 || arg[len] != '=') {
+        return false;
+    }
+    out = arg + len + 1;
+    return true;
+}
+
+bool ParseUint32Arg(const char* arg, const char* name, uint32_t& out) {
+    size_t value = out;
+    if (!ParseSizeArg(arg, name, value)) {
+        return false;
+    }
+    out = static_cast<uint32_t>(value);
+    return true;
+}
+
+void PrintUsage() {
+    std::cout <<
+#ifdef SYSMONITOR_LOADTEST_REAL_BACKENDS
+        "Usage: SnapshotLoadTestLinux [options]\n"
+        "  (CPU, memory and process data come from /proc and /sys; the mock\n"
+        "   process/core counts below do not apply)\n"
+#else
+        "Usage: SnapshotLoadTest [options]\n"
+#endif
+        "  --port=N                 listen port (default 18080)\n"
+        "  --duration=SEC           test duration (default 30)\n"
+        "  --pollers=N              dashboard polling clients (default 20)\n"
+        "  --poll-interval-ms=N     dashboard refresh interval (default 1000)\n"
+        "  --sse=N                  SSE clients (default 5)\n"
+        "  --sse-reconnect-ms=N     SSE reconnect interval (default 3000)\n"
+        "  --comparers=N            snapshot compare clients (default 2)\n"
+        "  --compare-interval-ms=N  compare interval (default 2000)\n"
+        "  --keep-alive=0|1         reuse client connections (default 1)\n"
+        "  --cpu-counters=perf|off  per-core hardware counters (default perf)\n"
+        "  --process-events=netlink|scan  process lifecycle source (default scan)\n"
+        "  --max-cheap-p99-ms=N     exit 2 if a cheap route's p99 exceeds N ms or any\n"
+        "                           cheap request fails (default 0: report only)\n"
+        "  --processes=N --drivers=N --cores=N            mock data sizes\n"
+        "  --process-latency-ms=N --disk-latency-ms=N\n"
+        "  --driver-latency-ms=N --registry-latency-ms=N  mock collector cost\n"
+        "  --cheap-threads=N --expensive-threads=N\n"
+        "  --expensive-queue=N --connection-queue=N\n"
+        "  --keep-alive-threads=N                         server worker pool\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    LoadTestOptions options;
+    WorkerPoolOptions poolOptions;
+    auto& mock = loadtest::MockOptions();
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            PrintUsage();
+            return 0;
+        }
+        size_t port = static_cast<size_t>(options.port);
+        if (ParseSizeArg(arg, "--port", port)) {
+            options.port = static_cast<int>(port);
+            continue;
+        }
+        bool matched =
+            ParseSizeArg(arg, "--duration", options.durationSec) ||
+            ParseSizeArg(arg, "--pollers", options.pollers) ||
+            ParseSizeArg(arg, "--poll-interval-ms", options.pollIntervalMs) ||
+            ParseSizeArg(arg, "--sse", options.sseClients) ||
+            ParseSizeArg(arg, "--sse-reconnect-ms", options.sseReconnectMs) ||
+            ParseSizeArg(arg, "--comparers", options.comparers) ||
+            ParseSizeArg(arg, "--compare-interval-ms", options.compareIntervalMs) ||
+            ParseSizeArg(arg, "--keep-alive", options.keepAlive) ||
+            ParseStringArg(arg, "--cpu-counters", options.cpuCounters) ||
+            ParseStringArg(arg, "--process-events", options.processEvents) ||
+            ParseSizeArg(arg, "--max-cheap-p99-ms", options.maxCheapP99Ms) ||
+            ParseUint32Arg(arg, "--processes", mock.processCount) ||
+            ParseUint32Arg(arg, "--drivers", mock.driverCount) ||
+            ParseUint32Arg(arg, "--cores", mock.logicalCores) ||
+            ParseUint32Arg(arg, "--process-latency-ms", mock.processLatencyMs) ||
+            ParseUint32Arg(arg, "--disk-latency-ms", mock.diskLatencyMs) ||
+            ParseUint32Arg(arg, "--driver-latency-ms", mock.driverLatencyMs) ||
+            ParseUint32Arg(arg, "--registry-latency-ms", mock.registryLatencyMs) ||
+            ParseSizeArg(arg, "--cheap-threads", poolOptions.cheapThreads) ||
+            ParseSizeArg(arg, "--expensive-threads", poolOptions.expensiveThreads) ||
+            ParseSizeArg(arg, "--expensive-queue", poolOptions.maxExpensiveQueue) ||
+            ParseSizeArg(arg, "--keep-alive-threads", poolOptions.keepAliveThreads) ||
+            ParseSizeArg(arg, "--connection-queue", poolOptions.maxConnectionQueue);
+        if (!matched) {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    HttpServer server;
+    server.SetWorkerPoolOptions(poolOptions);
+    server.SetCpuCounters(options.cpuCounters == "perf");
+    server.SetKernelProcessEvents(options.processEvents == "netlink");
+    if (!server.Start(options.port)) {
+        std::cerr << "Failed to start server" << std::endl;
+        return 1;
+    }
+    if (options.comparers > 0 && !CreateBaselineSnapshots(options)) {
+        server.Stop();
+        return 1;
+    }
+
+    std::cout << "\nLoad test: " << options.pollers << " pollers @" << options.pollIntervalMs << "ms, "
+              << options.sseClients << " sse, " << options.comparers << " comparers, "
+              << options.durationSec << "s, keep-alive=" << options.keepAlive
+              << ", cpu-counters=" << options.cpuCounters << ", process-events=" << options.processEvents << std::endl;
+
+    Report report({
+        "/api/cpu/usage", "/api/memory/usage", "/api/processes", "/api/disk/info",
+        "/api/cpu/history", "/api/memory/history", "/api/cpu/stream", "/api/system/snapshot/compare",
+    });
+
+    auto start = Clock::now();
+    auto deadline = start + std::chrono::seconds(options.durationSec);
+    std::vector<std::thread> clients;
+    for (size_t i = 0; i < options.pollers; ++i) {
+        clients.emplace_back(RunPoller, std::cref(options), std::ref(report), i, deadline);
+    }
+    for (size_t i = 0; i < options.sseClients; ++i) {
+        clients.emplace_back(RunSseClient, std::cref(options), std::ref(report), i, deadline);
+    }
+    for (size_t i = 0; i < options.comparers; ++i) {
+        clients.emplace_back(RunComparer, std::cref(options), std::ref(report), i, deadline);
+    }
+    for (auto& t : clients) {
+        t.join();
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    report.Print(elapsed);
+
+    // 服务端视角：连接排队与 503 情况
+    httplib::Client statsClient("127.0.0.1", options.port);
+    if (auto result = statsClient.Get("/api/server/stats")) {
+        std::cout << "\nServer stats: " << result->body << std::endl;
+    }
+
+    server.Stop();
+
+    if (options.maxCheapP99Ms > 0 && !report.CheckCheapRoutes(static_cast<double>(options.maxCheapP99Ms))) {
+        return 2;
+    }
+    return 0;
+}
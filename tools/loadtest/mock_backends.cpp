@@ -0,0 +1,394 @@
+// 压测用模拟后端：替换 CPU、内存、进程监控的平台访问路径（采样与计算逻辑使用真实实现）
+// SnapshotLoadTest 链接本文件；SnapshotLoadTestLinux 改为链接 SnapshotLinuxBackends 中的真实实现
+#include "mock_collectors.h"
+#include "core/CPUInfo/cpu_monitor.h"
+#include "core/CPUInfo/cpu_telemetry.h"
+#include "core/CPUInfo/cpu_topology.h"
+#include "core/Memory/memory_monitor.h"
+#include "core/Process/process_monitor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace sysmonitor {
+
+using loadtest::Mix;
+using loadtest::Unit;
+using loadtest::SimulateLatency;
+using loadtest::g_tick;
+
+namespace {
+
+const char* const kProcessNames[] = {
+    "System", "svchost.exe", "explorer.exe", "chrome.exe", "code.exe",
+    "SnapshotTool.exe", "MsMpEng.exe", "RuntimeBroker.exe", "dwm.exe", "conhost.exe"
+};
+
+ProcessInfo MakeProcess(uint32_t index, uint64_t tick) {
+    ProcessInfo p;
+    p.pid = 4 + index * 4;
+    p.parentPid = index == 0 ? 0 : 4 + static_cast<uint32_t>(Mix(index) % index) * 4;
+    p.name = kProcessNames[index % (sizeof(kProcessNames) / sizeof(kProcessNames[0]))];
+    p.fullPath = "C:\\Program Files\\LoadTest\\" + p.name;
+    p.state = "Running";
+    p.username = index % 3 == 0 ? "SYSTEM" : "loadtest";
+    p.cpuUsage = 5.0 * Unit(tick, index);
+    p.workingSetSize = (4ULL << 20) + (Mix(index) % (512ULL << 20));
+    p.memoryUsage = p.workingSetSize;
+    p.pagefileUsage = p.workingSetSize / 2;
+    p.createTime = 1735689600000LL + index * 1000;
+    p.priority = 8;
+    p.threadCount = 1 + static_cast<int32_t>(Mix(index + 1) % 64);
+    p.commandLine = "\"" + p.fullPath + "\" --instance=" + std::to_string(index);
+    p.handleCount = 50 + static_cast<uint32_t>(Mix(index + 2) % 2000);
+    p.gdiCount = static_cast<uint32_t>(Mix(index + 3) % 300);
+    p.userCount = static_cast<uint32_t>(Mix(index + 4) % 200);
+    return p;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// CPU
+// ---------------------------------------------------------------------------
+
+CPUInfo SystemInfo::GetCPUInfo() {
+    CPUInfo info;
+    info.name = GetCPUName();
+    info.vendor = "LoadTest";
+    info.logicalCores = GetLogicalCoreCount();
+    info.physicalCores = GetPhysicalCoreCount();
+    info.packages = 1;
+    info.baseFrequency = 3000;
+    info.maxFrequency = 4200;
+    info.architecture = "x64";
+    return info;
+}
+
+std::string SystemInfo::GetCPUName() { return "Mock CPU @ 3.00GHz"; }
+uint32_t SystemInfo::GetPhysicalCoreCount() { return std::max(1u, loadtest::MockOptions().logicalCores / 2); }
+uint32_t SystemInfo::GetLogicalCoreCount() { return std::max(1u, loadtest::MockOptions().logicalCores); }
+double SystemInfo::GetCPUTemperature() { return 45.0; }
+
+// 两个封装各一个 NUMA 节点，每个物理核心两个 SMT 线程；编号方式同 Linux（先排满各核心的线程 0）
+CpuTopology DiscoverCpuTopology() {
+    CpuTopology topology;
+    const uint32_t cpus = SystemInfo::GetLogicalCoreCount();
+    const uint32_t cores = std::max(1u, cpus / 2);
+    const uint32_t packages = cores >= 2 ? 2 : 1;
+    topology.packages = packages;
+    topology.physicalCores = cores;
+    topology.processors.resize(cpus);
+    for (uint32_t node = 0; node < packages; ++node) {
+        topology.nodes.push_back({node, {}});
+    }
+    for (uint32_t cpu = 0; cpu < cpus; ++cpu) {
+        LogicalProcessor& p = topology.processors[cpu];
+        p.cpu = cpu;
+        p.core = cpu % cores;
+        p.thread = cpu / cores;
+        p.package = p.core * packages / cores;
+        p.node = p.package;
+        topology.nodes[p.node].cpus.push_back(cpu);
+    }
+    return topology;
+}
+
+namespace {
+
+// 每次读取推进一个采样周期：每个核心一条相位不同的正弦曲线，叠加少量确定性抖动
+class MockCpuTimesSource : public CpuTimesSource {
+public:
+    MockCpuTimesSource() : cores_(SystemInfo::GetLogicalCoreCount()) {}
+
+    uint32_t CoreCount() const override { return static_cast<uint32_t>(cores_.size()); }
+
+    bool Read(CpuTimes& total, CpuTimes* cores) override {
+        uint64_t tick = g_tick.fetch_add(1) + 1;
+        total = CpuTimes();
+        for (size_t i = 0; i < cores_.size(); ++i) {
+            double usage = 30.0 + 20.0 * std::sin(static_cast<double>(tick) / 10.0 + static_cast<double>(i)) +
+                           5.0 * Unit(tick, i);
+            // 每个周期 1000 个时间单位
+            uint64_t busy = static_cast<uint64_t>(usage * 10.0);
+            // 忙时间按 70/20/4/4/2 分给 user/system/irq/softirq/steal，空闲中 5% 为 iowait
+            uint64_t system = busy / 5, irq = busy / 25, softirq = busy / 25, steal = busy / 50;
+            cores_[i].user += busy - system - irq - softirq - steal;
+            cores_[i].system += system;
+            cores_[i].irq += irq;
+            cores_[i].softirq += softirq;
+            cores_[i].steal += steal;
+            cores_[i].iowait += (1000 - busy) / 20;
+            cores_[i].busy += busy;
+            cores_[i].idle += 1000 - busy;
+            cores[i] = cores_[i];
+            total.busy += cores_[i].busy;
+            total.idle += cores_[i].idle;
+            total.user += cores_[i].user;
+            total.system += cores_[i].system;
+            total.irq += cores_[i].irq;
+            total.softirq += cores_[i].softirq;
+            total.steal += cores_[i].steal;
+            total.iowait += cores_[i].iowait;
+        }
+        return true;
+    }
+
+private:
+    std::vector<CpuTimes> cores_;
+};
+
+// 每分钟一次 5 个周期的降频：限制频率降到 2000MHz，封装降频计数加一，温度同步升高
+class MockCpuTelemetrySource : public CpuTelemetrySource {
+public:
+    MockCpuTelemetrySource()
+        : cores_(SystemInfo::GetLogicalCoreCount()), sensorNames_{"coretemp/Package id 0", "coretemp/Core 0"} {}
+
+    uint32_t CoreCount() const override { return cores_; }
+    const std::vector<std::string>& SensorNames() const override { return sensorNames_; }
+    bool HasThrottleCounters() const override { return true; }
+
+    bool Read(CpuCoreFrequency* cores, double* temperatures) override {
+        ++tick_;
+        const bool throttled = tick_ % 60 >= 55;
+        if (tick_ % 60 == 55) {
+            ++packageThrottles_;
+        }
+        for (uint32_t i = 0; i < cores_; ++i) {
+            cores[i].maxMHz = 4200;
+            cores[i].limitMHz = throttled ? 2000 : 4200;
+            double mhz = 3000.0 + 1200.0 * std::sin(static_cast<double>(tick_) / 7.0 + static_cast<double>(i));
+            cores[i].currentMHz = static_cast<uint32_t>(std::min<double>(mhz, cores[i].limitMHz));
+            cores[i].coreThrottleCount = packageThrottles_ + (i == 0 ? tick_ / 120 : 0);
+            cores[i].packageThrottleCount = packageThrottles_;
+        }
+        temperatures[0] = 55.0 + 10.0 * std::sin(static_cast<double>(tick_) / 20.0) + (throttled ? 30.0 : 0.0);
+        temperatures[1] = temperatures[0] - 3.0;
+        return true;
+    }
+
+private:
+    uint32_t cores_;
+    std::vector<std::string> sensorNames_;
+    uint64_t tick_ = 0;
+    uint64_t packageThrottles_ = 0;
+};
+
+// 硬件模式；每核心 IPC 在 0.8 ~ 2.0 之间按核心与 tick 变化，缓存未命中随 IPC 降低而增加
+class MockCpuCounterSource : public CpuCounterSource {
+public:
+    MockCpuCounterSource() : values_(SystemInfo::GetLogicalCoreCount()) {}
+
+    CpuCounterMode Mode() const override { return CpuCounterMode::Hardware; }
+    uint32_t CoreCount() const override { return static_cast<uint32_t>(values_.size()); }
+
+    bool Read(CpuCounterValues* cores) override {
+        const uint64_t tick = g_tick.load();
+        for (size_t i = 0; i < values_.size(); ++i) {
+            CpuCounterValues& v = values_[i];
+            const uint64_t cycles = 1000000000ULL + (Mix(tick * 131 + i) % 2000000000ULL);
+            const double ipc = 1.4 + 0.6 * std::sin(static_cast<double>(tick + i * 7) / 15.0);
+            const uint64_t instructions = static_cast<uint64_t>(static_cast<double>(cycles) * ipc);
+            v.cycles += cycles;
+            v.instructions += instructions;
+            v.cacheMisses += static_cast<uint64_t>(static_cast<double>(instructions) * (2.2 - ipc) / 200.0);
+            v.branchMisses += instructions / 400;
+            cores[i] = v;
+        }
+        return true;
+    }
+
+private:
+    std::vector<CpuCounterValues> values_;
+};
+
+// 内存占用按正弦波动；换页与缺页按 tick 确定性增长，周期性出现换出高峰与内存压力
+class MockMemoryCountersSource : public MemoryCountersSource {
+public:
+    bool Read(MemoryCounters& counters) override {
+        const uint64_t total = 16ULL << 30;
+        const uint64_t tick = g_tick.load();
+        const double percent = 55.0 + 10.0 * std::sin(static_cast<double>(tick) / 30.0);
+        const uint64_t used = static_cast<uint64_t>(static_cast<double>(total) * percent / 100.0);
+        const bool pressured = tick % 60 >= 50;
+
+        pageFaults_ += 2000 + tick % 500;
+        majorFaults_ += pressured ? 40 : 1;
+        swappedOut_ += pressured ? 300 : 0;
+        swappedIn_ += pressured ? 120 : 2;
+        memoryStallUs_ += pressured ? 150000 : 2000;
+        cpuStallUs_ += 30000;
+        ioStallUs_ += pressured ? 80000 : 5000;
+
+        counters = MemoryCounters();
+        counters.totalPhysical = total;
+        counters.availablePhysical = total - used;
+        counters.commitCharge = used + (4ULL << 30);
+        counters.commitLimit = total + (8ULL << 30);
+        counters.cached = total / 5;
+        counters.swapTotal = 8ULL << 30;
+        counters.swapFree = counters.swapTotal - std::min<uint64_t>(swappedOut_ * 4096, counters.swapTotal);
+        counters.pagesSwappedIn = swappedIn_;
+        counters.pagesSwappedOut = swappedOut_;
+        counters.pageFaults = pageFaults_;
+        counters.majorFaults = majorFaults_;
+        counters.hasPressure = true;
+        counters.memoryPressure = {memoryStallUs_, memoryStallUs_ / 2};
+        counters.cpuPressure = {cpuStallUs_, 0};
+        counters.ioPressure = {ioStallUs_, ioStallUs_ / 3};
+        // 两个节点，节点 1 承担更多分配
+        counters.nodes = {{0, total / 2, (total - used) * 3 / 5}, {1, total / 2, (total - used) * 2 / 5}};
+        return true;
+    }
+
+private:
+    uint64_t pageFaults_ = 0;
+    uint64_t majorFaults_ = 0;
+    uint64_t swappedIn_ = 0;
+    uint64_t swappedOut_ = 0;
+    uint64_t memoryStallUs_ = 0;
+    uint64_t cpuStallUs_ = 0;
+    uint64_t ioStallUs_ = 0;
+};
+
+} // namespace
+
+std::unique_ptr<CpuTimesSource> CreateDefaultCpuTimesSource() {
+    return std::make_unique<MockCpuTimesSource>();
+}
+
+std::unique_ptr<CpuTelemetrySource> CreateDefaultCpuTelemetrySource() {
+    return std::make_unique<MockCpuTelemetrySource>();
+}
+
+std::unique_ptr<CpuCounterSource> CreateDefaultCpuCounterSource() {
+    return std::make_unique<MockCpuCounterSource>();
+}
+
+std::unique_ptr<MemoryCountersSource> CreateDefaultMemoryCountersSource() {
+    return std::make_unique<MockMemoryCountersSource>();
+}
+
+// ---------------------------------------------------------------------------
+// Process：只替换访问路径，ProcessMonitor 的缓存与计算逻辑使用真实实现
+// ---------------------------------------------------------------------------
+
+namespace {
+
+// 句柄即进程序号 + 1；每次采样 CPU 时间按确定性速率增长
+class MockProcessAccess : public ProcessAccess {
+public:
+    bool Enumerate(std::vector<ProcessEntry>& out) override {
+        SimulateLatency(loadtest::MockOptions().processLatencyMs);
+
+        out.clear();
+        uint32_t count = loadtest::MockOptions().processCount;
+        out.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            ProcessInfo p = MakeProcess(i, 0);
+            out.push_back(ProcessEntry{p.pid, p.parentPid, p.name, p.threadCount, p.priority});
+        }
+        return true;
+    }
+
+    Handle Open(uint32_t pid) override {
+        if (pid < 4 || pid % 4 != 0 || (pid - 4) / 4 >= loadtest::MockOptions().processCount) {
+            return kInvalidHandle;
+        }
+        return static_cast<Handle>((pid - 4) / 4 + 1);
+    }
+
+    void Close(Handle) override {}
+
+    bool QueryTimes(Handle handle, ProcessTimes& times) override {
+        uint32_t index = Index(handle);
+        uint64_t tick = g_tick.load();
+        times.createTime = MakeProcess(index, 0).createTime;
+        // 每个进程占用一个固定比例的 CPU
+        uint64_t rate = Mix(index) % 200000;
+        times.userTime = tick * rate;
+        times.kernelTime = tick * rate / 4;
+        return true;
+    }
+
+    bool QueryMemory(Handle handle, ProcessMemory& memory) override {
+        ProcessInfo p = MakeProcess(Index(handle), 0);
+        memory.workingSetSize = p.workingSetSize;
+        memory.pagefileUsage = p.pagefileUsage;
+        return true;
+    }
+
+    bool QueryCounters(Handle handle, ProcessCounters& counters) override {
+        uint32_t index = Index(handle);
+        uint64_t tick = g_tick.load();
+        // 少数进程有较重的 I/O，其余接近空闲
+        uint64_t ioRate = (Mix(index) % 16 == 0) ? Mix(index + 1) % (32ULL << 20) : Mix(index + 1) % 4096;
+        counters.readBytes = tick * ioRate;
+        counters.writeBytes = tick * ioRate / 3;
+        counters.readOps = tick * (ioRate / 4096 + 1);
+        counters.writeOps = tick * (ioRate / 16384 + 1);
+        counters.minorFaults = tick * (Mix(index + 2) % 500);
+        counters.majorFaults = tick * (Mix(index + 2) % 7);
+        counters.voluntaryCtxSwitches = tick * (Mix(index + 3) % 2000);
+        counters.involuntaryCtxSwitches = tick * (Mix(index + 3) % 50);
+        return true;
+    }
+
+    // 少数进程每个采样周期多出几个句柄，供泄漏检测观察
+    uint32_t QueryHandleCount(Handle handle) override {
+        uint32_t index = Index(handle);
+        uint32_t leaked = (index % 97 == 1) ? static_cast<uint32_t>(g_tick.load() * 3) : 0;
+        return MakeProcess(index, 0).handleCount + leaked;
+    }
+    uint32_t QueryGdiCount(Handle handle) override { return MakeProcess(Index(handle), 0).gdiCount; }
+    uint32_t QueryUserCount(Handle handle) override { return MakeProcess(Index(handle), 0).userCount; }
+    std::string QueryImagePath(Handle handle) override { return MakeProcess(Index(handle), 0).fullPath; }
+    std::string QueryCommandLine(Handle handle) override { return MakeProcess(Index(handle), 0).commandLine; }
+    bool QueryUserId(Handle handle, std::string& userId) override {
+        userId = MakeProcess(Index(handle), 0).username;
+        return true;
+    }
+    std::string LookupAccountName(const std::string& userId) override { return userId; }
+
+    // 主线程占进程 CPU 时间的一半，其余线程平分另一半
+    bool EnumerateThreads(uint32_t pid, std::vector<ThreadEntry>& out) override {
+        out.clear();
+        Handle handle = Open(pid);
+        if (handle == kInvalidHandle) return false;
+        ProcessInfo p = MakeProcess(Index(handle), 0);
+        ProcessTimes times;
+        QueryTimes(handle, times);
+
+        uint32_t count = static_cast<uint32_t>(p.threadCount > 0 ? p.threadCount : 1);
+        for (uint32_t i = 0; i < count; ++i) {
+            ThreadEntry entry;
+            entry.tid = pid + 100000 + i;
+            entry.name = i == 0 ? "main" : "worker-" + std::to_string(i);
+            entry.state = i == 0 ? "Running" : "Waiting";
+            entry.priority = p.priority;
+            entry.createTime = p.createTime;
+            uint64_t share = count == 1 ? 1 : (i == 0 ? 2 : 2 * (count - 1));
+            entry.userTime = times.userTime / share;
+            entry.kernelTime = times.kernelTime / share;
+            out.push_back(std::move(entry));
+        }
+        return true;
+    }
+
+    uint64_t QuerySystemTime() override {
+        // 每个采样周期每核 1 秒（100ns 单位）
+        return g_tick.load() * 10000000ULL * SystemInfo::GetLogicalCoreCount();
+    }
+
+    bool Terminate(uint32_t, uint32_t) override { return false; }
+
+private:
+    static uint32_t Index(Handle handle) { return static_cast<uint32_t>(handle - 1); }
+};
+
+} // namespace
+
+std::unique_ptr<ProcessAccess> CreateDefaultProcessAccess() {
+    return std::make_unique<MockProcessAccess>();
+}
+
+} // namespace sysmonitor
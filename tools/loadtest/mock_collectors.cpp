@@ -0,0 +1,277 @@
+// 压测用模拟采集器：替换磁盘、注册表与驱动监控的 Windows 实现
+// 与 WebServer.cpp 一起链接，HttpServer 本身不做任何修改；CPU、内存与进程的模拟后端见 mock_backends.cpp
+#include "mock_collectors.h"
+#include "core/Disk/disk_monitor.h"
+#include "core/Driver/driver_monitor.h"
+#include "core/Register/registry_monitor.h"
+#include "utils/util_time.h"
+#include "utils/metrics.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace sysmonitor {
+
+// WebServer.cpp 通过 extern 引用（HandleGetRegistryInfo）
+char g_backupDir[260] = "loadtest/Backup_20250101_000000";
+
+namespace loadtest {
+
+MockCollectorOptions& MockOptions() {
+    static MockCollectorOptions options;
+    return options;
+}
+
+uint64_t Mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+double Unit(uint64_t seed, uint64_t id) {
+    return static_cast<double>(Mix(seed * 1000003ULL + id) >> 11) / static_cast<double>(1ULL << 53);
+}
+
+void SimulateLatency(uint32_t ms) {
+    if (ms > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+}
+
+std::atomic<uint64_t> g_tick{0};
+
+} // namespace loadtest
+
+using loadtest::Mix;
+using loadtest::Unit;
+using loadtest::SimulateLatency;
+using loadtest::g_tick;
+
+namespace {
+
+DriverDetail MakeDriver(uint32_t index) {
+    DriverDetail d;
+    d.name = "lt_drv" + std::to_string(index);
+    d.displayName = "Load Test Driver " + std::to_string(index);
+    d.description = d.displayName;
+    d.state = index % 4 == 0 ? "Stopped" : "Running";
+    d.startType = index % 3 == 0 ? "Auto Start" : "Demand Start";
+    d.binaryPath = "C:\\Windows\\System32\\drivers\\" + d.name + ".sys";
+    d.serviceType = index % 5 == 0 ? "File System Driver" : "Kernel Driver";
+    d.errorControl = "Normal";
+    d.account = "LocalSystem";
+    d.group = "Base";
+    d.tagId = std::to_string(index);
+    d.driverType = d.serviceType;
+    d.hardwareClass = index % 2 == 0 ? "System" : "";
+    d.exitCode = "0";
+    d.win32ExitCode = "0";
+    d.serviceSpecificExitCode = "0";
+    d.version.fileVersion = "10.0.19041." + std::to_string(index);
+    d.version.productVersion = d.version.fileVersion;
+    d.version.companyName = index % 7 == 0 ? "Contoso" : "Microsoft Corporation";
+    d.version.fileDescription = d.displayName;
+    d.version.originalFilename = d.name + ".sys";
+    return d;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Disk
+// ---------------------------------------------------------------------------
+
+DiskMonitor::DiskMonitor() : isMonitoring_(false) {}
+DiskMonitor::~DiskMonitor() {}
+
+DiskSnapshot DiskMonitor::GetDiskSnapshot() {
+    SYSMON_TIME_COLLECTOR("GetDiskSnapshot");
+    SimulateLatency(loadtest::MockOptions().diskLatencyMs);
+
+    DiskSnapshot snapshot;
+    snapshot.timestamp = GET_LOCAL_TIME_MS();
+    snapshot.drives = GetDiskDrives();
+    snapshot.partitions = GetPartitions();
+    snapshot.performance = GetDiskPerformance();
+    snapshot.smartData = GetSMARTData();
+    return snapshot;
+}
+
+std::vector<DiskDriveInfo> DiskMonitor::GetDiskDrives() {
+    std::vector<DiskDriveInfo> drives;
+    for (uint32_t i = 0; i < loadtest::MockOptions().diskCount; ++i) {
+        DiskDriveInfo d;
+        d.model = "Mock NVMe " + std::to_string(i);
+        d.serialNumber = "LT" + std::to_string(Mix(i) % 1000000);
+        d.interfaceType = "NVMe";
+        d.mediaType = "SSD";
+        d.totalSize = 512ULL << 30;
+        d.bytesPerSector = 512;
+        d.status = "OK";
+        d.deviceId = "\\\\.\\PHYSICALDRIVE" + std::to_string(i);
+        drives.push_back(d);
+    }
+    return drives;
+}
+
+std::vector<PartitionInfo> DiskMonitor::GetPartitions() {
+    std::vector<PartitionInfo> partitions;
+    const auto& options = loadtest::MockOptions();
+    uint32_t count = std::min(options.diskCount * options.partitionsPerDisk, 24u);
+    for (uint32_t i = 0; i < count; ++i) {
+        PartitionInfo p;
+        p.driveLetter = std::string(1, static_cast<char>('C' + i)) + ":";
+        p.label = "Volume" + std::to_string(i);
+        p.fileSystem = "NTFS";
+        p.totalSize = 256ULL << 30;
+        p.usedSpace = static_cast<uint64_t>(static_cast<double>(p.totalSize) * (0.2 + 0.6 * Unit(0, i)));
+        p.freeSpace = p.totalSize - p.usedSpace;
+        p.usagePercentage = 100.0 * static_cast<double>(p.usedSpace) / static_cast<double>(p.totalSize);
+        p.serialNumber = static_cast<uint32_t>(Mix(i));
+        partitions.push_back(p);
+    }
+    return partitions;
+}
+
+std::vector<DiskPerformance> DiskMonitor::GetDiskPerformance() {
+    uint64_t tick = g_tick.load();
+    std::vector<DiskPerformance> performance;
+    for (const auto& partition : GetPartitions()) {
+        DiskPerformance p{};
+        p.driveLetter = partition.driveLetter;
+        p.readBytesPerSec = static_cast<uint64_t>(50e6 * Unit(tick, performance.size()));
+        p.writeBytesPerSec = static_cast<uint64_t>(20e6 * Unit(tick + 1, performance.size()));
+        p.readSpeed = static_cast<double>(p.readBytesPerSec) / (1024.0 * 1024.0);
+        p.writeSpeed = static_cast<double>(p.writeBytesPerSec) / (1024.0 * 1024.0);
+        p.readCountPerSec = p.readBytesPerSec / 4096;
+        p.writeCountPerSec = p.writeBytesPerSec / 4096;
+        p.queueLength = 0.5;
+        p.usagePercentage = 10.0;
+        p.responseTime = 1;
+        performance.push_back(p);
+    }
+    return performance;
+}
+
+std::vector<DiskSMARTData> DiskMonitor::GetSMARTData() {
+    std::vector<DiskSMARTData> smart;
+    for (const auto& drive : GetDiskDrives()) {
+        DiskSMARTData s{};
+        s.deviceId = drive.deviceId;
+        s.temperature = 40;
+        s.healthStatus = 100;
+        s.powerOnHours = 1000;
+        s.powerOnCount = 100;
+        s.overallHealth = "Good";
+        smart.push_back(s);
+    }
+    return smart;
+}
+
+bool DiskMonitor::StartIOMonitoring(const std::string&) { return false; }
+void DiskMonitor::StopIOMonitoring() {}
+
+// ---------------------------------------------------------------------------
+// Registry
+// ---------------------------------------------------------------------------
+
+RegistryMonitor::RegistryMonitor() {}
+
+RegistrySnapshot RegistryMonitor::GetRegistrySnapshot() {
+    SYSMON_TIME_COLLECTOR("GetRegistrySnapshot");
+    SimulateLatency(loadtest::MockOptions().registryLatencyMs);
+
+    RegistrySnapshot snapshot;
+    snapshot.timestamp = GET_LOCAL_TIME_MS();
+    auto all = GetAllBackupInfo();
+    snapshot.backupInfo = all.empty() ? BackupInfo() : all.begin()->second;
+    return snapshot;
+}
+
+int RegistryMonitor::SaveReg() {
+    SimulateLatency(loadtest::MockOptions().registryLatencyMs);
+    return 0;
+}
+
+std::map<std::string, BackupInfo> RegistryMonitor::GetAllBackupInfo() {
+    std::map<std::string, BackupInfo> result;
+    BackupInfo info;
+    info.folderName = "Backup_20250101_000000";
+    info.folderPath = g_backupDir;
+    info.createTime = 1735689600;
+    info.totalSize = 0;
+    for (const char* hive : {"HKLM_SOFTWARE", "HKLM_SYSTEM", "HKCU"}) {
+        RegFileInfo file{std::string(hive) + ".reg", 64LL << 20};
+        info.totalSize += file.fileSize;
+        info.regFiles.push_back(file);
+    }
+    result[info.folderName] = info;
+    return result;
+}
+
+FolderComparisonResult RegistryMonitor::compareFolders(const std::string& relativeFolder1, const std::string& relativeFolder2) {
+    SYSMON_TIME_COLLECTOR("CompareRegistryFolders");
+    SimulateLatency(loadtest::MockOptions().registryLatencyMs);
+
+    FolderComparisonResult result;
+    result.folder1 = relativeFolder1;
+    result.folder2 = relativeFolder2;
+    result.totalComparedFiles = 0;
+    result.totalAddedKeys = 0;
+    result.totalRemovedKeys = 0;
+    result.totalModifiedKeys = 0;
+    return result;
+}
+
+} // namespace sysmonitor
+
+// ---------------------------------------------------------------------------
+// Driver（全局命名空间，与 driver_monitor.h 一致）
+// ---------------------------------------------------------------------------
+
+DriverMonitor::DriverMonitor() {}
+DriverMonitor::~DriverMonitor() {}
+
+DriverSnapshot DriverMonitor::GetDriverSnapshot() {
+    SYSMON_TIME_COLLECTOR("GetDriverSnapshot");
+    sysmonitor::loadtest::SimulateLatency(sysmonitor::loadtest::MockOptions().driverLatencyMs);
+
+    DriverSnapshot snapshot;
+    snapshot.timestamp = GET_LOCAL_TIME_MS();
+    for (uint32_t i = 0; i < sysmonitor::loadtest::MockOptions().driverCount; ++i) {
+        DriverDetail d = sysmonitor::MakeDriver(i);
+        (d.state == "Running" ? snapshot.runningDrivers : snapshot.stoppedDrivers).push_back(d);
+        (d.serviceType == "Kernel Driver" ? snapshot.kernelDrivers : snapshot.fileSystemDrivers).push_back(d);
+        if (d.startType == "Auto Start") snapshot.autoStartDrivers.push_back(d);
+        if (d.version.companyName != "Microsoft Corporation") snapshot.thirdPartyDrivers.push_back(d);
+    }
+    snapshot.stats.totalDrivers = sysmonitor::loadtest::MockOptions().driverCount;
+    snapshot.stats.runningCount = snapshot.runningDrivers.size();
+    snapshot.stats.stoppedCount = snapshot.stoppedDrivers.size();
+    snapshot.stats.kernelCount = snapshot.kernelDrivers.size();
+    snapshot.stats.fileSystemCount = snapshot.fileSystemDrivers.size();
+    snapshot.stats.autoStartCount = snapshot.autoStartDrivers.size();
+    snapshot.stats.thirdPartyCount = snapshot.thirdPartyDrivers.size();
+    return snapshot;
+}
+
+DriverDetail DriverMonitor::GetDriverDetail(const std::string& driverName) {
+    SYSMON_TIME_COLLECTOR("GetDriverDetail");
+
+    const std::string prefix = "lt_drv";
+    if (driverName.compare(0, prefix.size(), prefix) == 0) {
+        try {
+            uint32_t index = static_cast<uint32_t>(std::stoul(driverName.substr(prefix.size())));
+            if (index < sysmonitor::loadtest::MockOptions().driverCount) {
+                return sysmonitor::MakeDriver(index);
+            }
+        } catch (...) {
+        }
+    }
+    return DriverDetail();
+}
+
+bool DriverMonitor::IsDriverRunning(const std::string& driverName) {
+    return GetDriverDetail(driverName).state == "Running";
+}
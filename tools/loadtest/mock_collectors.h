@@ -0,0 +1,40 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace sysmonitor {
+namespace loadtest {
+
+// 模拟采集器配置
+// 所有数据由采样序号和对象编号确定性生成，同样的参数每次运行得到相同的响应；
+// 延迟参数模拟真实采集器（ToolHelp、WMI、SCM 枚举）阻塞工作线程的耗时
+struct MockCollectorOptions {
+    uint32_t logicalCores = 8;
+    uint32_t processCount = 300;
+    uint32_t driverCount = 200;
+    uint32_t diskCount = 2;
+    uint32_t partitionsPerDisk = 2;
+
+    uint32_t processLatencyMs = 15;    // GetProcessSnapshot
+    uint32_t diskLatencyMs = 30;       // GetDiskSnapshot
+    uint32_t driverLatencyMs = 80;     // GetDriverSnapshot
+    uint32_t registryLatencyMs = 20;   // GetRegistrySnapshot / compareFolders
+};
+
+// 需在创建 HttpServer 之前设置
+MockCollectorOptions& MockOptions();
+
+// 以下供 mock_collectors.cpp 与 mock_backends.cpp 共用
+
+// splitmix64：由 (种子, 编号) 得到稳定的伪随机数
+uint64_t Mix(uint64_t x);
+// [0, 1) 区间的确定性伪随机数
+double Unit(uint64_t seed, uint64_t id);
+void SimulateLatency(uint32_t ms);
+
+// 全局采样序号，模拟 CPU 来源每次采样递增，其他模拟采集器用它让数据随时间变化；
+// 使用真实后端时不递增，磁盘性能数据保持不变
+extern std::atomic<uint64_t> g_tick;
+
+} // namespace loadtest
+} // namespace sysmonitor
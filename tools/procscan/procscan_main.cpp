@@ -0,0 +1,181 @@
+// 进程扫描基准：用真实的 /proc 后端反复采集（未启动后台采样时 GetLatestTable 每次同步刷新），输出每轮耗时与堆分配次数
+//
+// --spawn=N 先 fork N 个挂起的子进程，把进程数撑到目标规模（结束时全部杀掉并回收）。
+// 第一轮要为每个进程打开描述符、读取路径/命令行/用户名，不计入统计；之后各轮即稳态扫描。
+//
+// 输出中的 kernel 时间是读取 procfs 的开销，随内核与虚拟化环境变化很大；user 时间与堆分配次数才是
+// 解析与建表本身的开销。--max-scan-ms / --max-allocations-per-process 把结果变为通过/失败，
+// 稳态扫描耗时或每进程堆分配次数的中位数超出时退出码为 2（ctest 只检查后者，与机器快慢无关）
+#include "core/Process/process_monitor.h"
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace sysmonitor;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+
+struct ScanOptions {
+    size_t spawn = 0;
+    size_t scans = 20;
+    size_t maxScanMs = 0;      // 非 0 时稳态扫描耗时中位数超出则退出码为 2
+    size_t maxAllocationsPerProcess = 0;
+};
+
+// 解析 --name=value 形式的数值参数，未匹配时返回 false
+bool ParseSizeArg(const char* arg, const char* name, size_t& out) {
+    size_t len = std::strlen(name);
+    if (std::strncmp(arg, name, len) != 0 || arg[len] != '=') {
+        return false;
+    }
+    try {
+        out = static_cast<size_t>(std::stoul(arg + len + 1));
+    } catch (...) {
+        std::cerr << "Invalid value for " << name << ": " << (arg + len + 1) << std::endl;
+    }
+    return true;
+}
+
+void PrintUsage() {
+    std::cout <<
+        "Usage: ProcessScanBench [options]\n"
+        "  --spawn=N         fork N idle child processes before scanning (default 0)\n"
+        "  --scans=N         steady-state scans to time (default 20)\n"
+        "  --max-scan-ms=N   exit 2 if the median steady-state scan exceeds N ms\n"
+        "  --max-allocations-per-process=N\n"
+        "                    exit 2 if the median scan makes more than N heap allocations per process\n";
+}
+
+// 子进程只等待信号，不做任何事
+std::vector<pid_t> SpawnIdleChildren(size_t count) {
+    std::vector<pid_t> children;
+    children.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            for (;;) pause();
+        }
+        if (pid < 0) {
+            std::cerr << "fork failed after " << children.size() << " children: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        children.push_back(pid);
+    }
+    return children;
+}
+
+// 本进程累计的用户态、内核态 CPU 时间（毫秒）
+void CpuTimeMs(double& user, double& system) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    user = usage.ru_utime.tv_sec * 1e3 + usage.ru_utime.tv_usec / 1e3;
+    system = usage.ru_stime.tv_sec * 1e3 + usage.ru_stime.tv_usec / 1e3;
+}
+
+void KillChildren(const std::vector<pid_t>& children) {
+    for (pid_t pid : children) kill(pid, SIGKILL);
+    for (pid_t pid : children) waitpid(pid, nullptr, 0);
+}
+
+} // namespace
+
+// 统计堆分配次数：稳态扫描除新进程外不应分配
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char* argv[]) {
+    ScanOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            PrintUsage();
+            return 0;
+        }
+        bool matched =
+            ParseSizeArg(arg, "--spawn", options.spawn) ||
+            ParseSizeArg(arg, "--scans", options.scans) ||
+            ParseSizeArg(arg, "--max-scan-ms", options.maxScanMs) ||
+            ParseSizeArg(arg, "--max-allocations-per-process", options.maxAllocationsPerProcess);
+        if (!matched) {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            PrintUsage();
+            return 1;
+        }
+    }
+    options.scans = std::max<size_t>(options.scans, 1);
+
+    std::vector<pid_t> children = SpawnIdleChildren(options.spawn);
+
+    std::vector<double> scanMs;
+    std::vector<uint64_t> scanAllocations;
+    size_t rows = 0;
+    double userMs = 0, systemMs = 0;
+    {
+        ProcessMonitor monitor;
+        auto warmupStart = Clock::now();
+        rows = monitor.GetLatestTable()->Size();
+        double warmupMs = std::chrono::duration<double, std::milli>(Clock::now() - warmupStart).count();
+        std::cout << "Processes: " << rows << ", first scan " << warmupMs << " ms" << std::endl;
+
+        double userBefore = 0, systemBefore = 0;
+        CpuTimeMs(userBefore, systemBefore);
+        for (size_t i = 0; i < options.scans; ++i) {
+            uint64_t allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+            auto start = Clock::now();
+            auto table = monitor.GetLatestTable();
+            scanMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            scanAllocations.push_back(g_allocations.load(std::memory_order_relaxed) - allocationsBefore);
+            rows = table->Size();
+        }
+        CpuTimeMs(userMs, systemMs);
+        userMs = (userMs - userBefore) / options.scans;
+        systemMs = (systemMs - systemBefore) / options.scans;
+    }
+    KillChildren(children);
+
+    std::vector<double> sorted = scanMs;
+    std::sort(sorted.begin(), sorted.end());
+    const double median = sorted[sorted.size() / 2];
+    std::sort(scanAllocations.begin(), scanAllocations.end());
+    const uint64_t allocations = scanAllocations[scanAllocations.size() / 2];
+    std::printf("%zu steady-state scans of %zu processes: min %.2f ms, median %.2f ms, max %.2f ms, "
+                "%.1f us/process\n  per scan: %.2f ms user, %.2f ms kernel (procfs reads), heap allocations median %llu\n",
+                sorted.size(), rows, sorted.front(), median, sorted.back(), median * 1000.0 / std::max<size_t>(rows, 1),
+                userMs, systemMs, static_cast<unsigned long long>(allocations));
+
+    if (options.maxScanMs > 0 && median > static_cast<double>(options.maxScanMs)) {
+        std::cerr << "Median scan " << median << " ms exceeds " << options.maxScanMs << " ms" << std::endl;
+        return 2;
+    }
+    if (options.maxAllocationsPerProcess > 0 && allocations > options.maxAllocationsPerProcess * rows) {
+        std::cerr << "Median scan made " << allocations << " heap allocations for " << rows << " processes, over "
+                  << options.maxAllocationsPerProcess << " per process" << std::endl;
+        return 2;
+    }
+    return 0;
+}